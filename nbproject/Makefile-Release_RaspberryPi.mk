@@ -39,6 +39,14 @@ OBJECTFILES= \
 	${OBJECTDIR}/src/backend/board/pieces/piece_actions.o \
 	${OBJECTDIR}/src/backend/board/random_generator.o \
 	${OBJECTDIR}/src/backend/board/timer/boardTimer.o \
+	${OBJECTDIR}/src/backend/board/zobrist.o \
+	${OBJECTDIR}/src/backend/bot/bot.o \
+	${OBJECTDIR}/src/backend/bot/pool.o \
+	${OBJECTDIR}/src/backend/bot/ttable.o \
+	${OBJECTDIR}/src/backend/input/input.o \
+	${OBJECTDIR}/src/backend/latency/latency.o \
+	${OBJECTDIR}/src/backend/monotonic/monotonic.o \
+	${OBJECTDIR}/src/backend/replay/replay.o \
 	${OBJECTDIR}/src/backend/rw/rw_ops.o \
 	${OBJECTDIR}/src/backend/stats/stats_mgmt.o \
 	${OBJECTDIR}/src/frontend/rpi/audioControl.o \
@@ -55,14 +63,22 @@ TESTFILES= \
 	${TESTDIR}/TestFiles/f3 \
 	${TESTDIR}/TestFiles/f2 \
 	${TESTDIR}/TestFiles/f1 \
-	${TESTDIR}/TestFiles/f5
+	${TESTDIR}/TestFiles/f5 \
+	${TESTDIR}/TestFiles/f6 \
+	${TESTDIR}/TestFiles/f7 \
+	${TESTDIR}/TestFiles/f8 \
+	${TESTDIR}/TestFiles/f9
 
 # Test Object Files
 TESTOBJECTFILES= \
 	${TESTDIR}/tests/backend/test_board.o \
 	${TESTDIR}/tests/backend/test_piece_actions.o \
 	${TESTDIR}/tests/backend/test_random_gen.o \
-	${TESTDIR}/tests/backend/test_rwops.o
+	${TESTDIR}/tests/backend/test_rwops.o \
+	${TESTDIR}/tests/backend/test_bot.o \
+	${TESTDIR}/tests/backend/test_replay.o \
+	${TESTDIR}/tests/backend/test_input.o \
+	${TESTDIR}/tests/backend/test_latency.o
 
 # C Compiler Flags
 CFLAGS=-Os
@@ -78,7 +94,7 @@ FFLAGS=
 ASFLAGS=
 
 # Link Libraries and Options
-LDLIBSOPTIONS=-L/usr/local/lib/ `pkg-config --libs sdl` -I/usr/local/include  
+LDLIBSOPTIONS=-L/usr/local/lib/ `pkg-config --libs sdl` -I/usr/local/include -lpthread
 
 # Build Targets
 .build-conf: ${BUILD_SUBPROJECTS}
@@ -108,6 +124,46 @@ ${OBJECTDIR}/src/backend/board/timer/boardTimer.o: src/backend/board/timer/board
 	${RM} "$@.d"
 	$(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/board/timer/boardTimer.o src/backend/board/timer/boardTimer.c
 
+${OBJECTDIR}/src/backend/board/zobrist.o: src/backend/board/zobrist.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/board
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/board/zobrist.o src/backend/board/zobrist.c
+
+${OBJECTDIR}/src/backend/bot/bot.o: src/backend/bot/bot.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/bot
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/bot/bot.o src/backend/bot/bot.c
+
+${OBJECTDIR}/src/backend/bot/pool.o: src/backend/bot/pool.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/bot
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/bot/pool.o src/backend/bot/pool.c
+
+${OBJECTDIR}/src/backend/bot/ttable.o: src/backend/bot/ttable.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/bot
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/bot/ttable.o src/backend/bot/ttable.c
+
+${OBJECTDIR}/src/backend/input/input.o: src/backend/input/input.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/input
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/input/input.o src/backend/input/input.c
+
+${OBJECTDIR}/src/backend/latency/latency.o: src/backend/latency/latency.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/latency
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/latency/latency.o src/backend/latency/latency.c
+
+${OBJECTDIR}/src/backend/monotonic/monotonic.o: src/backend/monotonic/monotonic.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/monotonic
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/monotonic/monotonic.o src/backend/monotonic/monotonic.c
+
+${OBJECTDIR}/src/backend/replay/replay.o: src/backend/replay/replay.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/replay
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/replay/replay.o src/backend/replay/replay.c
+
 ${OBJECTDIR}/src/backend/rw/rw_ops.o: src/backend/rw/rw_ops.c
 	${MKDIR} -p ${OBJECTDIR}/src/backend/rw
 	${RM} "$@.d"
@@ -166,6 +222,22 @@ ${TESTDIR}/TestFiles/f5: ${TESTDIR}/tests/backend/test_rwops.o ${OBJECTFILES:%.o
 	${MKDIR} -p ${TESTDIR}/TestFiles
 	${LINK.c} -o ${TESTDIR}/TestFiles/f5 $^ ${LDLIBSOPTIONS}   -lcunit 
 
+${TESTDIR}/TestFiles/f9: ${TESTDIR}/tests/backend/test_latency.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.c} -o ${TESTDIR}/TestFiles/f9 $^ ${LDLIBSOPTIONS}   -lcunit 
+
+${TESTDIR}/TestFiles/f8: ${TESTDIR}/tests/backend/test_input.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.c} -o ${TESTDIR}/TestFiles/f8 $^ ${LDLIBSOPTIONS}   -lcunit 
+
+${TESTDIR}/TestFiles/f7: ${TESTDIR}/tests/backend/test_replay.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.c} -o ${TESTDIR}/TestFiles/f7 $^ ${LDLIBSOPTIONS}   -lcunit 
+
+${TESTDIR}/TestFiles/f6: ${TESTDIR}/tests/backend/test_bot.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.c} -o ${TESTDIR}/TestFiles/f6 $^ ${LDLIBSOPTIONS}   -lcunit 
+
 
 ${TESTDIR}/tests/backend/test_board.o: tests/backend/test_board.c 
 	${MKDIR} -p ${TESTDIR}/tests/backend
@@ -191,6 +263,30 @@ ${TESTDIR}/tests/backend/test_rwops.o: tests/backend/test_rwops.c
 	$(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -MMD -MP -MF "$@.d" -o ${TESTDIR}/tests/backend/test_rwops.o tests/backend/test_rwops.c
 
 
+${TESTDIR}/tests/backend/test_latency.o: tests/backend/test_latency.c 
+	${MKDIR} -p ${TESTDIR}/tests/backend
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -MMD -MP -MF "$@.d" -o ${TESTDIR}/tests/backend/test_latency.o tests/backend/test_latency.c
+
+
+${TESTDIR}/tests/backend/test_input.o: tests/backend/test_input.c 
+	${MKDIR} -p ${TESTDIR}/tests/backend
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -MMD -MP -MF "$@.d" -o ${TESTDIR}/tests/backend/test_input.o tests/backend/test_input.c
+
+
+${TESTDIR}/tests/backend/test_replay.o: tests/backend/test_replay.c 
+	${MKDIR} -p ${TESTDIR}/tests/backend
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -MMD -MP -MF "$@.d" -o ${TESTDIR}/tests/backend/test_replay.o tests/backend/test_replay.c
+
+
+${TESTDIR}/tests/backend/test_bot.o: tests/backend/test_bot.c 
+	${MKDIR} -p ${TESTDIR}/tests/backend
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -MMD -MP -MF "$@.d" -o ${TESTDIR}/tests/backend/test_bot.o tests/backend/test_bot.c
+
+
 ${OBJECTDIR}/src/backend/board/board_nomain.o: ${OBJECTDIR}/src/backend/board/board.o src/backend/board/board.c 
 	${MKDIR} -p ${OBJECTDIR}/src/backend/board
 	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/board/board.o`; \
@@ -243,6 +339,110 @@ ${OBJECTDIR}/src/backend/board/timer/boardTimer_nomain.o: ${OBJECTDIR}/src/backe
 	    ${CP} ${OBJECTDIR}/src/backend/board/timer/boardTimer.o ${OBJECTDIR}/src/backend/board/timer/boardTimer_nomain.o;\
 	fi
 
+${OBJECTDIR}/src/backend/board/zobrist_nomain.o: ${OBJECTDIR}/src/backend/board/zobrist.o src/backend/board/zobrist.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/board
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/board/zobrist.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/board/zobrist_nomain.o src/backend/board/zobrist.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/board/zobrist.o ${OBJECTDIR}/src/backend/board/zobrist_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/bot/bot_nomain.o: ${OBJECTDIR}/src/backend/bot/bot.o src/backend/bot/bot.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/bot
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/bot/bot.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/bot/bot_nomain.o src/backend/bot/bot.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/bot/bot.o ${OBJECTDIR}/src/backend/bot/bot_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/bot/pool_nomain.o: ${OBJECTDIR}/src/backend/bot/pool.o src/backend/bot/pool.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/bot
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/bot/pool.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/bot/pool_nomain.o src/backend/bot/pool.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/bot/pool.o ${OBJECTDIR}/src/backend/bot/pool_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/bot/ttable_nomain.o: ${OBJECTDIR}/src/backend/bot/ttable.o src/backend/bot/ttable.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/bot
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/bot/ttable.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/bot/ttable_nomain.o src/backend/bot/ttable.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/bot/ttable.o ${OBJECTDIR}/src/backend/bot/ttable_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/input/input_nomain.o: ${OBJECTDIR}/src/backend/input/input.o src/backend/input/input.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/input
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/input/input.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/input/input_nomain.o src/backend/input/input.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/input/input.o ${OBJECTDIR}/src/backend/input/input_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/latency/latency_nomain.o: ${OBJECTDIR}/src/backend/latency/latency.o src/backend/latency/latency.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/latency
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/latency/latency.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/latency/latency_nomain.o src/backend/latency/latency.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/latency/latency.o ${OBJECTDIR}/src/backend/latency/latency_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/monotonic/monotonic_nomain.o: ${OBJECTDIR}/src/backend/monotonic/monotonic.o src/backend/monotonic/monotonic.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/monotonic
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/monotonic/monotonic.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/monotonic/monotonic_nomain.o src/backend/monotonic/monotonic.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/monotonic/monotonic.o ${OBJECTDIR}/src/backend/monotonic/monotonic_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/replay/replay_nomain.o: ${OBJECTDIR}/src/backend/replay/replay.o src/backend/replay/replay.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/replay
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/replay/replay.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DRPI -I/usr/local/include `pkg-config --cflags sdl` -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/replay/replay_nomain.o src/backend/replay/replay.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/replay/replay.o ${OBJECTDIR}/src/backend/replay/replay_nomain.o;\
+	fi
+
 ${OBJECTDIR}/src/backend/rw/rw_ops_nomain.o: ${OBJECTDIR}/src/backend/rw/rw_ops.o src/backend/rw/rw_ops.c 
 	${MKDIR} -p ${OBJECTDIR}/src/backend/rw
 	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/rw/rw_ops.o`; \
@@ -342,6 +542,10 @@ ${OBJECTDIR}/src/main_nomain.o: ${OBJECTDIR}/src/main.o src/main.c
 	    ${TESTDIR}/TestFiles/f2 || true; \
 	    ${TESTDIR}/TestFiles/f1 || true; \
 	    ${TESTDIR}/TestFiles/f5 || true; \
+	    ${TESTDIR}/TestFiles/f9 || true; \
+	    ${TESTDIR}/TestFiles/f8 || true; \
+	    ${TESTDIR}/TestFiles/f7 || true; \
+	    ${TESTDIR}/TestFiles/f6 || true; \
 	else  \
 	    ./${TEST} || true; \
 	fi
@@ -0,0 +1,487 @@
+#
+# Generated Makefile - do not edit!
+#
+# Edit the Makefile in the project folder instead (../Makefile). Each target
+# has a -pre and a -post target defined where you can add customized code.
+#
+# This makefile implements configuration specific macros and targets.
+
+
+# Environment
+MKDIR=mkdir
+CP=cp
+GREP=grep
+NM=nm
+CCADMIN=CCadmin
+RANLIB=ranlib
+CC=gcc
+CCC=g++
+CXX=g++
+FC=gfortran
+AS=as
+
+# Macros
+CND_PLATFORM=GNU-Linux
+CND_DLIB_EXT=so
+CND_CONF=Simulator
+CND_DISTDIR=dist
+CND_BUILDDIR=build
+
+# Include project Makefile
+include Makefile
+
+# Object Directory
+OBJECTDIR=${CND_BUILDDIR}/${CND_CONF}/${CND_PLATFORM}
+
+# Object Files
+OBJECTFILES= \
+	${OBJECTDIR}/src/backend/board/board.o \
+	${OBJECTDIR}/src/backend/board/pieces/piece_actions.o \
+	${OBJECTDIR}/src/backend/board/random_generator.o \
+	${OBJECTDIR}/src/backend/board/timer/boardTimer.o \
+	${OBJECTDIR}/src/backend/board/zobrist.o \
+	${OBJECTDIR}/src/backend/bot/bot.o \
+	${OBJECTDIR}/src/backend/bot/pool.o \
+	${OBJECTDIR}/src/backend/bot/ttable.o \
+	${OBJECTDIR}/src/backend/input/input.o \
+	${OBJECTDIR}/src/backend/latency/latency.o \
+	${OBJECTDIR}/src/backend/monotonic/monotonic.o \
+	${OBJECTDIR}/src/backend/replay/replay.o \
+	${OBJECTDIR}/src/backend/rw/rw_ops.o \
+	${OBJECTDIR}/src/backend/stats/stats_mgmt.o \
+	${OBJECTDIR}/src/sim/sim.o
+
+# Test Directory
+TESTDIR=${CND_BUILDDIR}/${CND_CONF}/${CND_PLATFORM}/tests
+
+# Test Files
+TESTFILES= \
+	${TESTDIR}/TestFiles/f3 \
+	${TESTDIR}/TestFiles/f2 \
+	${TESTDIR}/TestFiles/f1 \
+	${TESTDIR}/TestFiles/f5 \
+	${TESTDIR}/TestFiles/f6 \
+	${TESTDIR}/TestFiles/f7 \
+	${TESTDIR}/TestFiles/f8 \
+	${TESTDIR}/TestFiles/f9
+
+# Test Object Files
+TESTOBJECTFILES= \
+	${TESTDIR}/tests/backend/test_board.o \
+	${TESTDIR}/tests/backend/test_piece_actions.o \
+	${TESTDIR}/tests/backend/test_random_gen.o \
+	${TESTDIR}/tests/backend/test_rwops.o \
+	${TESTDIR}/tests/backend/test_bot.o \
+	${TESTDIR}/tests/backend/test_replay.o \
+	${TESTDIR}/tests/backend/test_input.o \
+	${TESTDIR}/tests/backend/test_latency.o
+
+# C Compiler Flags
+CFLAGS=-O3
+
+# CC Compiler Flags
+CCFLAGS=
+CXXFLAGS=
+
+# Fortran Compiler Flags
+FFLAGS=
+
+# Assembler Flags
+ASFLAGS=
+
+# Link Libraries and Options
+LDLIBSOPTIONS=-lpthread -lm
+
+# Build Targets
+.build-conf: ${BUILD_SUBPROJECTS}
+	"${MAKE}"  -f nbproject/Makefile-${CND_CONF}.mk ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/tetrix-sim
+
+${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/tetrix-sim: ${OBJECTFILES}
+	${MKDIR} -p ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}
+	${LINK.c} -o ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/tetrix-sim ${OBJECTFILES} ${LDLIBSOPTIONS}
+
+${OBJECTDIR}/src/backend/board/board.o: src/backend/board/board.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/board
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/board/board.o src/backend/board/board.c
+
+${OBJECTDIR}/src/backend/board/pieces/piece_actions.o: src/backend/board/pieces/piece_actions.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/board/pieces
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/board/pieces/piece_actions.o src/backend/board/pieces/piece_actions.c
+
+${OBJECTDIR}/src/backend/board/random_generator.o: src/backend/board/random_generator.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/board
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/board/random_generator.o src/backend/board/random_generator.c
+
+${OBJECTDIR}/src/backend/board/timer/boardTimer.o: src/backend/board/timer/boardTimer.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/board/timer
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/board/timer/boardTimer.o src/backend/board/timer/boardTimer.c
+
+${OBJECTDIR}/src/backend/board/zobrist.o: src/backend/board/zobrist.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/board
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/board/zobrist.o src/backend/board/zobrist.c
+
+${OBJECTDIR}/src/backend/bot/bot.o: src/backend/bot/bot.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/bot
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/bot/bot.o src/backend/bot/bot.c
+
+${OBJECTDIR}/src/backend/bot/pool.o: src/backend/bot/pool.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/bot
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/bot/pool.o src/backend/bot/pool.c
+
+${OBJECTDIR}/src/backend/bot/ttable.o: src/backend/bot/ttable.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/bot
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/bot/ttable.o src/backend/bot/ttable.c
+
+${OBJECTDIR}/src/backend/input/input.o: src/backend/input/input.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/input
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/input/input.o src/backend/input/input.c
+
+${OBJECTDIR}/src/backend/latency/latency.o: src/backend/latency/latency.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/latency
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/latency/latency.o src/backend/latency/latency.c
+
+${OBJECTDIR}/src/backend/monotonic/monotonic.o: src/backend/monotonic/monotonic.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/monotonic
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/monotonic/monotonic.o src/backend/monotonic/monotonic.c
+
+${OBJECTDIR}/src/backend/replay/replay.o: src/backend/replay/replay.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/replay
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/replay/replay.o src/backend/replay/replay.c
+
+${OBJECTDIR}/src/backend/rw/rw_ops.o: src/backend/rw/rw_ops.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/rw
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/rw/rw_ops.o src/backend/rw/rw_ops.c
+
+${OBJECTDIR}/src/backend/stats/stats_mgmt.o: src/backend/stats/stats_mgmt.c
+	${MKDIR} -p ${OBJECTDIR}/src/backend/stats
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/stats/stats_mgmt.o src/backend/stats/stats_mgmt.c
+
+${OBJECTDIR}/src/sim/sim.o: src/sim/sim.c
+	${MKDIR} -p ${OBJECTDIR}/src/sim
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/sim/sim.o src/sim/sim.c
+
+# Subprojects
+.build-subprojects:
+
+# Build Test Targets
+.build-tests-conf: .build-tests-subprojects .build-conf ${TESTFILES}
+.build-tests-subprojects:
+
+${TESTDIR}/TestFiles/f3: ${TESTDIR}/tests/backend/test_board.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.c} -o ${TESTDIR}/TestFiles/f3 $^ ${LDLIBSOPTIONS}   -lcunit 
+
+${TESTDIR}/TestFiles/f2: ${TESTDIR}/tests/backend/test_piece_actions.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.c} -o ${TESTDIR}/TestFiles/f2 $^ ${LDLIBSOPTIONS}   -lcunit 
+
+${TESTDIR}/TestFiles/f1: ${TESTDIR}/tests/backend/test_random_gen.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.c} -o ${TESTDIR}/TestFiles/f1 $^ ${LDLIBSOPTIONS}   -lcunit 
+
+${TESTDIR}/TestFiles/f5: ${TESTDIR}/tests/backend/test_rwops.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.c} -o ${TESTDIR}/TestFiles/f5 $^ ${LDLIBSOPTIONS}   -lcunit 
+
+${TESTDIR}/TestFiles/f9: ${TESTDIR}/tests/backend/test_latency.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.c} -o ${TESTDIR}/TestFiles/f9 $^ ${LDLIBSOPTIONS}   -lcunit 
+
+${TESTDIR}/TestFiles/f8: ${TESTDIR}/tests/backend/test_input.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.c} -o ${TESTDIR}/TestFiles/f8 $^ ${LDLIBSOPTIONS}   -lcunit 
+
+${TESTDIR}/TestFiles/f7: ${TESTDIR}/tests/backend/test_replay.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.c} -o ${TESTDIR}/TestFiles/f7 $^ ${LDLIBSOPTIONS}   -lcunit 
+
+${TESTDIR}/TestFiles/f6: ${TESTDIR}/tests/backend/test_bot.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.c} -o ${TESTDIR}/TestFiles/f6 $^ ${LDLIBSOPTIONS}   -lcunit 
+
+
+${TESTDIR}/tests/backend/test_board.o: tests/backend/test_board.c 
+	${MKDIR} -p ${TESTDIR}/tests/backend
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${TESTDIR}/tests/backend/test_board.o tests/backend/test_board.c
+
+
+${TESTDIR}/tests/backend/test_piece_actions.o: tests/backend/test_piece_actions.c 
+	${MKDIR} -p ${TESTDIR}/tests/backend
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${TESTDIR}/tests/backend/test_piece_actions.o tests/backend/test_piece_actions.c
+
+
+${TESTDIR}/tests/backend/test_random_gen.o: tests/backend/test_random_gen.c 
+	${MKDIR} -p ${TESTDIR}/tests/backend
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${TESTDIR}/tests/backend/test_random_gen.o tests/backend/test_random_gen.c
+
+
+${TESTDIR}/tests/backend/test_rwops.o: tests/backend/test_rwops.c 
+	${MKDIR} -p ${TESTDIR}/tests/backend
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${TESTDIR}/tests/backend/test_rwops.o tests/backend/test_rwops.c
+
+
+${TESTDIR}/tests/backend/test_latency.o: tests/backend/test_latency.c 
+	${MKDIR} -p ${TESTDIR}/tests/backend
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${TESTDIR}/tests/backend/test_latency.o tests/backend/test_latency.c
+
+
+${TESTDIR}/tests/backend/test_input.o: tests/backend/test_input.c 
+	${MKDIR} -p ${TESTDIR}/tests/backend
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${TESTDIR}/tests/backend/test_input.o tests/backend/test_input.c
+
+
+${TESTDIR}/tests/backend/test_replay.o: tests/backend/test_replay.c 
+	${MKDIR} -p ${TESTDIR}/tests/backend
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${TESTDIR}/tests/backend/test_replay.o tests/backend/test_replay.c
+
+
+${TESTDIR}/tests/backend/test_bot.o: tests/backend/test_bot.c 
+	${MKDIR} -p ${TESTDIR}/tests/backend
+	${RM} "$@.d"
+	$(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -MMD -MP -MF "$@.d" -o ${TESTDIR}/tests/backend/test_bot.o tests/backend/test_bot.c
+
+
+${OBJECTDIR}/src/backend/board/board_nomain.o: ${OBJECTDIR}/src/backend/board/board.o src/backend/board/board.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/board
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/board/board.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/board/board_nomain.o src/backend/board/board.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/board/board.o ${OBJECTDIR}/src/backend/board/board_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/board/pieces/piece_actions_nomain.o: ${OBJECTDIR}/src/backend/board/pieces/piece_actions.o src/backend/board/pieces/piece_actions.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/board/pieces
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/board/pieces/piece_actions.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/board/pieces/piece_actions_nomain.o src/backend/board/pieces/piece_actions.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/board/pieces/piece_actions.o ${OBJECTDIR}/src/backend/board/pieces/piece_actions_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/board/random_generator_nomain.o: ${OBJECTDIR}/src/backend/board/random_generator.o src/backend/board/random_generator.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/board
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/board/random_generator.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/board/random_generator_nomain.o src/backend/board/random_generator.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/board/random_generator.o ${OBJECTDIR}/src/backend/board/random_generator_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/board/timer/boardTimer_nomain.o: ${OBJECTDIR}/src/backend/board/timer/boardTimer.o src/backend/board/timer/boardTimer.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/board/timer
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/board/timer/boardTimer.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/board/timer/boardTimer_nomain.o src/backend/board/timer/boardTimer.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/board/timer/boardTimer.o ${OBJECTDIR}/src/backend/board/timer/boardTimer_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/board/zobrist_nomain.o: ${OBJECTDIR}/src/backend/board/zobrist.o src/backend/board/zobrist.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/board
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/board/zobrist.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/board/zobrist_nomain.o src/backend/board/zobrist.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/board/zobrist.o ${OBJECTDIR}/src/backend/board/zobrist_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/bot/bot_nomain.o: ${OBJECTDIR}/src/backend/bot/bot.o src/backend/bot/bot.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/bot
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/bot/bot.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/bot/bot_nomain.o src/backend/bot/bot.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/bot/bot.o ${OBJECTDIR}/src/backend/bot/bot_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/bot/pool_nomain.o: ${OBJECTDIR}/src/backend/bot/pool.o src/backend/bot/pool.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/bot
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/bot/pool.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/bot/pool_nomain.o src/backend/bot/pool.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/bot/pool.o ${OBJECTDIR}/src/backend/bot/pool_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/bot/ttable_nomain.o: ${OBJECTDIR}/src/backend/bot/ttable.o src/backend/bot/ttable.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/bot
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/bot/ttable.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/bot/ttable_nomain.o src/backend/bot/ttable.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/bot/ttable.o ${OBJECTDIR}/src/backend/bot/ttable_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/input/input_nomain.o: ${OBJECTDIR}/src/backend/input/input.o src/backend/input/input.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/input
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/input/input.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/input/input_nomain.o src/backend/input/input.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/input/input.o ${OBJECTDIR}/src/backend/input/input_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/latency/latency_nomain.o: ${OBJECTDIR}/src/backend/latency/latency.o src/backend/latency/latency.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/latency
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/latency/latency.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/latency/latency_nomain.o src/backend/latency/latency.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/latency/latency.o ${OBJECTDIR}/src/backend/latency/latency_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/monotonic/monotonic_nomain.o: ${OBJECTDIR}/src/backend/monotonic/monotonic.o src/backend/monotonic/monotonic.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/monotonic
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/monotonic/monotonic.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/monotonic/monotonic_nomain.o src/backend/monotonic/monotonic.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/monotonic/monotonic.o ${OBJECTDIR}/src/backend/monotonic/monotonic_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/replay/replay_nomain.o: ${OBJECTDIR}/src/backend/replay/replay.o src/backend/replay/replay.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/replay
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/replay/replay.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/replay/replay_nomain.o src/backend/replay/replay.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/replay/replay.o ${OBJECTDIR}/src/backend/replay/replay_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/rw/rw_ops_nomain.o: ${OBJECTDIR}/src/backend/rw/rw_ops.o src/backend/rw/rw_ops.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/rw
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/rw/rw_ops.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/rw/rw_ops_nomain.o src/backend/rw/rw_ops.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/rw/rw_ops.o ${OBJECTDIR}/src/backend/rw/rw_ops_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/backend/stats/stats_mgmt_nomain.o: ${OBJECTDIR}/src/backend/stats/stats_mgmt.o src/backend/stats/stats_mgmt.c 
+	${MKDIR} -p ${OBJECTDIR}/src/backend/stats
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/backend/stats/stats_mgmt.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/backend/stats/stats_mgmt_nomain.o src/backend/stats/stats_mgmt.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/backend/stats/stats_mgmt.o ${OBJECTDIR}/src/backend/stats/stats_mgmt_nomain.o;\
+	fi
+
+${OBJECTDIR}/src/sim/sim_nomain.o: ${OBJECTDIR}/src/sim/sim.o src/sim/sim.c 
+	${MKDIR} -p ${OBJECTDIR}/src/sim
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/sim/sim.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.c) -O2 -Wall -DALLEGRO -std=c11  -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/sim/sim_nomain.o src/sim/sim.c;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/sim/sim.o ${OBJECTDIR}/src/sim/sim_nomain.o;\
+	fi
+
+# Run Test Targets
+.test-conf:
+	@if [ "${TEST}" = "" ]; \
+	then  \
+	    ${TESTDIR}/TestFiles/f3 || true; \
+	    ${TESTDIR}/TestFiles/f2 || true; \
+	    ${TESTDIR}/TestFiles/f1 || true; \
+	    ${TESTDIR}/TestFiles/f5 || true; \
+	    ${TESTDIR}/TestFiles/f9 || true; \
+	    ${TESTDIR}/TestFiles/f8 || true; \
+	    ${TESTDIR}/TestFiles/f7 || true; \
+	    ${TESTDIR}/TestFiles/f6 || true; \
+	else  \
+	    ./${TEST} || true; \
+	fi
+
+# Clean Targets
+.clean-conf: ${CLEAN_SUBPROJECTS}
+	${RM} -r ${CND_BUILDDIR}/${CND_CONF}
+
+# Subprojects
+.clean-subprojects:
+
+# Enable dependency checking
+.dep.inc: .depcheck-impl
+
+include .dep.inc
@@ -31,7 +31,7 @@ DEFAULTCONF=RaspberryPi
 CONF=${DEFAULTCONF}
 
 # All Configurations
-ALLCONFS=RaspberryPi Allegro Release_Allegro Release_RaspberryPi 
+ALLCONFS=RaspberryPi Allegro Release_Allegro Release_RaspberryPi Simulator 
 
 
 # build
@@ -38,6 +38,14 @@ CND_ARTIFACT_PATH_Release_RaspberryPi=dist/Release_RaspberryPi/GNU-Linux/tetrix
 CND_PACKAGE_DIR_Release_RaspberryPi=
 CND_PACKAGE_NAME_Release_RaspberryPi=tetrix.tar
 CND_PACKAGE_PATH_Release_RaspberryPi=tetrix.tar
+# Simulator configuration
+CND_PLATFORM_Simulator=GNU-Linux
+CND_ARTIFACT_DIR_Simulator=dist/Simulator/GNU-Linux
+CND_ARTIFACT_NAME_Simulator=tetrix-sim
+CND_ARTIFACT_PATH_Simulator=dist/Simulator/GNU-Linux/tetrix-sim
+CND_PACKAGE_DIR_Simulator=dist/Simulator/GNU-Linux/package
+CND_PACKAGE_NAME_Simulator=tetrix.tar
+CND_PACKAGE_PATH_Simulator=dist/Simulator/GNU-Linux/package/tetrix.tar
 #
 # include compiler specific variables
 #
@@ -30,10 +30,12 @@
  * types of tetrominos available and their code when are fixed and the board 
  * size are also defined here.
  * 
- * At the beggining of a new game board_init() must be called with a pointer to
- * the structure board_t that will be used during the whole game. After 
- * ending the game (or displaying the top score), the board_t must be destroyed
- * to avoid unexpected behaviour.
+ * At the beggining of a new game board_create() must be called to get the
+ * board_t that will be used during the whole game. After ending the game (or
+ * displaying the top score), the board_t must be freed with board_free().
+ * 
+ * Every board has its own piece, stats, timer and bag of pieces, so many games
+ * can be played at the same time, each one from a single thread.
  *
  * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
  * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
@@ -47,6 +49,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>     // For memcpy and memset
+#include <stdatomic.h>  // For the games counter of newSeed()
+#include <time.h>       // For timespec_get
 
 // To generate random pieces and rows
 #include "random_generator.h"
@@ -57,21 +62,21 @@
 // For STATS
 #include "../stats/stats_mgmt.h"
 
-// For initTimer
+// For TIMER
 #include "timer/boardTimer.h"
 
+// For the keys of the hash
+#include "zobrist.h"
+
+// To record the game
+#include "../replay/replay.h"
+
 // This file
 #include "board.h"
 
 /// @privatesection
 // === Constants and Macro definitions ===
 
-/**
- * @def HIDDEN_ROWS
- * @brief Rows hidden to the user which will be part of the board
- */
-#define HIDDEN_ROWS     3
-
 /**
  * @def MBOARD_H
  * @brief Board Height for the matrix plus the 3 rows hidden to the user
@@ -84,6 +89,19 @@
  */
 #define MBOARD_W        (BOARD_WIDTH)
 
+/**
+ * @def CACHE_LINE
+ * @brief Size in bytes of a cache line. The board is aligned to it
+ */
+#define CACHE_LINE      64
+
+/**
+ * @def GBOARD_SIZE
+ * @brief Bytes allocated for the board, rounded up to whole cache lines
+ */
+#define GBOARD_SIZE     ((((MBOARD_W * MBOARD_H * sizeof (grid_t)) + \
+                           CACHE_LINE - 1) / CACHE_LINE) * CACHE_LINE)
+
 #define INVALID_LINE    -1
 #define INVALID_PIECE   -1
 
@@ -91,13 +109,25 @@
  * @def CELL(r,c)
  * @brief Returns the information in the row (r) and column (c) of the board
  */
-#define CELL(r,c) ( bStruct.gboard[ ((r) * MBOARD_W) + (c) ] )
+#define CELL(r,c) ( bStruct -> gboard[ ((r) * MBOARD_W) + (c) ] )
 
 /**
  * @def CELL_ADDRESS(r,c)
  * @brief Returns the memory address in the row (r) and column (c) of the board
  */
-#define CELL_ADDRESS(r,c) ( &bStruct.gboard[ ((r) * MBOARD_W) + (c) ] )
+#define CELL_ADDRESS(r,c) ( &bStruct -> gboard[ ((r) * MBOARD_W) + (c) ] )
+
+/**
+ * @def ROW(r)
+ * @brief Returns the occupancy mask of the row (r) of the board
+ */
+#define ROW(r) ( bStruct -> rows[(r)] )
+
+/**
+ * @def PRIVATE(b)
+ * @brief Returns the private structure of the board_t (b)
+ */
+#define PRIVATE(b) ( (board_private_t *) (b) )
 
 // === Enumerations, structures and typedefs ===
 
@@ -117,20 +147,65 @@ enum statsUpdates
  * This function has the full board, a PIECE structure to which it constantly 
  * calls and the bag of pieces that are being used in the game.
  * 
+ * Allocated by board_create(). Every board has its own, so no state is shared
+ * between two games.
  */
 typedef struct GAMEBOARD_PRIVATE
 {
-    /// Public GAMEBOARD structure to which functions address is written
-    board_t * public;
+    /**
+     * @brief Public GAMEBOARD structure to which functions address is written
+     * 
+     * @note Must be the first member, so the board_t given to every function
+     * can be casted to this structure.
+     */
+    board_t public;
 
-    /// Full game board
+    /// Full game board. Holds the type of block in every cell, one byte each.
+    /// Aligned to a cache line
     grid_t * gboard;
 
-    /// PIECE structure with the functions needed to modify it
+    /// Occupancy mask of every row in gboard. Only fixed blocks are set
+    row_t rows[MBOARD_H];
+
+    /// Height of every column, counting the hidden rows. See ask.heights()
+    int heights[MBOARD_W];
+
+    /**
+     * @brief Rows that may have been filled since the last ask.filledRows().
+     * 
+     * Bit r is set when a block is fixed or loaded in the row r of gboard. 
+     * Only these rows are checked for filled ones.
+     */
+    uint32_t touched;
+
+    /**
+     * @brief PIECE structure with the functions needed to modify it
+     * 
+     * The moving piece is never written in gboard. It's kept here, over the
+     * fixed blocks, until it's fixed.
+     */
     piece_t piece;
 
+    /// Game status, kept up to date by updateStatus() every time the board
+    /// or the moving piece change
+
+    struct
+    {
+        /// There's a moving piece in the visible rows
+        bool moving;
+        /// The stack reached the hidden rows. The game must finish
+        bool topOut;
+    } status;
+
+    /// STATS structure of the game
     stats_t stats;
 
+    /// Time between two board updates, according to the game's level
+    tmr_t timer;
+
+    /// State of the random generator used to fill the bag
+    rnd_state_t random;
+
     /// Bag of pieces
     int bag[TETROMINOS];
 
@@ -146,140 +221,409 @@ typedef struct GAMEBOARD_PRIVATE
      */
     int lastTetromino;
 
+    /**
+     * @brief Zobrist hash of the game. See ask.hash()
+     * 
+     * Fixed blocks are added as they're fixed, loaded or cleared. The keys
+     * of the moving piece and the bag are replaced by updateHash().
+     */
+    uint64_t hash;
+
+    /// Key of the moving piece in hash
+    uint64_t pieceKey;
+
+    /// Key of the bag in hash
+    uint64_t bagKey;
+
+    /// Replay where the game is recorded. NULL if it isn't
+    replay_t * replay;
+
+    /// Calls being made from another one, so they aren't recorded twice
+    int nested;
+
 } board_private_t;
 
 // === Global variables ===
 
 // === Function prototypes for private functions with file level scope ===
 // Returns the point (0,0) of the public board
-static int *
-askBoard (void);
+static grid_t *
+askBoard (board_t * self);
 
 // Returns a constant pointer to the current STATS structure.
 static const void *
-askStats (void);
+askStats (board_t * self);
+
+// Returns a pointer to the current TIMER structure.
+static void *
+askBoardTimer (board_t * self);
+
+// Coordinates of the moving piece in the public board
+static int
+askPiece (board_t * self, int cells[BLOCKS][COORD_NUM]);
+
+// Coordinates where the moving piece would land in the public board
+static int
+askGhost (board_t * self, int cells[BLOCKS][COORD_NUM]);
+
+// Height of every column of the board
+static const int *
+askHeights (board_t * self);
+
+// Every distinct place where a piece can be fixed
+static int
+askPlacements (board_t * self, int type, placement_t list[MAX_PLACEMENTS]);
+
+// Every distinct place where a new piece can be fixed in the given rows
+static int
+askPlacementsIn (board_t * self, const row_t rows[MBOARD_H], int type,
+                 placement_t list[MAX_PLACEMENTS]);
+
+// Zobrist hash of the game
+static uint64_t
+askHash (board_t * self);
+
+// Occupancy mask of every row of the board
+static const row_t *
+askRows (board_t * self);
+
+// Randomizer choosing the pieces of the game
+static int
+askRandomizer (board_t * self);
+
+// Seed of the game's random generator
+static uint64_t
+askSeed (board_t * self);
 
 // Clear a filled row.
 static void
-clearLine (int lines[BOARD_HEIGHT], int position);
+clearLine (board_t * self, int lines[BOARD_HEIGHT], int position);
 
-// Clear all cells with moving pieces on the board
+// Clear many filled rows at once.
 static void
-clearMoving (void);
+clearLines (board_t * self, const int lines[BOARD_HEIGHT], int n);
 
 // Destroy current board, erasing all the structure's information
 static void
-destroy (void);
+destroy (board_private_t * bStruct);
 
 // Tells if the current game should be finished.
 static int
-endGame (void);
+endGame (board_t * self);
 
 // Fills the bag of pieces
 static void
-fillBag (void);
+fillBag (board_private_t * bStruct);
+
+// Perform a hard drop of the piece
+static void
+hardDropPiece (board_t * self);
 
 // How many rows are complete and which are those.
 static int
-filledRows (int lines[BOARD_HEIGHT]);
+filledRows (board_t * self, int lines[BOARD_HEIGHT]);
 
 // Game mode to be played
 //void gameMode (int mode);
 
 // Initializes a new board.
 static int
-init (void);
+init (board_private_t * bStruct);
 
 // Tells if there's a moving piece currently in the board
 static int
-movingPieceInBoard (void);
+movingPieceInBoard (board_t * self);
+
+// Seed for a game created with no seed
+static uint64_t
+newSeed (void);
+
+// Fix the piece in the given placement
+static int
+placePiece (board_t * self, const placement_t * where);
+
+// Convert placements to the rows of the public board
+static void
+publicPlacements (placement_t list[], int n);
+
+// Record a call in the replay of the game
+static void
+record (board_private_t * bStruct, int type, int n, const int64_t args[]);
+
+// Record a keyframe if a piece is about to be deployed
+static void
+recordKeyframe (board_t * self);
 
 // Rotate the piece in the given direction
 static void
-rotatePiece (int direction);
+rotatePiece (board_t * self, int direction);
 
 // Set the piece's coordinates as CELL_I, ..., CELL_Z in the board
 static void
-setFixed (int cellType);
+setFixed (board_private_t * bStruct, int cellType);
+
+// Compute the height of every column from the occupancy masks
+static void
+setHeights (board_private_t * bStruct);
+
+// Load a visible row of the board with the given cells
+static void
+setRow (board_t * self, int row, const grid_t cells[BOARD_WIDTH]);
+
+// Choose the game's randomizer, generating the bag again
+static void
+setRandomizer (board_t * self, int randomizer);
+
+// Record the game in a replay
+static void
+setReplay (board_t * self, replay_t * replay);
+
+// Seed the game's random generator, generating the bag again
+static void
+setSeed (board_t * self, uint64_t seed);
 
-// Set the piece's coordinates as CELL_MOVING on the board
+// Read the top scores file, creating it if it doesn't exist
 static void
-setMoving (void);
+setTopScores (board_t * self);
 
 // Shift the piece in the given direction
 static void
-shiftPiece (int direction);
+shiftPiece (board_t * self, int direction);
 
 // Perform a soft drop of the piece
 static void
-softDropPiece (void);
+softDropPiece (board_t * self);
 
 // Level in which the game starts
 static void
-startLevel (unsigned char n);
+startLevel (board_t * self, unsigned char n);
 
 // Amount of rows to start in the board
 static void
-startRows (unsigned char n);
+startRows (board_t * self, unsigned char n);
 
 // Updates the board accoding the moving piece actions.
 static int
-updateBoard (int cellType);
+updateBoard (board_private_t * bStruct, int cellType);
+
+// Replace the keys of the moving piece and the bag in the hash
+static void
+updateHash (board_private_t * bStruct);
 
 // Updates the piece in the board
 static void
-updatePiece (void);
+updatePiece (board_t * self);
 
 // @brief Update STATS structure using an action from statsUpdate enum
 static void
-updateStats (int action);
+updateStats (board_private_t * bStruct, int action);
+
+// Update the game status after the board or the moving piece changed
+static void
+updateStatus (board_private_t * bStruct);
 
 // === ROM Constant variables with file level scope ===
 
 // === Static variables and constant variables with file level scope ===
 
-/// Board structure used in every function
-static board_private_t bStruct;
-
 // === Global function definitions ===
 /// @publicsection
 
 /**
- * @brief Initialize a GAMEBOARD structure
+ * @brief Create a new GAMEBOARD structure
+ * 
+ * Allocates and initializes a new board, with its own piece, stats, timer and
+ * bag of pieces.
+ * 
+ * @param None
+ * 
+ * @return Success: Pointer to the new board
+ * @return Fail: NULL
+ */
+board_t *
+board_create (void)
+{
+    board_private_t * bStruct = calloc(1, sizeof (board_private_t));
+
+    if ( bStruct == NULL )
+    {
+        fputs("Could not allocate memory for the GAMEBOARD.", stderr);
+        return NULL;
+    }
+
+    // Hold as uninitialized until init() finishes
+    bStruct -> public.init = false;
+
+    if ( init(bStruct) )
+    {
+        fputs("Board could not be initialized. Drestroying", stderr);
+        // Destroy the board
+        destroy(bStruct);
+        free(bStruct);
+
+        return NULL;
+    }
+
+    // Properly initialized
+    bStruct -> public.init = true;
+
+    return &bStruct -> public;
+}
+
+/**
+ * @brief Free a GAMEBOARD structure created with board_create()
  * 
- * @param gameBoardStruct GAMEBOARD structure to initialize
+ * All the structure's information is erased.
+ * 
+ * @param self GAMEBOARD structure to free. Can be NULL
+ * 
+ * @return Nothing
  */
 void
-board_init (void * gameBoardStruct)
+board_free (board_t * self)
+{
+    if ( self != NULL )
+    {
+        destroy(PRIVATE(self));
+        free(PRIVATE(self));
+    }
+}
+
+/**
+ * @brief Copy the full state of a game
+ * 
+ * The state holds no pointers and can be kept as long as needed. Taking one
+ * doesn't change the game.
+ * 
+ * @param self GAMEBOARD structure of the game
+ * @param state Where the state is written
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+int
+board_snapshot (board_t * self, board_state_t * state)
 {
-    if ( gameBoardStruct == NULL )
+    board_private_t * bStruct;
+
+    if ( self == NULL || state == NULL || self -> init == false )
     {
-        fputs("Invalid argument.", stderr);
-        fputs("A GAMEBOARD struct must be passed by reference.", stderr);
+        fputs("Invalid board for board_snapshot()", stderr);
+        return EXIT_FAILURE;
     }
 
+    bStruct = PRIVATE(self);
+
+    // Padding is cleared too, so two snapshots of the same game can be
+    // compared byte by byte
+    memset(state, 0, sizeof (board_state_t));
+
+    memcpy(state -> cells, bStruct -> gboard, sizeof (state -> cells));
+    memcpy(state -> rows, bStruct -> rows, sizeof (state -> rows));
+    memcpy(state -> heights, bStruct -> heights, sizeof (state -> heights));
+    state -> touched = bStruct -> touched;
+    state -> status.moving = bStruct -> status.moving;
+    state -> status.topOut = bStruct -> status.topOut;
+
+    if ( bStruct -> piece.init == true )
+    {
+        bStruct -> piece.save(&bStruct -> piece, state);
+    }
     else
     {
-        bStruct.public = (board_t *) gameBoardStruct;
+        state -> piece.type = TETROMINO_NONE;
+    }
 
-        // Hold as uninitialized until init() finishes
-        bStruct.public -> init = false;
+    memcpy(state -> bag.pieces, bStruct -> bag, sizeof (state -> bag.pieces));
+    state -> bag.position = bStruct -> bagPosition;
+    state -> bag.lastTetromino = bStruct -> lastTetromino;
+    state -> bag.piecesSinceI = bStruct -> random.piecesSinceI;
+    state -> bag.szInARow = bStruct -> random.szInARow;
+    memcpy(state -> bag.history, bStruct -> random.history,
+           sizeof (state -> bag.history));
+    state -> bag.randomizer = bStruct -> random.randomizer;
+    state -> bag.seed = bStruct -> random.seed;
+    memcpy(state -> bag.random, bStruct -> random.s,
+           sizeof (state -> bag.random));
 
-        if ( !init() )
-        {
-            // Properly initialized
-            bStruct.public -> init = true;
-        }
-        else
+    bStruct -> stats.save(&bStruct -> stats, state);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Set a game to a state taken with board_snapshot()
+ * 
+ * The state can come from any board, not only @p self. The game's timer and
+ * top score are left as they are.
+ * 
+ * @param self GAMEBOARD structure of the game
+ * @param state State to set
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+int
+board_restore (board_t * self, const board_state_t * state)
+{
+    board_private_t * bStruct;
+
+    if ( self == NULL || state == NULL || self -> init == false )
+    {
+        fputs("Invalid board for board_restore()", stderr);
+        return EXIT_FAILURE;
+    }
+
+    bStruct = PRIVATE(self);
+
+    memcpy(bStruct -> gboard, state -> cells, sizeof (state -> cells));
+    memcpy(bStruct -> rows, state -> rows, sizeof (state -> rows));
+    memcpy(bStruct -> heights, state -> heights, sizeof (state -> heights));
+    bStruct -> touched = state -> touched;
+    bStruct -> status.moving = state -> status.moving;
+    bStruct -> status.topOut = state -> status.topOut;
+
+    memcpy(bStruct -> bag, state -> bag.pieces, sizeof (bStruct -> bag));
+    bStruct -> bagPosition = state -> bag.position;
+    bStruct -> lastTetromino = state -> bag.lastTetromino;
+    bStruct -> random.piecesSinceI = state -> bag.piecesSinceI;
+    bStruct -> random.szInARow = state -> bag.szInARow;
+    memcpy(bStruct -> random.history, state -> bag.history,
+           sizeof (bStruct -> random.history));
+    bStruct -> random.randomizer = state -> bag.randomizer;
+    bStruct -> random.seed = state -> bag.seed;
+    memcpy(bStruct -> random.s, state -> bag.random,
+           sizeof (bStruct -> random.s));
+
+    bStruct -> stats.load(&bStruct -> stats, state);
+
+    // Replace the moving piece
+    if ( bStruct -> piece.init == true )
+    {
+        bStruct -> piece.destroy(&bStruct -> piece);
+    }
+
+    bStruct -> piece.type = TETROMINO_NONE;
+
+    if ( state -> piece.type != TETROMINO_NONE )
+    {
+        if ( piece_init(&bStruct -> piece, &bStruct -> public,
+                        bStruct -> rows, MBOARD_H, MBOARD_W,
+                        state -> piece.type) )
         {
-            fputs("Board could not be initialized. Drestroying", stderr);
-            // Avoid a possible error when trying to destroy a non-initialized
-            // piece
-            bStruct.piece.destroy = NULL;
-            // Destroy the board
-            destroy();
+            fputs("Could not restore the piece", stderr);
+            return EXIT_FAILURE;
         }
+
+        bStruct -> piece.load(&bStruct -> piece, state);
     }
+
+    // Every key is added again
+    bStruct -> hash = zobrist_rows(bStruct -> rows, MBOARD_H);
+    bStruct -> pieceKey = bStruct -> bagKey = 0;
+    updateHash(bStruct);
+
+    return EXIT_SUCCESS;
 }
 
 /// @privatesection
@@ -288,247 +632,521 @@ board_init (void * gameBoardStruct)
 /**
  * @brief Returns the point (0,0) of the public board
  * 
- * @param None
+ * @param self GAMEBOARD structure from which this function is called
  * 
  * @return Pointer to the first non-hidden row and column 0 (top-left public 
  * corner) of the board
  */
 static grid_t *
-askBoard (void)
+askBoard (board_t * self)
 {
+    board_private_t * bStruct = PRIVATE(self);
+
     return CELL_ADDRESS(HIDDEN_ROWS, 0);
 }
 
 /**
  * @brief Returns a constant pointer to the current STATS structure.
  * 
- * @param None
+ * @param self GAMEBOARD structure from which this function is called
  * 
  * @return Pointer to the current game' STATS structure
  */
 static const void *
-askStats (void)
+askStats (board_t * self)
 {
-    return &bStruct.stats;
+    board_private_t * bStruct = PRIVATE(self);
+
+    return &bStruct -> stats;
 }
 
 /**
- * @brief Clear a filled row.
- * 
- * Clears the given row and drops the board "as it is" once.
+ * @brief Returns a pointer to the current TIMER structure.
  * 
- * @param lines Array with all the filled rows.
- * @param position Position of the row to be cleared in @p lines array.
+ * @param self GAMEBOARD structure from which this function is called
  * 
- * @return Nothing
+ * @return Pointer to the current game' TIMER structure, already initialized
  */
-static void
-clearLine (int lines[BOARD_HEIGHT], int position)
+static void *
+askBoardTimer (board_t * self)
 {
-    int i, j;
+    board_private_t * bStruct = PRIVATE(self);
 
-    // Add hidden rows
-    int line = lines[position] + HIDDEN_ROWS;
-
-    // Goes from bottom to top starting in the filled line
-    for ( i = line; i > 0; i-- )
-    {
-        for ( j = 0; j < MBOARD_W; j++ )
-        {
-            // If there's a fixed piece or a CELL_CLEAR, copy it
-            if ( CELL(i - 1, j) > CELL_MOVING &&
-                 CELL(i, j) > CELL_MOVING )
-            {
-                CELL(i, j) = CELL(i - 1, j);
-            }
+    return &bStruct -> timer;
+}
 
-                // If the previous grid cell has a CELL_MOVING but not the one it's
-                // meant to be filled, ignore the piece and leave the cell as 
-                // CELL_CLEAR
-            else if ( CELL(i - 1, j) == CELL_MOVING &&
-                      CELL(i, j) > CELL_MOVING )
-            {
+/**
+ * @brief Coordinates where the moving piece would land in the public board
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * @param cells Array where the coordinates of every block are written. Blocks
+ * in the hidden rows have a negative COORD_Y.
+ * 
+ * @return Type of the moving piece, or TETROMINO_NONE if there is none
+ */
+static int
+askGhost (board_t * self, int cells[BLOCKS][COORD_NUM])
+{
+    int i, rows;
+    board_private_t * bStruct = PRIVATE(self);
 
-                CELL(i, j) = CELL_CLEAR;
-            }
-        }
+    if ( bStruct -> piece.init == false )
+    {
+        return TETROMINO_NONE;
     }
 
-    // Update the rest of the lines in the array
-    lines[position] = INVALID_LINE;
-    line -= HIDDEN_ROWS;
+    rows = bStruct -> piece.landing(&bStruct -> piece);
 
-    // Update the upper rows number of the one that's been cleared
-    for ( i = 0; i < BOARD_HEIGHT; i++ )
+    for ( i = b1; i < BLOCKS; i++ )
     {
-        (lines[i] != INVALID_LINE && lines[i] < line) ? (lines[i]++) : 0;
+        cells[i][COORD_X] = bStruct -> piece.get.coordinates[i][COORD_X];
+        cells[i][COORD_Y] = bStruct -> piece.get.coordinates[i][COORD_Y] + \
+                rows - HIDDEN_ROWS;
     }
+
+    return bStruct -> piece.type;
 }
 
 /**
- * @brief Clear all cells with moving pieces on the board
- *  
- * @param None
+ * @brief Height of every column of the board
  * 
- * @return Nothing
+ * @param self GAMEBOARD structure from which this function is called
+ * 
+ * @return Array with the height of every column, from left to right
  */
-static void
-clearMoving (void)
+static const int *
+askHeights (board_t * self)
 {
-    int i, j;
-
-    for ( i = 0; i < MBOARD_H; i++ )
-    {
-        for ( j = 0; j < MBOARD_W; j++ )
-        {
-            if ( CELL(i, j) == CELL_MOVING )
-            {
+    board_private_t * bStruct = PRIVATE(self);
 
-                CELL(i, j) = CELL_CLEAR;
-            }
-        }
-    }
+    return bStruct -> heights;
 }
 
 /**
- * @brief Destroy current board, erasing all the structure's information
+ * @brief Coordinates of the moving piece in the public board
  * 
- * @param None
+ * @param self GAMEBOARD structure from which this function is called
+ * @param cells Array where the coordinates of every block are written. Blocks
+ * in the hidden rows have a negative COORD_Y.
  * 
- * @return Nothing
+ * @return Type of the moving piece, or TETROMINO_NONE if there is none
  */
-static void
-destroy (void)
+static int
+askPiece (board_t * self, int cells[BLOCKS][COORD_NUM])
 {
     int i;
+    board_private_t * bStruct = PRIVATE(self);
 
-    // Free game board memory
-    free(bStruct.gboard);
-    bStruct.gboard = NULL;
-
-    // Clear bag
-    for ( i = 0; i < TETROMINOS; i++ )
-    {
-        bStruct.bag[i] = TETROMINO_NONE;
-    }
-
-    bStruct.bagPosition = 0;
-    bStruct.lastTetromino = TETROMINO_NONE;
-
-    // Destroy the piece if it hasn't been already
-    if ( bStruct.piece.destroy != NULL )
+    if ( bStruct -> piece.init == false )
     {
-        bStruct.piece.destroy();
-        bStruct.piece.destroy = NULL;
+        return TETROMINO_NONE;
     }
 
-    // Remove stats structure
-    if ( bStruct.public -> ask.stats != NULL )
+    for ( i = b1; i < BLOCKS; i++ )
     {
-        bStruct.stats.destroy();
-        bStruct.public -> ask.stats = NULL;
+        cells[i][COORD_X] = bStruct -> piece.get.coordinates[i][COORD_X];
+        cells[i][COORD_Y] = bStruct -> piece.get.coordinates[i][COORD_Y] - \
+                HIDDEN_ROWS;
     }
 
-    // Clear function pointers
-    bStruct.public -> ask.board = NULL;
-    bStruct.public -> ask.endGame = NULL;
-    bStruct.public -> ask.filledRows = NULL;
-    bStruct.public -> ask.movingPiece = NULL;
-
-    bStruct.public -> clear.line = NULL;
-
-    bStruct.public -> piece.rotate = NULL;
-    bStruct.public -> piece.shift = NULL;
-    bStruct.public -> piece.softDrop = NULL;
-
-    //bStruct.public -> set.gameMode = NULL;
-    bStruct.public -> set.startLevel = NULL;
-    bStruct.public -> set.startRows = NULL;
-
-    bStruct.public -> update = NULL;
-
-    bStruct.public -> init = false;
-
-    bStruct.public -> destroy = NULL;
-    bStruct.public = NULL;
+    return bStruct -> piece.type;
 }
 
 /**
- * @brief Tells if the current game should be finished.
+ * @brief Every distinct place where a piece can be fixed
  * 
- * @return True: 1
- * @return False: 0
+ * @param self GAMEBOARD structure from which this function is called
+ * @param type Piece to search from where new pieces appear, or TETROMINO_NONE
+ * for the moving piece from where it is
+ * @param list Array where the placements are written
+ * 
+ * @return Number of placements written in @p list
  */
 static int
-endGame (void)
+askPlacements (board_t * self, int type, placement_t list[MAX_PLACEMENTS])
 {
-    int i, j;
-    int ans = 0;
-    bool found = false;
+    int n = 0;
+    board_private_t * bStruct = PRIVATE(self);
 
-    if ( bStruct.public -> init == true )
+    if ( type != TETROMINO_NONE )
     {
-        for ( j = 0; j < MBOARD_W; j++ )
-        {
-            CELL(HIDDEN_ROWS, j) ? found = true : 0;
-        }
+        return askPlacementsIn(self, bStruct -> rows, type, list);
+    }
 
-        if ( found == true )
-        {
-            for ( i = 0; i < HIDDEN_ROWS; i++ )
-            {
-                for ( j = 0; j < MBOARD_W; j++ )
-                {
-                    CELL(i, j) > CELL_CLEAR ? ans = 1 : 0;
-                }
-            }
-        }
+    if ( bStruct -> piece.init == true )
+    {
+        n = bStruct -> piece.placements(&bStruct -> piece, list);
+        publicPlacements(list, n);
     }
 
-    return ans;
+    return n;
 }
 
 /**
- * @brief Fills the bag of pieces
+ * @brief Every distinct place where a new piece can be fixed in the given
+ * rows
  * 
- * When called the first time, bagPosition variable in the structure is set to
- * 0. From then on, every time it's called, bagPosition is left as it is and
- * lastTetromino variable is updated.
- * 
- * @param None
+ * @param self GAMEBOARD structure from which this function is called
+ * @param rows Row masks to search in, hidden rows included
+ * @param type Piece to search from where new pieces appear
+ * @param list Array where the placements are written
  * 
- * @return Nothing
+ * @return Number of placements written in @p list
  */
-static void
-fillBag (void)
+static int
+askPlacementsIn (board_t * self, const row_t rows[MBOARD_H], int type,
+                 placement_t list[MAX_PLACEMENTS])
 {
-    if ( bStruct.bagPosition == TETROMINOS - 1 )
-    {
-        bStruct.lastTetromino = bStruct.bag[TETROMINOS - 1];
-    }
-    else
+    int n = 0;
+    piece_t piece = {0};
+
+    // A new piece that's never part of the game
+    if ( type != TETROMINO_NONE && rows != NULL &&
+         !piece_init(&piece, self, rows, MBOARD_H, MBOARD_W, type) )
     {
+        n = piece.placements(&piece, list);
+        piece.destroy(&piece);
 
-        bStruct.bagPosition = 0;
+        publicPlacements(list, n);
     }
 
-    // Generate set of pieces
-    random_generator(bStruct.bag, TETROMINOS);
+    return n;
 }
 
 /**
- * @brief How many rows are complete and which are those.
+ * @brief Zobrist hash of the game
  * 
- * @param lines Array with the number of the rows that are filled.
+ * @param self GAMEBOARD structure from which this function is called
  * 
- * @return Number of filled rows
+ * @return Hash of the fixed blocks, the moving piece and the bag
+ */
+static uint64_t
+askHash (board_t * self)
+{
+    board_private_t * bStruct = PRIVATE(self);
+
+    return bStruct -> hash;
+}
+
+/**
+ * @brief Occupancy mask of every row of the board
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * 
+ * @return Array with the masks of every row, hidden ones included
+ */
+static const row_t *
+askRows (board_t * self)
+{
+    board_private_t * bStruct = PRIVATE(self);
+
+    return bStruct -> rows;
+}
+
+/**
+ * @brief Randomizer choosing the pieces of the game
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * 
+ * @return One of randomizers enum
  */
 static int
-filledRows (int lines[BOARD_HEIGHT])
+askRandomizer (board_t * self)
 {
-    int i, j;
+    board_private_t * bStruct = PRIVATE(self);
+
+    return bStruct -> random.randomizer;
+}
+
+/**
+ * @brief Seed of the game's random generator
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * 
+ * @return Seed given to set.seed(), or the one chosen by board_create()
+ */
+static uint64_t
+askSeed (board_t * self)
+{
+    board_private_t * bStruct = PRIVATE(self);
+
+    return bStruct -> random.seed;
+}
+
+/**
+ * @brief Clear a filled row.
+ * 
+ * Clears the given row and drops the board "as it is" once.
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * @param lines Array with all the filled rows.
+ * @param position Position of the row to be cleared in @p lines array.
+ * 
+ * @return Nothing
+ */
+static void
+clearLine (board_t * self, int lines[BOARD_HEIGHT], int position)
+{
+    int i;
+    int line = lines[position];
+    board_private_t * bStruct = PRIVATE(self);
+    int64_t args[1] = {line};
+
+    record(bStruct, REPLAY_CLEAR_LINES, 1, args);
+
+    // Drop every row over the filled one at once
+    bStruct -> nested++;
+    clearLines(self, &lines[position], 1);
+    bStruct -> nested--;
+
+    // Update the rest of the lines in the array
+    lines[position] = INVALID_LINE;
+
+    // Update the upper rows number of the one that's been cleared
+    for ( i = 0; i < BOARD_HEIGHT; i++ )
+    {
+        (lines[i] != INVALID_LINE && lines[i] < line) ? (lines[i]++) : 0;
+    }
+}
+
+/**
+ * @brief Clear many filled rows at once.
+ * 
+ * Compacts the board in a single bottom-up pass: a read cursor walks every
+ * row while a write cursor only advances over the rows that are kept. The rows
+ * left at the top are cleared.
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * @param lines Array with the filled rows to clear. It's not modified.
+ * @param n Number of rows in @p lines array.
+ * 
+ * @return Nothing
+ */
+static void
+clearLines (board_t * self, const int lines[BOARD_HEIGHT], int n)
+{
+    int i, read, write;
+    uint32_t touched = 0;
+    board_private_t * bStruct = PRIVATE(self);
+
+    // Bit r is set when the row r of the matrix must be cleared.
+    // MBOARD_H is always smaller than 32
+    uint32_t clear = 0;
+    int64_t args[BOARD_HEIGHT];
+
+    for ( i = 0; lines != NULL && i < n && i < BOARD_HEIGHT; i++ )
+    {
+        args[i] = lines[i];
+    }
+
+    // Nothing is cleared with no rows
+    (i > 0) ? record(bStruct, REPLAY_CLEAR_LINES, i, args) : (void) 0;
+
+    for ( i = 0; lines != NULL && i < n && i < BOARD_HEIGHT; i++ )
+    {
+        if ( lines[i] >= 0 && lines[i] < BOARD_HEIGHT )
+        {
+            clear |= (uint32_t) 1 << (lines[i] + HIDDEN_ROWS);
+        }
+    }
+
+    if ( clear == 0 )
+    {
+        return;
+    }
+
+    for ( read = write = MBOARD_H - 1; read >= 0; read-- )
+    {
+        // Keep the row, dropping it over the last one kept
+        if ( !(clear & ((uint32_t) 1 << read)) )
+        {
+            if ( write != read )
+            {
+                bStruct -> hash ^= zobrist_row(write, ROW(write)) ^ \
+                        zobrist_row(write, ROW(read));
+
+                ROW(write) = ROW(read);
+                memcpy(CELL_ADDRESS(write, 0), CELL_ADDRESS(read, 0),
+                       MBOARD_W * sizeof (grid_t));
+            }
+
+            // Pending rows to check are dropped with the rest
+            (bStruct -> touched & ((uint32_t) 1 << read)) ? \
+                    touched |= (uint32_t) 1 << write : 0;
+
+            write--;
+        }
+    }
+
+    // As many rows as the ones cleared are left clear at the top
+    for ( ; write >= 0; write-- )
+    {
+        bStruct -> hash ^= zobrist_row(write, ROW(write));
+
+        ROW(write) = 0;
+        memset(CELL_ADDRESS(write, 0), CELL_CLEAR, MBOARD_W * sizeof (grid_t));
+    }
+
+    bStruct -> touched = touched;
+
+    // The highest block of a column may have been cleared, so they are
+    // computed again. Lines are cleared far less often than pieces are fixed
+    setHeights(bStruct);
+
+    updateStatus(bStruct);
+}
+
+/**
+ * @brief Destroy current board, erasing all the structure's information
+ * 
+ * @param bStruct Private structure of the board
+ * 
+ * @return Nothing
+ */
+static void
+destroy (board_private_t * bStruct)
+{
+    int i;
+
+    // Free game board memory
+    free(bStruct -> gboard);
+    bStruct -> gboard = NULL;
+
+    memset(bStruct -> rows, 0, sizeof (bStruct -> rows));
+    memset(bStruct -> heights, 0, sizeof (bStruct -> heights));
+    bStruct -> touched = 0;
+    bStruct -> status.moving = false;
+    bStruct -> status.topOut = false;
+
+    // Clear bag
+    for ( i = 0; i < TETROMINOS; i++ )
+    {
+        bStruct -> bag[i] = TETROMINO_NONE;
+    }
+
+    bStruct -> bagPosition = 0;
+    bStruct -> lastTetromino = TETROMINO_NONE;
+
+    // Destroy the piece if it hasn't been already
+    if ( bStruct -> piece.destroy != NULL )
+    {
+        bStruct -> piece.destroy(&bStruct -> piece);
+    }
 
-    int fixed, nFill;
+    // Remove stats structure
+    if ( bStruct -> stats._init == true )
+    {
+        bStruct -> stats.destroy(&bStruct -> stats);
+        bStruct -> stats._init = false;
+    }
+
+    // Clear function pointers
+    bStruct -> public.ask.board = NULL;
+    bStruct -> public.ask.endGame = NULL;
+    bStruct -> public.ask.filledRows = NULL;
+    bStruct -> public.ask.hash = NULL;
+    bStruct -> public.ask.heights = NULL;
+    bStruct -> public.ask.movingPiece = NULL;
+    bStruct -> public.ask.piece = NULL;
+    bStruct -> public.ask.ghost = NULL;
+    bStruct -> public.ask.placements = NULL;
+    bStruct -> public.ask.placementsIn = NULL;
+    bStruct -> public.ask.rows = NULL;
+    bStruct -> public.ask.seed = NULL;
+    bStruct -> public.ask.randomizer = NULL;
+    bStruct -> public.ask.stats = NULL;
+    bStruct -> public.ask.timer = NULL;
+
+    bStruct -> public.clear.line = NULL;
+    bStruct -> public.clear.lines = NULL;
+
+    bStruct -> public.piece.rotate = NULL;
+    bStruct -> public.piece.shift = NULL;
+    bStruct -> public.piece.softDrop = NULL;
+    bStruct -> public.piece.hardDrop = NULL;
+    bStruct -> public.piece.place = NULL;
+
+    //bStruct -> public.set.gameMode = NULL;
+    bStruct -> public.set.startLevel = NULL;
+    bStruct -> public.set.startRows = NULL;
+    bStruct -> public.set.row = NULL;
+    bStruct -> public.set.seed = NULL;
+    bStruct -> public.set.randomizer = NULL;
+    bStruct -> public.set.replay = NULL;
+    bStruct -> public.set.topScores = NULL;
+
+    // The replay is freed by whoever created it
+    bStruct -> replay = NULL;
+
+    bStruct -> public.update = NULL;
+
+    bStruct -> public.init = false;
+}
+
+/**
+ * @brief Tells if the current game should be finished.
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * 
+ * @return True: 1
+ * @return False: 0
+ */
+static int
+endGame (board_t * self)
+{
+    board_private_t * bStruct = PRIVATE(self);
+
+    return (self -> init == true && bStruct -> status.topOut == true);
+}
+
+/**
+ * @brief Fills the bag of pieces
+ * 
+ * When called the first time, bagPosition variable in the structure is set to
+ * 0. From then on, every time it's called, bagPosition is left as it is and
+ * lastTetromino variable is updated.
+ * 
+ * @param bStruct Private structure of the board
+ * 
+ * @return Nothing
+ */
+static void
+fillBag (board_private_t * bStruct)
+{
+    if ( bStruct -> bagPosition == TETROMINOS - 1 )
+    {
+        bStruct -> lastTetromino = bStruct -> bag[TETROMINOS - 1];
+    }
+    else
+    {
+
+        bStruct -> bagPosition = 0;
+    }
+
+    // Generate set of pieces
+    random_generator(&bStruct -> random, bStruct -> bag, TETROMINOS);
+}
+
+/**
+ * @brief How many rows are complete and which are those.
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * @param lines Array with the number of the rows that are filled.
+ * 
+ * @return Number of filled rows
+ */
+static int
+filledRows (board_t * self, int lines[BOARD_HEIGHT])
+{
+    int i, nFill;
+    board_private_t * bStruct = PRIVATE(self);
+
+    // Rows are scored and checked now, so keyframes are the same. With no
+    // row touched since the last call nothing changes, and nothing is recorded
+    if ( bStruct -> touched != 0 )
+    {
+        record(bStruct, REPLAY_FILLED_ROWS, 0, NULL);
+    }
 
     // Clear the array
     for ( i = 0; i < BOARD_HEIGHT; i++ )
@@ -536,33 +1154,59 @@ filledRows (int lines[BOARD_HEIGHT])
         lines[i] = INVALID_LINE;
     }
 
-    // The whole board is readed looking for the lines
+    // Only the rows where a block was fixed can be filled. A row is filled when
+    // every column in its mask is set, and stays pending until it's cleared
     for ( i = HIDDEN_ROWS, nFill = 0; i < MBOARD_H; i++ )
     {
-        // To make it faster, only the first column of each row is checked at
-        // the beginning
-        if ( CELL(i, 0) > CELL_CLEAR )
+        if ( bStruct -> touched & ((uint32_t) 1 << i) )
         {
-            // And when both columns have a fixed block, the rest of the 
-            // columns are checked
-            for ( j = 1, fixed = 2;
-                  j < MBOARD_W && fixed > 0;
-                  j++ )
+            if ( ROW(i) == ROW_FULL )
             {
-                // Every grid cell must have a fixed block
-                (CELL(i, j) > CELL_CLEAR) ? (fixed++) : (fixed = 0);
+                lines[nFill++] = i - HIDDEN_ROWS;
+            }
+            else
+            {
+                bStruct -> touched &= ~((uint32_t) 1 << i);
             }
-
-            (fixed > 0) ? (lines[nFill++] = i - HIDDEN_ROWS) : 0;
         }
     }
 
-    bStruct.stats.update(nFill);
+    bStruct -> stats.update(&bStruct -> stats, nFill);
 
     // Number of filled rows
     return nFill;
 }
 
+/**
+ * @brief Perform a hard drop of the piece
+ * 
+ * The piece is moved to where it lands at once and then fixed by a board 
+ * update, just like when it can't be dropped any more.
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * 
+ * @return Nothing
+ */
+static void
+hardDropPiece (board_t * self)
+{
+    board_private_t * bStruct = PRIVATE(self);
+
+    record(bStruct, REPLAY_HARD_DROP, 0, NULL);
+
+    if ( bStruct -> piece.init == true )
+    {
+        // Every row dropped scores as a soft drop
+        bStruct -> stats.hardDrop(&bStruct -> stats,
+                                  bStruct -> piece.hardDrop(&bStruct -> piece));
+
+        // Fix it
+        bStruct -> nested++;
+        updatePiece(self);
+        bStruct -> nested--;
+    }
+}
+
 /**
  * @brief Game mode to be played
  * 
@@ -596,34 +1240,42 @@ gameMode (int mode)
  * new piece as PIECE_NONE (it will be later initialized by updatePiece() ) and
  * clears stats.
  * 
- * @param None
+ * @param bStruct Private structure of the board
  * 
  * @return Success: EXIT_SUCCESS
  * @return Fail: EXIT_FAILURE
  */
 static int
-init (void)
+init (board_private_t * bStruct)
 {
 
-#ifndef TRUERANDOM
-    if ( init_random_generator() )
+    // Allocate board. Every game fits in a few cache lines
+    bStruct -> gboard = (grid_t *) aligned_alloc(CACHE_LINE, GBOARD_SIZE);
+
+    if ( bStruct -> gboard == NULL )
     {
+        fputs("Could not allocate memory for the board.", stderr);
         return EXIT_FAILURE;
     }
-#endif
 
-    // Allocate board
-    bStruct.gboard = (grid_t *) calloc(MBOARD_W * MBOARD_H, sizeof (grid_t));
+    memset(bStruct -> gboard, CELL_CLEAR, GBOARD_SIZE);
 
-    if ( bStruct.gboard == NULL )
+    // Empty occupancy masks
+    memset(bStruct -> rows, 0, sizeof (bStruct -> rows));
+    memset(bStruct -> heights, 0, sizeof (bStruct -> heights));
+    bStruct -> touched = 0;
+    bStruct -> status.moving = false;
+    bStruct -> status.topOut = false;
+
+    if ( initStats(&bStruct -> stats) )
     {
-        fputs("Could not allocate memory for the board.", stderr);
+        fputs("Could initialize STATS.", stderr);
         return EXIT_FAILURE;
     }
 
-    if ( initStats(&bStruct.stats) )
+    if ( initTimer(&bStruct -> timer, &bStruct -> stats) )
     {
-        fputs("Could initialize STATS.", stderr);
+        fputs("Could initialize TIMER.", stderr);
         return EXIT_FAILURE;
     }
 
@@ -649,37 +1301,57 @@ init (void)
     putchar('\n');
 #endif
 
-    bStruct.public -> ask.stats = &askStats;
+    bStruct -> public.ask.stats = &askStats;
 
     // Generate first set of pieces
-    bStruct.bagPosition = 0;
-    bStruct.lastTetromino = INVALID_PIECE;
-    fillBag();
-
-    // Piece to PIECE_NONE
-    bStruct.piece.type = TETROMINO_NONE;
-
-    bStruct.public -> update = &updatePiece;
-    bStruct.public -> destroy = &destroy;
+    init_random_state(&bStruct -> random, newSeed(), RANDOMIZER_BAG);
+    bStruct -> bagPosition = 0;
+    bStruct -> lastTetromino = INVALID_PIECE;
+    fillBag(bStruct);
 
-    bStruct.public -> ask.board = &askBoard;
-    bStruct.public -> ask.endGame = &endGame;
-    bStruct.public -> ask.filledRows = &filledRows;
-    bStruct.public -> ask.movingPiece = &movingPieceInBoard;
+    // Empty board with no piece
+    bStruct -> hash = bStruct -> pieceKey = bStruct -> bagKey = 0;
+    updateHash(bStruct);
 
-    bStruct.public -> clear.line = &clearLine;
+    // Piece to PIECE_NONE
+    bStruct -> piece.type = TETROMINO_NONE;
+
+    bStruct -> public.update = &updatePiece;
+
+    bStruct -> public.ask.board = &askBoard;
+    bStruct -> public.ask.endGame = &endGame;
+    bStruct -> public.ask.filledRows = &filledRows;
+    bStruct -> public.ask.hash = &askHash;
+    bStruct -> public.ask.heights = &askHeights;
+    bStruct -> public.ask.movingPiece = &movingPieceInBoard;
+    bStruct -> public.ask.piece = &askPiece;
+    bStruct -> public.ask.ghost = &askGhost;
+    bStruct -> public.ask.placements = &askPlacements;
+    bStruct -> public.ask.placementsIn = &askPlacementsIn;
+    bStruct -> public.ask.rows = &askRows;
+    bStruct -> public.ask.seed = &askSeed;
+    bStruct -> public.ask.randomizer = &askRandomizer;
+    bStruct -> public.ask.timer = &askBoardTimer;
+
+    bStruct -> public.clear.line = &clearLine;
+    bStruct -> public.clear.lines = &clearLines;
 
     // Piece functions
-    bStruct.public -> piece.rotate = &rotatePiece;
-    bStruct.public -> piece.shift = &shiftPiece;
-    bStruct.public -> piece.softDrop = &softDropPiece;
+    bStruct -> public.piece.rotate = &rotatePiece;
+    bStruct -> public.piece.shift = &shiftPiece;
+    bStruct -> public.piece.softDrop = &softDropPiece;
+    bStruct -> public.piece.hardDrop = &hardDropPiece;
+    bStruct -> public.piece.place = &placePiece;
 
     // Options to set for the current game
-    //bStruct.public -> set.gameMode = &gameMode;
-    bStruct.public -> set.startLevel = &startLevel;
-    bStruct.public -> set.startRows = &startRows;
-
-    //initTimer(&bStruct.stats);
+    //bStruct -> public.set.gameMode = &gameMode;
+    bStruct -> public.set.startLevel = &startLevel;
+    bStruct -> public.set.startRows = &startRows;
+    bStruct -> public.set.row = &setRow;
+    bStruct -> public.set.seed = &setSeed;
+    bStruct -> public.set.randomizer = &setRandomizer;
+    bStruct -> public.set.replay = &setReplay;
+    bStruct -> public.set.topScores = &setTopScores;
 
     return EXIT_SUCCESS;
 }
@@ -687,29 +1359,159 @@ init (void)
 /**
  * @brief Tells if there's a moving piece currently in the visible board
  * 
+ * @param self GAMEBOARD structure from which this function is called
+ * 
  * @return True: 1
  * @return False: 0
  */
 static int
-movingPieceInBoard (void)
+movingPieceInBoard (board_t * self)
+{
+    board_private_t * bStruct = PRIVATE(self);
+
+    return (bStruct -> status.moving == true);
+}
+
+/**
+ * @brief Seed for a game created with no seed
+ * 
+ * The clock is mixed with the number of games created, so two games created
+ * at once don't get the same pieces.
+ * 
+ * @return Seed
+ */
+static uint64_t
+newSeed (void)
+{
+    static atomic_uint_fast64_t games = 0;
+    struct timespec t;
+
+    timespec_get(&t, TIME_UTC);
+
+    return ((uint64_t) t.tv_sec * 1000000000ULL + (uint64_t) t.tv_nsec) ^
+            (atomic_fetch_add(&games, 1) * 0x9E3779B97F4A7C15ULL);
+}
+
+/**
+ * @brief Fix the piece in the given placement
+ * 
+ * The piece is moved there at once and fixed by a board update, just like
+ * when it's hard dropped.
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * @param where Placement given by ask.placements()
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+static int
+placePiece (board_t * self, const placement_t * where)
 {
-    // Answer and counters
-    int ans = 0, i, j;
+    board_private_t * bStruct = PRIVATE(self);
+
+    if ( where != NULL )
+    {
+        int64_t args[3] = {where -> x, where -> y, where -> orientation};
+
+        record(bStruct, REPLAY_PLACE, 3, args);
+    }
 
-    if ( bStruct.piece.init == true &&
-         bStruct.stats.piece.current != TETROMINO_NONE )
+    if ( where == NULL || bStruct -> piece.init == false ||
+         bStruct -> piece.place(&bStruct -> piece, where -> x,
+                                where -> y + HIDDEN_ROWS,
+                                where -> orientation) )
     {
-        //CELL(r,c)
-        for ( i = HIDDEN_ROWS; ans == 0 && i < MBOARD_H; i++ )
+        return EXIT_FAILURE;
+    }
+
+    // Fix it if it can't go any lower
+    bStruct -> nested++;
+    updatePiece(self);
+    bStruct -> nested--;
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Convert placements to the rows of the public board
+ * 
+ * @param list Placements given by piece.placements()
+ * @param n Number of placements in @p list
+ * 
+ * @return Nothing
+ */
+static void
+publicPlacements (placement_t list[], int n)
+{
+    int i, j;
+
+    for ( i = 0; i < n; i++ )
+    {
+        list[i].y -= HIDDEN_ROWS;
+
+        for ( j = b1; j < BLOCKS; j++ )
         {
-            for ( j = 0; ans == 0 && j < BOARD_WIDTH; j++ )
-            {
-                (CELL(i, j) == CELL_MOVING) ? (ans = 1) : 0;
-            }
+            list[i].cells[j][COORD_Y] -= HIDDEN_ROWS;
         }
     }
+}
+
+/**
+ * @brief Record a call in the replay of the game
+ * 
+ * Nothing is recorded if there's no replay or the call is made from another
+ * one, which was already recorded.
+ * 
+ * @param bStruct Private structure of the board
+ * @param type One of replayEvents enum
+ * @param n Number of arguments
+ * @param args Arguments, as described in replayEvents enum
+ * 
+ * @return Nothing
+ */
+static void
+record (board_private_t * bStruct, int type, int n, const int64_t args[])
+{
+    if ( bStruct -> replay != NULL && bStruct -> nested == 0 )
+    {
+        bStruct -> replay -> event(bStruct -> replay, type, n, args);
+    }
+}
+
+/**
+ * @brief Record a keyframe if a piece is about to be deployed
+ * 
+ * Called before an update, so the keyframe is the state of the game between
+ * two calls. It's recorded every REPLAY_KEYFRAME_PIECES pieces, from the
+ * first one.
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * 
+ * @return Nothing
+ */
+static void
+recordKeyframe (board_t * self)
+{
+    int i, pieces = 0;
+    board_state_t state;
+    board_private_t * bStruct = PRIVATE(self);
+
+    if ( bStruct -> replay == NULL || bStruct -> nested != 0 ||
+         bStruct -> piece.type != TETROMINO_NONE )
+    {
+        return;
+    }
 
-    return ans;
+    for ( i = 0; i < TETROMINOS; i++ )
+    {
+        pieces += bStruct -> stats.piece.number[i];
+    }
+
+    if ( pieces % REPLAY_KEYFRAME_PIECES == 0 &&
+         board_snapshot(self, &state) == EXIT_SUCCESS )
+    {
+        bStruct -> replay -> keyframe(bStruct -> replay, &state);
+    }
 }
 
 /**
@@ -718,85 +1520,300 @@ movingPieceInBoard (void)
  * Automatically performs a board update but does not fixes the piece
  * if the ratation cannot be performed.
  * 
+ * @param self GAMEBOARD structure from which this function is called
  * @param direction LEFT or RIGHT, according to shiftingTypes enum
  * 
  * @return Nothing
  */
 static void
-rotatePiece (int direction)
+rotatePiece (board_t * self, int direction)
 {
+    board_private_t * bStruct = PRIVATE(self);
+    int64_t args[1] = {direction};
+
+    record(bStruct, REPLAY_ROTATE, 1, args);
+
     if ( (direction == LEFT || direction == RIGHT) &&
-         (bStruct.piece.init == true) )
+         (bStruct -> piece.init == true) )
     {
         // Rotate piece
-        bStruct.piece.rotate(direction);
+        bStruct -> piece.rotate(&bStruct -> piece, direction);
 
         // Force update
-        updateBoard(CELL_MOVING);
+        updateBoard(bStruct, CELL_MOVING);
     }
 }
 
 /**
- * @brief Set the piece's coordinates as CELL_MOVING on the board
+ * @brief Set the piece's coordinates as CELL_I, ..., CELL_Z in the board
  *  
- * @param None
+ * @param bStruct Private structure of the board
+ * @param cellType Block that's going to be fixed. (i.e. TETROMINO_J will set
+ * the four cells as CELL_J)
  * 
  * @return Nothing
  */
 static void
-setMoving (void)
+setFixed (board_private_t * bStruct, int cellType)
 {
-    // Block b1
-    CELL(bStruct.piece.get.coordinates[b1][COORD_Y], \
-        bStruct.piece.get.coordinates[b1][COORD_X]) = CELL_MOVING;
+    int i, x, y;
+
+    if ( cellType >= CELL_I )
+    {
+        for ( i = b1; i < BLOCKS; i++ )
+        {
+            x = bStruct -> piece.get.coordinates[i][COORD_X];
+            y = bStruct -> piece.get.coordinates[i][COORD_Y];
+
+            CELL(y, x) = cellType;
+
+            (!(ROW(y) & ROW_BIT(x))) ? \
+                    bStruct -> hash ^= zobrist_row(y, ROW_BIT(x)) : 0;
+            ROW(y) |= ROW_BIT(x);
+
+            // Rows are numbered from the top
+            (bStruct -> heights[x] < MBOARD_H - y) ? \
+                    bStruct -> heights[x] = MBOARD_H - y : 0;
+            bStruct -> touched |= (uint32_t) 1 << y;
+        }
+    }
 
-    // Block b2
-    CELL(bStruct.piece.get.coordinates[b2][COORD_Y], \
-        bStruct.piece.get.coordinates[b2][COORD_X]) = CELL_MOVING;
+    else
+    {
+        fputs("Invalid cellType for setFixed()", stderr);
+    }
+}
 
-    // Block b3
-    CELL(bStruct.piece.get.coordinates[b3][COORD_Y], \
-        bStruct.piece.get.coordinates[b3][COORD_X]) = CELL_MOVING;
+/**
+ * @brief Compute the height of every column from the occupancy masks
+ * 
+ * @param bStruct Private structure of the board
+ * 
+ * @return Nothing
+ */
+static void
+setHeights (board_private_t * bStruct)
+{
+    int i, j;
 
-    // Block b4
-    CELL(bStruct.piece.get.coordinates[b4][COORD_Y], \
-        bStruct.piece.get.coordinates[b4][COORD_X]) = CELL_MOVING;
+    for ( j = 0; j < MBOARD_W; j++ )
+    {
+        // Look for the highest block in the column
+        i = 0;
+        while ( i < MBOARD_H && !(ROW(i) & ROW_BIT(j)) )
+        {
+            i++;
+        }
+
+        bStruct -> heights[j] = MBOARD_H - i;
+    }
 }
 
 /**
- * @brief Set the piece's coordinates as CELL_I, ..., CELL_Z in the board
- *  
- * @param cellType Block that's going to be fixed. (i.e. TETROMINO_J will set
- * the four cells as CELL_J)
+ * @brief Load a visible row of the board with the given cells
+ * 
+ * Any value out of the CELL_CLEAR to CELL_Z range is loaded as CELL_CLEAR.
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * @param row Visible row number, being 0 the top one
+ * @param cells Array with the cells of the row, from left to right
  * 
  * @return Nothing
  */
 static void
-setFixed (int cellType)
+setRow (board_t * self, int row, const grid_t cells[BOARD_WIDTH])
 {
-    if ( cellType >= CELL_I )
+    int j;
+    row_t mask = 0;
+    board_private_t * bStruct = PRIVATE(self);
+
+    if ( cells == NULL || row < 0 || row >= BOARD_HEIGHT )
     {
-        // Block b1
-        CELL(bStruct.piece.get.coordinates[b1][COORD_Y], \
-            bStruct.piece.get.coordinates[b1][COORD_X]) = cellType;
+        fputs("Invalid row for setRow()", stderr);
+        return;
+    }
 
-        // Block b2
-        CELL(bStruct.piece.get.coordinates[b2][COORD_Y], \
-            bStruct.piece.get.coordinates[b2][COORD_X]) = cellType;
+    if ( bStruct -> replay != NULL )
+    {
+        int64_t args[1 + BOARD_WIDTH] = {row};
 
-        // Block b3
-        CELL(bStruct.piece.get.coordinates[b3][COORD_Y], \
-            bStruct.piece.get.coordinates[b3][COORD_X]) = cellType;
+        for ( j = 0; j < BOARD_WIDTH; j++ )
+        {
+            args[j + 1] = cells[j];
+        }
 
-        // Block b4
-        CELL(bStruct.piece.get.coordinates[b4][COORD_Y], \
-            bStruct.piece.get.coordinates[b4][COORD_X]) = cellType;
+        record(bStruct, REPLAY_ROW, 1 + BOARD_WIDTH, args);
     }
 
-    else
+    // Add hidden rows
+    row += HIDDEN_ROWS;
+
+    for ( j = 0; j < MBOARD_W; j++ )
     {
-        fputs("Invalid cellType for setFixed()", stderr);
+        if ( cells[j] >= CELL_I && cells[j] <= CELL_Z )
+        {
+            CELL(row, j) = cells[j];
+            mask |= ROW_BIT(j);
+        }
+        else
+        {
+            CELL(row, j) = CELL_CLEAR;
+        }
     }
+
+    bStruct -> hash ^= zobrist_row(row, ROW(row)) ^ zobrist_row(row, mask);
+
+    ROW(row) = mask;
+    bStruct -> touched |= (uint32_t) 1 << row;
+
+    // Blocks may have been removed too
+    setHeights(bStruct);
+
+    updateStatus(bStruct);
+}
+
+/**
+ * @brief Choose the game's randomizer, generating the bag again
+ * 
+ * It can only be set before the first update. The seed is kept, so the same
+ * seed and randomizer get the same pieces.
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * @param randomizer One of randomizers enum
+ * 
+ * @return Nothing
+ */
+static void
+setRandomizer (board_t * self, int randomizer)
+{
+    board_private_t * bStruct = PRIVATE(self);
+    int64_t args[1] = {randomizer};
+
+    record(bStruct, REPLAY_RANDOMIZER, 1, args);
+
+    if ( randomizer < 0 || randomizer >= RANDOMIZERS )
+    {
+        fputs("Invalid randomizer for set.randomizer()", stderr);
+        return;
+    }
+
+    if ( bStruct -> piece.type != TETROMINO_NONE ||
+         bStruct -> bagPosition != 0 )
+    {
+        fputs("The randomizer can only be set before the first update",
+              stderr);
+        return;
+    }
+
+    init_random_state(&bStruct -> random, bStruct -> random.seed, randomizer);
+    bStruct -> lastTetromino = INVALID_PIECE;
+    fillBag(bStruct);
+
+    updateHash(bStruct);
+}
+
+/**
+ * @brief Record the game in a replay
+ * 
+ * It can only be set before anything else is done with the board. Then, the
+ * seed, randomizer and start level are recorded, followed by every call that
+ * changes the game.
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * @param replay Replay given by replay_record(). NULL to stop recording
+ * 
+ * @return Nothing
+ */
+static void
+setReplay (board_t * self, replay_t * replay)
+{
+    int i;
+    bool fresh;
+    int64_t args[1];
+    board_private_t * bStruct = PRIVATE(self);
+
+    if ( replay != NULL && (replay -> init == false ||
+                            replay -> recording == false) )
+    {
+        fputs("Invalid replay for set.replay()", stderr);
+        return;
+    }
+
+    // A new board has no piece, the whole bag left and every row empty
+    fresh = (bStruct -> piece.type == TETROMINO_NONE &&
+             bStruct -> bagPosition == 0);
+
+    for ( i = 0; fresh == true && i < MBOARD_H; i++ )
+    {
+        (ROW(i) != 0) ? fresh = false : 0;
+    }
+
+    if ( replay != NULL && fresh == false )
+    {
+        fputs("The replay can only be set in a new board", stderr);
+        return;
+    }
+
+    bStruct -> replay = replay;
+
+    args[0] = (int64_t) bStruct -> random.seed;
+    record(bStruct, REPLAY_SEED, 1, args);
+
+    args[0] = bStruct -> random.randomizer;
+    record(bStruct, REPLAY_RANDOMIZER, 1, args);
+
+    args[0] = bStruct -> stats.level;
+    record(bStruct, REPLAY_START_LEVEL, 1, args);
+}
+
+/**
+ * @brief Seed the game's random generator, generating the bag again
+ * 
+ * Games with the same seed get the same pieces and random rows. It can only
+ * be set before the first update.
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * @param seed Any number
+ * 
+ * @return Nothing
+ */
+static void
+setSeed (board_t * self, uint64_t seed)
+{
+    board_private_t * bStruct = PRIVATE(self);
+    int64_t args[1] = {(int64_t) seed};
+
+    record(bStruct, REPLAY_SEED, 1, args);
+
+    if ( bStruct -> piece.type != TETROMINO_NONE ||
+         bStruct -> bagPosition != 0 )
+    {
+        fputs("The seed can only be set before the first update", stderr);
+        return;
+    }
+
+    init_random_state(&bStruct -> random, seed, bStruct -> random.randomizer);
+    bStruct -> lastTetromino = INVALID_PIECE;
+    fillBag(bStruct);
+
+    updateHash(bStruct);
+}
+
+/**
+ * @brief Read the top scores file, creating it if it doesn't exist
+ * 
+ * It isn't recorded in the replay, as it doesn't change the game.
+ * 
+ * @param self GAMEBOARD structure from which this function is called
+ * 
+ * @return Nothing
+ */
+static void
+setTopScores (board_t * self)
+{
+    stats_t * stats = &PRIVATE(self) -> stats;
+
+    stats -> loadTopScores(stats);
 }
 
 /**
@@ -805,21 +1822,27 @@ setFixed (int cellType)
  * Automatically performs a board update but does not fixes the piece
  * if the shifting cannot be performed.
  * 
+ * @param self GAMEBOARD structure from which this function is called
  * @param direction LEFT or RIGHT, according to shiftingTypes enum
  * 
  * @return Nothing
  */
 static void
-shiftPiece (int direction)
+shiftPiece (board_t * self, int direction)
 {
+    board_private_t * bStruct = PRIVATE(self);
+    int64_t args[1] = {direction};
+
+    record(bStruct, REPLAY_SHIFT, 1, args);
+
     if ( (direction == LEFT || direction == RIGHT) &&
-         (bStruct.piece.init == true) )
+         (bStruct -> piece.init == true) )
     {
         // Shift piece
-        bStruct.piece.shift(direction);
+        bStruct -> piece.shift(&bStruct -> piece, direction);
 
         // Force update
-        updateBoard(CELL_MOVING);
+        updateBoard(bStruct, CELL_MOVING);
     }
 }
 
@@ -828,63 +1851,81 @@ shiftPiece (int direction)
  * 
  * Automatically performs a board update.
  * 
- * @param None
+ * @param self GAMEBOARD structure from which this function is called
  * 
  * @return Nothing
  */
 static void
-softDropPiece (void)
+softDropPiece (board_t * self)
 {
-    if ( bStruct.piece.init == true )
+    board_private_t * bStruct = PRIVATE(self);
+
+    record(bStruct, REPLAY_SOFT_DROP, 0, NULL);
+
+    if ( bStruct -> piece.init == true )
     {
         // Soft drop (calls board update)
-        bStruct.piece.softDrop();
+        bStruct -> nested++;
+        bStruct -> piece.softDrop(&bStruct -> piece);
+        bStruct -> nested--;
 
         // Update stats
-        updateStats(SOFT);
+        updateStats(bStruct, SOFT);
     }
 }
 
 /**
  * @brief Level in which the game starts
  * 
+ * @param self GAMEBOARD structure from which this function is called
  * @param n Level number between 0 and 9
  * 
  * @return Nothing
  */
 static void
-startLevel (unsigned char n)
+startLevel (board_t * self, unsigned char n)
 {
-    (n <= 9) ? (bStruct.stats.level = n) : (bStruct.stats.level = 0);
+    board_private_t * bStruct = PRIVATE(self);
+    int64_t args[1] = {n};
+
+    record(bStruct, REPLAY_START_LEVEL, 1, args);
+
+    (n <= 9) ? (bStruct -> stats.level = n) : (bStruct -> stats.level = 0);
 }
 
 /**
  * @brief Amount of rows to start in the board
  * 
+ * @param self GAMEBOARD structure from which this function is called
  * @param n Number between 0 and 9
  * 
  * @return Nothing
  */
 static void
-startRows (unsigned char n)
+startRows (board_t * self, unsigned char n)
 {
+    board_private_t * bStruct = PRIVATE(self);
+    int64_t args[1] = {n};
+
+    record(bStruct, REPLAY_START_ROWS, 1, args);
+
     if ( n > 0 && n <= 9 )
     {
-        int i = 1, j;
-        int row[MBOARD_W];
+        int i = 1;
+        grid_t row[MBOARD_W];
+
+        // The rows come from the seed, so they aren't recorded
+        bStruct -> nested++;
 
         while ( i <= n )
         {
-            random_row(row, MBOARD_W);
-
-            // CELL(r,c)
-            for ( j = 0; j < MBOARD_W; j++ )
-            {
-                CELL(MBOARD_H - i, j) = row[j];
-            }
+            random_row(&bStruct -> random, row, MBOARD_W);
+            setRow(self, BOARD_HEIGHT - i, row);
 
             i++;
         }
+
+        bStruct -> nested--;
     }
 }
 
@@ -894,6 +1935,7 @@ startRows (unsigned char n)
  * If the current piece isn't initialized, calls piece_init(), otherwise, 
  * follows the user input, rotating, shifting or dropping the piece.
  * 
+ * @param bStruct Private structure of the board
  * @param cellType Blocks type of the piece. Could be CELL_MOVING or >= CELL_I
  * if the piece should be moving or fixed
  * 
@@ -901,27 +1943,48 @@ startRows (unsigned char n)
  * @return Failure: EXIT_FAILURE
  */
 static int
-updateBoard (int cellType)
+updateBoard (board_private_t * bStruct, int cellType)
 {
-    // Clear moving pieces
-    clearMoving();
-
-    // Set the piece as moving or as fixed
-    if ( cellType == CELL_MOVING )
-    {
-        setMoving();
-    }
-
-    else
+    // A moving piece is only kept in the PIECE structure. The board is written
+    // just when it's fixed
+    if ( cellType != CELL_MOVING )
     {
         // Fix it and destroy the piece structure
-        setFixed(cellType);
-        bStruct.piece.destroy();
+        setFixed(bStruct, cellType);
+        bStruct -> piece.destroy(&bStruct -> piece);
     }
 
+    updateHash(bStruct);
+    updateStatus(bStruct);
+
     return EXIT_SUCCESS;
 }
 
+/**
+ * @brief Replace the keys of the moving piece and the bag in the hash
+ * 
+ * @param bStruct Private structure of the board
+ * 
+ * @return Nothing
+ */
+static void
+updateHash (board_private_t * bStruct)
+{
+    uint64_t piece = 0, bag;
+
+    (bStruct -> piece.init == true) ? \
+            piece = zobrist_piece(bStruct -> piece.type,
+                                  (const int (*)[COORD_NUM])
+                                  bStruct -> piece.get.coordinates) : 0;
+
+    bag = zobrist_bag(bStruct -> bag, bStruct -> bagPosition,
+                      bStruct -> lastTetromino);
+
+    bStruct -> hash ^= bStruct -> pieceKey ^ piece ^ bStruct -> bagKey ^ bag;
+    bStruct -> pieceKey = piece;
+    bStruct -> bagKey = bag;
+}
+
 /**
  * @brief Updates the piece in the board
  * 
@@ -930,54 +1993,60 @@ updateBoard (int cellType)
  * If the piece already exists, updates its position (drops it once) and the 
  * board.
  * 
- * @param None
+ * @param self GAMEBOARD structure from which this function is called
  * 
  * @return Nothing
  */
 static void
-updatePiece (void)
+updatePiece (board_t * self)
 {
     int cellType;
+    board_private_t * bStruct = PRIVATE(self);
+
+    recordKeyframe(self);
+    record(bStruct, REPLAY_UPDATE, 0, NULL);
 
     // No piece is set
-    if ( bStruct.piece.type == TETROMINO_NONE )
+    if ( bStruct -> piece.type == TETROMINO_NONE )
     {
-        switch ( bStruct.bagPosition )
+        switch ( bStruct -> bagPosition )
         {
                 // Bag is almost empty
             case TETROMINOS - 2:
-                bStruct.piece.type = bStruct.bag[bStruct.bagPosition++];
-                fillBag();
+                bStruct -> piece.type = \
+                        bStruct -> bag[bStruct -> bagPosition++];
+                fillBag(bStruct);
                 break;
 
                 // Last piece in the bag
             case TETROMINOS - 1:
-                bStruct.piece.type = bStruct.lastTetromino;
+                bStruct -> piece.type = bStruct -> lastTetromino;
                 // Reset bagPosition
-                bStruct.bagPosition = 0;
+                bStruct -> bagPosition = 0;
                 break;
 
                 // More than 2 pieces left in the bag
             default:
-                bStruct.piece.type = bStruct.bag[bStruct.bagPosition++];
-                bStruct.lastTetromino = INVALID_PIECE;
+                bStruct -> piece.type = \
+                        bStruct -> bag[bStruct -> bagPosition++];
+                bStruct -> lastTetromino = INVALID_PIECE;
                 break;
         }
 
         // Update piece type in stats
-        updateStats(NPIECE);
+        updateStats(bStruct, NPIECE);
 
         // Initialize the piece
-        piece_init(&bStruct.piece, bStruct.public,
-                   CELL_ADDRESS(0, 0), MBOARD_H, MBOARD_W,
-                   bStruct.piece.type);
+        piece_init(&bStruct -> piece, &bStruct -> public,
+                   bStruct -> rows, MBOARD_H, MBOARD_W,
+                   bStruct -> piece.type);
     }
 
     // Get the cellType
-    cellType = bStruct.piece.update();
+    cellType = bStruct -> piece.update(&bStruct -> piece);
 
     // And update the board
-    updateBoard(cellType);
+    updateBoard(bStruct, cellType);
 }
 
 /**
@@ -986,30 +2055,76 @@ updatePiece (void)
  * Function used to update the stats when a soft drop is performed or a new
  * piece is generated.
  * 
+ * @param bStruct Private structure of the board
  * @param action
  * 
  * @return Nothing
  */
 static void
-updateStats (int action)
+updateStats (board_private_t * bStruct, int action)
 {
     switch ( action )
     {
         case SOFT:
-            bStruct.stats.softDrop();
+            bStruct -> stats.softDrop(&bStruct -> stats);
             break;
 
         case NPIECE:
             // When using the last position in the bag, read lastTetromino as 
             // the next piece. Otherwise, read the following piece in the bag
-            (bStruct.bagPosition == TETROMINOS - 1) ? \
-                                  bStruct.stats.newPiece(&bStruct.piece.type, \
-                                                    &bStruct.lastTetromino) : \
-                                  bStruct.stats.newPiece(&bStruct.piece.type, \
-                                            &bStruct.bag[bStruct.bagPosition]);
+            (bStruct -> bagPosition == TETROMINOS - 1) ? \
+                    bStruct -> stats.newPiece(&bStruct -> stats,
+                                              &bStruct -> piece.type,
+                                              &bStruct -> lastTetromino) : \
+                    bStruct -> stats.newPiece(&bStruct -> stats,
+                                              &bStruct -> piece.type,
+                                    &bStruct -> bag[bStruct -> bagPosition]);
             break;
 
         default:
             break;
     }
 }
+
+/**
+ * @brief Update the game status after the board or the moving piece changed
+ * 
+ * Called when a piece moves, is fixed, or rows are loaded or cleared, so
+ * ask.endGame() and ask.movingPiece() only have to read the status.
+ * 
+ * The game finishes when there are fixed blocks in the hidden rows and any
+ * block, fixed or moving, in the first visible row.
+ * 
+ * @param bStruct Private structure of the board
+ * 
+ * @return Nothing
+ */
+static void
+updateStatus (board_private_t * bStruct)
+{
+    int i;
+    row_t hidden = 0;
+    bool firstRow = (ROW(HIDDEN_ROWS) != 0);
+
+    bStruct -> status.moving = false;
+
+    if ( bStruct -> piece.init == true &&
+         bStruct -> stats.piece.current != TETROMINO_NONE )
+    {
+        for ( i = b1; i < BLOCKS; i++ )
+        {
+            (bStruct -> piece.get.coordinates[i][COORD_Y] >= HIDDEN_ROWS) ? \
+                    bStruct -> status.moving = true : 0;
+            (bStruct -> piece.get.coordinates[i][COORD_Y] == HIDDEN_ROWS) ? \
+                    firstRow = true : 0;
+        }
+    }
+
+    // Fixed blocks in the hidden rows
+    for ( i = 0; i < HIDDEN_ROWS; i++ )
+    {
+        hidden |= ROW(i);
+    }
+
+    bStruct -> status.topOut = (firstRow == true && hidden != 0);
+}
@@ -30,10 +30,17 @@
  * types of tetrominos available and their code when are fixed and the board 
  * size are also defined here.
  * 
- * At the beggining of a new game board_init() must be called with a pointer to
- * the structure board_t that will be used during the whole game. After 
- * ending the game (or displaying the top score), the board_t must be destroyed
- * to avoid unexpected behaviour.
+ * At the beggining of a new game board_create() must be called to get the
+ * board_t that will be used during the whole game. After ending the game (or
+ * displaying the top score), the board_t must be freed with board_free().
+ * 
+ * Every board has its own piece, stats, timer and bag of pieces, so many games
+ * can be played at the same time, each one from a single thread.
+ * 
+ * Pieces come from a random generator seeded by every board, so a game can be
+ * played again with set.seed() and the seed given by ask.seed(), as long as
+ * set.randomizer() chooses the same way of picking them. The whole game,
+ * moves included, can be recorded with set.replay().
  *
  * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
  * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
@@ -49,6 +56,8 @@
 // === Libraries and header files ===
 /// For bool, true and false
 #    include <stdbool.h>
+/// For uint16_t
+#    include <stdint.h>
 
 // === Constants and Macro definitions ===
 
@@ -66,19 +75,57 @@
 /// @brief Board Width
 #    define BOARD_WIDTH         10
 
+/**
+ * @def HIDDEN_ROWS
+ * @brief Rows hidden to the user over the visible board, where new pieces
+ * appear
+ */
+#    define HIDDEN_ROWS         3
+
 /**
  * @def ORIENTATION
  * @brief How many different orientations a piece can have
  */
 #    define ORIENTATION         4
 
+/**
+ * @def MAX_PLACEMENTS
+ * @brief Most places where a piece can be fixed in the board
+ * 
+ * Every distinct placement has one of the ORIENTATION shapes of the piece in
+ * one column and row of the board.
+ */
+#    define MAX_PLACEMENTS      (ORIENTATION * BOARD_WIDTH * \
+                                 (BOARD_HEIGHT + HIDDEN_ROWS))
+
+/**
+ * @def RANDOM_HISTORY
+ * @brief Last pieces remembered by the randomizers
+ */
+#    define RANDOM_HISTORY      4
+
 /**
  * @def GET_CELL(r,c)
  * @brief Returns the information in the row (r) and column (c) of the board 
  * (b)
+ * 
+ * Use it to read the board given by ask.board() instead of indexing it, so
+ * the code doesn't depend on how cells are stored.
  */
 #    define GET_CELL(r,c,b) ( (b)[ ((r) * BOARD_WIDTH) + (c) ] )
 
+/**
+ * @def ROW_FULL
+ * @brief Occupancy mask of a row with every column filled
+ */
+#    define ROW_FULL            ((row_t) ((1U << BOARD_WIDTH) - 1))
+
+/**
+ * @def ROW_BIT(c)
+ * @brief Occupancy bit of column (c) in a row mask
+ */
+#    define ROW_BIT(c)          ((row_t) (1U << (c)))
+
 // === Enumerations, structures and typedefs ===
 
 /**
@@ -119,6 +166,24 @@ enum piecesType
     TETROMINOS
 };
 
+/**
+ * @brief Randomizers choosing the pieces of the bag.
+ * 
+ * Whichever is used, there are never more than 4 S or Z pieces together nor
+ * more than 12 pieces between two I pieces.
+ */
+enum randomizers
+{
+    /// Every bag has the 7 tetrominos, shuffled
+    RANDOMIZER_BAG = 0,
+    /// Any piece, rolled again once if it's the same as the last one
+    RANDOMIZER_NES,
+    /// Any piece, rolled up to 4 times while it's one of the last 4
+    RANDOMIZER_HISTORY,
+    /// Number of randomizers
+    RANDOMIZERS
+};
+
 /**
  * @brief Parameters to shift a piece.
  * 
@@ -141,7 +206,12 @@ enum shiftingTypes
  */
 enum board_cell
 {
-    /// The cell has a block that is part of a moving piece
+    /**
+     * @brief The cell has a block that is part of a moving piece
+     * 
+     * @note The moving piece is not written in the board. Use ask.piece() to
+     * get its cells.
+     */
     CELL_MOVING = -1,
     /// The cell is clear
     CELL_CLEAR = 0,
@@ -189,18 +259,130 @@ enum coords
     CRAZY
 };*/
 
-/// Type of every grid in the board.
-typedef int grid_t;
+/// Type of every grid in the board. A single byte holding one of board_cell
+/// enum values, from CELL_CLEAR to CELL_Z.
+typedef uint8_t grid_t;
+
+/**
+ * @brief Occupancy of a board row.
+ * 
+ * Bit c is set when column c has a fixed block. Moving pieces are never part
+ * of this mask.
+ */
+typedef uint16_t row_t;
+
+/// See GAMEBOARD documentation
+typedef struct GAMEBOARD board_t;
+
+/// See REPLAY documentation in replay.h
+struct REPLAY;
+
+/**
+ * @brief Place where a piece can be fixed, as given by ask.placements()
+ */
+typedef struct PLACEMENT
+{
+    /// Column of the top-left corner of the piece's box
+    int x;
+
+    /// Row of the top-left corner of the piece's box where it lands
+    int y;
+
+    /// Orientation of the piece
+    int orientation;
+
+    /// Coordinates of every block of the piece, using coords enum
+    int cells[BLOCKS][COORD_NUM];
+} placement_t;
+
+/**
+ * @brief Full state of a game, taken with board_snapshot().
+ * 
+ * Holds the fixed blocks, the moving piece, the bag of pieces and the stats
+ * of a game in a single block of memory with no pointers, so it can be copied
+ * with an assignment or memcpy() and kept as many times as needed (i.e. for
+ * undoing a move or trying moves ahead) with no allocation.
+ * 
+ * The top scores and the timer are not part of the state, as they don't
+ * belong to a single game.
+ * 
+ * @note Treat it as opaque. It's only meant to be given back to
+ * board_restore().
+ */
+typedef struct BOARD_STATE
+{
+    /// Cells of the board, hidden rows included
+    grid_t cells[BOARD_HEIGHT + HIDDEN_ROWS][BOARD_WIDTH];
+
+    /// Occupancy mask of every row
+    row_t rows[BOARD_HEIGHT + HIDDEN_ROWS];
+
+    /// Height of every column
+    int heights[BOARD_WIDTH];
+
+    /// Rows pending to be checked for filled ones
+    uint32_t touched;
+
+    /// Game status
+
+    struct
+    {
+        bool moving;
+        bool topOut;
+    } status;
+
+    /// Moving piece. type is TETROMINO_NONE if there's none
+
+    struct
+    {
+        int type;
+        int move[COORD_NUM];
+        int orientation;
+    } piece;
+
+    /// Bag of pieces and random generator state
+
+    struct
+    {
+        int pieces[TETROMINOS];
+        int position;
+        int lastTetromino;
+        int piecesSinceI;
+        int szInARow;
+        int history[RANDOM_HISTORY];
+        int randomizer;
+        uint64_t seed;
+        uint64_t random[4];
+    } bag;
+
+    /// Stats of the game, top score excluded
+
+    struct
+    {
+        int level;
+        int cleared;
+        int current;
+        int next;
+        int number[TETROMINOS];
+        int actual;
+        int lastPiece;
+        int lastDifficult;
+        int soft;
+        int newTop;
+    } stats;
+
+} board_state_t;
 
 /**
  * @brief Current game's board object.
  * 
  * This structure gives access to different board actions to display it on the
- * front end of the program.
+ * front end of the program. Every function receives the board from which it
+ * is called as its first parameter.
  * 
- * @warning board_init() must be called before using this structure.
+ * @warning Must be created with board_create() and freed with board_free().
  */
-typedef struct GAMEBOARD
+struct GAMEBOARD
 {
     /**
      * @brief Set to true when the piece is initialized.
@@ -210,15 +392,21 @@ typedef struct GAMEBOARD
      */
     bool init;
 
-    /// Destroy current board. All structure information is deleted.
-    void (* destroy) (void);
-
     /// Get board information
 
     struct
     {
-        /// Get coordinate (0,0) of the board (top-left)
-        grid_t * (* board) (void);
+        /**
+         * @brief Get coordinate (0,0) of the board (top-left)
+         * 
+         * Only fixed blocks are kept in the board, so it's not modified
+         * between two pieces being fixed or rows being cleared. The moving
+         * piece must be drawn over it with ask.piece().
+         * 
+         * @note The board must be treated as read only. Use set.row() to load
+         * cells on it.
+         */
+        grid_t * (* board) (board_t * self);
 
         /** 
          * @brief Ask if game has to finish
@@ -226,7 +414,7 @@ typedef struct GAMEBOARD
          * @return True: 1
          * @return False: 0
          */
-        int (* endGame) (void);
+        int (* endGame) (board_t * self);
 
         /**
          * @brief How many rows are complete and which are those.
@@ -235,7 +423,34 @@ typedef struct GAMEBOARD
          * 
          * @return Number of filled rows
          */
-        int (* filledRows) (int lines[BOARD_HEIGHT]);
+        int (* filledRows) (board_t * self, int lines[BOARD_HEIGHT]);
+
+        /**
+         * @brief Zobrist hash of the game.
+         * 
+         * Made of the fixed blocks, the moving piece and the bag, and
+         * updated as they change. Two games in the same state have the same
+         * hash, even in different runs of the program. Stats and the timer
+         * aren't part of it.
+         * 
+         * @return 64 bits hash
+         */
+        uint64_t (* hash) (board_t * self);
+
+        /**
+         * @brief Height of every column of the board, from left to right.
+         * 
+         * A column's height is the number of rows from the bottom of the board
+         * up to its highest fixed block (0 when it's empty). The moving piece
+         * is not taken into account. When there are fixed blocks in the rows
+         * hidden to the user, the height can be greater than BOARD_HEIGHT.
+         * 
+         * @note The array is kept up to date by the board and must be treated
+         * as read only.
+         * 
+         * @return Array with BOARD_WIDTH heights
+         */
+        const int * (* heights) (board_t * self);
 
         /**
          * @brief Tells if there's a moving piece currently in the board
@@ -243,14 +458,115 @@ typedef struct GAMEBOARD
          * @return True: 1
          * @return False: 0
          */
-        int (* movingPiece) (void);
+        int (* movingPiece) (board_t * self);
+
+        /**
+         * @brief Cells of the moving piece.
+         * 
+         * @param cells Array where the coordinates of every block of the
+         * piece are written, using coords enum. They are given in the same
+         * rows and columns as ask.board(), so blocks in the rows hidden to the
+         * user have a negative COORD_Y.
+         * 
+         * @return Type of the moving piece (TETROMINO_I, ..., TETROMINO_Z)
+         * @return TETROMINO_NONE if there isn't one. @p cells isn't written
+         */
+        int (* piece) (board_t * self, int cells[BLOCKS][COORD_NUM]);
+
+        /**
+         * @brief Cells where the moving piece would land if hard dropped.
+         * 
+         * @param cells Array where the coordinates of every block of the
+         * landed piece are written, as in ask.piece().
+         * 
+         * @return Type of the moving piece (TETROMINO_I, ..., TETROMINO_Z)
+         * @return TETROMINO_NONE if there isn't one. @p cells isn't written
+         */
+        int (* ghost) (board_t * self, int cells[BLOCKS][COORD_NUM]);
+
+        /**
+         * @brief Every distinct place where a piece can be fixed.
+         * 
+         * Placements are searched shifting, rotating and dropping the piece
+         * with the same rules as piece.shift(), piece.rotate() and update().
+         * Placements with the same blocks (i.e. the four orientations of an
+         * O piece) are listed once.
+         * 
+         * @param type TETROMINO_I, ..., TETROMINO_Z to search from where new
+         * pieces appear, or TETROMINO_NONE to search from where the moving
+         * piece is
+         * @param list Array where the placements are written. Rows and
+         * columns are the same as ask.piece(), so they can be negative.
+         * 
+         * @return Number of placements written in @p list
+         */
+        int (* placements) (board_t * self, int type,
+                            placement_t list[MAX_PLACEMENTS]);
+
+        /**
+         * @brief Every distinct place where a new piece can be fixed in the
+         * given rows instead of the board's.
+         * 
+         * Same as ask.placements() for a new piece, so moves can be searched
+         * in boards that are not played. The board isn't changed, so it can
+         * be called from many threads at once.
+         * 
+         * @param rows Row masks as given by ask.rows()
+         * @param type TETROMINO_I, ..., TETROMINO_Z
+         * @param list Array where the placements are written
+         * 
+         * @return Number of placements written in @p list
+         */
+        int (* placementsIn) (board_t * self,
+                              const row_t rows[BOARD_HEIGHT + HIDDEN_ROWS],
+                              int type, placement_t list[MAX_PLACEMENTS]);
+
+        /**
+         * @brief Occupancy mask of every row of the board.
+         * 
+         * Unlike ask.board(), the rows hidden to the user are included, so
+         * there are BOARD_HEIGHT + HIDDEN_ROWS rows, being the first visible
+         * one at HIDDEN_ROWS. Only fixed blocks are set.
+         * 
+         * @note The array is kept up to date by the board and must be treated
+         * as read only.
+         * 
+         * @return Array with the row masks, from top to bottom
+         */
+        const row_t * (* rows) (board_t * self);
+
+        /**
+         * @brief Seed of the random generator of the game.
+         * 
+         * Giving it to set.seed() in a new board gets the same pieces.
+         * 
+         * @return Seed set with set.seed(), or the one chosen by
+         * board_create()
+         */
+        uint64_t (* seed) (board_t * self);
+
+        /**
+         * @brief Randomizer choosing the pieces of the game.
+         * 
+         * @return One of randomizers enum. RANDOMIZER_BAG unless it's
+         * changed with set.randomizer()
+         */
+        int (* randomizer) (board_t * self);
 
         /**
          * @brief Get the current game stats.
          * 
          * @note This pointer must be casted to stats_t or STATS structure.
          */
-        const void * (* stats) (void);
+        const void * (* stats) (board_t * self);
+
+        /**
+         * @brief Get the timer of the current game, already initialized with
+         * its stats.
+         * 
+         * @note This pointer must be casted to tmr_t or TIMER structure.
+         */
+        void * (* timer) (board_t * self);
     } ask;
 
     /// Clear a specific part of the board
@@ -268,7 +584,22 @@ typedef struct GAMEBOARD
          * 
          * @return Nothing
          */
-        void (* line) (int lines[BOARD_HEIGHT], int position);
+        void (* line) (board_t * self, int lines[BOARD_HEIGHT], int position);
+
+        /**
+         * @brief Clear many filled rows at once.
+         * 
+         * Clears the given rows and drops the board "as it is" in a single
+         * pass. @p lines is not modified, so the cleared rows can still be
+         * animated after calling it. This function it's intended to be called
+         * with the rows returned by ask.filledRows().
+         * 
+         * @param lines Array with the filled rows to clear.
+         * @param n Number of rows in @p lines array.
+         * 
+         * @return Nothing
+         */
+        void (* lines) (board_t * self, const int lines[BOARD_HEIGHT], int n);
     } clear;
 
     /// Manage the current piece
@@ -285,7 +616,7 @@ typedef struct GAMEBOARD
          * 
          * @return Nothing
          */
-        void (* rotate) (int direction);
+        void (* rotate) (board_t * self, int direction);
 
         /**
          * @brief Shift the piece in the given direction
@@ -297,18 +628,41 @@ typedef struct GAMEBOARD
          * 
          * @return Nothing
          */
-        void (* shift) (int direction);
+        void (* shift) (board_t * self, int direction);
 
         /**
          * @brief Perform a soft drop of the piece
          * 
          * Automatically performs a board update.
          * 
-         * @param None
+         * @return Nothing
+         */
+        void (* softDrop) (board_t * self);
+
+        /**
+         * @brief Perform a hard drop of the piece
+         * 
+         * The piece is dropped to the lowest position it can reach and fixed
+         * there. Every row dropped scores as a soft drop.
          * 
          * @return Nothing
          */
-        void (* softDrop) (void);
+        void (* hardDrop) (board_t * self);
+
+        /**
+         * @brief Fix the piece in one of the places given by 
+         * ask.placements()
+         * 
+         * The piece is moved there at once and fixed, as if it was hard
+         * dropped there.
+         * 
+         * @param where Placement of the moving piece
+         * 
+         * @return Success: EXIT_SUCCESS
+         * @return Fail: EXIT_FAILURE if there is no moving piece or it
+         * doesn't fit there. Nothing is changed
+         */
+        int (* place) (board_t * self, const placement_t * where);
     } piece;
 
     /// Optional game modifications that can be set before the first update
@@ -331,7 +685,7 @@ typedef struct GAMEBOARD
          * 
          * @return Nothing
          */
-        void (* startLevel) (unsigned char n);
+        void (* startLevel) (board_t * self, unsigned char n);
 
         /**
          * @brief Amount of rows to start in the board
@@ -340,7 +694,72 @@ typedef struct GAMEBOARD
          * 
          * @return Nothing
          */
-        void (* startRows) (unsigned char n);
+        void (* startRows) (board_t * self, unsigned char n);
+
+        /**
+         * @brief Load a visible row of the board with the given cells
+         * 
+         * Any value out of the CELL_CLEAR to CELL_Z range is loaded as 
+         * CELL_CLEAR.
+         * 
+         * @param row Visible row number, being 0 the top one
+         * @param cells Array with the cells of the row, from left to right
+         * 
+         * @return Nothing
+         */
+        void (* row) (board_t * self, int row,
+                      const grid_t cells[BOARD_WIDTH]);
+
+        /**
+         * @brief Seed the random generator of the game
+         * 
+         * Games with the same seed get the same pieces and the same rows
+         * from set.startRows(), so it must be called before it. Every board
+         * is created with a different seed.
+         * 
+         * @note Ignored when compiled with TRUERANDOM.
+         * 
+         * @param seed Any number
+         * 
+         * @return Nothing
+         */
+        void (* seed) (board_t * self, uint64_t seed);
+
+        /**
+         * @brief Choose the randomizer of the game
+         * 
+         * As the seed, it can only be changed before the first update, and
+         * the same seed and randomizer get the same pieces.
+         * 
+         * @param randomizer One of randomizers enum
+         * 
+         * @return Nothing
+         */
+        void (* randomizer) (board_t * self, int randomizer);
+
+        /**
+         * @brief Record the game in a replay
+         * 
+         * Must be called before anything else is done with the board. Every
+         * call that changes the game is recorded from then on, but
+         * board_restore().
+         * 
+         * @param replay Replay given by replay_record(), which must be
+         * closed after the board is freed. NULL to stop recording
+         * 
+         * @return Nothing
+         */
+        void (* replay) (board_t * self, struct REPLAY * replay);
+
+        /**
+         * @brief Read the top scores file, creating it if it doesn't exist
+         * 
+         * The board does no I/O until it's called, so frontends showing top
+         * scores must call it once after board_create().
+         * 
+         * @return Nothing
+         */
+        void (* topScores) (board_t * self);
     } set;
 
     /**
@@ -349,13 +768,11 @@ typedef struct GAMEBOARD
      * Updates the piece position in the board, dropping it once or fixing it
      * if necessary.
      * 
-     * @param None
-     * 
      * @return Nothing
      */
-    void (* update) (void);
+    void (* update) (board_t * self);
 
-} board_t;
+};
 
 // === Global variables ===
 
@@ -363,8 +780,20 @@ typedef struct GAMEBOARD
 
 // === Global function definitions ===
 
-// Initialize a GAMEBOARD structure
+// Create a new GAMEBOARD structure
+board_t *
+board_create (void);
+
+// Free a GAMEBOARD structure created with board_create()
 void
-board_init (void * gameBoardStruct);
+board_free (board_t * self);
+
+// Copy the full state of a game
+int
+board_snapshot (board_t * self, board_state_t * state);
+
+// Set a game to a state taken with board_snapshot()
+int
+board_restore (board_t * self, const board_state_t * state);
 
 #endif /* BOARD_H */
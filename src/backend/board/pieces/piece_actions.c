@@ -39,6 +39,7 @@
 // === Libraries and header files ===
 #include <stdio.h>
 #include <stdlib.h>
+#include <pthread.h>    // For pthread_once
 
 // This file
 #include "piece_actions.h"
@@ -47,11 +48,44 @@
 // === Constants and Macro definitions ===
 
 /**
- * @def CELL(r,c)
- * @brief Returns the information in the row (r) and column (c) of the board
+ * @def SEARCH_ROWS
+ * @brief Tallest board in which placements() can look for placements
  */
-#define CELL(c,r) ( * (currentPiece.board.r0c0 + \
-                    (((r) * currentPiece.board.width) + (c)) ) )
+#define SEARCH_ROWS     (BOARD_HEIGHT + HIDDEN_ROWS)
+
+/**
+ * @def SEARCH_COLS
+ * @brief Columns the piece's box can be in, as it can go up to PIECE_BOX - 1
+ * columns out of the left side of the board
+ */
+#define SEARCH_COLS     (BOARD_WIDTH + PIECE_BOX - 1)
+
+/**
+ * @def STATE(x,y,o)
+ * @brief Packs a position of the piece's box in a single int
+ */
+#define STATE(x,y,o)    ((((o) * SEARCH_ROWS) + (y)) * SEARCH_COLS + \
+                         (x) + PIECE_BOX - 1)
+
+/**
+ * @def SHAPE_COLS
+ * @brief Columns the piece's box can be in, in the widest board allowed
+ */
+#define SHAPE_COLS      ((int) sizeof (row_t) * 8 + PIECE_BOX - 1)
+
+/**
+ * @def SHAPE(p,o)
+ * @brief Collision shape of the piece with private variables (p) in the
+ * orientation (o)
+ */
+#define SHAPE(p,o)      (&shapes[(p) -> type][(o)])
+
+/**
+ * @def SHAPE_ROWS(s,x)
+ * @brief Occupancy mask of every row of the shape (s) with its box in the
+ * column (x)
+ */
+#define SHAPE_ROWS(s,x) ((s) -> rows[(x) + PIECE_BOX - 1])
 
 // === Enumerations, structures and typedefs ===
 
@@ -65,43 +99,27 @@ enum plusminus
 };
 
 /**
- * @brief Private variables of a piece object.
- * 
- * This structure let's the piece's related functions modify it. Contains the
- * needed parameters to shift, drop and rotate it, as well as the board
- * where the given piece exists.
+ * @brief Collision shape of a piece in an orientation
  * 
- * @note Public PIECE structure is located in piece_actions.h
+ * Built from pieceArr once for every piece, so checking if a piece fits
+ * somewhere in the board only takes a mask AND per row.
  */
-typedef struct PRIVATE_PIECE
+typedef struct PIECE_SHAPE
 {
-    /// Public structure of this piece
-    piece_t * public;
+    /// Occupancy mask of every row of the piece's box, with the box in every
+    /// column it can be. Use SHAPE_ROWS
+    row_t rows[SHAPE_COLS][PIECE_BOX];
 
-    /// Piece's board information
-
-    struct
-    {
-        /// Board structure where this piece exists
-        board_t * pBoard;
-        /// Top left corner of the board. In a 2D array, it will be board[0][0]
-        const int * r0c0;
-        /// Board height
-        int height;
-        /// Board width
-        int width;
-    } board;
+    /// First and last columns with a block of the piece's box
+    int left, right;
 
-    /// Type of piece. Set using definitions in board.h file.
-    int type;
+    /// First and last rows with a block of the piece's box
+    int top, bottom;
 
-    /// Board coordinates of the piece. Use coords enum in board.h
-    int move[COORD_NUM];
+    /// First orientation with the same blocks
+    int same;
+} shape_t;
 
-    /// Rotation status (true or false) and which is the piece's position
-    int orientation;
-
-} piece_private_t;
 
 // === Global variables ===
 
@@ -109,43 +127,79 @@ typedef struct PRIVATE_PIECE
 
 // Destroy the current piece.
 static void
-destroy (void);
+destroy (piece_t * self);
+
+// Drop the piece to the lowest position it can reach
+static int
+hardDrop (piece_t * self);
 
 // Initialize piece's type and coordinates in the PIECE structure
 static int
-init (const int piece);
+init (piece_t * self, const int piece);
+
+// Build the collision shape of every orientation of every piece
+static void
+initShapes (void);
+
+// How many rows the piece can fall before being blocked
+static int
+landing (piece_t * self);
+
+// Place the piece where a board state says
+static void
+load (piece_t * self, const board_state_t * state);
 
 // Increment or decrement by 1 the piece's coordinates on the given axis
 static void
-moveOneCell (int coord, int pm);
+moveOneCell (piece_t * self, int coord, int pm);
 
 // Updates the piece in the board (called from public PIECE)
 static int
-normalDrop (void);
+normalDrop (piece_t * self);
+
+// Move the piece to the given position, if it fits there
+static int
+place (piece_t * self, int x, int y, int orientation);
+
+// Every distinct place where the piece can be fixed from where it is
+static int
+placements (piece_t * self, placement_t list[MAX_PLACEMENTS]);
 
 // Rotate the piece in the desired direction
 static void
-rotate (int direction);
+rotate (piece_t * self, int direction);
+
+// Tells if two shapes have the same blocks
+static bool
+sameShape (const shape_t * a, const shape_t * b);
+
+// Copy the piece's position to a board state
+static void
+save (piece_t * self, board_state_t * state);
 
 // Shift the piece in the desired direction
 static void
-shift (int direction);
+shift (piece_t * self, int direction);
 
 // Perform a soft drop
 static void
-softDrop (void);
+softDrop (piece_t * self);
 
 // Update piece orientation
 static void
-updateOrientation (int pm);
+updateOrientation (piece_t * self, int pm);
 
 // Update coordinates in PIECE structure
 static void
-updatePublicCoordinates (void);
+updatePublicCoordinates (piece_t * self);
 
 // Given a piece a new position, check if it can be keeped there or not.
 static int
-verifyFixedPieces (void);
+verifyFixedPieces (piece_t * self);
+
+// Check if the piece can be kept in the given position.
+static int
+verifyPosition (piece_t * self, int x, int y, int o);
 
 // === ROM Constant variables with file level scope ===
 /// Array with each piece coordinates and orientations.
@@ -589,8 +643,12 @@ const int pieceArr[TETROMINOS][ORIENTATION][BLOCKS][COORD_NUM] = {
 };
 
 // === Static variables and constant variables with file level scope ===
-/// Piece to be working with
-static piece_private_t currentPiece;
+
+/// Collision shape of every piece in every orientation. Built by initShapes()
+static shape_t shapes[TETROMINOS][ORIENTATION];
+
+/// Builds shapes once
+static pthread_once_t shapesOnce = PTHREAD_ONCE_INIT;
 
 // === Global function definitions ===
 /// @publicsection
@@ -603,10 +661,10 @@ static piece_private_t currentPiece;
  * 
  * @param pstruct PIECE structure to initialize.
  * @param boardStr GAMEBOARD structure of the board with the piece
- * @param board Top left corner of the board with the piece (in a 2D array it
- * will be equivalent to board[0][0])
+ * @param rows Occupancy mask of every row of the board with the piece, being 
+ * rows[0] the top one
  * @param boardHeight Board Height
- * @param boardWidth Board Width
+ * @param boardWidth Board Width. Can't be bigger than the bits in row_t
  * @param piece Piece to initialize
  * 
  * @return Success: EXIT_SUCCESS
@@ -614,7 +672,7 @@ static piece_private_t currentPiece;
  */
 int
 piece_init (struct PIECE * pstruct, struct GAMEBOARD * boardStr,
-            grid_t * board, int boardHeight, int boardWidth,
+            const row_t * rows, int boardHeight, int boardWidth,
             const int piece)
 {
     int exitStatus = EXIT_FAILURE;
@@ -630,13 +688,15 @@ piece_init (struct PIECE * pstruct, struct GAMEBOARD * boardStr,
         fputs("GAMEBOARD struct returned NULL", stderr);
     }
 
-    else if ( board == NULL )
+    else if ( rows == NULL )
     {
         fputs("BOARD returned NULL", stderr);
     }
 
-        // Check that board dimensions aren't 0 or negative
-    else if ( boardHeight < 1 || boardWidth < 1 )
+        // Check that board dimensions aren't 0 or negative and that every
+        // column fits in a row mask
+    else if ( boardHeight < 1 || boardWidth < 1 ||
+              boardWidth > (int) (sizeof (row_t) * 8) )
     {
         fputs("Invalid boardHeigth or boardWidth", stderr);
     }
@@ -644,42 +704,50 @@ piece_init (struct PIECE * pstruct, struct GAMEBOARD * boardStr,
         // If no NULL pointer is given, initialize the piece
     else
     {
-        // Save the pointer to PIECE in a variable to avoid asking it again
-        currentPiece.public = pstruct;
-
         // Just in case, set piece as not initialized while performing the 
         // configurations
-        currentPiece.public -> init = false;
+        pstruct -> init = false;
+
+        // Shapes of every piece, shared by every board
+        pthread_once(&shapesOnce, &initShapes);
 
         // Save the pointer to GAMEBOARD in a variable to avoid asking it again
-        currentPiece.board.pBoard = boardStr;
+        pstruct -> _private.board.pBoard = boardStr;
 
-        // Save the top left position of the board and its size
-        currentPiece.board.r0c0 = board;
-        currentPiece.board.height = boardHeight;
-        currentPiece.board.width = boardWidth;
+        // Save the rows of the board and its size
+        pstruct -> _private.board.rows = rows;
+        pstruct -> _private.board.height = boardHeight;
+        pstruct -> _private.board.width = boardWidth;
 
         // Set function pointers
         // Rotate piece
-        currentPiece.public -> rotate = &rotate;
+        pstruct -> rotate = &rotate;
         // Shift piece
-        currentPiece.public -> shift = &shift;
+        pstruct -> shift = &shift;
         // Soft drop
-        currentPiece.public -> softDrop = &softDrop;
+        pstruct -> softDrop = &softDrop;
+        // Hard drop
+        pstruct -> hardDrop = &hardDrop;
+        pstruct -> landing = &landing;
+        pstruct -> placements = &placements;
+        pstruct -> place = &place;
+        // Snapshots
+        pstruct -> save = &save;
+        pstruct -> load = &load;
         // Normal drop
-        currentPiece.public -> update = &normalDrop;
+        pstruct -> update = &normalDrop;
 
         // Destroy Piece
-        currentPiece.public -> destroy = &destroy;
+        pstruct -> destroy = &destroy;
 
         // Initialize the piece in the given position of the bag
-        if ( !init(piece) )
+        if ( !init(pstruct, piece) )
         {
             exitStatus = EXIT_SUCCESS;
-            updatePublicCoordinates();
+            updatePublicCoordinates(pstruct);
 
             // Set piece as initialized
-            currentPiece.public -> init = true;
+            pstruct -> init = true;
         }
     }
 
@@ -694,55 +762,86 @@ piece_init (struct PIECE * pstruct, struct GAMEBOARD * boardStr,
  * 
  * All structure information is ereased.
  * 
- * @param None
+ * @param self PIECE structure from which this function is called
  * 
  * @return Nothing
  */
 static void
-destroy (void)
+destroy (piece_t * self)
 {
     int i, j;
+    piece_private_t * currentPiece;
 
     // Check if it's accidentaly called
-    if ( currentPiece.public == NULL )
+    if ( self == NULL )
     {
         fputs("Bad destroy call. Noting to destroy, exiting...", stderr);
         return;
     }
 
+    currentPiece = &self -> _private;
+
     // Clear public variables and set pointers to NULL
-    currentPiece.public -> type = TETROMINO_NONE;
-    currentPiece.public -> rotate = NULL;
-    currentPiece.public -> shift = NULL;
-    currentPiece.public -> softDrop = NULL;
-    currentPiece.public -> update = NULL;
+    self -> type = TETROMINO_NONE;
+    self -> rotate = NULL;
+    self -> shift = NULL;
+    self -> softDrop = NULL;
+    self -> hardDrop = NULL;
+    self -> landing = NULL;
+    self -> placements = NULL;
+    self -> place = NULL;
+    self -> save = NULL;
+    self -> load = NULL;
+    self -> update = NULL;
 
     // Clear public piece's coordinates
     for ( i = b1; i < BLOCKS; i++ )
     {
         for ( j = COORD_X; j < COORD_NUM; j++ )
         {
-            currentPiece.public -> get.coordinates[i][j] = 0;
+            self -> get.coordinates[i][j] = 0;
         }
     }
 
     // Clear board information
-    currentPiece.board.r0c0 = NULL;
-    currentPiece.board.height = 0;
-    currentPiece.board.width = 0;
-    currentPiece.board.pBoard = NULL;
+    currentPiece -> board.rows = NULL;
+    currentPiece -> board.height = 0;
+    currentPiece -> board.width = 0;
+    currentPiece -> board.pBoard = NULL;
 
     // Clear type and position information
-    currentPiece.type = TETROMINO_NONE;
-    currentPiece.move[COORD_X] = 0;
-    currentPiece.move[COORD_Y] = 0;
-    currentPiece.orientation = 0;
+    currentPiece -> type = TETROMINO_NONE;
+    currentPiece -> move[COORD_X] = 0;
+    currentPiece -> move[COORD_Y] = 0;
+    currentPiece -> orientation = 0;
 
     // Piece is not initialized
-    currentPiece.public -> init = false;
+    self -> init = false;
+
+    self -> destroy = NULL;
+}
+
+/**
+ * @brief Drop the piece to the lowest position it can reach
+ * 
+ * The piece is moved at once, without fixing it.
+ * 
+ * @param self PIECE structure from which this function is called
+ * 
+ * @return Number of rows the piece was dropped
+ */
+static int
+hardDrop (piece_t * self)
+{
+    piece_private_t * currentPiece = &self -> _private;
+    int rows = landing(self);
+
+    currentPiece -> move[COORD_Y] += rows;
+
+    // Update public coordinates
+    updatePublicCoordinates(self);
 
-    currentPiece.public -> destroy = NULL;
-    currentPiece.public = NULL;
+    return rows;
 }
 
 /**
@@ -753,18 +852,20 @@ destroy (void)
  * function to update the board is called right after this function as they
  * appear a row or two over the first visible row.
  * 
+ * @param self PIECE structure from which this function is called
  * @param piece Piece to initialize. Use tetrominos enum in board.h
  * 
  * @return Success: EXIT_SUCCESS
  * @return Fail: EXIT_FAILURE
  */
 static int
-init (const int piece)
+init (piece_t * self, const int piece)
 {
+    piece_private_t * currentPiece = &self -> _private;
     int exitStatus = EXIT_SUCCESS;
 
     // No rotation
-    currentPiece.orientation = 0;
+    currentPiece -> orientation = 0;
 
     // Coordinates
     switch ( piece )
@@ -781,14 +882,14 @@ init (const int piece)
              *  3  |    |    |    |    |
              *     ---------------------
              */
-            currentPiece.public -> type = TETROMINO_I;
-            currentPiece.type = TETROMINO_I;
+            self -> type = TETROMINO_I;
+            currentPiece -> type = TETROMINO_I;
 
             // X coordinates
-            currentPiece.move[COORD_X] = currentPiece.board.width / 2 - 2;
+            currentPiece -> move[COORD_X] = currentPiece -> board.width / 2 - 2;
 
             // Y coordinates
-            currentPiece.move[COORD_Y] = 0;
+            currentPiece -> move[COORD_Y] = 0;
 
             break;
 
@@ -804,14 +905,14 @@ init (const int piece)
              *  3  |    |    |    |    |
              *     ---------------------
              */
-            currentPiece.public -> type = TETROMINO_J;
-            currentPiece.type = TETROMINO_J;
+            self -> type = TETROMINO_J;
+            currentPiece -> type = TETROMINO_J;
 
             // X coordinates
-            currentPiece.move[COORD_X] = currentPiece.board.width / 2 - 2;
+            currentPiece -> move[COORD_X] = currentPiece -> board.width / 2 - 2;
 
             // Y coordinates
-            currentPiece.move[COORD_Y] = 0;
+            currentPiece -> move[COORD_Y] = 0;
 
             break;
 
@@ -827,14 +928,14 @@ init (const int piece)
              *  3  |    |    |    |    |
              *     ---------------------
              */
-            currentPiece.public -> type = TETROMINO_L;
-            currentPiece.type = TETROMINO_L;
+            self -> type = TETROMINO_L;
+            currentPiece -> type = TETROMINO_L;
 
             // X coordinates
-            currentPiece.move[COORD_X] = currentPiece.board.width / 2 - 2;
+            currentPiece -> move[COORD_X] = currentPiece -> board.width / 2 - 2;
 
             // Y coordinates
-            currentPiece.move[COORD_Y] = 0;
+            currentPiece -> move[COORD_Y] = 0;
             break;
 
 
@@ -850,14 +951,14 @@ init (const int piece)
              *  3  |    |    |    |    |
              *     ---------------------
              */
-            currentPiece.public -> type = TETROMINO_O;
-            currentPiece.type = TETROMINO_O;
+            self -> type = TETROMINO_O;
+            currentPiece -> type = TETROMINO_O;
 
             // X coordinates
-            currentPiece.move[COORD_X] = currentPiece.board.width / 2 - 1;
+            currentPiece -> move[COORD_X] = currentPiece -> board.width / 2 - 1;
 
             // Y coordinates
-            currentPiece.move[COORD_Y] = 1;
+            currentPiece -> move[COORD_Y] = 1;
             break;
 
         case TETROMINO_S:
@@ -872,14 +973,14 @@ init (const int piece)
              *  3  |    |    |    |    |
              *     ---------------------
              */
-            currentPiece.public -> type = TETROMINO_S;
-            currentPiece.type = TETROMINO_S;
+            self -> type = TETROMINO_S;
+            currentPiece -> type = TETROMINO_S;
 
             // X coordinates
-            currentPiece.move[COORD_X] = currentPiece.board.width / 2 - 2;
+            currentPiece -> move[COORD_X] = currentPiece -> board.width / 2 - 2;
 
             // Y coordinates
-            currentPiece.move[COORD_Y] = 1;
+            currentPiece -> move[COORD_Y] = 1;
             break;
 
         case TETROMINO_T:
@@ -894,14 +995,14 @@ init (const int piece)
              *  3  |    |    |    |    |
              *     ---------------------
              */
-            currentPiece.public -> type = TETROMINO_T;
-            currentPiece.type = TETROMINO_T;
+            self -> type = TETROMINO_T;
+            currentPiece -> type = TETROMINO_T;
 
             // X coordinates
-            currentPiece.move[COORD_X] = currentPiece.board.width / 2 - 2;
+            currentPiece -> move[COORD_X] = currentPiece -> board.width / 2 - 2;
 
             // Y coordinates
-            currentPiece.move[COORD_Y] = 1;
+            currentPiece -> move[COORD_Y] = 1;
             break;
 
         case TETROMINO_Z:
@@ -916,14 +1017,14 @@ init (const int piece)
              *  3  |    |    |    |    |
              *     ---------------------
              */
-            currentPiece.public -> type = TETROMINO_Z;
-            currentPiece.type = TETROMINO_Z;
+            self -> type = TETROMINO_Z;
+            currentPiece -> type = TETROMINO_Z;
 
             // X coordinates
-            currentPiece.move[COORD_X] = currentPiece.board.width / 2 - 1;
+            currentPiece -> move[COORD_X] = currentPiece -> board.width / 2 - 1;
 
             // Y coordinates
-            currentPiece.move[COORD_Y] = 1;
+            currentPiece -> move[COORD_Y] = 1;
             break;
 
             // Bad piece
@@ -935,62 +1036,189 @@ init (const int piece)
     return exitStatus;
 }
 
+/**
+ * @brief Build the collision shape of every orientation of every piece
+ * 
+ * Reads the blocks from pieceArr once, so no block coordinate has to be
+ * computed again when a piece is moved. Called through shapesOnce.
+ * 
+ * @return Nothing
+ */
+static void
+initShapes (void)
+{
+    int type, o, i, x, bx, by;
+    shape_t * shape;
+
+    for ( type = 0; type < TETROMINOS; type++ )
+    {
+        for ( o = 0; o < ORIENTATION; o++ )
+        {
+            shape = &shapes[type][o];
+
+            shape -> left = PIECE_BOX - 1;
+            shape -> right = 0;
+            shape -> top = PIECE_BOX - 1;
+            shape -> bottom = 0;
+
+            for ( i = b1; i < BLOCKS; i++ )
+            {
+                bx = pieceArr[type][o][i][COORD_X];
+                by = pieceArr[type][o][i][COORD_Y];
+
+                // The block with the box in every column
+                for ( x = 1 - PIECE_BOX; x < SHAPE_COLS - (PIECE_BOX - 1);
+                      x++ )
+                {
+                    SHAPE_ROWS(shape, x)[by] |= (x >= 0) ? \
+                            (row_t) (ROW_BIT(bx) << x) : \
+                            (row_t) (ROW_BIT(bx) >> -x);
+                }
+
+                // Bounding box of the blocks
+                (bx < shape -> left) ? shape -> left = bx : 0;
+                (bx > shape -> right) ? shape -> right = bx : 0;
+                (by < shape -> top) ? shape -> top = by : 0;
+                (by > shape -> bottom) ? shape -> bottom = by : 0;
+            }
+
+            // Orientations with the same blocks (i.e. every one of the O
+            // piece) are equal to the first of them
+            shape -> same = o;
+
+            for ( i = 0; i < o && shape -> same == o; i++ )
+            {
+                sameShape(&shapes[type][i], shape) ? shape -> same = i : 0;
+            }
+        }
+    }
+}
+
+/**
+ * @brief How many rows the piece can fall before being blocked
+ * 
+ * The rows of the board under the piece are scanned until one of them collides with the
+ * shape or the bottom of the board is reached.
+ * 
+ * @param self PIECE structure from which this function is called
+ * 
+ * @return Number of rows
+ */
+static int
+landing (piece_t * self)
+{
+    int r, rows;
+    bool blocked = false;
+    piece_private_t * currentPiece = &self -> _private;
+    const shape_t * shape = SHAPE(currentPiece, currentPiece -> orientation);
+    const int y = currentPiece -> move[COORD_Y];
+    const int top = shape -> top;
+    const int bottom = shape -> bottom;
+
+    // Shape of the piece in its column
+    const row_t * mask = SHAPE_ROWS(shape, currentPiece -> move[COORD_X]);
+
+    // Go down while the next position is inside the board and it's clear
+    rows = 0;
+    while ( blocked == false &&
+            y + bottom + rows + 1 < currentPiece -> board.height )
+    {
+        for ( r = top; blocked == false && r <= bottom; r++ )
+        {
+            (currentPiece -> board.rows[y + r + rows + 1] & mask[r]) ? \
+                    blocked = true : 0;
+        }
+
+        (blocked == false) ? rows++ : 0;
+    }
+
+    return rows;
+}
+
+/**
+ * @brief Place the piece where a board state says
+ * 
+ * The piece must have been initialized with the type in the state. No
+ * collision check is done, as the state was taken from a valid game.
+ * 
+ * @param self PIECE structure from which this function is called
+ * @param state State taken with save()
+ * 
+ * @return Nothing
+ */
+static void
+load (piece_t * self, const board_state_t * state)
+{
+    piece_private_t * currentPiece = &self -> _private;
+
+    currentPiece -> move[COORD_X] = state -> piece.move[COORD_X];
+    currentPiece -> move[COORD_Y] = state -> piece.move[COORD_Y];
+    currentPiece -> orientation = state -> piece.orientation;
+
+    // Update public coordinates
+    updatePublicCoordinates(self);
+}
+
 /**
  * @brief Increment or decrement by 1 the piece's coordinates on the given axis
  *  
+ * @param self PIECE structure from which this function is called
  * @param coord COORD_X for X axis or COORD_Y for Y axis
  * @param pm PLUS to increment or MINUS to decrement
  * 
  * @return Nothing
  */
 static void
-moveOneCell (int coord, int pm)
+moveOneCell (piece_t * self, int coord, int pm)
 {
+    piece_private_t * currentPiece = &self -> _private;
+
     // +1 in coord axis
     if ( pm == PLUS )
     {
-        (currentPiece.move[coord])++;
+        (currentPiece -> move[coord])++;
     }
 
         // -1 in coord axis
     else if ( pm == MINUS )
     {
-        (currentPiece.move[coord])--;
+        (currentPiece -> move[coord])--;
     }
 }
 
 /**
  * @brief Updates the piece in the board (called from public PIECE)
  * 
- * @param None
+ * @param self PIECE structure from which this function is called
  * 
  * @return Nothing
  */
 static int
-normalDrop (void)
+normalDrop (piece_t * self)
 {
+    piece_private_t * currentPiece = &self -> _private;
     int cellType = CELL_MOVING;
 
     // Drop the piece one position
-    moveOneCell(COORD_Y, PLUS);
+    moveOneCell(self, COORD_Y, PLUS);
 
     // Check if no other already fixed piece is on this one's path
-    if ( verifyFixedPieces() > 0 )
+    if ( verifyFixedPieces(self) > 0 )
     {
-        currentPiece.public -> init = false;
+        self -> init = false;
 
         // Another piece is blocking this one
         // Restore the previous position
-        moveOneCell(COORD_Y, MINUS);
+        moveOneCell(self, COORD_Y, MINUS);
 
         // Update public coordinates to avoid an error when updating the board
-        updatePublicCoordinates();
+        updatePublicCoordinates(self);
 
         // Clear the piece as moving from the board
-        //currentPiece.board.pBoard -> piece.clear.moving();
+        //currentPiece -> board.pBoard -> piece.clear.moving();
 
         // And fix it according to its type
-        switch ( currentPiece.type )
+        switch ( currentPiece -> type )
         {
             case TETROMINO_I:
                 cellType = CELL_I;
@@ -1030,47 +1258,196 @@ normalDrop (void)
     else
     {
         // No other piece is blocking this one, so update the public coords
-        updatePublicCoordinates();
+        updatePublicCoordinates(self);
     }
 
     return cellType;
 }
 
+/**
+ * @brief Move the piece to the given position, if it fits there
+ * 
+ * The piece is moved at once, so the path to the position isn't checked.
+ * 
+ * @param self PIECE structure from which this function is called
+ * @param x Column of the piece's box
+ * @param y Row of the piece's box
+ * @param orientation Orientation of the piece
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+static int
+place (piece_t * self, int x, int y, int orientation)
+{
+    piece_private_t * currentPiece = &self -> _private;
+
+    if ( orientation < 0 || orientation >= ORIENTATION ||
+         verifyPosition(self, x, y, orientation) )
+    {
+        return EXIT_FAILURE;
+    }
+
+    currentPiece -> move[COORD_X] = x;
+    currentPiece -> move[COORD_Y] = y;
+    currentPiece -> orientation = orientation;
+
+    // Update public coordinates
+    updatePublicCoordinates(self);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Every distinct place where the piece can be fixed from where it is
+ * 
+ * Searches breadth first every position the piece can reach from the current
+ * one, shifting, rotating and dropping it with the same rules as shift(),
+ * rotate() and update(). Every position is visited once. The ones where the
+ * piece can't be dropped any more are where it would be fixed.
+ * 
+ * Two placements with the same blocks (i.e. two orientations of an O piece in
+ * the same place) are only listed once, the first one being found.
+ * 
+ * @param self PIECE structure from which this function is called
+ * @param list Array where the placements are written, in board coordinates
+ * 
+ * @return Number of placements written in @p list
+ */
+static int
+placements (piece_t * self, placement_t list[MAX_PLACEMENTS])
+{
+    int i, n, x, y, o, nx, no, head, tail;
+    piece_private_t * currentPiece = &self -> _private;
+
+    // Shifts and rotations, in X and orientation
+    const int moves[4][2] = {{-1, 0}, {1, 0}, {0, ORIENTATION - 1}, {0, 1}};
+
+    // Positions waiting to be visited
+    int queue[ORIENTATION * SEARCH_ROWS * SEARCH_COLS];
+
+    // Bit x + PIECE_BOX - 1 is set when the position (x, y, o) was reached
+    uint32_t seen[ORIENTATION][SEARCH_ROWS] = {{0}};
+
+    // Bit x is set when a placement with its left-most block in the column x
+    // and its top block in the row y was listed
+    uint32_t found[ORIENTATION][SEARCH_ROWS] = {{0}};
+
+    x = currentPiece -> move[COORD_X];
+    y = currentPiece -> move[COORD_Y];
+    o = currentPiece -> orientation;
+
+    if ( currentPiece -> board.height > SEARCH_ROWS ||
+         currentPiece -> board.width > BOARD_WIDTH )
+    {
+        fputs("Board too big to search placements", stderr);
+        return 0;
+    }
+
+    if ( y < 0 || verifyPosition(self, x, y, o) )
+    {
+        return 0;
+    }
+
+    head = tail = n = 0;
+    queue[tail++] = STATE(x, y, o);
+    seen[o][y] |= (uint32_t) 1 << (x + PIECE_BOX - 1);
+
+    while ( head < tail )
+    {
+        x = queue[head] % SEARCH_COLS - (PIECE_BOX - 1);
+        y = (queue[head] / SEARCH_COLS) % SEARCH_ROWS;
+        o = queue[head] / (SEARCH_COLS * SEARCH_ROWS);
+        head++;
+
+        for ( i = 0; i < 4; i++ )
+        {
+            nx = x + moves[i][0];
+            no = (o + moves[i][1]) % ORIENTATION;
+
+            if ( !(seen[no][y] & ((uint32_t) 1 << (nx + PIECE_BOX - 1))) &&
+                 !verifyPosition(self, nx, y, no) )
+            {
+                seen[no][y] |= (uint32_t) 1 << (nx + PIECE_BOX - 1);
+                queue[tail++] = STATE(nx, y, no);
+            }
+        }
+
+        // Keep dropping it
+        if ( !verifyPosition(self, x, y + 1, o) )
+        {
+            if ( !(seen[o][y + 1] & ((uint32_t) 1 << (x + PIECE_BOX - 1))) )
+            {
+                seen[o][y + 1] |= (uint32_t) 1 << (x + PIECE_BOX - 1);
+                queue[tail++] = STATE(x, y + 1, o);
+            }
+        }
+
+            // It would be fixed here. List it unless it has the same blocks as
+            // another placement
+        else if ( !(found[SHAPE(currentPiece, o) -> same]\
+                    [y + SHAPE(currentPiece, o) -> top] & \
+                    ((uint32_t) 1 << (x + SHAPE(currentPiece, o) -> left))) )
+        {
+            found[SHAPE(currentPiece, o) -> same]\
+                    [y + SHAPE(currentPiece, o) -> top] |= \
+                    (uint32_t) 1 << (x + SHAPE(currentPiece, o) -> left);
+
+            list[n].x = x;
+            list[n].y = y;
+            list[n].orientation = o;
+
+            for ( i = b1; i < BLOCKS; i++ )
+            {
+                list[n].cells[i][COORD_X] = x + \
+                        pieceArr[currentPiece -> type][o][i][COORD_X];
+                list[n].cells[i][COORD_Y] = y + \
+                        pieceArr[currentPiece -> type][o][i][COORD_Y];
+            }
+
+            n++;
+        }
+    }
+
+    return n;
+}
+
 /**
  * @brief Rotate the piece in the desired direction
  * 
  * Rotating the piece to the left equals to decrementing its orientations once,
  * rotating it to the right, it's the opposite.
  * 
+ * @param self PIECE structure from which this function is called
  * @param direction Direction in which the piece should be rotated 
  * (LEFT or RIGHT)
  * 
  * @return Nothing
  */
 static void
-rotate (int direction)
+rotate (piece_t * self, int direction)
 {
     switch ( direction )
     {
         case LEFT:
             // Decrement orientation once
-            updateOrientation(MINUS);
+            updateOrientation(self, MINUS);
 
             // If conflicts occur with another piece, revert changes
-            if ( verifyFixedPieces() )
+            if ( verifyFixedPieces(self) )
             {
-                updateOrientation(PLUS);
+                updateOrientation(self, PLUS);
             }
             break;
 
         case RIGHT:
             // Increment orientation once
-            updateOrientation(PLUS);
+            updateOrientation(self, PLUS);
 
             // If conflicts occur with another piece, revert changes
-            if ( verifyFixedPieces() )
+            if ( verifyFixedPieces(self) )
             {
-                updateOrientation(MINUS);
+                updateOrientation(self, MINUS);
             }
             break;
 
@@ -1079,40 +1456,95 @@ rotate (int direction)
     }
 
     // Update public coordinates
-    updatePublicCoordinates();
+    updatePublicCoordinates(self);
+}
+
+/**
+ * @brief Tells if two shapes have the same blocks
+ * 
+ * They are compared after moving both to the top-left corner of the piece's
+ * box.
+ * 
+ * @param a First shape
+ * @param b Second shape
+ * 
+ * @return True: The blocks are the same
+ * @return False: They aren't
+ */
+static bool
+sameShape (const shape_t * a, const shape_t * b)
+{
+    int r;
+    const int height = a -> bottom - a -> top;
+
+    if ( height != b -> bottom - b -> top )
+    {
+        return false;
+    }
+
+    for ( r = 0; r <= height; r++ )
+    {
+        if ( (SHAPE_ROWS(a, 0)[a -> top + r] >> a -> left) != \
+             (SHAPE_ROWS(b, 0)[b -> top + r] >> b -> left) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Copy the piece's type and position to a board state
+ * 
+ * @param self PIECE structure from which this function is called
+ * @param state Board state where the piece is written
+ * 
+ * @return Nothing
+ */
+static void
+save (piece_t * self, board_state_t * state)
+{
+    piece_private_t * currentPiece = &self -> _private;
+
+    state -> piece.type = currentPiece -> type;
+    state -> piece.move[COORD_X] = currentPiece -> move[COORD_X];
+    state -> piece.move[COORD_Y] = currentPiece -> move[COORD_Y];
+    state -> piece.orientation = currentPiece -> orientation;
 }
 
 /**
  * @brief Shift the piece in the desired direction
  * 
+ * @param self PIECE structure from which this function is called
  * @param direction Direction to shift the piece (LEFT or RIGHT, according to
  * shiftingTypes enum).
  * 
  * @return Nothing
  */
 static void
-shift (int direction)
+shift (piece_t * self, int direction)
 {
     switch ( direction )
     {
         case LEFT:
-            moveOneCell(COORD_X, MINUS);
+            moveOneCell(self, COORD_X, MINUS);
 
             // If the piece can't be left in the new position, reset it
-            if ( verifyFixedPieces() )
+            if ( verifyFixedPieces(self) )
             {
-                moveOneCell(COORD_X, PLUS);
+                moveOneCell(self, COORD_X, PLUS);
             }
 
             break;
 
         case RIGHT:
-            moveOneCell(COORD_X, PLUS);
+            moveOneCell(self, COORD_X, PLUS);
 
             // If the piece can't be left in the new position, reset it
-            if ( verifyFixedPieces() )
+            if ( verifyFixedPieces(self) )
             {
-                moveOneCell(COORD_X, MINUS);
+                moveOneCell(self, COORD_X, MINUS);
             }
 
             break;
@@ -1122,7 +1554,7 @@ shift (int direction)
     }
 
     // Update public coordinates
-    updatePublicCoordinates();
+    updatePublicCoordinates(self);
 }
 
 /**
@@ -1131,53 +1563,58 @@ shift (int direction)
  * Drops the piece one row so, when called from a function which updates the
  * board constantly, it seems like a double drop at the same time.
  * 
- * @param None
+ * @param self PIECE structure from which this function is called
  * 
  * @return Nothing
  */
 static void
-softDrop (void)
+softDrop (piece_t * self)
 {
+    piece_private_t * currentPiece = &self -> _private;
+
     // Drop once
-    currentPiece.board.pBoard -> update();
+    currentPiece -> board.pBoard -> update(currentPiece -> board.pBoard);
 }
 
 /**
  * @brief Update piece orientation
  * 
+ * @param self PIECE structure from which this function is called
  * @param pm PLUS or MINUS. Change the piece orientation to the next or
  * previous one in the array
  * 
  * @return Nothing
  */
 static void
-updateOrientation (int pm)
+updateOrientation (piece_t * self, int pm)
 {
+    piece_private_t * currentPiece = &self -> _private;
+
     switch ( pm )
     {
             // Previous
         case MINUS:
             // If the first one is reached, go back to the last
-            if ( currentPiece.orientation == 0 )
+            if ( currentPiece -> orientation == 0 )
             {
-                currentPiece.orientation = ORIENTATION - 1;
+                currentPiece -> orientation = ORIENTATION - 1;
             }
             else
             {
-                currentPiece.orientation--;
+                currentPiece -> orientation--;
             }
             break;
 
             // Next
         case PLUS:
             // If the last one is reached, go back to the first
-            if ( currentPiece.orientation == ORIENTATION - 1 )
+            if ( currentPiece -> orientation == ORIENTATION - 1 )
             {
-                currentPiece.orientation = 0;
+                currentPiece -> orientation = 0;
             }
             else
             {
-                currentPiece.orientation++;
+                currentPiece -> orientation++;
             }
             break;
 
@@ -1192,52 +1629,54 @@ updateOrientation (int pm)
  * Uses the private coordinates, which are gathered adding movements to the
  * origin position of the piece, to update the public ones.
  * 
- * @param None
+ * @param self PIECE structure from which this function is called
  * 
  * @return Nothing
  */
 static void
-updatePublicCoordinates (void)
+updatePublicCoordinates (piece_t * self)
 {
+    piece_private_t * currentPiece = &self -> _private;
+
     // Block b1
     // X
-    currentPiece.public -> get.coordinates[b1][COORD_X] = \
-                pieceArr[currentPiece.type][currentPiece.orientation]\
-                [b1][COORD_X] + currentPiece.move[COORD_X];
+    self -> get.coordinates[b1][COORD_X] = \
+                pieceArr[currentPiece -> type][currentPiece -> orientation]\
+                [b1][COORD_X] + currentPiece -> move[COORD_X];
     // Y
-    currentPiece.public -> get.coordinates[b1][COORD_Y] = \
-                pieceArr[currentPiece.type][currentPiece.orientation]\
-                [b1][COORD_Y] + currentPiece.move[COORD_Y];
+    self -> get.coordinates[b1][COORD_Y] = \
+                pieceArr[currentPiece -> type][currentPiece -> orientation]\
+                [b1][COORD_Y] + currentPiece -> move[COORD_Y];
 
     // Block b2
     // X
-    currentPiece.public -> get.coordinates[b2][COORD_X] = \
-                pieceArr[currentPiece.type][currentPiece.orientation]\
-                [b2][COORD_X] + currentPiece.move[COORD_X];
+    self -> get.coordinates[b2][COORD_X] = \
+                pieceArr[currentPiece -> type][currentPiece -> orientation]\
+                [b2][COORD_X] + currentPiece -> move[COORD_X];
     // Y
-    currentPiece.public -> get.coordinates[b2][COORD_Y] = \
-                pieceArr[currentPiece.type][currentPiece.orientation]\
-                [b2][COORD_Y] + currentPiece.move[COORD_Y];
+    self -> get.coordinates[b2][COORD_Y] = \
+                pieceArr[currentPiece -> type][currentPiece -> orientation]\
+                [b2][COORD_Y] + currentPiece -> move[COORD_Y];
 
     // Block b3
     // X
-    currentPiece.public -> get.coordinates[b3][COORD_X] = \
-                pieceArr[currentPiece.type][currentPiece.orientation]\
-                [b3][COORD_X] + currentPiece.move[COORD_X];
+    self -> get.coordinates[b3][COORD_X] = \
+                pieceArr[currentPiece -> type][currentPiece -> orientation]\
+                [b3][COORD_X] + currentPiece -> move[COORD_X];
     // Y
-    currentPiece.public -> get.coordinates[b3][COORD_Y] = \
-               pieceArr[currentPiece.type][currentPiece.orientation]\
-                [b3][COORD_Y] + currentPiece.move[COORD_Y];
+    self -> get.coordinates[b3][COORD_Y] = \
+               pieceArr[currentPiece -> type][currentPiece -> orientation]\
+                [b3][COORD_Y] + currentPiece -> move[COORD_Y];
 
     // Block b4
     // X
-    currentPiece.public -> get.coordinates[b4][COORD_X] = \
-                pieceArr[currentPiece.type][currentPiece.orientation]\
-                [b4][COORD_X] + currentPiece.move[COORD_X];
+    self -> get.coordinates[b4][COORD_X] = \
+                pieceArr[currentPiece -> type][currentPiece -> orientation]\
+                [b4][COORD_X] + currentPiece -> move[COORD_X];
     // Y
-    currentPiece.public -> get.coordinates[b4][COORD_Y] = \
-                pieceArr[currentPiece.type][currentPiece.orientation]\
-                [b4][COORD_Y] + currentPiece.move[COORD_Y];
+    self -> get.coordinates[b4][COORD_Y] = \
+                pieceArr[currentPiece -> type][currentPiece -> orientation]\
+                [b4][COORD_Y] + currentPiece -> move[COORD_Y];
 }
 
 /**
@@ -1246,48 +1685,62 @@ updatePublicCoordinates (void)
  * Verify if no superposition is made after performing an action with a piece,
  * like rotating, shifting or dropping.
  * 
- * @return Error: -1
+ * @param self PIECE structure from which this function is called
+ * 
  * @return Success: EXIT_SUCCESS
  * @return Fail: EXIT_FAILURE
  */
 static int
-verifyFixedPieces (void)
+verifyFixedPieces (piece_t * self)
 {
-    //
-    int i;
-    int count = 0, ans = -1;
-    int x, y;
+    piece_private_t * currentPiece = &self -> _private;
 
-    for ( i = 0; i < BLOCKS; i++ )
+    return verifyPosition(self, currentPiece -> move[COORD_X],
+                          currentPiece -> move[COORD_Y],
+                          currentPiece -> orientation);
+}
+
+/**
+ * @brief Check if the piece can be kept in the given position.
+ * 
+ * The piece's bounding box is checked against the board limits and then every
+ * row of its shape in the given column against the board's row mask.
+ * 
+ * @param self PIECE structure from which this function is called
+ * @param x Column of the piece's box
+ * @param y Row of the piece's box
+ * @param o Orientation of the piece
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+static int
+verifyPosition (piece_t * self, int x, int y, int o)
+{
+    int r;
+    const row_t * mask;
+    piece_private_t * currentPiece = &self -> _private;
+    const shape_t * shape = SHAPE(currentPiece, o);
+
+    // Does it get out of the board?
+    if ( x + shape -> left < 0 ||
+         x + shape -> right >= currentPiece -> board.width ||
+         y + shape -> top < 0 ||
+         y + shape -> bottom >= currentPiece -> board.height )
     {
-        // X coordinate of the block given by i counter plus how many times it
-        // was moved in this axis
-        x = pieceArr[currentPiece.type][currentPiece.orientation][ \
-                i][COORD_X] + currentPiece.move[COORD_X];
-
-        // Y coordinate of the block given by i counter plus how many times it
-        // was moved in this axis
-        y = pieceArr[currentPiece.type][currentPiece.orientation][ \
-                i][COORD_Y] + currentPiece.move[COORD_Y];
-
-        // Does it get out of the board?
-        if ( (x < currentPiece.board.width) &&
-             (y < currentPiece.board.height) &&
-             x >= 0 && y >= 0 )
-        {
-            // If not, does the desired board cell have a fixed block?
-            // count++ if no fixed block is found
-            (CELL(x, y) > CELL_CLEAR) ? (count = -1) : (count++);
+        return EXIT_FAILURE;
+    }
 
-        }
-        else
+    // If not, does any row of the board have a fixed block where the piece is?
+    mask = SHAPE_ROWS(shape, x);
+
+    for ( r = shape -> top; r <= shape -> bottom; r++ )
+    {
+        if ( currentPiece -> board.rows[y + r] & mask[r] )
         {
-            count = -1;
+            return EXIT_FAILURE;
         }
     }
 
-    // When all blocks of the TETROMINO have it's path clear, return 0
-    (count == BLOCKS) ? (ans = EXIT_SUCCESS) : (ans = EXIT_FAILURE);
-
-    return ans;
+    return EXIT_SUCCESS;
 }
@@ -48,8 +48,50 @@
 
 // === Constants and Macro definitions ===
 
+/**
+ * @def PIECE_BOX
+ * @brief Size of the square box with every orientation of a piece in pieceArr
+ */
+#    define PIECE_BOX   4
+
 // === Enumerations, structures and typedefs ===
 
+/**
+ * @brief Private variables of a piece object.
+ * 
+ * Contains the needed parameters to shift, drop and rotate the piece, as well
+ * as the board where the given piece exists. Kept inside every PIECE structure
+ * so pieces of different boards don't share them.
+ * 
+ * @warning Must be modified only by piece_actions.c functions.
+ */
+typedef struct PRIVATE_PIECE
+{
+    /// Piece's board information
+
+    struct
+    {
+        /// Board structure where this piece exists
+        struct GAMEBOARD * pBoard;
+        /// Occupancy mask of every row in the board, being rows[0] the top one
+        const row_t * rows;
+        /// Board height
+        int height;
+        /// Board width
+        int width;
+    } board;
+
+    /// Type of piece. Set using definitions in board.h file.
+    int type;
+
+    /// Board coordinates of the piece. Use coords enum in board.h
+    int move[COORD_NUM];
+
+    /// Rotation status (true or false) and which is the piece's position
+    int orientation;
+
+} piece_private_t;
+
 /**
  * @brief Piece object.
  * 
@@ -83,51 +125,128 @@ typedef struct PIECE
 
     } get;
 
+    /// Private variables. Do not access them
+    piece_private_t _private;
+
     /**
      * @brief Perform piece rotation
      * 
+     * @param self Structure from which this function is called
      * @param direction Direction to rotate the piece. Use shiftingTypes enum.
      * 
      * @return Nothing
      */
-    void (* rotate) (int direction);
+    void (* rotate) (struct PIECE * self, int direction);
 
     /**
      * @brief Shift piece in the given direction
      * 
+     * @param self Structure from which this function is called
      * @param direction Direction to shift the piece. Use shiftingTypes enum.
      * 
      * @return Nothing
      */
-    void (* shift) (int direction);
+    void (* shift) (struct PIECE * self, int direction);
 
     /**
      * @brief Perform a soft drop
      * 
-     * @param None
+     * @param self Structure from which this function is called
+     * 
+     * @return Nothing
+     */
+    void (* softDrop) (struct PIECE * self);
+
+    /**
+     * @brief Drop the piece to the lowest position it can reach
+     * 
+     * The piece isn't fixed. That's done by the next update().
+     * 
+     * @param self Structure from which this function is called
+     * 
+     * @return Number of rows the piece was dropped
+     */
+    int (* hardDrop) (struct PIECE * self);
+
+    /**
+     * @brief How many rows the piece can fall before being blocked
+     * 
+     * The piece isn't moved.
+     * 
+     * @param self Structure from which this function is called
+     * 
+     * @return Number of rows
+     */
+    int (* landing) (struct PIECE * self);
+
+    /**
+     * @brief Every distinct place where the piece can be fixed from where it
+     * is, shifting, rotating and dropping it
+     * 
+     * The piece isn't moved. Placements with the same blocks are listed once.
+     * 
+     * @param self Structure from which this function is called
+     * @param list Array where the placements are written, in the coordinates
+     * of the board given to piece_init()
+     * 
+     * @return Number of placements written in @p list
+     */
+    int (* placements) (struct PIECE * self, placement_t list[MAX_PLACEMENTS]);
+
+    /**
+     * @brief Move the piece to the given position, if it fits there
+     * 
+     * @param self Structure from which this function is called
+     * @param x Column of the piece's box
+     * @param y Row of the piece's box
+     * @param orientation Orientation of the piece
+     * 
+     * @return Success: EXIT_SUCCESS
+     * @return Fail: EXIT_FAILURE. The piece isn't moved
+     */
+    int (* place) (struct PIECE * self, int x, int y, int orientation);
+
+    /**
+     * @brief Copy the piece's type and position to a board state
+     * 
+     * @param self Structure from which this function is called
+     * @param state Board state where the piece is written
+     * 
+     * @return Nothing
+     */
+    void (* save) (struct PIECE * self, board_state_t * state);
+
+    /**
+     * @brief Place the piece where a board state says
+     * 
+     * The piece must have been initialized with the same type saved in the
+     * state.
+     * 
+     * @param self Structure from which this function is called
+     * @param state State taken with save()
      * 
      * @return Nothing
      */
-    void (* softDrop) (void);
+    void (* load) (struct PIECE * self, const board_state_t * state);
 
     /**
      * @brief Update the board with this piece's information
      * 
-     * @param None
+     * @param self Structure from which this function is called
      * 
      * @return Nothing
      */
-    int (* update) (void);
+    int (* update) (struct PIECE * self);
 
     /**
      * @brief Destroy the current piece. All structure information will be 
      * ereased
      * 
-     * @param None
+     * @param self Structure from which this function is called
      * 
      * @return Nothing
      */
-    void (* destroy) (void);
+    void (* destroy) (struct PIECE * self);
 
 } piece_t;
 
@@ -140,7 +259,7 @@ typedef struct PIECE
 // Piece initialization
 int
 piece_init (struct PIECE * pstruct, struct GAMEBOARD * boardStr,
-            grid_t * board, int boardHeight, int boardWidth,
+            const row_t * rows, int boardHeight, int boardWidth,
             const int piece);
 
 #endif /* PIECE_ACTIONS_H */
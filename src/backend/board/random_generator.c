@@ -28,13 +28,29 @@
  *  - No more than 12 pieces between two different I pieces.
  * 
  * There are two compilation options for this functions, the normal one, which
- * uses rand() and another which uses getrandom() from library sys/random.h 
- * (not found in every linux system as it's a relatively new function).
+ * uses a xoshiro256** generator kept in the state of every game, and another
+ * which uses getrandom() from library sys/random.h (not found in every linux
+ * system as it's a relatively new function).
+ * 
+ * Pieces are chosen by the randomizer of the state: a shuffled bag of the 7
+ * tetrominos, as the Tetris Guideline, the one from the Tetris for the NES or
+ * one remembering the last pieces. Each one draws a bounded number of random
+ * numbers for every piece, and the rules are kept by counting the pieces as
+ * they're chosen.
+ * 
+ * xoshiro256** is seeded through SplitMix64, so any seed (0 included) gives a
+ * good state, and it takes a few instructions per number with no lock or
+ * global state, unlike rand().
  * 
  * The later one securely reads data from /dev/urandom and uses it for 
  * generating random intigers. To enable this function, add the argument 
  * -D TRUERANDOM at compilation time.
  * 
+ * A syscall for every number would be too slow while filling a bag or a
+ * row, so RANDOM_POOL bytes are read at once into the state and used from
+ * there. getrandom() is asked not to block and, if it can't give them all,
+ * the rest is read from /dev/urandom, which never blocks either.
+ * 
  * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
  * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
  * 
@@ -49,10 +65,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#ifndef TRUERANDOM
-// For srand
-#    include <time.h>
-#else
+#ifdef TRUERANDOM
+// For memcpy
+#    include <string.h>
+
 // For getrandom
 #    include <sys/random.h>
 #endif
@@ -67,9 +83,6 @@
 #define MAX_SZ          4
 #define MAX_I           12
 
-// Number of options in bool
-#define BOOLOPTIONS     2
-
 // Size of unsigned int
 #define INTSIZE         (sizeof(unsigned int))
 
@@ -79,292 +92,351 @@
 
 // === Function prototypes for private functions with file level scope ===
 
-// Verify if random_generator() rules are being accomplished 
-static char
-chk_rnd (int * rnd_bag, int pos, int * old_bag);
+// Keep random_generator() rules with the piece chosen by a randomizer
+static int
+follow (rnd_state_t * state, int piece);
+
+// Fill a bag with the 7 tetrominos, shuffled
+static void
+randomBag (rnd_state_t * state, int * rnd_bag);
+
+// Fill a bag avoiding the last pieces, as the Tetris: The Grand Master
+static void
+randomHistory (rnd_state_t * state, int * rnd_bag);
+
+// Fill a bag avoiding the last piece, as the Tetris for the NES
+static void
+randomNES (rnd_state_t * state, int * rnd_bag);
 
 #ifdef TRUERANDOM
 // Generate a true random unsigned int
 static unsigned int
-myRand (void);
+myRand (rnd_state_t * state);
+
+// Fill the pool of random bytes of a state
+static void
+fillPool (rnd_state_t * state);
+#else
+// Next number of a xoshiro256** generator
+static uint64_t
+next (uint64_t s[4]);
+
+// Rotate the bits of a number to the left
+static uint64_t
+rotl (uint64_t x, int k);
+
+// Next number of a SplitMix64 generator
+static uint64_t
+splitmix (uint64_t * x);
 #endif
 
 // === ROM Constant variables with file level scope ===
 
+// Randomizers, in randomizers enum order
+static void (* const randomizer[RANDOMIZERS]) (rnd_state_t *, int *) = {
+    &randomBag,
+    &randomNES,
+    &randomHistory
+};
+
+// Every piece but S and Z
+static const int notSZ[] = {
+    TETROMINO_I, TETROMINO_J, TETROMINO_L, TETROMINO_O, TETROMINO_T
+};
+
 // === Static variables and constant variables with file level scope ===
 
 // === Global function definitions ===
 /// @publicsection
 
-#ifndef TRUERANDOM
-
 /**
- * @brief Initialize random generator
+ * @brief Seeds a random generator state before generating the first bag
+ * 
+ * The same seed and randomizer always give the same numbers and pieces.
  * 
- * Must be called once before random_generator().
+ * @param state State to seed
+ * @param seed Any number
+ * @param randomizer One of randomizers enum
  * 
- * @return Success: 0
- * @return Fail: Non 0
+ * @return Nothing
  */
-int
-init_random_generator (void)
+void
+init_random_state (rnd_state_t * state, uint64_t seed, int randomizer)
 {
-    srand(time(NULL));
-    return 0;
-}
+    if ( state != NULL )
+    {
+        int i;
+
+#ifndef TRUERANDOM
+        uint64_t x = seed;
+
+        for ( i = 0; i < 4; i++ )
+        {
+            state -> s[i] = splitmix(&x);
+        }
+#else
+        // Filled now so the first bag doesn't wait for it
+        fillPool(state);
 #endif
 
+        for ( i = 0; i < RANDOM_HISTORY; i++ )
+        {
+            state -> history[i] = TETROMINO_NONE;
+        }
+
+        state -> seed = seed;
+        state -> randomizer = (randomizer >= 0 && randomizer < RANDOMIZERS) ?
+                randomizer : RANDOMIZER_BAG;
+        state -> piecesSinceI = 0;
+        state -> szInARow = 0;
+    }
+}
+
 /**
  * @brief Generates a TETROMINOS size bag with a pseudo-random list of pieces.
  * 
- * Bags are filled with random pieces with the following rules:
+ * Bags are filled by the randomizer of the state with the following rules:
  *  - No more than 4 S or Z pieces togheter.
  *  - No more than 12 pieces between two different I pieces.
  * 
+ * A 7 pieces bag always keeps them. Other randomizers get an I instead of the
+ * 13th piece with no I, and a piece other than S or Z instead of the 5th S or
+ * Z in a row, so no piece is ever drawn again.
+ * 
+ * @param state Random generator state of the game. Must be seeded with
+ * init_random_state() before generating the first bag
  * @param rnd_bag Array of size TETROMINOS
  * @param size Size of rnd_bag array. Used to verify if it's actually 
  * TETROMINOS
  * 
  * @return Nothing
- * 
- * @note init_random_generator() must be called before using this function for
- * the first time.
  */
 void
-random_generator (int * rnd_bag, int size)
+random_generator (rnd_state_t * state, int * rnd_bag, int size)
 {
-    int i, piece;
-
-    int old_bag[TETROMINOS];
-
     if ( size != TETROMINOS )
     {
         fputs("Error on bag size for random_generator()", stderr);
         return;
     }
 
-    // Copy the last used bag.
-    for ( i = 0; i < TETROMINOS; i++ )
+    if ( state == NULL )
     {
-        old_bag[i] = rnd_bag[i];
+        fputs("Invalid state for random_generator()", stderr);
+        return;
     }
 
-    // Generate pieces to fill the bag
-    i = 0;
-    while ( i < TETROMINOS )
-    {
+    randomizer[state -> randomizer](state, rnd_bag);
+}
+
+/**
+ * @brief Random number lower than n
+ * 
+ * @param state Random generator state of the game, seeded with
+ * init_random_state()
+ * @param n Numbers that can be returned. Greater than 0
+ * 
+ * @return Number from 0 to n - 1
+ */
+unsigned int
+random_number (rnd_state_t * state, unsigned int n)
+{
 #ifndef TRUERANDOM
-        piece = (rand() % TETROMINOS) + 1;
+    // The highest 32 bits are scaled to [0, n), with no division
+    return (unsigned int) (((next(state -> s) >> 32) * n) >> 32);
 #else
-        piece = (myRand() % TETROMINOS) + 1;
+    return (unsigned int) (((uint64_t) myRand(state) * n) >> 32);
 #endif
-
-        switch ( piece )
-        {
-            case 1:
-                rnd_bag[i] = TETROMINO_I;
-                break;
-            case 2:
-                rnd_bag[i] = TETROMINO_J;
-                break;
-            case 3:
-                rnd_bag[i] = TETROMINO_L;
-                break;
-            case 4:
-                rnd_bag[i] = TETROMINO_O;
-                break;
-            case 5:
-                rnd_bag[i] = TETROMINO_S;
-                break;
-            case 6:
-                rnd_bag[i] = TETROMINO_T;
-                break;
-            case 7:
-                rnd_bag[i] = TETROMINO_Z;
-                break;
-
-            default:
-                break;
-        }
-
-        // Verify if rules are being accomplished
-        if ( !chk_rnd(rnd_bag, i, old_bag) )
-        {
-            i++;
-        }
-    }
 }
 
 /**
  * @brief Fills an array randomly to represent a row filled between 30% to 75%
  * 
- * Each array position is filled with a TETROMINO_X
+ * Each array position is filled with a TETROMINO_X. The cells are taken from
+ * a partial shuffle of the row, so each one is drawn once.
  * 
+ * @param state Random generator state of the game
  * @param rowArray Array representing a row
  * @param size Array (row) size
  * 
  * @return Nothing
  */
 void
-random_row (grid_t * rowArray, int size)
+random_row (rnd_state_t * state, grid_t * rowArray, int size)
 {
     // Min and max number of cells to fill in the row. Max is also randomized
     // to avoid having almost always near 75% of the rows filled
     const int min = 3 * size / 10;
-#ifndef TRUERANDOM
-    const int max = ((rand() % 45) * size / 100) + min;
-#else
-    const int max = ((myRand() % 45) * size / 100) + min;
-#endif
+    const int max = (random_number(state, 45) * size / 100) + min;
 
-    int i, filled = 0, cellsToFill[max];
+    int i, cells[size];
 
     // Clear array
     for ( i = 0; i < size; i++ )
     {
         rowArray[i] = 0;
-        (i < max) ? (cellsToFill[i] = 0) : 0;
+        cells[i] = i;
     }
 
-    for ( i = 0; i < max; i++ )
+    for ( i = 0; i < max && i < size; i++ )
     {
-        int j;
+        // Swap a cell not taken yet into position i
+        int j = i + random_number(state, size - i), cell = cells[j];
 
-#ifndef TRUERANDOM
-        cellsToFill[i] = rand() % size;
-#else
-        cellsToFill[i] = myRand() % size;
-#endif
+        cells[j] = cells[i];
+        cells[i] = cell;
 
-        for ( j = 0; j < i; j++ )
-        {
-            (cellsToFill[j] == cellsToFill[i]) ? i-- : 0;
-        }
+        // The first min cells are always filled, the rest may be left clear
+        rowArray[cell] = (i < min) ? random_number(state, TETROMINOS) + 1 :
+                random_number(state, TETROMINOS + 1);
+    }
+}
+/// @privatesection
+// === Local function definitions ===
+
+/**
+ * @brief Keep random_generator() rules with the piece chosen by a randomizer
+ * 
+ * Counts how many S / Z pieces are togheter and the pieces since the last I,
+ * changing the piece if it would break a rule. The piece is also added to the
+ * history of the state.
+ * 
+ * @param state Random generator state, with the counts of the last pieces
+ * @param piece Piece chosen by the randomizer
+ * 
+ * @return Piece to add to the bag
+ */
+static int
+follow (rnd_state_t * state, int piece)
+{
+    int i;
+
+    // If there are more than MAX_I pieces between two I, it must be an I
+    if ( state -> piecesSinceI >= MAX_I )
+    {
+        piece = TETROMINO_I;
     }
 
-    // Fill with pieces
-    while ( filled < min )
+        // If an extra S or Z has been chosen, take any other piece
+    else if ( state -> szInARow >= MAX_SZ &&
+              (piece == TETROMINO_S || piece == TETROMINO_Z) )
     {
+        piece = notSZ[random_number(state, TETROMINOS - 2)];
+    }
 
-        for ( i = 0; i < max; i++ )
-        {
+    (piece == TETROMINO_I) ? (state -> piecesSinceI = 0) :
+            state -> piecesSinceI++;
 
-#ifndef TRUERANDOM
-            rowArray[ cellsToFill[i] ] = rand() % (TETROMINOS + 1);
-#else
-            rowArray[ cellsToFill[i] ] = myRand() % (TETROMINOS + 1);
-#endif
-            (rowArray[ cellsToFill[i] ] > 0) ? (filled++) : 0;
+    (piece == TETROMINO_S || piece == TETROMINO_Z) ? state -> szInARow++ :
+            (state -> szInARow = 0);
 
-        }
+    for ( i = RANDOM_HISTORY - 1; i > 0; i-- )
+    {
+        state -> history[i] = state -> history[i - 1];
     }
+    state -> history[0] = piece;
+
+    return piece;
 }
-/// @privatesection
-// === Local function definitions ===
 
 /**
- * @brief Verify if random_generator() rules are being accomplished 
+ * @brief Fill a bag with the 7 tetrominos, shuffled
  * 
- * First counts how many S / Z pieces are togheter and the distance between the 
- * two nearest I pieces, then, compares this values with the generator rules
- * and returns 0 if both are being accomplished.
+ * Uses a Fisher-Yates shuffle. There can be at most 12 pieces between two I
+ * and 4 S or Z together (two at the end of a bag and two at the start of the
+ * next one), so the rules are always kept.
  * 
- * @param rnd_bag Array of size TETROMINOS with the bag being generated.
- * @param pos Position in rnd_bag array with the piece to check.
- * @param old_bag Array of size TETROMINOS with the old bag with random pieces.
+ * @param state Random generator state of the game
+ * @param rnd_bag Array of size TETROMINOS
  * 
- * @return Success: 0 (All rules are being accomplished)
- * @return Fail: Non 0 (At least one of the rules is not accomplished)
+ * @return Nothing
  */
-static char
-chk_rnd (int * rnd_bag, int pos, int * old_bag)
+static void
+randomBag (rnd_state_t * state, int * rnd_bag)
 {
-    // Return
-    int ans = 0;
-
-    // Counters
-    int i = 0, count_sz = 0;
-    static int pieces_since_i = 0;
+    int i;
 
-    // Count S and Z pieces in the old bag and the number of pieces between
-    // the last I and the end of the bag.
-    i = 0;
-    while ( i < TETROMINOS )
+    for ( i = 0; i < TETROMINOS; i++ )
     {
-        // If an S or Z is found, increment counter
-        if ( old_bag[i] == TETROMINO_S || old_bag[i] == TETROMINO_Z )
-        {
-            count_sz++;
-        }
-
-            // With any other piece, reset it
-        else
-        {
-            count_sz = 0;
-        }
-
-        // If an I is found, (re)start counting 
-        if ( old_bag[i] == TETROMINO_I )
-        {
-            pieces_since_i = 0;
-        }
+        rnd_bag[i] = TETROMINO_I + i;
+    }
 
-            // Keep counting while not finding another I
-        else
-        {
-            pieces_since_i++;
-        }
+    for ( i = TETROMINOS - 1; i > 0; i-- )
+    {
+        int j = random_number(state, i + 1), piece = rnd_bag[j];
 
-        i++;
+        rnd_bag[j] = rnd_bag[i];
+        rnd_bag[i] = piece;
     }
 
-    // Verify the bag that's being generated
-    i = 0;
-    while ( i < pos )
+    for ( i = 0; i < TETROMINOS; i++ )
     {
-        // If an S or Z is found, increment counter
-        if ( rnd_bag[i] == TETROMINO_S || rnd_bag[i] == TETROMINO_Z )
-        {
-            count_sz++;
-        }
+        rnd_bag[i] = follow(state, rnd_bag[i]);
+    }
+}
 
-            // With any other piece, reset it
-        else
-        {
-            count_sz = 0;
-        }
+/**
+ * @brief Fill a bag avoiding the last pieces, as the Tetris: The Grand Master
+ * 
+ * Every piece is drawn up to RANDOM_HISTORY times while it's one of the last
+ * RANDOM_HISTORY pieces, keeping the last one drawn.
+ * 
+ * @param state Random generator state of the game
+ * @param rnd_bag Array of size TETROMINOS
+ * 
+ * @return Nothing
+ */
+static void
+randomHistory (rnd_state_t * state, int * rnd_bag)
+{
+    int i, j, k, piece, seen;
 
-        // If an I is found, (re)start counting 
-        if ( rnd_bag[i] == TETROMINO_I )
-        {
-            pieces_since_i = 0;
-        }
+    for ( i = 0; i < TETROMINOS; i++ )
+    {
+        seen = true;
 
-            // Keep counting while not finding another I
-        else
+        for ( j = 0; j < RANDOM_HISTORY && seen; j++ )
         {
-            pieces_since_i++;
+            piece = random_number(state, TETROMINOS);
+            seen = false;
+
+            for ( k = 0; k < RANDOM_HISTORY; k++ )
+            {
+                (state -> history[k] == piece) ? (seen = true) : 0;
+            }
         }
 
-        i++;
+        rnd_bag[i] = follow(state, piece);
     }
+}
 
-    // If there are more than MAX_I pieces between two I, modify the generated
-    // piece to follow the generator rule.
-    if ( pieces_since_i >= MAX_I )
-    {
-        rnd_bag[pos] = TETROMINO_I;
-        pieces_since_i = 0;
-    }
+/**
+ * @brief Fill a bag avoiding the last piece, as the Tetris for the NES
+ * 
+ * One of 8 numbers is drawn for every piece. If it's the last piece, or the
+ * 8th number, which is no piece, any piece is drawn again and kept.
+ * 
+ * @param state Random generator state of the game
+ * @param rnd_bag Array of size TETROMINOS
+ * 
+ * @return Nothing
+ */
+static void
+randomNES (rnd_state_t * state, int * rnd_bag)
+{
+    int i, piece;
 
-        // If an extra S or Z has been generated, ask for another
-    else if ( count_sz >= MAX_SZ &&
-              (rnd_bag[pos] == TETROMINO_S || rnd_bag[pos] == TETROMINO_Z) )
+    for ( i = 0; i < TETROMINOS; i++ )
     {
-        ans = 1;
-    }
+        piece = random_number(state, TETROMINOS + 1);
+
+        if ( piece == TETROMINOS || piece == state -> history[0] )
+        {
+            piece = random_number(state, TETROMINOS);
+        }
 
-    return ans;
+        rnd_bag[i] = follow(state, piece);
+    }
 }
 
 #ifdef TRUERANDOM
@@ -372,44 +444,124 @@ chk_rnd (int * rnd_bag, int pos, int * old_bag)
 /**
  * @brief Generate a true random unsigned int
  * 
- * Uses getrandom() which reads data from /dev/urandom
+ * Uses the bytes in the pool of the state, filling it again when they're all
+ * used.
  * 
- * @param None
+ * @param state Random generator state of the game
  * 
- * @return 0 when an error occurred
- * @return >0 random generated number
+ * @return Random number
  */
 static unsigned int
-myRand (void)
+myRand (rnd_state_t * state)
 {
-    // rndInt will be returned, i is a counter
-    unsigned int rndInt = 0, i;
-
-    // Manage rndInt byte per byte
-    char *p = (char *) (&rndInt);
+    unsigned int rndInt;
 
-    // Generated data will be stored here
-    char rndData[INTSIZE];
-
-    // Generate a set of bytes
-    if ( (getrandom(rndData, sizeof (rndData), GRND_NONBLOCK)) == -1 )
+    if ( state -> poolPosition + (int) INTSIZE > RANDOM_POOL )
     {
-        fputs("Error getting random bytes.", stderr);
-        rndInt = 0;
+        fillPool(state);
     }
 
-    else
+    memcpy(&rndInt, &state -> pool[state -> poolPosition], INTSIZE);
+    state -> poolPosition += INTSIZE;
+
+    return rndInt;
+}
+
+/**
+ * @brief Fill the pool of random bytes of a state
+ * 
+ * Uses getrandom() which reads data from /dev/urandom, with no blocking. If
+ * it gives fewer bytes than asked, the rest are read from /dev/urandom.
+ * 
+ * @param state Random generator state of the game
+ * 
+ * @return Nothing
+ */
+static void
+fillPool (rnd_state_t * state)
+{
+    ssize_t got = getrandom(state -> pool, RANDOM_POOL, GRND_NONBLOCK);
+
+    (got < 0) ? (got = 0) : 0;
+
+    if ( got < RANDOM_POOL )
     {
-        // Move generated bytes to an int
-        for ( i = 0; i < INTSIZE; i++ )
+        FILE * urandom = fopen("/dev/urandom", "rb");
+
+        if ( urandom != NULL )
         {
-            p[i] = rndData[i];
+            got += fread(&state -> pool[got], 1, RANDOM_POOL - got, urandom);
+            fclose(urandom);
         }
 
-        // Avoid returning 0 by mistake
-        rndInt++;
+        // The bytes left from the last time are used again
+        (got < RANDOM_POOL) ? fputs("Error getting random bytes.", stderr) : 0;
     }
 
-    return rndInt;
+    state -> poolPosition = 0;
+}
+#endif
+
+#ifndef TRUERANDOM
+
+/**
+ * @brief Next number of a xoshiro256** generator
+ * 
+ * @param s State of the generator. Updated
+ * 
+ * @return Random number
+ * 
+ * @see https://prng.di.unimi.it/xoshiro256starstar.c
+ */
+static uint64_t
+next (uint64_t s[4])
+{
+    const uint64_t result = rotl(s[1] * 5, 7) * 9;
+    const uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+
+    s[2] ^= t;
+
+    s[3] = rotl(s[3], 45);
+
+    return result;
+}
+
+/**
+ * @brief Rotate the bits of a number to the left
+ * 
+ * @param x Number
+ * @param k Bits to rotate, from 1 to 63
+ * 
+ * @return Rotated number
+ */
+static uint64_t
+rotl (uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * @brief Next number of a SplitMix64 generator
+ * 
+ * Used to turn a seed into a xoshiro256** state, which can't be all zeros.
+ * 
+ * @param x State of the generator. Updated
+ * 
+ * @return Random number
+ */
+static uint64_t
+splitmix (uint64_t * x)
+{
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+    return z ^ (z >> 31);
 }
 #endif
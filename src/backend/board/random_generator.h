@@ -28,12 +28,21 @@
  *  - No more than 12 pieces between two different I pieces.
  * 
  * There are two compilation options for this functions, the normal one, which
- * uses rand() and another which uses getrandom() from library sys/random.h 
- * (not found in every linux system as it's a relatively new function).
+ * uses a xoshiro256** generator kept in the state of every game, and another
+ * which uses getrandom() from library sys/random.h (not found in every linux
+ * system as it's a relatively new function).
+ * 
+ * With the first one, two games started with the same seed and randomizer get
+ * the same pieces, no matter when or in which thread they're played.
+ * 
+ * Pieces are chosen by one of randomizers enum. Each one takes a bounded
+ * number of random numbers per piece, and the rules above are kept by
+ * counting the pieces as they're chosen, with no retries.
  * 
  * The later one securely reads data from /dev/urandom and uses it for 
- * generating random intigers. To enable this function, add the argument 
- * -D TRUERANDOM at compilation time.
+ * generating random intigers, so seeds are ignored. To enable this function,
+ * add the argument -D TRUERANDOM at compilation time. RANDOM_POOL bytes are
+ * read at once and kept in the state until they're used.
  *
  * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
  * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
@@ -49,31 +58,80 @@
 #    define RANDOM_GENERATOR_H 1
 
 // === Libraries and header files ===
-// For pieces, board_cell and coords enum
+// For uint64_t
+#include <stdint.h>
+
+// For pieces, board_cell, coords and randomizers enum
 #include "board.h"
 
 // === Constants and Macro definitions ===
 
+#    ifdef TRUERANDOM
+/**
+ * @def RANDOM_POOL
+ * @brief Random bytes read at once with TRUERANDOM, and kept in the state
+ */
+#        define RANDOM_POOL     4096
+#    endif
+
 // === Enumerations, structures and typedefs ===
 
+/**
+ * @brief State kept between two bags generated by random_generator().
+ * 
+ * Every game must have its own state, so generating a bag for one game
+ * doesn't change the rules being applied to another, nor the pieces it gets.
+ */
+typedef struct RANDOM_STATE
+{
+    /// Seed given to init_random_state()
+    uint64_t seed;
+
+    /// State of the generator
+    uint64_t s[4];
+
+    /// Randomizer choosing the pieces, one of randomizers enum
+    int randomizer;
+
+    /// Pieces generated since the last I piece
+    int piecesSinceI;
+
+    /// S and Z pieces generated in a row
+    int szInARow;
+
+    /// Last pieces generated, the newest first. TETROMINO_NONE until there
+    /// are enough of them
+    int history[RANDOM_HISTORY];
+
+#    ifdef TRUERANDOM
+    /// Random bytes not used yet, so numbers aren't read one by one
+    unsigned char pool[RANDOM_POOL];
+
+    /// Next byte to use from pool. RANDOM_POOL when it must be filled again
+    int poolPosition;
+#    endif
+} rnd_state_t;
+
 // === Global variables ===
 
 // === ROM Constant variables ===
 
 // === Global function definitions ===
 
-#ifndef TRUERANDOM
-// Initialize pseudo-random generator
-int
-init_random_generator (void);
-#endif
+// Seeds a random generator state before generating the first bag
+void
+init_random_state (rnd_state_t * state, uint64_t seed, int randomizer);
 
 // Generates a NUM_PIECES size bag with a pseudo-random list of pieces.
 void
-random_generator (int * rnd_bag, int size);
+random_generator (rnd_state_t * state, int * rnd_bag, int size);
+
+// Random number lower than n
+unsigned int
+random_number (rnd_state_t * state, unsigned int n);
 
 // Fills an array randomly to represent a row filled between 30% to 75%
 void
-random_row (grid_t * rowArray, int size);
+random_row (rnd_state_t * state, grid_t * rowArray, int size);
 
 #endif /* RANDOM_GENERATOR_H */
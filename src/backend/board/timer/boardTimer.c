@@ -23,9 +23,13 @@
  * 
  * @details After initializing the timer, askTimeLimit() can be called to 
  * know how much time should be ellapsed between two board updates. This can
- * be handled with your own code or using askTimer(), which automatically calls
- * askTimeLimit() and, using the system clock, calculates if that time has
- * been ellapsed.
+ * be handled with your own code or using askSteps(), which automatically calls
+ * askTimeLimit() and, using the monotonic clock, calculates how many times
+ * that time has been ellapsed.
+ *
+ * The time passed since the last call is added to an accumulator, and every
+ * step takes the time limit out of it. What's left is kept for the next
+ * step, so steps don't drift however often the timer is asked.
  *
  * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
  * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
@@ -39,7 +43,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>    // For bool, true and false
-#include <time.h>       // For clock_t, clock and CLOCKS_PER_SEC
+#include <stdint.h>     // For uint64_t and int64_t
+
+// For monotonic_now
+#include "../../monotonic/monotonic.h"
 
 // This file
 #include "boardTimer.h"
@@ -48,20 +55,15 @@
 // === Constants and Macro definitions ===
 /**
  * @def NTIMER_T
- * @brief tmr_t variable name
+ * @brief tmr_t being used, given as self to every function
  */
-#define NTIMER_T    (timer)
+#define NTIMER_T    (*self)
 
 /**
- * @def CLKDIFF(t)
- * @brief Get the difference between the actual clock and @p t
- */
-#define CLKDIFF(t)  (clock() - (t))
-/**
- * @def CLK2MS(c)
- * @brief Convert the difference between two clocks (@p c) to milliseconds
+ * @def MS2NS(t)
+ * @brief Convert @p t milliseconds to nanoseconds
  */
-#define CLK2MS(c)    ( ( ( (double)(c) ) / CLOCKS_PER_SEC) * 1000.0 )
+#define MS2NS(t)    ((uint64_t) ((t) * 1000000.0))
 
 /**
  * @def TLIMIT
@@ -71,92 +73,132 @@
 
 /**
  * @def RESET_T0
- * @brief Set the initial time variable to the current time.
+ * @brief Set the initial time variable to the current time, with no time
+ * accumulated.
  */
-#define RESET_T0    (NTIMER_T.t0 = clock())
+#define RESET_T0    (NTIMER_T.t0 = monotonic_now(), NTIMER_T.accumulator = 0)
 
 // === Enumerations, structures and typedefs ===
 
-/**
- * @brief Structure with the current game level, initial timer and time limit
- */
-typedef struct TIMER
-{
-    // Stats structure used to get the current level
-    const stats_t * stats;
-
-    // Initial timer
-    clock_t t0;
-
-    // Time limit in the current level
-    double t1;
-
-    // Current level
-    int level;
-} tmr_t;
-
 // === Global variables ===
 
 // === Function prototypes for private functions with file level scope ===
+// Add the time passed since the last call to the accumulator
+static void
+accumulate (tmr_t * self);
+
 // Update the time limit according to the current level
 static void
-updateLimit (void);
+updateLimit (tmr_t * self);
 
 // === ROM Constant variables with file level scope ===
 
 // === Static variables and constant variables with file level scope ===
-// tmr_t global variable. Used by all functions
-static tmr_t NTIMER_T;
 
 // === Global function definitions ===
 /// @publicsection
 
+/**
+ * @brief Number of steps due since the last call
+ * 
+ * Every step takes the time limit from the time accumulated, and the rest
+ * is kept for the next call. After a stall there can be several, but never
+ * more than TIMER_MAX_STEPS.
+ * 
+ * @param self Timer of the game
+ * 
+ * @return Steps due. Each one is a board update
+ */
+int
+askSteps (tmr_t * self)
+{
+    uint64_t limit, steps;
+
+    accumulate(self);
+
+    limit = MS2NS(TLIMIT);
+    steps = NTIMER_T.accumulator / limit;
+
+    if ( steps > TIMER_MAX_STEPS )
+    {
+        steps = TIMER_MAX_STEPS;
+        NTIMER_T.accumulator = 0;
+    }
+    else
+    {
+        NTIMER_T.accumulator -= steps * limit;
+    }
+
+    return (int) steps;
+}
+
 /**
  * @brief Tells if the time limit has been reached
  * 
+ * A single step is taken, so the next call tells if there's another one due
+ * after a stall.
+ * 
+ * @param self Timer of the game
+ * 
  * @return true Time limit has been reached or passed
  * @return false Time limit has not been reached
  */
 bool
-askTimer (void)
+askTimer (tmr_t * self)
 {
     bool ans = false;
+    uint64_t limit;
+
+    accumulate(self);
 
-    // Get time difference between the initial and actual time, in ms
-    double dt = CLK2MS(CLKDIFF(NTIMER_T.t0));
+    limit = MS2NS(TLIMIT);
 
     // Time limit
-    if ( dt >= TLIMIT )
+    if ( NTIMER_T.accumulator >= limit )
     {
-        // Update time limit if level has changed
-        if ( NTIMER_T.level != NTIMER_T.stats -> level )
-        {
-            updateLimit();
-        }
-
+        NTIMER_T.accumulator -= limit;
         ans = true;
-
-        // Reset timer
-        RESET_T0;
     }
 
     return ans;
 }
 
+/**
+ * @brief Time left until the next step, in ns
+ * 
+ * Frontends can sleep this long before asking for the next step.
+ * 
+ * @param self Timer of the game
+ * 
+ * @return Nanoseconds until the next step. 0 if it's due already
+ */
+int64_t
+askTimeLeft (tmr_t * self)
+{
+    uint64_t limit;
+
+    accumulate(self);
+
+    limit = MS2NS(TLIMIT);
+
+    return (NTIMER_T.accumulator >= limit) ? 0 : \
+            (int64_t) (limit - NTIMER_T.accumulator);
+}
+
 /**
  * @brief Returns the time in ms that a piece has to be static before updating
  * 
- * @param None
+ * @param self Timer of the game
  * 
  * @return Time limit for the current level
  */
 int
-askTimeLimit (void)
+askTimeLimit (tmr_t * self)
 {
     // Update time limit if level has changed
     if ( NTIMER_T.level != NTIMER_T.stats -> level )
     {
-        updateLimit();
+        updateLimit(self);
     }
 
     return TLIMIT;
@@ -165,19 +207,20 @@ askTimeLimit (void)
 /**
  * @brief Initialize the timer functions.
  * 
+ * @param self Timer to initialize
  * @param sts Pointer to the current STATS structure. Used to get the current
  * game level.
  * 
  * @return Success: 0
  * @return Fail: Non-zero
  * 
- * @note This function <b>must</b> be called once before askTimer or startTimer
+ * @note This function <b>must</b> be called once before any other one
  */
 int
-initTimer (const stats_t * sts)
+initTimer (tmr_t * self, const stats_t * sts)
 {
     // Check that STATS is valid
-    if ( sts == NULL )
+    if ( self == NULL || sts == NULL )
     {
         fputs("Bad STATS structure.", stderr);
         return 1;
@@ -186,9 +229,9 @@ initTimer (const stats_t * sts)
     NTIMER_T.stats = sts;
 
     // Initial time limit
-    updateLimit();
+    updateLimit(self);
 
-    // Start timer in case askTimer is called before another call to startTimer
+    // Start timer in case askSteps is called before another call to startTimer
     RESET_T0;
 
     return 0;
@@ -197,14 +240,15 @@ initTimer (const stats_t * sts)
 /**
  * @brief Reset timer
  * 
- * This function should be called when the delay counter should start.
+ * This function should be called when the delay counter should start. Any
+ * time accumulated is dropped.
  * 
- * @param None
+ * @param self Timer of the game
  * 
  * @return Nothing
  */
 void
-startTimer (void)
+startTimer (tmr_t * self)
 {
     RESET_T0;
 }
@@ -212,11 +256,37 @@ startTimer (void)
 /// @privatesection
 // === Local function definitions ===
 
+/**
+ * @brief Add the time passed since the last call to the accumulator
+ * 
+ * The time limit is updated first if the level has changed.
+ * 
+ * @param self Timer of the game
+ * 
+ * @return Nothing
+ */
+static void
+accumulate (tmr_t * self)
+{
+    uint64_t t = monotonic_now();
+
+    // Update time limit if level has changed
+    if ( NTIMER_T.level != NTIMER_T.stats -> level )
+    {
+        updateLimit(self);
+    }
+
+    NTIMER_T.accumulator += t - NTIMER_T.t0;
+    NTIMER_T.t0 = t;
+}
+
 /**
  * @brief Update the time limit according to the current level
+ * 
+ * @param self Timer of the game
  */
 static void
-updateLimit (void)
+updateLimit (tmr_t * self)
 {
     const float times[] = {
         1000.0,
@@ -23,9 +23,14 @@
  * 
  * @details After initializing the timer, askTimeLimit() can be called to 
  * know how much time should be ellapsed between two board updates. This can
- * be handled with your own code or using askTimer(), which automatically calls
- * askTimeLimit() and, using the system clock, calculates if that time has
- * been ellapsed.
+ * be handled with your own code or using askSteps(), which tells how many
+ * updates are due since it was last called, and askTimeLeft(), which tells
+ * how long until the next one.
+ *
+ * Time is taken from CLOCK_MONOTONIC, so it's the real time passed even when
+ * the game sleeps or waits for events, with nanosecond resolution. It's
+ * accumulated and taken a step at a time, so every step takes exactly the
+ * time limit, and some steps are given at once after a stall.
  *
  * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
  * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
@@ -39,32 +44,76 @@
 #    define BOARDTIMER_H 1
 
 // === Libraries and header files ===
+// For uint64_t and int64_t
+#include <stdint.h>
+
 // For STATS struct
 #include "../../stats/stats_mgmt.h"
 
 // === Constants and Macro definitions ===
 
+/**
+ * @def TIMER_MAX_STEPS
+ * @brief Most steps given at once by askSteps(). Any time after them is
+ * dropped, so a long stall doesn't play a whole game at once
+ */
+#    define TIMER_MAX_STEPS     20
+
 // === Enumerations, structures and typedefs ===
 
+/**
+ * @brief Structure with the current game level, initial timer and time limit
+ * 
+ * Every game has its own timer. Its fields must be modified only by the
+ * functions in this file.
+ * 
+ * @warning initTimer() must be called before using this structure.
+ */
+typedef struct TIMER
+{
+    /// Stats structure used to get the current level
+    const stats_t * stats;
+
+    /// Time up to which steps were counted, in ns
+    uint64_t t0;
+
+    /// Time counted but not taken by a step yet, in ns
+    uint64_t accumulator;
+
+    /// Time limit in the current level, in ms
+    double t1;
+
+    /// Current level
+    int level;
+} tmr_t;
+
 // === Global variables ===
 
 // === ROM Constant variables ===
 
 // === Global function definitions ===
 
+// Number of steps due since the last call
+int
+askSteps (tmr_t * self);
+
 // Tells if the time limit has been reached
 bool
-askTimer (void);
+askTimer (tmr_t * self);
+
+// Time left until the next step, in ns
+int64_t
+askTimeLeft (tmr_t * self);
 
 // Returns the time in ms that a piece has to be static before updating
 int
-askTimeLimit (void);
+askTimeLimit (tmr_t * self);
 
 // Initialize the timer functions.
 int
-initTimer (const stats_t * sts);
+initTimer (tmr_t * self, const stats_t * sts);
 
 // (Re)Set timer
 void
-startTimer (void);
+startTimer (tmr_t * self);
 #endif /* BOARDTIMER_H */
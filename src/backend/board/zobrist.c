@@ -0,0 +1,205 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/******************************************************************************
+ * 
+ * @file    zobrist.c
+ * 
+ * @brief   Zobrist keys of the parts of a game.
+ * 
+ * @details Every part is numbered with its kind in the highest bits, and the
+ * number is mixed with the finalizer of SplitMix64. Any change in the number
+ * changes about half of the bits of the key, as a random table would.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 16:05
+ * 
+ * @see https://prng.di.unimi.it/splitmix64.c
+ * 
+ * @copyright GNU General Public License v3
+ *****************************************************************************/
+
+// === Libraries and header files ===
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+// This file
+#include "zobrist.h"
+
+/// @privatesection
+// === Constants and Macro definitions ===
+
+/**
+ * @def OFFSET
+ * @brief Added to coordinates that can be negative
+ */
+#define OFFSET          16
+
+// === Enumerations, structures and typedefs ===
+
+/**
+ * @brief Kinds of parts with a key
+ */
+enum keyKinds
+{
+    /// Fixed block
+    KEY_CELL = 1,
+    /// Block of the moving piece
+    KEY_PIECE,
+    /// Piece in the bag
+    KEY_BAG,
+    /// Position in the bag
+    KEY_POSITION
+};
+
+// === Global variables ===
+
+// === Function prototypes for private functions with file level scope ===
+
+// Key of a part of the game
+static uint64_t
+key (int kind, int a, int b, int c);
+
+// === ROM Constant variables with file level scope ===
+
+// === Static variables and constant variables with file level scope ===
+
+// === Global function definitions ===
+/// @publicsection
+
+/**
+ * @brief Key of the pieces left in the bag
+ * 
+ * The whole bag is used, since it's filled again before its last piece is
+ * taken.
+ * 
+ * @param bag Bag of pieces
+ * @param position Next piece to take from the bag
+ * @param last Piece kept from the last bag, or a negative number
+ * 
+ * @return Key
+ */
+uint64_t
+zobrist_bag (const int bag[TETROMINOS], int position, int last)
+{
+    int i;
+    uint64_t hash = key(KEY_POSITION, position, last + OFFSET, 0);
+
+    for ( i = 0; i < TETROMINOS; i++ )
+    {
+        hash ^= key(KEY_BAG, i, bag[i] + OFFSET, 0);
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Key of the moving piece
+ * 
+ * @param type Type of the piece (TETROMINO_I, ..., TETROMINO_Z)
+ * @param cells Row and column of every block, hidden rows included
+ * 
+ * @return Key
+ */
+uint64_t
+zobrist_piece (int type, const int cells[BLOCKS][COORD_NUM])
+{
+    int i;
+    uint64_t hash = 0;
+
+    for ( i = b1; i < BLOCKS; i++ )
+    {
+        hash ^= key(KEY_PIECE, type, cells[i][COORD_Y] + OFFSET,
+                    cells[i][COORD_X] + OFFSET);
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Key of the fixed blocks of a row
+ * 
+ * @param row Row number, hidden rows included
+ * @param mask Occupancy mask of the row
+ * 
+ * @return Key. 0 for an empty row
+ */
+uint64_t
+zobrist_row (int row, row_t mask)
+{
+    int col;
+    uint64_t hash = 0;
+
+    for ( col = 0; mask != 0; col++, mask >>= 1 )
+    {
+        (mask & 1) ? hash ^= key(KEY_CELL, row, col, 0) : 0;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Key of the fixed blocks of many rows
+ * 
+ * @param rows Occupancy mask of every row, from the first one
+ * @param n Number of rows
+ * 
+ * @return Key. 0 for an empty board
+ */
+uint64_t
+zobrist_rows (const row_t * rows, int n)
+{
+    int row;
+    uint64_t hash = 0;
+
+    for ( row = 0; row < n; row++ )
+    {
+        hash ^= zobrist_row(row, rows[row]);
+    }
+
+    return hash;
+}
+
+/// @privatesection
+// === Local function definitions ===
+
+/**
+ * @brief Key of a part of the game
+ * 
+ * @param kind What the part is, from keyKinds enum
+ * @param a First number of the part. From 0 to 65535
+ * @param b Second number of the part. From 0 to 65535
+ * @param c Third number of the part. From 0 to 65535
+ * 
+ * @return Key
+ */
+static uint64_t
+key (int kind, int a, int b, int c)
+{
+    uint64_t z = ((uint64_t) kind << 48) | ((uint64_t) (a & 0xFFFF) << 32) |
+            ((uint64_t) (b & 0xFFFF) << 16) | (uint64_t) (c & 0xFFFF);
+
+    // SplitMix64
+    z += 0x9E3779B97F4A7C15u;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+
+    return z ^ (z >> 31);
+}
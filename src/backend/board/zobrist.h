@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ * 
+ * @file    zobrist.h
+ * 
+ * @brief   Zobrist keys of the parts of a game.
+ * 
+ * @details Every fixed block, every block of the moving piece and the pieces
+ * left in the bag have their own 64 bits key. The hash of a game is the XOR
+ * of the keys of all of them, so it's updated with a XOR every time one of
+ * them changes.
+ * 
+ * Keys are not read from a table but mixed from what they stand for, so
+ * they're the same in every run and every program. Hashes can be saved and
+ * compared later.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 16:05
+ * 
+ * @see https://en.wikipedia.org/wiki/Zobrist_hashing
+ * 
+ * @copyright GNU General Public License v3
+ */
+
+#ifndef ZOBRIST_H
+#    define ZOBRIST_H 1
+
+// === Libraries and header files ===
+// For uint64_t
+#include <stdint.h>
+
+// For row_t, BLOCKS and COORD_NUM
+#include "board.h"
+
+// === Constants and Macro definitions ===
+
+// === Enumerations, structures and typedefs ===
+
+// === Global variables ===
+
+// === ROM Constant variables ===
+
+// === Global function definitions ===
+
+// Key of the pieces left in the bag
+uint64_t
+zobrist_bag (const int bag[TETROMINOS], int position, int last);
+
+// Key of the moving piece
+uint64_t
+zobrist_piece (int type, const int cells[BLOCKS][COORD_NUM]);
+
+// Key of the fixed blocks of a row
+uint64_t
+zobrist_row (int row, row_t mask);
+
+// Key of the fixed blocks of many rows
+uint64_t
+zobrist_rows (const row_t * rows, int n);
+
+#endif /* ZOBRIST_H */
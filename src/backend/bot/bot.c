@@ -0,0 +1,986 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/******************************************************************************
+ * 
+ * @file    bot.c
+ * 
+ * @brief   Headless player that chooses where to fix every piece.
+ * 
+ * @details Every feature is computed walking the row masks of the board from
+ * the top, keeping the union of the rows already walked. A column has a block
+ * in that union from its highest block down, so counting its bits in every
+ * row gives the height of the columns, and comparing it with the row and with
+ * itself shifted one column gives the holes, bumpiness and wells.
+ * 
+ * lookahead() evaluates the board left by every placement of a piece as the
+ * best score reachable with the pieces after it. Every placement of the
+ * moving piece is a task of the pool, and deeper ones submit their own tasks
+ * for the best placements of the piece after them, so idle threads steal
+ * them. Boards past the known pieces are kept in the transposition table,
+ * if there's one.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 10:12
+ * 
+ * @copyright GNU General Public License v3
+ *****************************************************************************/
+
+// === Libraries and header files ===
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>     // For memcpy
+#include <stddef.h>     // For max_align_t
+#include <float.h>      // For DBL_MAX
+#include <stdatomic.h>
+#include <pthread.h>
+
+// For monotonic_now, the clock of the deadlines
+#include "../monotonic/monotonic.h"
+
+// For stats_t
+#include "../stats/stats_mgmt.h"
+
+// For the hash of the boards searched
+#include "../board/zobrist.h"
+
+// This file
+#include "bot.h"
+
+/// @privatesection
+// === Constants and Macro definitions ===
+
+/**
+ * @def POPCOUNT(x)
+ * @brief Number of bits set in the row mask (x)
+ */
+#ifdef __GNUC__
+#    define POPCOUNT(x)     __builtin_popcount(x)
+#else
+#    define POPCOUNT(x)     popcount(x)
+#endif
+
+/**
+ * @def TOP_OUT
+ * @brief Score of a placement that leaves blocks in the hidden rows
+ */
+#define TOP_OUT         (-DBL_MAX)
+
+/// Default pieces searched by lookahead()
+#define DEPTH           2
+/// Default placements searched further after the first piece
+#define BEAM            8
+
+/// Default weight of the aggregate height
+#define W_HEIGHT        -0.510066
+/// Default weight of the lines cleared
+#define W_LINES         0.760666
+/// Default weight of the holes
+#define W_HOLES         -0.35663
+/// Default weight of the bumpiness
+#define W_BUMPINESS     -0.184483
+/// Default weight of the wells
+#define W_WELLS         -0.05
+
+/**
+ * @def SCRATCH_SIZE
+ * @brief Bytes of the scratch memory of every thread running expand()
+ * 
+ * Enough for the root and the nodes under it, with the default beam. Nodes
+ * that don't fit, as the ones of tasks taken while waiting, are allocated.
+ */
+#define SCRATCH_SIZE    (1 << 20)
+
+/**
+ * @def ALIGNED(n)
+ * @brief (n) bytes rounded up so that any type can follow them
+ */
+#define ALIGNED(n)      (((n) + sizeof (max_align_t) - 1) / \
+                         sizeof (max_align_t) * sizeof (max_align_t))
+
+/**
+ * @def DEPTH_KEY(d)
+ * @brief Added to the hash of a board searched (d) pieces deep
+ */
+#define DEPTH_KEY(d)    ((uint64_t) (d) * 0x9E3779B97F4A7C15u)
+
+// === Enumerations, structures and typedefs ===
+
+/**
+ * @brief Features of the first rows of a board
+ */
+typedef struct BOT_PREFIX
+{
+    /// Union of the rows walked
+    row_t above;
+
+    /// Features of the rows walked
+    bot_features_t features;
+} prefix_t;
+
+/**
+ * @brief Search shared by every node
+ */
+typedef struct BOT_SEARCH
+{
+    bot_t * self;
+    board_t * board;
+
+    /// Known pieces. The moving one is searched from where it is
+    int pieces[BOT_KNOWN];
+
+    /// Pieces searched
+    int depth;
+
+    /// When the search must end, in ns of the monotonic clock
+    uint64_t deadline;
+
+    /// Set when the deadline passes. The search is stopped and discarded
+    atomic_bool late;
+} search_t;
+
+/**
+ * @brief Board left by some pieces, to search the next one
+ */
+typedef struct BOT_NODE
+{
+    search_t * search;
+
+    /// Pieces fixed in the board
+    int level;
+
+    /// Row masks of the board, with the lines cleared
+    row_t rows[BOT_ROWS];
+
+    /// Score of the lines cleared by the last piece fixed
+    double gain;
+
+    /// Best score reachable from this board, not counting gain
+    double value;
+
+    /// Best placement of every known piece from this board on
+    placement_t moves[BOT_KNOWN];
+} node_t;
+
+/**
+ * @brief Scratch memory of a thread, taken by expand() as a stack
+ * 
+ * Nodes expanded by a thread end in the reverse order they started, even
+ * the ones of tasks it takes while waiting, so only the bytes taken are kept.
+ */
+typedef struct BOT_SCRATCH
+{
+    /// Bytes of memory taken
+    size_t used;
+
+    max_align_t memory[SCRATCH_SIZE / sizeof (max_align_t)];
+} scratch_t;
+
+// === Global variables ===
+
+// === Function prototypes for private functions with file level scope ===
+
+// Add a row to the features of the rows over it
+static void
+addRow (prefix_t * prefix, row_t row);
+
+// Board left by a placement, with its lines cleared
+static int
+apply (const row_t rows[BOT_ROWS], const placement_t * where,
+       row_t out[BOT_ROWS]);
+
+// Destroy the bot, stopping its threads
+static void
+destroy (bot_t * self);
+
+// Best score reachable from the board of a node
+static void
+expand (void * arg);
+
+// Features of the board left by a placement
+static void
+features (bot_t * self, const row_t rows[BOT_ROWS],
+          const placement_t * where, bot_features_t * features);
+
+// Features of the board left by a placement, from the ones of the rows over it
+static void
+fromPrefix (const prefix_t prefix[BOT_ROWS + 1], const row_t rows[BOT_ROWS],
+            const placement_t * where, bot_features_t * features);
+
+// Best placements of the moving piece and the next one
+static int
+lookahead (bot_t * self, board_t * board, double budget,
+           placement_t moves[BOT_KNOWN]);
+
+// Create the key freeing the scratch memory of every thread
+static void
+newScratchKey (void);
+
+// Fix the moving piece where it scores best
+static int
+play (bot_t * self, board_t * board);
+
+#ifndef __GNUC__
+// Number of bits set in a row mask
+static int
+popcount (row_t row);
+#endif
+
+// Give back the last memory taken with reserve()
+static void
+release (void * memory, size_t size);
+
+// Take memory from the scratch of the calling thread
+static void *
+reserve (size_t size);
+
+// Score many placements of a piece at once
+static void
+score (bot_t * self, const row_t rows[BOT_ROWS],
+       const placement_t list[], int n, double scores[]);
+
+// Set how many threads run lookahead()
+static int
+threads (bot_t * self, int n);
+
+// Score of a board with the given features
+static double
+weigh (bot_t * self, const bot_features_t * features);
+
+// === ROM Constant variables with file level scope ===
+
+// === Static variables and constant variables with file level scope ===
+
+/// Scratch memory of the calling thread. NULL until it runs expand()
+static _Thread_local scratch_t * scratch = NULL;
+
+/// Frees the scratch memory of a thread when it exits
+static pthread_key_t scratchKey;
+
+/// Creates scratchKey once
+static pthread_once_t scratchOnce = PTHREAD_ONCE_INIT;
+
+// === Global function definitions ===
+/// @publicsection
+
+/**
+ * @brief Initialize a bot with the default weights
+ * 
+ * @param self BOT structure to initialize
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+int
+bot_init (bot_t * self)
+{
+    if ( self == NULL )
+    {
+        fputs("Invalid BOT structure.", stderr);
+        return EXIT_FAILURE;
+    }
+
+    self -> weights.height = W_HEIGHT;
+    self -> weights.lines = W_LINES;
+    self -> weights.holes = W_HOLES;
+    self -> weights.bumpiness = W_BUMPINESS;
+    self -> weights.wells = W_WELLS;
+
+    self -> depth = DEPTH;
+    self -> beam = BEAM;
+    self -> pool = NULL;
+    self -> table = NULL;
+
+    self -> features = &features;
+    self -> score = &score;
+    self -> play = &play;
+    self -> lookahead = &lookahead;
+    self -> threads = &threads;
+    self -> destroy = &destroy;
+
+    self -> init = true;
+
+    return EXIT_SUCCESS;
+}
+
+/// @privatesection
+// === Local function definitions ===
+
+/**
+ * @brief Add a row to the features of the rows over it
+ * 
+ * A filled row is cleared, so it only counts as a line.
+ * 
+ * @param prefix Features of the rows over @p row. Updated with it
+ * @param row Row mask
+ * 
+ * @return Nothing
+ */
+static void
+addRow (prefix_t * prefix, row_t row)
+{
+    row_t above;
+
+    if ( row == ROW_FULL )
+    {
+        prefix -> features.lines++;
+        return;
+    }
+
+    // Clear cells under a block
+    prefix -> features.holes += POPCOUNT((row_t) (prefix -> above & ~row));
+
+    above = prefix -> above |= row;
+
+    if ( above != 0 )
+    {
+        // Every column with a block in this row or over it is one row higher
+        prefix -> features.height += POPCOUNT(above);
+        prefix -> features.top++;
+
+        // Only one of two adjacent columns is this high
+        prefix -> features.bumpiness += \
+                POPCOUNT((row_t) ((above ^ (above >> 1)) & (ROW_FULL >> 1)));
+
+        // Clear cells between two higher columns or a column and a wall
+        prefix -> features.wells += \
+                POPCOUNT((row_t) (~above & ROW_FULL &
+                                  ((above << 1) | ROW_BIT(0)) &
+                                  ((above >> 1) | ROW_BIT(BOARD_WIDTH - 1))));
+    }
+}
+
+/**
+ * @brief Board left by a placement, with its lines cleared
+ * 
+ * @param rows Row masks of the board
+ * @param where Placement of the piece
+ * @param out Where the row masks of the new board are written
+ * 
+ * @return Lines cleared
+ */
+static int
+apply (const row_t rows[BOT_ROWS], const placement_t * where,
+       row_t out[BOT_ROWS])
+{
+    int i, r, bottom, lines = 0;
+
+    memcpy(out, rows, BOT_ROWS * sizeof (row_t));
+
+    for ( i = b1; i < BLOCKS; i++ )
+    {
+        out[where -> cells[i][COORD_Y] + HIDDEN_ROWS] |= \
+                ROW_BIT(where -> cells[i][COORD_X]);
+    }
+
+    // Drop every row over a filled one
+    for ( r = bottom = BOT_ROWS - 1; r >= 0; r-- )
+    {
+        (out[r] == ROW_FULL) ? lines++ : (out[bottom--] = out[r]);
+    }
+
+    for ( ; bottom >= 0; bottom-- )
+    {
+        out[bottom] = 0;
+    }
+
+    return lines;
+}
+
+/**
+ * @brief Destroy the bot, stopping its threads
+ * 
+ * @param self BOT structure from which this function is called
+ * 
+ * @return Nothing
+ */
+static void
+destroy (bot_t * self)
+{
+    pool_free(self -> pool);
+    self -> pool = NULL;
+    self -> table = NULL;
+
+    self -> features = NULL;
+    self -> score = NULL;
+    self -> play = NULL;
+    self -> lookahead = NULL;
+    self -> threads = NULL;
+    self -> destroy = NULL;
+
+    self -> init = false;
+}
+
+/**
+ * @brief Best score reachable from the board of a node
+ * 
+ * Every placement of the piece after the board is scored. If it's the last
+ * piece searched, the best score is the value of the board. Otherwise, the
+ * best placements are searched as nodes of their own, one task each. When
+ * the piece isn't known, the value is the average of every tetromino.
+ * 
+ * @param arg node_t to search. Its value and moves are written
+ * 
+ * @return Nothing
+ */
+static void
+expand (void * arg)
+{
+    node_t * node = arg;
+    search_t * search = node -> search;
+    bot_t * self = search -> self;
+    int i, j, k, n, type, types, width;
+    int top[MAX_PLACEMENTS];
+    size_t size;
+    unsigned char * memory;
+    placement_t * list;
+    double * scores, best, value = 0;
+    node_t * children;
+    atomic_int pending;
+    uint64_t hash = 0;
+    tt_entry_t entry;
+
+    if ( atomic_load(&search -> late) ||
+         monotonic_now() > search -> deadline )
+    {
+        atomic_store(&search -> late, true);
+        return;
+    }
+
+    // Past the known pieces no move is kept, so boards reached in different
+    // ways are searched once
+    if ( self -> table != NULL && node -> level >= BOT_KNOWN )
+    {
+        entry.depth = search -> depth - node -> level;
+        hash = zobrist_rows(node -> rows, BOT_ROWS) ^ DEPTH_KEY(entry.depth);
+
+        if ( self -> table -> probe(self -> table, hash, &entry) &&
+             entry.depth == search -> depth - node -> level )
+        {
+            node -> value = entry.value;
+            return;
+        }
+    }
+
+    // Every node is expanded at the root. Further down, only the beam
+    width = (node -> level == 0) ? MAX_PLACEMENTS : self -> beam;
+    (width < 1) ? width = 1 : 0;
+    (width > MAX_PLACEMENTS) ? width = MAX_PLACEMENTS : 0;
+
+    // Placements, their scores and the children, at once
+    size = ALIGNED(MAX_PLACEMENTS * sizeof (placement_t)) + \
+            ALIGNED(MAX_PLACEMENTS * sizeof (double)) + width * sizeof (node_t);
+    memory = reserve(size);
+
+    if ( memory == NULL )
+    {
+        fputs("Could not allocate memory for the BOT search.", stderr);
+        atomic_store(&search -> late, true);
+        return;
+    }
+
+    list = (placement_t *) memory;
+    scores = (double *) (memory + ALIGNED(MAX_PLACEMENTS *
+                                          sizeof (placement_t)));
+    children = (node_t *) ((unsigned char *) scores +
+                           ALIGNED(MAX_PLACEMENTS * sizeof (double)));
+
+    types = (node -> level < BOT_KNOWN &&
+             search -> pieces[node -> level] != TETROMINO_NONE) ? \
+            1 : TETROMINOS;
+
+    for ( type = 0; type < types; type++ )
+    {
+        if ( types == 1 )
+        {
+            n = (node -> level == 0) ? \
+                    search -> board -> ask.placements(search -> board,
+                                                      TETROMINO_NONE, list) :
+                    search -> board -> ask.placementsIn(search -> board,
+                                                        node -> rows,
+                                                        search -> pieces[
+                                                        node -> level], list);
+        }
+        else
+        {
+            n = search -> board -> ask.placementsIn(search -> board,
+                                                    node -> rows, type, list);
+        }
+
+        score(self, node -> rows, list, n, scores);
+
+        // Best placements, from the best one. Ties keep the first one
+        for ( i = k = 0; i < n; i++ )
+        {
+            if ( scores[i] == TOP_OUT ||
+                 (k == width && scores[i] <= scores[top[k - 1]]) )
+            {
+                continue;
+            }
+
+            // The worst one is dropped if there's no room
+            (k < width) ? k++ : 0;
+
+            for ( j = k - 1; j > 0 && scores[top[j - 1]] < scores[i]; j-- )
+            {
+                top[j] = top[j - 1];
+            }
+
+            top[j] = i;
+        }
+
+        best = TOP_OUT;
+
+        // Last piece searched
+        if ( node -> level + 1 == search -> depth )
+        {
+            (k > 0) ? best = scores[top[0]] : 0;
+        }
+        else
+        {
+            atomic_init(&pending, 0);
+
+            for ( i = 0; i < k; i++ )
+            {
+                children[i].search = search;
+                children[i].level = node -> level + 1;
+                children[i].gain = self -> weights.lines * \
+                        apply(node -> rows, &list[top[i]], children[i].rows);
+                children[i].value = TOP_OUT;
+
+                if ( self -> pool != NULL )
+                {
+                    self -> pool -> submit(self -> pool, &expand,
+                                           &children[i], &pending);
+                }
+                else
+                {
+                    expand(&children[i]);
+                }
+            }
+
+            if ( self -> pool != NULL )
+            {
+                self -> pool -> wait(self -> pool, &pending);
+            }
+
+            for ( i = 0, j = -1; i < k; i++ )
+            {
+                if ( j < 0 || children[i].gain + children[i].value > best )
+                {
+                    best = children[i].gain + children[i].value;
+                    j = i;
+                }
+            }
+
+            // The known moves after this one are the best child's
+            if ( j >= 0 )
+            {
+                memcpy(node -> moves, children[j].moves,
+                       sizeof (node -> moves));
+                top[0] = top[j];
+            }
+        }
+
+        // Even if every placement tops out, one is chosen
+        if ( types == 1 && n > 0 )
+        {
+            node -> moves[node -> level] = list[(k > 0) ? top[0] : 0];
+        }
+
+        value += best / types;
+    }
+
+    node -> value = value;
+
+    if ( hash != 0 && !atomic_load(&search -> late) )
+    {
+        entry.depth = search -> depth - node -> level;
+        entry.value = value;
+        entry.move = 0;
+
+        self -> table -> store(self -> table, hash, &entry);
+    }
+
+    release(memory, size);
+}
+
+/**
+ * @brief Features of the board left by a placement
+ * 
+ * @param self BOT structure from which this function is called
+ * @param rows Row masks of the board
+ * @param where Placement of the piece
+ * @param features Where the features are written
+ * 
+ * @return Nothing
+ */
+static void
+features (bot_t * self, const row_t rows[BOT_ROWS],
+          const placement_t * where, bot_features_t * features)
+{
+    prefix_t prefix[BOT_ROWS + 1] = {{0}};
+    int r;
+
+    (void) self;
+
+    for ( r = 0; r < BOT_ROWS; r++ )
+    {
+        prefix[r + 1] = prefix[r];
+        addRow(&prefix[r + 1], rows[r]);
+    }
+
+    fromPrefix(prefix, rows, where, features);
+}
+
+/**
+ * @brief Features of the board left by a placement, from the ones of the rows
+ * over it
+ * 
+ * Only the rows from the top of the piece down are walked.
+ * 
+ * @param prefix Features of the first r rows of the board in prefix[r]
+ * @param rows Row masks of the board
+ * @param where Placement of the piece
+ * @param features Where the features are written
+ * 
+ * @return Nothing
+ */
+static void
+fromPrefix (const prefix_t prefix[BOT_ROWS + 1], const row_t rows[BOT_ROWS],
+            const placement_t * where, bot_features_t * features)
+{
+    int i, r, top = BOT_ROWS, bottom = 0;
+    row_t piece[BOT_ROWS] = {0};
+    prefix_t walk;
+
+    // Rows of the piece
+    for ( i = b1; i < BLOCKS; i++ )
+    {
+        r = where -> cells[i][COORD_Y] + HIDDEN_ROWS;
+
+        piece[r] |= ROW_BIT(where -> cells[i][COORD_X]);
+        (r < top) ? top = r : 0;
+        (r > bottom) ? bottom = r : 0;
+    }
+
+    walk = prefix[top];
+
+    for ( r = top; r <= bottom; r++ )
+    {
+        addRow(&walk, rows[r] | piece[r]);
+    }
+
+    for ( ; r < BOT_ROWS; r++ )
+    {
+        addRow(&walk, rows[r]);
+    }
+
+    *features = walk.features;
+}
+
+/**
+ * @brief Best placements of the moving piece and the next one
+ * 
+ * @param self BOT structure from which this function is called
+ * @param board Board with the moving piece
+ * @param budget Time the search can take, in milliseconds
+ * @param moves Where the best placement of every known piece is written
+ * 
+ * @return Number of placements written in @p moves
+ */
+static int
+lookahead (bot_t * self, board_t * board, double budget,
+           placement_t moves[BOT_KNOWN])
+{
+    int depth, known, found = 0;
+    int cells[BLOCKS][COORD_NUM];
+    uint64_t deadline = monotonic_now();
+    const stats_t * stats = board -> ask.stats(board);
+    search_t search;
+    node_t root;
+
+    search.self = self;
+    search.board = board;
+    search.pieces[0] = board -> ask.piece(board, cells);
+    search.pieces[1] = stats -> piece.next;
+
+    if ( search.pieces[0] == TETROMINO_NONE )
+    {
+        return 0;
+    }
+
+    // Budgets of over 30 years never end
+    (budget > 1e12) ? deadline = UINT64_MAX :
+            (budget > 0) ? deadline += (uint64_t) (budget * 1000000) : 0;
+
+    // Without the next piece, only the moving one is known
+    known = (search.pieces[1] == TETROMINO_NONE) ? 1 : BOT_KNOWN;
+
+    for ( depth = 1; depth <= self -> depth && depth <= BOT_DEPTH; depth++ )
+    {
+        search.depth = depth;
+        atomic_init(&search.late, false);
+
+        // A single piece is always searched
+        search.deadline = (depth == 1) ? UINT64_MAX : deadline;
+
+        root.search = &search;
+        root.level = 0;
+        root.gain = 0;
+        root.value = TOP_OUT;
+        root.moves[0].orientation = -1;
+        memcpy(root.rows, board -> ask.rows(board), sizeof (root.rows));
+
+        expand(&root);
+
+        if ( atomic_load(&search.late) )
+        {
+            break;
+        }
+
+        // Nowhere to fix the piece
+        if ( root.moves[0].orientation < 0 )
+        {
+            return 0;
+        }
+
+        memcpy(moves, root.moves, sizeof (root.moves));
+        found = (depth < known) ? depth : known;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Create the key freeing the scratch memory of every thread
+ * 
+ * Called once, through scratchOnce.
+ * 
+ * @return Nothing
+ */
+static void
+newScratchKey (void)
+{
+    (pthread_key_create(&scratchKey, &free) != 0) ? \
+            fputs("Scratch memory of the BOT won't be freed.", stderr) : 0;
+}
+
+/**
+ * @brief Fix the moving piece where it scores best
+ * 
+ * @param self BOT structure from which this function is called
+ * @param board Board with the moving piece
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+static int
+play (bot_t * self, board_t * board)
+{
+    int i, n, best;
+    placement_t list[MAX_PLACEMENTS];
+    double scores[MAX_PLACEMENTS];
+
+    n = board -> ask.placements(board, TETROMINO_NONE, list);
+
+    if ( n == 0 )
+    {
+        return EXIT_FAILURE;
+    }
+
+    score(self, board -> ask.rows(board), list, n, scores);
+
+    for ( i = 1, best = 0; i < n; i++ )
+    {
+        (scores[i] > scores[best]) ? best = i : 0;
+    }
+
+    return board -> piece.place(board, &list[best]);
+}
+
+#ifndef __GNUC__
+
+/**
+ * @brief Number of bits set in a row mask
+ * 
+ * @param row Row mask
+ * 
+ * @return Number of bits set
+ */
+static int
+popcount (row_t row)
+{
+    int n;
+
+    // Clear the lowest bit set until there's none
+    for ( n = 0; row != 0; n++ )
+    {
+        row &= row - 1;
+    }
+
+    return n;
+}
+#endif
+
+/**
+ * @brief Give back the last memory taken with reserve()
+ * 
+ * @param memory Memory given by reserve()
+ * @param size Bytes given to reserve()
+ * 
+ * @return Nothing
+ */
+static void
+release (void * memory, size_t size)
+{
+    unsigned char * bytes = memory;
+
+    if ( scratch != NULL && bytes >= (unsigned char *) scratch -> memory &&
+         bytes < (unsigned char *) scratch -> memory + SCRATCH_SIZE )
+    {
+        scratch -> used -= ALIGNED(size);
+    }
+    else
+    {
+        free(memory);
+    }
+}
+
+/**
+ * @brief Take memory from the scratch of the calling thread
+ * 
+ * The scratch is allocated the first time, and freed when the thread exits.
+ * Memory is given back with release(), in the reverse order it was taken.
+ * When there's no room left, it's allocated instead.
+ * 
+ * @param size Bytes to take
+ * 
+ * @return Success: Memory aligned for any type
+ * @return Fail: NULL
+ */
+static void *
+reserve (size_t size)
+{
+    void * memory;
+
+    if ( scratch == NULL )
+    {
+        pthread_once(&scratchOnce, &newScratchKey);
+
+        scratch = malloc(sizeof (scratch_t));
+
+        if ( scratch == NULL )
+        {
+            return malloc(size);
+        }
+
+        scratch -> used = 0;
+        pthread_setspecific(scratchKey, scratch);
+    }
+
+    if ( scratch -> used + ALIGNED(size) > SCRATCH_SIZE )
+    {
+        return malloc(size);
+    }
+
+    memory = (unsigned char *) scratch -> memory + scratch -> used;
+    scratch -> used += ALIGNED(size);
+
+    return memory;
+}
+
+/**
+ * @brief Score many placements of a piece at once
+ * 
+ * @param self BOT structure from which this function is called
+ * @param rows Row masks of the board
+ * @param list Placements of the piece
+ * @param n Number of placements in @p list
+ * @param scores Where the score of every placement is written
+ * 
+ * @return Nothing
+ */
+static void
+score (bot_t * self, const row_t rows[BOT_ROWS],
+       const placement_t list[], int n, double scores[])
+{
+    int i, r;
+    prefix_t prefix[BOT_ROWS + 1] = {{0}};
+    bot_features_t current;
+
+    // Every placement shares the rows over it with the board
+    for ( r = 0; r < BOT_ROWS; r++ )
+    {
+        prefix[r + 1] = prefix[r];
+        addRow(&prefix[r + 1], rows[r]);
+    }
+
+    for ( i = 0; i < n; i++ )
+    {
+        fromPrefix(prefix, rows, &list[i], &current);
+
+        scores[i] = (current.top > BOARD_HEIGHT) ? \
+                TOP_OUT : weigh(self, &current);
+    }
+}
+
+/**
+ * @brief Set how many threads run lookahead()
+ * 
+ * @param self BOT structure from which this function is called
+ * @param n Threads, the one calling lookahead() included
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+static int
+threads (bot_t * self, int n)
+{
+    pool_free(self -> pool);
+    self -> pool = NULL;
+
+    // The caller works too, so one thread needs no pool
+    if ( n > 1 && (self -> pool = pool_create(n - 1)) == NULL )
+    {
+        fputs("Could not start the BOT threads.", stderr);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Score of a board with the given features
+ * 
+ * @param self BOT structure from which this function is called
+ * @param features Features of the board
+ * 
+ * @return Score. The higher, the better
+ */
+static double
+weigh (bot_t * self, const bot_features_t * features)
+{
+    return self -> weights.height * features -> height +
+            self -> weights.lines * features -> lines +
+            self -> weights.holes * features -> holes +
+            self -> weights.bumpiness * features -> bumpiness +
+            self -> weights.wells * features -> wells;
+}
@@ -0,0 +1,241 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ * 
+ * @file    bot.h
+ * 
+ * @brief   Headless player that chooses where to fix every piece.
+ * 
+ * Every place where the moving piece can be fixed is given a score from the
+ * board it would leave: its aggregate height, holes, bumpiness, wells and
+ * the lines it would clear. The piece is fixed in the best one.
+ * 
+ * Nothing but the board is needed, so it can play with no frontend.
+ * 
+ * lookahead() also searches every placement of the next piece for each one
+ * of the moving piece, spreading the work between the threads given with
+ * threads().
+ * 
+ * @note bot_init() <b>must</b> be called before accessing the structure.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 10:12
+ * 
+ * @copyright GNU General Public License v3
+ */
+
+#ifndef BOT_H
+#    define BOT_H 1
+
+// === Libraries and header files ===
+/// For bool, true and false
+#    include <stdbool.h>
+
+/// For board_t, placement_t and row_t
+#    include "../board/board.h"
+
+/// For pool_t
+#    include "pool.h"
+
+/// For ttable_t
+#    include "ttable.h"
+
+// === Constants and Macro definitions ===
+
+/**
+ * @def BOT_ROWS
+ * @brief Rows of the board given to the bot, hidden ones included
+ */
+#    define BOT_ROWS            (BOARD_HEIGHT + HIDDEN_ROWS)
+
+/**
+ * @def BOT_KNOWN
+ * @brief Pieces known when searching: the moving one and the next one
+ */
+#    define BOT_KNOWN           2
+
+/**
+ * @def BOT_DEPTH
+ * @brief Most pieces lookahead() can search, the moving one included
+ */
+#    define BOT_DEPTH           4
+
+// === Enumerations, structures and typedefs ===
+
+/**
+ * @brief Features of the board left by a placement, after clearing its lines
+ */
+typedef struct BOT_FEATURES
+{
+    /// Sum of the height of every column
+    int height;
+
+    /// Lines cleared
+    int lines;
+
+    /// Clear cells with a block over them
+    int holes;
+
+    /// Sum of the height difference between every two adjacent columns
+    int bumpiness;
+
+    /// Clear cells with blocks, or a wall, at both sides
+    int wells;
+
+    /// Height of the highest column
+    int top;
+} bot_features_t;
+
+/**
+ * @brief Bot object.
+ * 
+ * @warning Function bot_init() must be called before using this object
+ * 
+ * @headerfile bot.h
+ */
+typedef struct BOT
+{
+    /// Set to true when the bot is initialized.
+    bool init;
+
+    /// Weight of every feature in the score. Set to the defaults by bot_init()
+
+    struct
+    {
+        double height;
+        double lines;
+        double holes;
+        double bumpiness;
+        double wells;
+    } weights;
+
+    /// Pieces searched by lookahead(), from 1 to BOT_DEPTH. Past the next
+    /// piece, every tetromino is tried and their scores averaged
+    int depth;
+
+    /// Best placements of every piece searched further after the first one
+    int beam;
+
+    /// Threads running lookahead(). NULL to run it only from the caller
+    pool_t * pool;
+
+    /// Boards already searched by lookahead(), shared by its threads. NULL
+    /// to search them every time. Scores depend on the weights and beam, so
+    /// it must be cleared if they change. Not freed by the bot
+    ttable_t * table;
+
+    /**
+     * @brief Features of the board left by a placement
+     * 
+     * @param self Structure from which this function is called
+     * @param rows Row masks of the board, as given by ask.rows()
+     * @param where Placement of the piece, as given by ask.placements()
+     * @param features Where the features are written
+     * 
+     * @return Nothing
+     */
+    void (* features) (struct BOT * self, const row_t rows[BOT_ROWS],
+                       const placement_t * where, bot_features_t * features);
+
+    /**
+     * @brief Score many placements of a piece at once
+     * 
+     * The features of the rows over every placement are computed once for
+     * the whole batch. A placement that leaves blocks in the hidden rows
+     * has the lowest score possible.
+     * 
+     * @param self Structure from which this function is called
+     * @param rows Row masks of the board, as given by ask.rows()
+     * @param list Placements, as given by ask.placements()
+     * @param n Number of placements in @p list
+     * @param scores Where the score of every placement is written
+     * 
+     * @return Nothing
+     */
+    void (* score) (struct BOT * self, const row_t rows[BOT_ROWS],
+                    const placement_t list[], int n, double scores[]);
+
+    /**
+     * @brief Fix the moving piece where it scores best
+     * 
+     * @param self Structure from which this function is called
+     * @param board Board with the moving piece
+     * 
+     * @return Success: EXIT_SUCCESS
+     * @return Fail: EXIT_FAILURE if there's no moving piece or nowhere to
+     * fix it
+     */
+    int (* play) (struct BOT * self, board_t * board);
+
+    /**
+     * @brief Best placements of the moving piece and the next one
+     * 
+     * The search is repeated one piece deeper each time, up to depth pieces,
+     * and the deepest one finished within the budget is used. One piece is
+     * always searched, even with no budget left.
+     * 
+     * The board isn't changed. moves[0] can be given to piece.place() and,
+     * once the lines are cleared and the next piece appears, so can
+     * moves[1].
+     * 
+     * @param self Structure from which this function is called
+     * @param board Board with the moving piece
+     * @param budget Time the search can take, in milliseconds
+     * @param moves Where the best placement of every known piece is written
+     * 
+     * @return Number of placements written in @p moves. 0 if there's no
+     * moving piece or nowhere to fix it
+     */
+    int (* lookahead) (struct BOT * self, board_t * board, double budget,
+                       placement_t moves[BOT_KNOWN]);
+
+    /**
+     * @brief Set how many threads run lookahead()
+     * 
+     * @param self Structure from which this function is called
+     * @param n Threads, the one calling lookahead() included
+     * 
+     * @return Success: EXIT_SUCCESS
+     * @return Fail: EXIT_FAILURE. lookahead() runs only from the caller
+     */
+    int (* threads) (struct BOT * self, int n);
+
+    /**
+     * @brief Destroy the bot, stopping its threads
+     * 
+     * @param self Structure from which this function is called
+     * 
+     * @return Nothing
+     */
+    void (* destroy) (struct BOT * self);
+
+} bot_t;
+
+// === Global variables ===
+
+// === ROM Constant variables ===
+
+// === Global function definitions ===
+
+// Initialize a bot with the default weights
+int
+bot_init (bot_t * self);
+
+#endif /* BOT_H */
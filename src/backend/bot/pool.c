@@ -0,0 +1,587 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/******************************************************************************
+ * 
+ * @file    pool.c
+ * 
+ * @brief   Work-stealing pool of threads.
+ * 
+ * @details Every queue is a ring with its own lock. Its owner pushes and
+ * takes tasks from the bottom, while other threads steal from the top. There's
+ * one more queue for the threads out of the pool.
+ * 
+ * Threads with nothing to steal sleep until a task is queued.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 13:40
+ * 
+ * @copyright GNU General Public License v3
+ *****************************************************************************/
+
+// === Libraries and header files ===
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>      // For sched_yield
+
+// This file
+#include "pool.h"
+
+/// @privatesection
+// === Constants and Macro definitions ===
+
+/**
+ * @def PRIVATE(p)
+ * @brief Returns the private structure of the pool_t (p)
+ */
+#define PRIVATE(p)      ((pool_private_t *) (p))
+
+/**
+ * @def OUTSIDE(p)
+ * @brief Queue of the threads out of the pool (p)
+ */
+#define OUTSIDE(p)      (&(p) -> queues[(p) -> public.threads])
+
+// === Enumerations, structures and typedefs ===
+
+/**
+ * @brief Queued task
+ */
+typedef struct POOL_TASK
+{
+    /// Function to run
+    void (* run) (void * arg);
+
+    /// Argument given to run
+    void * arg;
+
+    /// Counter decremented after running it
+    atomic_int * pending;
+} task_t;
+
+/**
+ * @brief Queue of tasks of a thread
+ */
+typedef struct POOL_QUEUE
+{
+    pthread_mutex_t lock;
+
+    /// Ring with the tasks
+    task_t tasks[POOL_TASKS];
+
+    /// Next task to steal
+    unsigned int top;
+
+    /// Where the next task is pushed
+    unsigned int bottom;
+} queue_t;
+
+/**
+ * @brief Private structure of a pool
+ */
+typedef struct POOL_PRIVATE
+{
+    /// Public structure. Must be the first member
+    pool_t public;
+
+    /// Threads of the pool
+    pthread_t * threads;
+
+    /// Argument of every thread
+    struct POOL_WORKER * workers;
+
+    /// Threads started
+    int started;
+
+    /// Queue of every thread, plus one for the ones out of the pool
+    queue_t * queues;
+
+    /// Tasks queued and not taken yet, in every queue
+    atomic_int queued;
+
+    /// Set to stop the threads
+    atomic_bool quit;
+
+    /// Lock and condition where threads sleep until there's a task
+    pthread_mutex_t sleep;
+    pthread_cond_t wake;
+} pool_private_t;
+
+/**
+ * @brief Argument of every thread of the pool
+ */
+typedef struct POOL_WORKER
+{
+    pool_private_t * pool;
+    int id;
+} worker_t;
+
+// === Global variables ===
+
+// === Function prototypes for private functions with file level scope ===
+
+// Free everything a pool holds
+static void
+destroy (pool_private_t * pStruct);
+
+// Queue the calling thread pushes to
+static queue_t *
+ownQueue (pool_private_t * pStruct);
+
+// Push a task to the bottom of a queue
+static bool
+push (pool_private_t * pStruct, queue_t * queue, const task_t * task);
+
+// Take the newest task of a queue
+static bool
+pop (pool_private_t * pStruct, queue_t * queue, task_t * task);
+
+// Run a task and count it as done
+static void
+run (const task_t * task);
+
+// Take the oldest task of a queue
+static bool
+steal (pool_private_t * pStruct, queue_t * queue, task_t * task);
+
+// Queue a task
+static void
+submit (pool_t * self, void (* task) (void * arg), void * arg,
+        atomic_int * pending);
+
+// Take a task from the calling thread's queue or any other
+static bool
+take (pool_private_t * pStruct, task_t * task);
+
+// Run queued tasks until there's no one pending in a counter
+static void
+waitTasks (pool_t * self, atomic_int * pending);
+
+// Loop of every thread of the pool
+static void *
+work (void * arg);
+
+// === ROM Constant variables with file level scope ===
+
+// === Static variables and constant variables with file level scope ===
+
+/// Pool of the calling thread, if it's part of one
+static _Thread_local pool_private_t * currentPool = NULL;
+
+/// Queue of the calling thread in currentPool
+static _Thread_local int currentId = -1;
+
+// === Global function definitions ===
+/// @publicsection
+
+/**
+ * @brief Create a pool of threads
+ * 
+ * @param threads Threads to start. With 0, tasks are run by wait()
+ * 
+ * @return Success: Pointer to the new pool
+ * @return Fail: NULL
+ */
+pool_t *
+pool_create (int threads)
+{
+    int i;
+    pool_private_t * pStruct;
+
+    if ( threads < 0 )
+    {
+        fputs("Invalid number of threads for the POOL.", stderr);
+        return NULL;
+    }
+
+    pStruct = calloc(1, sizeof (pool_private_t));
+
+    if ( pStruct == NULL )
+    {
+        fputs("Could not allocate memory for the POOL.", stderr);
+        return NULL;
+    }
+
+    // Hold as uninitialized until every thread is running
+    pStruct -> public.init = false;
+    pStruct -> public.threads = threads;
+
+    atomic_init(&pStruct -> queued, 0);
+    atomic_init(&pStruct -> quit, false);
+    pthread_mutex_init(&pStruct -> sleep, NULL);
+    pthread_cond_init(&pStruct -> wake, NULL);
+
+    pStruct -> threads = calloc(threads + 1, sizeof (pthread_t));
+    pStruct -> workers = calloc(threads + 1, sizeof (worker_t));
+    pStruct -> queues = calloc(threads + 1, sizeof (queue_t));
+
+    if ( pStruct -> threads == NULL || pStruct -> workers == NULL ||
+         pStruct -> queues == NULL )
+    {
+        fputs("Could not allocate memory for the POOL.", stderr);
+        destroy(pStruct);
+        return NULL;
+    }
+
+    for ( i = 0; i <= threads; i++ )
+    {
+        pthread_mutex_init(&pStruct -> queues[i].lock, NULL);
+    }
+
+    pStruct -> public.submit = &submit;
+    pStruct -> public.wait = &waitTasks;
+
+    for ( i = 0; i < threads; i++ )
+    {
+        pStruct -> workers[i].pool = pStruct;
+        pStruct -> workers[i].id = i;
+
+        if ( pthread_create(&pStruct -> threads[i], NULL, &work,
+                            &pStruct -> workers[i]) )
+        {
+            fputs("Could not start a thread of the POOL.", stderr);
+            destroy(pStruct);
+            return NULL;
+        }
+
+        pStruct -> started++;
+    }
+
+    pStruct -> public.init = true;
+
+    return &pStruct -> public;
+}
+
+/**
+ * @brief Free a pool created with pool_create()
+ * 
+ * Waits for every thread to finish the task it's running. Queued tasks are
+ * not run.
+ * 
+ * @param self Pool to free. Can be NULL
+ * 
+ * @return Nothing
+ */
+void
+pool_free (pool_t * self)
+{
+    if ( self != NULL )
+    {
+        destroy(PRIVATE(self));
+    }
+}
+
+/// @privatesection
+// === Local function definitions ===
+
+/**
+ * @brief Free everything a pool holds
+ * 
+ * @param pStruct Private structure of the pool
+ * 
+ * @return Nothing
+ */
+static void
+destroy (pool_private_t * pStruct)
+{
+    int i;
+
+    pthread_mutex_lock(&pStruct -> sleep);
+    atomic_store(&pStruct -> quit, true);
+    pthread_cond_broadcast(&pStruct -> wake);
+    pthread_mutex_unlock(&pStruct -> sleep);
+
+    for ( i = 0; i < pStruct -> started; i++ )
+    {
+        pthread_join(pStruct -> threads[i], NULL);
+    }
+
+    if ( pStruct -> queues != NULL )
+    {
+        for ( i = 0; i <= pStruct -> public.threads; i++ )
+        {
+            pthread_mutex_destroy(&pStruct -> queues[i].lock);
+        }
+    }
+
+    pthread_mutex_destroy(&pStruct -> sleep);
+    pthread_cond_destroy(&pStruct -> wake);
+
+    pStruct -> public.init = false;
+    pStruct -> public.submit = NULL;
+    pStruct -> public.wait = NULL;
+
+    free(pStruct -> threads);
+    free(pStruct -> workers);
+    free(pStruct -> queues);
+    free(pStruct);
+}
+
+/**
+ * @brief Queue the calling thread pushes to
+ * 
+ * @param pStruct Private structure of the pool
+ * 
+ * @return Its own queue for a thread of the pool, the shared one otherwise
+ */
+static queue_t *
+ownQueue (pool_private_t * pStruct)
+{
+    return (currentPool == pStruct) ? \
+            &pStruct -> queues[currentId] : OUTSIDE(pStruct);
+}
+
+/**
+ * @brief Push a task to the bottom of a queue
+ * 
+ * @param pStruct Private structure of the pool
+ * @param queue Queue to push to
+ * @param task Task to push
+ * 
+ * @return True if it was queued, false if the queue is full
+ */
+static bool
+push (pool_private_t * pStruct, queue_t * queue, const task_t * task)
+{
+    bool queued = false;
+
+    pthread_mutex_lock(&queue -> lock);
+
+    if ( queue -> bottom - queue -> top < POOL_TASKS )
+    {
+        queue -> tasks[queue -> bottom % POOL_TASKS] = *task;
+        queue -> bottom++;
+        queued = true;
+    }
+
+    pthread_mutex_unlock(&queue -> lock);
+
+    if ( queued )
+    {
+        atomic_fetch_add(&pStruct -> queued, 1);
+
+        // Sleeping threads check the counter with this lock held
+        pthread_mutex_lock(&pStruct -> sleep);
+        pthread_cond_signal(&pStruct -> wake);
+        pthread_mutex_unlock(&pStruct -> sleep);
+    }
+
+    return queued;
+}
+
+/**
+ * @brief Take the newest task of a queue
+ * 
+ * @param pStruct Private structure of the pool
+ * @param queue Queue to take from
+ * @param task Where the task is written
+ * 
+ * @return True if a task was taken
+ */
+static bool
+pop (pool_private_t * pStruct, queue_t * queue, task_t * task)
+{
+    bool taken = false;
+
+    pthread_mutex_lock(&queue -> lock);
+
+    if ( queue -> bottom != queue -> top )
+    {
+        queue -> bottom--;
+        *task = queue -> tasks[queue -> bottom % POOL_TASKS];
+        taken = true;
+    }
+
+    pthread_mutex_unlock(&queue -> lock);
+
+    (taken) ? atomic_fetch_sub(&pStruct -> queued, 1) : 0;
+
+    return taken;
+}
+
+/**
+ * @brief Run a task and count it as done
+ * 
+ * @param task Task to run
+ * 
+ * @return Nothing
+ */
+static void
+run (const task_t * task)
+{
+    task -> run(task -> arg);
+    atomic_fetch_sub(task -> pending, 1);
+}
+
+/**
+ * @brief Take the oldest task of a queue
+ * 
+ * @param pStruct Private structure of the pool
+ * @param queue Queue to take from
+ * @param task Where the task is written
+ * 
+ * @return True if a task was taken
+ */
+static bool
+steal (pool_private_t * pStruct, queue_t * queue, task_t * task)
+{
+    bool taken = false;
+
+    pthread_mutex_lock(&queue -> lock);
+
+    if ( queue -> bottom != queue -> top )
+    {
+        *task = queue -> tasks[queue -> top % POOL_TASKS];
+        queue -> top++;
+        taken = true;
+    }
+
+    pthread_mutex_unlock(&queue -> lock);
+
+    (taken) ? atomic_fetch_sub(&pStruct -> queued, 1) : 0;
+
+    return taken;
+}
+
+/**
+ * @brief Queue a task
+ * 
+ * @param self POOL structure from which this function is called
+ * @param task Function to run
+ * @param arg Argument given to @p task
+ * @param pending Counter of pending tasks
+ * 
+ * @return Nothing
+ */
+static void
+submit (pool_t * self, void (* task) (void * arg), void * arg,
+        atomic_int * pending)
+{
+    pool_private_t * pStruct = PRIVATE(self);
+    task_t new = {task, arg, pending};
+
+    atomic_fetch_add(pending, 1);
+
+    // No room left, so it's run by whoever submits it
+    if ( !push(pStruct, ownQueue(pStruct), &new) )
+    {
+        run(&new);
+    }
+}
+
+/**
+ * @brief Take a task from the calling thread's queue or any other
+ * 
+ * @param pStruct Private structure of the pool
+ * @param task Where the task is written
+ * 
+ * @return True if a task was taken
+ */
+static bool
+take (pool_private_t * pStruct, task_t * task)
+{
+    int i, n = pStruct -> public.threads + 1;
+    int first = (currentPool == pStruct) ? currentId : n - 1;
+
+    if ( pop(pStruct, &pStruct -> queues[first], task) )
+    {
+        return true;
+    }
+
+    // Start from the next one, so not every thread steals from the same
+    for ( i = 1; i < n; i++ )
+    {
+        if ( steal(pStruct, &pStruct -> queues[(first + i) % n], task) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Run queued tasks until there's no one pending in a counter
+ * 
+ * @param self POOL structure from which this function is called
+ * @param pending Counter given to submit()
+ * 
+ * @return Nothing
+ */
+static void
+waitTasks (pool_t * self, atomic_int * pending)
+{
+    task_t task;
+    pool_private_t * pStruct = PRIVATE(self);
+
+    while ( atomic_load(pending) > 0 )
+    {
+        if ( take(pStruct, &task) )
+        {
+            run(&task);
+        }
+        else
+        {
+            // Tasks still pending are being run by other threads
+            sched_yield();
+        }
+    }
+}
+
+/**
+ * @brief Loop of every thread of the pool
+ * 
+ * @param arg worker_t with the pool and the thread's queue
+ * 
+ * @return NULL
+ */
+static void *
+work (void * arg)
+{
+    task_t task;
+    worker_t * worker = arg;
+    pool_private_t * pStruct = worker -> pool;
+
+    currentPool = pStruct;
+    currentId = worker -> id;
+
+    while ( !atomic_load(&pStruct -> quit) )
+    {
+        if ( take(pStruct, &task) )
+        {
+            run(&task);
+            continue;
+        }
+
+        pthread_mutex_lock(&pStruct -> sleep);
+
+        while ( atomic_load(&pStruct -> queued) == 0 &&
+                !atomic_load(&pStruct -> quit) )
+        {
+            pthread_cond_wait(&pStruct -> wake, &pStruct -> sleep);
+        }
+
+        pthread_mutex_unlock(&pStruct -> sleep);
+    }
+
+    return NULL;
+}
@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ * 
+ * @file    pool.h
+ * 
+ * @brief   Work-stealing pool of threads.
+ * 
+ * Every thread of the pool has its own queue of tasks. Tasks submitted from
+ * a task go to the queue of the thread running it, which takes the newest
+ * one first. A thread with nothing to do takes the oldest task of another
+ * thread, so big batches of work end up spread between all of them.
+ * 
+ * A counter of pending tasks is given with every task, and wait() runs tasks
+ * until it reaches 0. Tasks can wait for the tasks they submit, and the
+ * thread calling wait() works too, so a pool with no threads runs everything
+ * from wait().
+ * 
+ * @note pool_create() <b>must</b> be called to get a pool, and pool_free()
+ * to free it.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 13:40
+ * 
+ * @copyright GNU General Public License v3
+ */
+
+#ifndef POOL_H
+#    define POOL_H 1
+
+// === Libraries and header files ===
+/// For bool, true and false
+#    include <stdbool.h>
+
+/// For atomic_int
+#    include <stdatomic.h>
+
+// === Constants and Macro definitions ===
+
+/**
+ * @def POOL_TASKS
+ * @brief Tasks that fit in the queue of every thread. If it's full, a
+ * submitted task is run at once
+ */
+#    define POOL_TASKS          1024
+
+// === Enumerations, structures and typedefs ===
+
+/**
+ * @brief Pool object.
+ * 
+ * @warning Must be created with pool_create() and freed with pool_free().
+ * 
+ * @headerfile pool.h
+ */
+typedef struct POOL
+{
+    /// Set to true when the pool is initialized.
+    bool init;
+
+    /// Threads of the pool, not counting the one calling wait()
+    int threads;
+
+    /**
+     * @brief Queue a task
+     * 
+     * @param self Structure from which this function is called
+     * @param task Function to run
+     * @param arg Argument given to @p task
+     * @param pending Counter of pending tasks. Incremented now and
+     * decremented when @p task returns
+     * 
+     * @return Nothing
+     */
+    void (* submit) (struct POOL * self, void (* task) (void * arg),
+                     void * arg, atomic_int * pending);
+
+    /**
+     * @brief Run queued tasks until there's no one pending in a counter
+     * 
+     * @param self Structure from which this function is called
+     * @param pending Counter given to submit()
+     * 
+     * @return Nothing
+     */
+    void (* wait) (struct POOL * self, atomic_int * pending);
+} pool_t;
+
+// === Global variables ===
+
+// === ROM Constant variables ===
+
+// === Global function definitions ===
+
+// Create a pool of threads
+pool_t *
+pool_create (int threads);
+
+// Free a pool created with pool_create()
+void
+pool_free (pool_t * self);
+
+#endif /* POOL_H */
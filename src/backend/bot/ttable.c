@@ -0,0 +1,287 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/******************************************************************************
+ * 
+ * @file    ttable.c
+ * 
+ * @brief   Transposition table: scores of positions already searched.
+ * 
+ * @details Every slot is three 64 bits words: the value, the depth and move
+ * packed in another one, and the XOR of both with the hash. A reader checks
+ * the XOR against the hash it looks for, so a slot half written by another
+ * thread (or holding another position) fails the check and is a miss.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 16:05
+ * 
+ * @see https://www.cis.uab.edu/hyatt/hashing.html
+ * 
+ * @copyright GNU General Public License v3
+ *****************************************************************************/
+
+// === Libraries and header files ===
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>     // For memcpy
+#include <stdatomic.h>
+
+// This file
+#include "ttable.h"
+
+/// @privatesection
+// === Constants and Macro definitions ===
+
+/**
+ * @def PRIVATE(t)
+ * @brief Returns the private structure of the ttable_t (t)
+ */
+#define PRIVATE(t)      ((ttable_private_t *) (t))
+
+/**
+ * @def USED
+ * @brief Set in the packed depth and move of every stored entry
+ */
+#define USED            ((uint64_t) 1 << 63)
+
+/**
+ * @def PACK(d,m)
+ * @brief Depth (d) and move (m) in a single word
+ */
+#define PACK(d,m)       (USED | ((uint64_t) ((d) & 0xFF) << 16) | \
+                         (uint64_t) ((m) & 0xFFFF))
+
+/**
+ * @def DEPTH(p)
+ * @brief Depth of a packed word (p)
+ */
+#define DEPTH(p)        ((int) (((p) >> 16) & 0xFF))
+
+/**
+ * @def MOVE(p)
+ * @brief Move of a packed word (p)
+ */
+#define MOVE(p)         ((int) ((p) & 0xFFFF))
+
+// === Enumerations, structures and typedefs ===
+
+/**
+ * @brief Slot of the table
+ */
+typedef struct TTABLE_SLOT
+{
+    /// Hash XOR value XOR packed
+    _Atomic uint64_t check;
+
+    /// Bits of the value
+    _Atomic uint64_t value;
+
+    /// Depth and move, packed
+    _Atomic uint64_t packed;
+} slot_t;
+
+/**
+ * @brief Private structure of a table
+ */
+typedef struct TTABLE_PRIVATE
+{
+    /// Public structure. Must be the first member
+    ttable_t public;
+
+    /// Slots
+    slot_t * slots;
+} ttable_private_t;
+
+// === Global variables ===
+
+// === Function prototypes for private functions with file level scope ===
+
+// Remove every position
+static void
+clear (ttable_t * self);
+
+// Look up a position
+static bool
+probe (ttable_t * self, uint64_t hash, tt_entry_t * entry);
+
+// Store a position
+static void
+store (ttable_t * self, uint64_t hash, const tt_entry_t * entry);
+
+// === ROM Constant variables with file level scope ===
+
+// === Static variables and constant variables with file level scope ===
+
+// === Global function definitions ===
+/// @publicsection
+
+/**
+ * @brief Create a transposition table
+ * 
+ * @param slots Positions it can hold. Rounded down to a power of 2
+ * 
+ * @return Success: Pointer to the new table
+ * @return Fail: NULL
+ */
+ttable_t *
+ttable_create (size_t slots)
+{
+    size_t size = 1;
+    ttable_private_t * tStruct;
+
+    if ( slots == 0 )
+    {
+        fputs("Invalid size for the TTABLE.", stderr);
+        return NULL;
+    }
+
+    while ( size <= slots / 2 )
+    {
+        size *= 2;
+    }
+
+    tStruct = calloc(1, sizeof (ttable_private_t));
+
+    if ( tStruct == NULL ||
+         (tStruct -> slots = calloc(size, sizeof (slot_t))) == NULL )
+    {
+        fputs("Could not allocate memory for the TTABLE.", stderr);
+        free(tStruct);
+        return NULL;
+    }
+
+    tStruct -> public.size = size;
+
+    tStruct -> public.probe = &probe;
+    tStruct -> public.store = &store;
+    tStruct -> public.clear = &clear;
+
+    tStruct -> public.init = true;
+
+    return &tStruct -> public;
+}
+
+/**
+ * @brief Free a table created with ttable_create()
+ * 
+ * @param self Table to free. Can be NULL
+ * 
+ * @return Nothing
+ */
+void
+ttable_free (ttable_t * self)
+{
+    if ( self != NULL )
+    {
+        self -> init = false;
+        self -> probe = NULL;
+        self -> store = NULL;
+        self -> clear = NULL;
+
+        free(PRIVATE(self) -> slots);
+        free(PRIVATE(self));
+    }
+}
+
+/// @privatesection
+// === Local function definitions ===
+
+/**
+ * @brief Remove every position
+ * 
+ * @param self TTABLE structure from which this function is called
+ * 
+ * @return Nothing
+ */
+static void
+clear (ttable_t * self)
+{
+    size_t i;
+    slot_t * slots = PRIVATE(self) -> slots;
+
+    for ( i = 0; i < self -> size; i++ )
+    {
+        atomic_store_explicit(&slots[i].check, 0, memory_order_relaxed);
+        atomic_store_explicit(&slots[i].value, 0, memory_order_relaxed);
+        atomic_store_explicit(&slots[i].packed, 0, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Look up a position
+ * 
+ * @param self TTABLE structure from which this function is called
+ * @param hash Hash of the position
+ * @param entry Where the position is written if it's found
+ * 
+ * @return True if it was found
+ */
+static bool
+probe (ttable_t * self, uint64_t hash, tt_entry_t * entry)
+{
+    slot_t * slot = &PRIVATE(self) -> slots[hash & (self -> size - 1)];
+    uint64_t value, packed, check;
+
+    value = atomic_load_explicit(&slot -> value, memory_order_relaxed);
+    packed = atomic_load_explicit(&slot -> packed, memory_order_relaxed);
+    check = atomic_load_explicit(&slot -> check, memory_order_relaxed);
+
+    if ( !(packed & USED) || (check ^ value ^ packed) != hash )
+    {
+        return false;
+    }
+
+    memcpy(&entry -> value, &value, sizeof (double));
+    entry -> depth = DEPTH(packed);
+    entry -> move = MOVE(packed);
+
+    return true;
+}
+
+/**
+ * @brief Store a position
+ * 
+ * @param self TTABLE structure from which this function is called
+ * @param hash Hash of the position
+ * @param entry Position to store
+ * 
+ * @return Nothing
+ */
+static void
+store (ttable_t * self, uint64_t hash, const tt_entry_t * entry)
+{
+    slot_t * slot = &PRIVATE(self) -> slots[hash & (self -> size - 1)];
+    uint64_t value, packed = PACK(entry -> depth, entry -> move);
+    tt_entry_t old;
+
+    // A deeper search of the same position is kept
+    if ( probe(self, hash, &old) && old.depth > entry -> depth )
+    {
+        return;
+    }
+
+    memcpy(&value, &entry -> value, sizeof (double));
+
+    atomic_store_explicit(&slot -> value, value, memory_order_relaxed);
+    atomic_store_explicit(&slot -> packed, packed, memory_order_relaxed);
+    atomic_store_explicit(&slot -> check, hash ^ value ^ packed,
+                          memory_order_relaxed);
+}
@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ * 
+ * @file    ttable.h
+ * 
+ * @brief   Transposition table: scores of positions already searched.
+ * 
+ * Positions are looked up by their Zobrist hash (see ask.hash() and
+ * zobrist.h). The table has a fixed size and every hash has a single slot,
+ * where the last position stored is kept unless the one in it was searched
+ * deeper.
+ * 
+ * No lock is taken, so many threads can look up and store positions at
+ * once. An entry written while it's read is not mistaken for another: it's
+ * just not found.
+ * 
+ * @note ttable_create() <b>must</b> be called to get a table, and
+ * ttable_free() to free it.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 16:05
+ * 
+ * @copyright GNU General Public License v3
+ */
+
+#ifndef TTABLE_H
+#    define TTABLE_H 1
+
+// === Libraries and header files ===
+/// For bool, true and false
+#    include <stdbool.h>
+
+/// For size_t
+#    include <stddef.h>
+
+/// For uint64_t
+#    include <stdint.h>
+
+// === Constants and Macro definitions ===
+
+// === Enumerations, structures and typedefs ===
+
+/**
+ * @brief What's kept of a position
+ */
+typedef struct TTABLE_ENTRY
+{
+    /// Score of the position
+    double value;
+
+    /// How deep it was searched. From 0 to 255
+    int depth;
+
+    /// Best move found from it, if any. From 0 to 65535
+    int move;
+} tt_entry_t;
+
+/**
+ * @brief Transposition table object.
+ * 
+ * @warning Must be created with ttable_create() and freed with ttable_free().
+ * 
+ * @headerfile ttable.h
+ */
+typedef struct TTABLE
+{
+    /// Set to true when the table is initialized.
+    bool init;
+
+    /// Number of slots. Always a power of 2
+    size_t size;
+
+    /**
+     * @brief Look up a position
+     * 
+     * @param self Structure from which this function is called
+     * @param hash Hash of the position
+     * @param entry Where the position is written if it's found
+     * 
+     * @return True if it was found
+     */
+    bool (* probe) (struct TTABLE * self, uint64_t hash, tt_entry_t * entry);
+
+    /**
+     * @brief Store a position
+     * 
+     * The position in its slot is replaced, unless it's the same one and it
+     * was searched deeper.
+     * 
+     * @param self Structure from which this function is called
+     * @param hash Hash of the position
+     * @param entry Position to store
+     * 
+     * @return Nothing
+     */
+    void (* store) (struct TTABLE * self, uint64_t hash,
+                    const tt_entry_t * entry);
+
+    /**
+     * @brief Remove every position
+     * 
+     * @warning No other thread can use the table meanwhile.
+     * 
+     * @param self Structure from which this function is called
+     * 
+     * @return Nothing
+     */
+    void (* clear) (struct TTABLE * self);
+} ttable_t;
+
+// === Global variables ===
+
+// === ROM Constant variables ===
+
+// === Global function definitions ===
+
+// Create a transposition table
+ttable_t *
+ttable_create (size_t slots);
+
+// Free a table created with ttable_create()
+void
+ttable_free (ttable_t * self);
+
+#endif /* TTABLE_H */
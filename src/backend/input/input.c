@@ -0,0 +1,440 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/******************************************************************************
+ * 
+ * @file    input.c
+ * 
+ * @brief   Timestamped player input, with delayed auto shift and auto repeat.
+ * 
+ * @details Events are kept in a single producer, single consumer ring. The
+ * producer only writes the tail and the consumer only writes the head, so
+ * they're published with release and acquire orders and no lock.
+ * 
+ * Every held action that repeats keeps when it's due next. next() gives the
+ * earliest of that and the oldest queued event, so a key released between
+ * two repeats stops them right there.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 12:40
+ * 
+ * @copyright GNU General Public License v3
+ *****************************************************************************/
+
+// === Libraries and header files ===
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+// This file
+#include "input.h"
+
+/// @privatesection
+// === Constants and Macro definitions ===
+
+/**
+ * @def PRIVATE(p)
+ * @brief Returns the private structure of the input_t (p)
+ */
+#define PRIVATE(p)      ((input_private_t *) (p))
+
+/**
+ * @def SLOT(i)
+ * @brief Slot of the queue of the event number @p i
+ */
+#define SLOT(i)         ((i) & (INPUT_QUEUE - 1))
+
+/**
+ * @def NOT_DUE
+ * @brief Due time of an action that doesn't repeat
+ */
+#define NOT_DUE         UINT64_MAX
+
+// === Enumerations, structures and typedefs ===
+
+/**
+ * @brief An action pressed or released
+ */
+typedef struct INPUT_EVENT
+{
+    /// When it happened, in ns
+    uint64_t t;
+
+    /// One of inputActions enum
+    int action;
+
+    /// Pressed or released
+    bool pressed;
+} input_event_t;
+
+/**
+ * @brief Private structure of an input
+ */
+typedef struct INPUT_PRIVATE
+{
+    /// Public structure. Must be the first member
+    input_t public;
+
+    /// Events pushed and not taken yet
+    input_event_t queue[INPUT_QUEUE];
+
+    /// Next event to take. Written only by the consumer
+    atomic_uint_fast32_t head;
+
+    /// Next event to push. Written only by the producer
+    atomic_uint_fast32_t tail;
+
+    /// Delayed auto shift and auto repeat rate, in ns
+    uint64_t das;
+    uint64_t arr;
+
+    /// When every held action repeats next. NOT_DUE if it doesn't
+    uint64_t due[INPUT_ACTIONS];
+
+    /// When the last action taken happened
+    uint64_t taken;
+} input_private_t;
+
+// === Global variables ===
+
+// === Function prototypes for private functions with file level scope ===
+
+// Earliest action that repeats, and when
+static int
+earliest (input_private_t * iStruct, uint64_t * t);
+
+// Take the next action due
+static int
+next (input_t * self, uint64_t now);
+
+// Oldest event queued, if there's one
+static bool
+peek (input_private_t * iStruct, input_event_t * event);
+
+// Push that an action was pressed or released
+static int
+push (input_t * self, int action, bool pressed, uint64_t t);
+
+// Release every action and drop the queued events
+static void
+release (input_t * self);
+
+// Time left until the next action is due
+static int64_t
+timeLeft (input_t * self, uint64_t now);
+
+// When the last action taken happened
+static uint64_t
+when (input_t * self);
+
+// === ROM Constant variables with file level scope ===
+
+// === Static variables and constant variables with file level scope ===
+
+// === Global function definitions ===
+/// @publicsection
+
+/**
+ * @brief Create an input
+ * 
+ * @param das Milliseconds a shift is held before it repeats. INPUT_DAS if
+ * it's negative
+ * @param arr Milliseconds between repeats. INPUT_ARR if it's not positive
+ * 
+ * @return Success: Pointer to the input
+ * @return Fail: NULL
+ */
+input_t *
+input_create (int das, int arr)
+{
+    int i;
+    input_private_t * iStruct = calloc(1, sizeof (input_private_t));
+
+    if ( iStruct == NULL )
+    {
+        fputs("Could not allocate memory for the INPUT.", stderr);
+        return NULL;
+    }
+
+    iStruct -> das = (das < 0) ? INPUT_NS(INPUT_DAS) : INPUT_NS(das);
+    iStruct -> arr = (arr <= 0) ? INPUT_NS(INPUT_ARR) : INPUT_NS(arr);
+
+    for ( i = 0; i < INPUT_ACTIONS; i++ )
+    {
+        iStruct -> due[i] = NOT_DUE;
+    }
+
+    atomic_init(&iStruct -> head, 0);
+    atomic_init(&iStruct -> tail, 0);
+
+    iStruct -> public.push = &push;
+    iStruct -> public.next = &next;
+    iStruct -> public.timeLeft = &timeLeft;
+    iStruct -> public.release = &release;
+    iStruct -> public.when = &when;
+    iStruct -> public.init = true;
+
+    return &iStruct -> public;
+}
+
+/**
+ * @brief Free an input
+ * 
+ * @param self Input to free. Can be NULL
+ * 
+ * @return Nothing
+ */
+void
+input_free (input_t * self)
+{
+    free(PRIVATE(self));
+}
+
+/// @privatesection
+// === Local function definitions ===
+
+/**
+ * @brief Earliest action that repeats, and when
+ * 
+ * @param iStruct Input
+ * @param t Where its due time is written. NOT_DUE if there's none
+ * 
+ * @return One of inputActions enum. INPUT_NONE if no action repeats
+ */
+static int
+earliest (input_private_t * iStruct, uint64_t * t)
+{
+    int i, action = INPUT_NONE;
+
+    *t = NOT_DUE;
+
+    for ( i = 0; i < INPUT_ACTIONS; i++ )
+    {
+        if ( iStruct -> due[i] < *t )
+        {
+            *t = iStruct -> due[i];
+            action = i;
+        }
+    }
+
+    return action;
+}
+
+/**
+ * @brief Take the next action due
+ * 
+ * Releases are taken without giving an action, so the loop goes on until
+ * something is pressed or repeats.
+ * 
+ * @param self Structure from which this function is called
+ * @param now Current time, in ns of the monotonic clock
+ * 
+ * @return One of inputActions enum. INPUT_NONE if there's none due
+ */
+static int
+next (input_t * self, uint64_t now)
+{
+    input_private_t * iStruct = PRIVATE(self);
+    input_event_t event;
+    uint64_t repeat;
+    int action;
+
+    while ( true )
+    {
+        action = earliest(iStruct, &repeat);
+
+        // An event happened first, or at the same time
+        if ( peek(iStruct, &event) && event.t <= now && event.t <= repeat )
+        {
+            atomic_store_explicit(&iStruct -> head,
+                                  atomic_load_explicit(&iStruct -> head,
+                                                       memory_order_relaxed)
+                                  + 1, memory_order_release);
+
+            if ( event.pressed == false )
+            {
+                iStruct -> due[event.action] = NOT_DUE;
+                continue;
+            }
+
+            switch ( event.action )
+            {
+                    // The last direction pressed is the one that repeats
+                case INPUT_LEFT:
+                case INPUT_RIGHT:
+                    iStruct -> due[INPUT_LEFT] = NOT_DUE;
+                    iStruct -> due[INPUT_RIGHT] = NOT_DUE;
+                    iStruct -> due[event.action] = event.t + iStruct -> das;
+                    break;
+
+                case INPUT_SOFT_DROP:
+                    iStruct -> due[event.action] = event.t + iStruct -> arr;
+                    break;
+
+                default:
+                    break;
+            }
+
+            iStruct -> taken = event.t;
+            return event.action;
+        }
+
+        // A held action repeats
+        if ( action != INPUT_NONE && repeat <= now )
+        {
+            iStruct -> taken = repeat;
+            iStruct -> due[action] += iStruct -> arr;
+            return action;
+        }
+
+        return INPUT_NONE;
+    }
+}
+
+/**
+ * @brief Oldest event queued, if there's one
+ * 
+ * @param iStruct Input
+ * @param event Where the event is copied
+ * 
+ * @return true if there's an event, false if the queue is empty
+ */
+static bool
+peek (input_private_t * iStruct, input_event_t * event)
+{
+    uint_fast32_t head = atomic_load_explicit(&iStruct -> head,
+                                              memory_order_relaxed);
+
+    // Acquire pairs with push release, so the event is seen
+    if ( head == atomic_load_explicit(&iStruct -> tail, memory_order_acquire) )
+    {
+        return false;
+    }
+
+    *event = iStruct -> queue[SLOT(head)];
+
+    return true;
+}
+
+/**
+ * @brief Push that an action was pressed or released
+ * 
+ * @param self Structure from which this function is called
+ * @param action One of inputActions enum
+ * @param pressed true if it was pressed, false if it was released
+ * @param t When it happened, in ns of the monotonic clock
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE if the action is invalid or the queue is full
+ */
+static int
+push (input_t * self, int action, bool pressed, uint64_t t)
+{
+    input_private_t * iStruct = PRIVATE(self);
+    uint_fast32_t tail = atomic_load_explicit(&iStruct -> tail,
+                                              memory_order_relaxed);
+
+    if ( action <= INPUT_NONE || action >= INPUT_ACTIONS )
+    {
+        return EXIT_FAILURE;
+    }
+
+    // Full. Acquire so the slot isn't written before it's read
+    if ( tail - atomic_load_explicit(&iStruct -> head,
+                                     memory_order_acquire) == INPUT_QUEUE )
+    {
+        return EXIT_FAILURE;
+    }
+
+    iStruct -> queue[SLOT(tail)].t = t;
+    iStruct -> queue[SLOT(tail)].action = action;
+    iStruct -> queue[SLOT(tail)].pressed = pressed;
+
+    atomic_store_explicit(&iStruct -> tail, tail + 1, memory_order_release);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Release every action and drop the queued events
+ * 
+ * @param self Structure from which this function is called
+ * 
+ * @return Nothing
+ */
+static void
+release (input_t * self)
+{
+    input_private_t * iStruct = PRIVATE(self);
+    int i;
+
+    for ( i = 0; i < INPUT_ACTIONS; i++ )
+    {
+        iStruct -> due[i] = NOT_DUE;
+    }
+
+    atomic_store_explicit(&iStruct -> head,
+                          atomic_load_explicit(&iStruct -> tail,
+                                               memory_order_acquire),
+                          memory_order_release);
+}
+
+/**
+ * @brief Time left until the next action is due
+ * 
+ * @param self Structure from which this function is called
+ * @param now Current time, in ns of the monotonic clock
+ * 
+ * @return Nanoseconds until the next action. 0 if it's due already, -1 if
+ * no action is held or queued
+ */
+static int64_t
+timeLeft (input_t * self, uint64_t now)
+{
+    input_private_t * iStruct = PRIVATE(self);
+    input_event_t event;
+    uint64_t t;
+
+    earliest(iStruct, &t);
+
+    (peek(iStruct, &event) && event.t < t) ? (t = event.t) : 0;
+
+    if ( t == NOT_DUE )
+    {
+        return -1;
+    }
+
+    return (t <= now) ? 0 : (int64_t) (t - now);
+}
+
+/**
+ * @brief When the last action taken happened
+ *
+ * @param self Structure from which this function is called
+ *
+ * @return Time it was pressed, or due if it repeated, in ns of the monotonic
+ * clock. 0 if no action was taken yet
+ */
+static uint64_t
+when (input_t * self)
+{
+    return PRIVATE(self) -> taken;
+}
@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ * 
+ * @file    input.h
+ * 
+ * @brief   Timestamped player input, with delayed auto shift and auto repeat.
+ * 
+ * The frontend pushes when an action is pressed or released, with the time
+ * of the monotonic clock it happened at. Actions are taken with next() in
+ * the order they happened: once when pressed, and while shifts and soft
+ * drops are held, again after the delayed auto shift (DAS) and then every
+ * auto repeat rate (ARR). Repeats are timed from the press, so they don't
+ * depend on how often next() is called.
+ * 
+ * Pushed events go through a lock free queue, so the frontend can push from
+ * one thread while the game takes actions in another. Only one thread may
+ * push and only one may take actions.
+ * 
+ * @note input_create() <b>must</b> be called to get an input, and
+ * input_free() to free it.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 12:40
+ * 
+ * @copyright GNU General Public License v3
+ */
+
+#ifndef INPUT_H
+#    define INPUT_H 1
+
+// === Libraries and header files ===
+/// For bool, true and false
+#    include <stdbool.h>
+
+/// For int64_t and uint64_t
+#    include <stdint.h>
+
+// === Constants and Macro definitions ===
+
+/**
+ * @def INPUT_QUEUE
+ * @brief Events that can be pushed and not taken yet. Must be a power of 2
+ */
+#    define INPUT_QUEUE     64
+
+/**
+ * @def INPUT_DAS
+ * @brief Default milliseconds a shift is held before it repeats
+ */
+#    define INPUT_DAS       133
+
+/**
+ * @def INPUT_ARR
+ * @brief Default milliseconds between repeated shifts and soft drops
+ */
+#    define INPUT_ARR       33
+
+/**
+ * @def INPUT_NS(ms)
+ * @brief Convert @p ms milliseconds to nanoseconds
+ */
+#    define INPUT_NS(ms)    ((uint64_t) (ms) * 1000000)
+
+// === Enumerations, structures and typedefs ===
+
+/**
+ * @brief Actions of the player
+ */
+enum inputActions
+{
+    /// No action due
+    INPUT_NONE = -1,
+    /// piece.shift(LEFT). Repeats
+    INPUT_LEFT,
+    /// piece.shift(RIGHT). Repeats
+    INPUT_RIGHT,
+    /// piece.softDrop(). Repeats every ARR, with no DAS
+    INPUT_SOFT_DROP,
+    /// piece.rotate(LEFT)
+    INPUT_ROTATE_LEFT,
+    /// piece.rotate(RIGHT)
+    INPUT_ROTATE_RIGHT,
+    /// piece.hardDrop()
+    INPUT_HARD_DROP,
+    /// Number of actions
+    INPUT_ACTIONS
+};
+
+/**
+ * @brief Input object.
+ * 
+ * @warning Must be created with input_create() and freed with input_free().
+ * 
+ * @headerfile input.h
+ */
+typedef struct INPUT
+{
+    /// Set to true when the input is initialized.
+    bool init;
+
+    /**
+     * @brief Push that an action was pressed or released
+     * 
+     * Called by the thread reading the keyboard or joystick. Events must be
+     * pushed in the order they happened.
+     * 
+     * @param self Structure from which this function is called
+     * @param action One of inputActions enum
+     * @param pressed true if it was pressed, false if it was released
+     * @param t When it happened, in ns of the monotonic clock. See
+     * monotonic_now()
+     * 
+     * @return Success: EXIT_SUCCESS
+     * @return Fail: EXIT_FAILURE if the action is invalid or the queue is
+     * full. The event is dropped
+     */
+    int (* push) (struct INPUT * self, int action, bool pressed, uint64_t t);
+
+    /**
+     * @brief Take the next action due
+     * 
+     * Actions are given in the order they happened, up to @p now. Call it
+     * until INPUT_NONE is returned.
+     * 
+     * @param self Structure from which this function is called
+     * @param now Current time, in ns of the monotonic clock
+     * 
+     * @return One of inputActions enum. INPUT_NONE if there's none due
+     */
+    int (* next) (struct INPUT * self, uint64_t now);
+
+    /**
+     * @brief Time left until the next action is due
+     * 
+     * Frontends can sleep this long before calling next() again, unless
+     * another event is pushed.
+     * 
+     * @param self Structure from which this function is called
+     * @param now Current time, in ns of the monotonic clock
+     * 
+     * @return Nanoseconds until the next action. 0 if it's due already, -1
+     * if no action is held or queued
+     */
+    int64_t (* timeLeft) (struct INPUT * self, uint64_t now);
+
+    /**
+     * @brief Release every action and drop the queued events
+     * 
+     * Used when the game is paused, so nothing repeats when it's resumed.
+     * Called by the thread taking actions.
+     * 
+     * @param self Structure from which this function is called
+     * 
+     * @return Nothing
+     */
+    void (* release) (struct INPUT * self);
+
+    /**
+     * @brief When the last action taken happened
+     *
+     * Used to measure how long an action took to reach the screen.
+     *
+     * @param self Structure from which this function is called
+     *
+     * @return Time it was pressed, or due if it repeated, in ns of the
+     * monotonic clock. 0 if no action was taken yet
+     */
+    uint64_t (* when) (struct INPUT * self);
+} input_t;
+
+// === Global variables ===
+
+// === ROM Constant variables ===
+
+// === Global function definitions ===
+
+// Create an input
+input_t *
+input_create (int das, int arr);
+
+// Free an input
+void
+input_free (input_t * self);
+
+#endif /* INPUT_H */
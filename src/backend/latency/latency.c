@@ -0,0 +1,539 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/******************************************************************************
+ * 
+ * @file    latency.c
+ * 
+ * @brief   Latency from the player input to the display.
+ * 
+ * @details There's one set of histograms per process, as the signal and exit
+ * handlers printing them can't be given one. Stages are recorded from the
+ * game logic and display threads, so counters are atomic and relaxed: a
+ * histogram printed while recording may be off by the values being added.
+ * 
+ * The signal handler only sets a flag, LATENCY_POLL() prints them.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 15:20
+ * 
+ * @copyright GNU General Public License v3
+ *****************************************************************************/
+
+// === Libraries and header files ===
+// For sigaction, as it isn't part of C11
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <signal.h>
+
+// For monotonic_now, the clock input times are taken with
+#include "../monotonic/monotonic.h"
+
+// This file
+#include "latency.h"
+
+/// @privatesection
+// === Constants and Macro definitions ===
+
+/**
+ * @def HIGHEST_BIT(x)
+ * @brief Position of the highest bit set in (x), which can't be 0
+ */
+#ifdef __GNUC__
+#    define HIGHEST_BIT(x)  (63 - __builtin_clzll(x))
+#else
+#    define HIGHEST_BIT(x)  highestBit(x)
+#endif
+
+/**
+ * @def NS2US(t)
+ * @brief Convert ns to us
+ */
+#define NS2US(t)        ((t) / 1000.0)
+
+// === Enumerations, structures and typedefs ===
+
+/**
+ * @brief Histogram of a stage
+ */
+typedef struct
+{
+    /// Values in each bucket
+    atomic_uint_fast64_t bucket[LATENCY_BUCKETS];
+
+    /// Values recorded
+    atomic_uint_fast64_t count;
+
+    /// Sum of the values, for the mean
+    atomic_uint_fast64_t sum;
+
+    /// Highest value recorded
+    atomic_uint_fast64_t max;
+} histogram_t;
+
+// === Global variables ===
+
+// === Function prototypes for private functions with file level scope ===
+
+// Bucket a value goes to
+static int
+bucketOf (uint64_t ns);
+
+// Time between two times, 0 if they're out of order
+static uint64_t
+elapsed (uint64_t from, uint64_t to);
+
+#ifndef __GNUC__
+// Position of the highest bit set
+static int
+highestBit (uint64_t x);
+#endif
+
+// Highest value a bucket keeps
+static uint64_t
+highestOf (int bucket);
+
+// Lowest value a bucket keeps
+static uint64_t
+lowestOf (int bucket);
+
+// Print the histograms when the process exits
+static void
+onExit (void);
+
+// Ask for the histograms to be printed
+static void
+onSignal (int signum);
+
+// === ROM Constant variables with file level scope ===
+static const char * stageNames[LATENCY_STAGES] = {
+    "input", "frame", "display", "total"
+};
+
+// === Static variables and constant variables with file level scope ===
+// Histograms of every stage. Zero initialized
+static histogram_t histograms[LATENCY_STAGES];
+
+// Set by the signal handler, cleared by latency_poll()
+static volatile sig_atomic_t dumpRequested = 0;
+
+// === Global function definitions ===
+/// @publicsection
+
+/**
+ * @brief The frame with the actions in @p mark was composed
+ * 
+ * Records the time since the board was changed, if there was an action.
+ * 
+ * @param mark Times of the oldest action in the frame
+ * 
+ * @return Nothing
+ */
+void
+latency_composed (latency_mark_t * mark)
+{
+    if ( mark -> input == 0 )
+    {
+        return;
+    }
+
+    mark -> frame = monotonic_now();
+
+    latency_record(LATENCY_FRAME, elapsed(mark -> mutation, mark -> frame));
+}
+
+/**
+ * @brief Print the percentiles of every stage
+ * 
+ * Times are in microseconds.
+ * 
+ * @param stream Where they're printed
+ * 
+ * @return Nothing
+ */
+void
+latency_dump (FILE * stream)
+{
+    int i;
+    uint64_t count;
+
+    fprintf(stream, "%-8s %10s %10s %10s %10s %10s %10s %10s\n",
+            "latency", "count", "mean", "p50", "p90", "p99", "p99.9", "max");
+
+    for ( i = 0; i < LATENCY_STAGES; i++ )
+    {
+        count = atomic_load_explicit(&histograms[i].count,
+                                     memory_order_relaxed);
+
+        fprintf(stream,
+                "%-8s %10llu %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                stageNames[i], (unsigned long long) count,
+                (count == 0) ? 0.0 :
+                NS2US((double) atomic_load_explicit(&histograms[i].sum,
+                                                    memory_order_relaxed) /
+                      count),
+                NS2US(latency_percentile(i, 0.5)),
+                NS2US(latency_percentile(i, 0.9)),
+                NS2US(latency_percentile(i, 0.99)),
+                NS2US(latency_percentile(i, 0.999)),
+                NS2US(atomic_load_explicit(&histograms[i].max,
+                                           memory_order_relaxed)));
+    }
+
+    fflush(stream);
+}
+
+/**
+ * @brief The board was changed by an action
+ * 
+ * Records the time since the action happened. If it's the oldest one not
+ * shown yet, @p mark keeps its times.
+ * 
+ * @param mark Times of the oldest action not shown yet
+ * @param input When the action happened, in ns of the monotonic clock.
+ * Nothing is recorded if it's 0
+ * 
+ * @return Nothing
+ */
+void
+latency_mutated (latency_mark_t * mark, uint64_t input)
+{
+    uint64_t mutation;
+
+    if ( input == 0 )
+    {
+        return;
+    }
+
+    mutation = monotonic_now();
+
+    latency_record(LATENCY_INPUT, elapsed(input, mutation));
+
+    if ( mark -> input == 0 )
+    {
+        mark -> input = input;
+        mark -> mutation = mutation;
+    }
+}
+
+/**
+ * @brief Time below which a fraction of the values of a stage are
+ * 
+ * @param stage One of latencyStages enum
+ * @param p Fraction of the values, from 0 to 1
+ * 
+ * @return Highest value of the bucket holding that fraction, in ns. Never
+ * more than the highest value recorded. 0 if the stage is invalid or empty
+ */
+uint64_t
+latency_percentile (int stage, double p)
+{
+    int i;
+    uint64_t count, rank, seen = 0, max;
+
+    if ( stage < 0 || stage >= LATENCY_STAGES )
+    {
+        return 0;
+    }
+
+    count = atomic_load_explicit(&histograms[stage].count,
+                                 memory_order_relaxed);
+    max = atomic_load_explicit(&histograms[stage].max, memory_order_relaxed);
+
+    if ( count == 0 )
+    {
+        return 0;
+    }
+
+    // Values that must be below, rounded up and at least 1
+    rank = (uint64_t) (p * count);
+    (rank < p * count || rank == 0) ? (rank++) : 0;
+    (rank > count) ? (rank = count) : 0;
+
+    for ( i = 0; i < LATENCY_BUCKETS; i++ )
+    {
+        seen += atomic_load_explicit(&histograms[stage].bucket[i],
+                                     memory_order_relaxed);
+
+        if ( seen >= rank )
+        {
+            return (highestOf(i) < max) ? highestOf(i) : max;
+        }
+    }
+
+    return max;
+}
+
+/**
+ * @brief Print the histograms if SIGUSR1 was received
+ * 
+ * @return Nothing
+ */
+void
+latency_poll (void)
+{
+    if ( dumpRequested )
+    {
+        dumpRequested = 0;
+        latency_dump(stderr);
+    }
+}
+
+/**
+ * @brief Add a value to the histogram of a stage
+ * 
+ * @param stage One of latencyStages enum. Ignored if it's invalid
+ * @param ns Value, in ns
+ * 
+ * @return Nothing
+ */
+void
+latency_record (int stage, uint64_t ns)
+{
+    histogram_t * h;
+    uint_fast64_t max;
+
+    if ( stage < 0 || stage >= LATENCY_STAGES )
+    {
+        return;
+    }
+
+    h = &histograms[stage];
+
+    atomic_fetch_add_explicit(&h -> bucket[bucketOf(ns)], 1,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&h -> count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&h -> sum, ns, memory_order_relaxed);
+
+    // On failure max gets the value some other thread stored
+    max = atomic_load_explicit(&h -> max, memory_order_relaxed);
+
+    while ( ns > max &&
+            !atomic_compare_exchange_weak_explicit(&h -> max, &max, ns,
+                                                   memory_order_relaxed,
+                                                   memory_order_relaxed) );
+}
+
+/**
+ * @brief Clear every histogram
+ * 
+ * @return Nothing
+ */
+void
+latency_reset (void)
+{
+    int i, j;
+
+    for ( i = 0; i < LATENCY_STAGES; i++ )
+    {
+        for ( j = 0; j < LATENCY_BUCKETS; j++ )
+        {
+            atomic_store_explicit(&histograms[i].bucket[j], 0,
+                                  memory_order_relaxed);
+        }
+
+        atomic_store_explicit(&histograms[i].count, 0, memory_order_relaxed);
+        atomic_store_explicit(&histograms[i].sum, 0, memory_order_relaxed);
+        atomic_store_explicit(&histograms[i].max, 0, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief The display returned after showing the frame
+ * 
+ * Records the time since the frame was composed and since the action
+ * happened, and clears @p mark.
+ * 
+ * @param mark Times of the oldest action in the frame
+ * 
+ * @return Nothing
+ */
+void
+latency_shown (latency_mark_t * mark)
+{
+    uint64_t shown;
+
+    if ( mark -> input == 0 || mark -> frame == 0 )
+    {
+        return;
+    }
+
+    shown = monotonic_now();
+
+    latency_record(LATENCY_DISPLAY, elapsed(mark -> frame, shown));
+    latency_record(LATENCY_TOTAL, elapsed(mark -> input, shown));
+
+    mark -> input = 0;
+    mark -> mutation = 0;
+    mark -> frame = 0;
+}
+
+/**
+ * @brief Print the histograms on exit and on SIGUSR1
+ * 
+ * Must be called once, before recording.
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+int
+latency_start (void)
+{
+    struct sigaction action = {0};
+
+    action.sa_handler = &onSignal;
+    sigemptyset(&action.sa_mask);
+
+    if ( sigaction(SIGUSR1, &action, NULL) != 0 || atexit(&onExit) != 0 )
+    {
+        fputs("Could not start measuring the latency.", stderr);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/// @privatesection
+// === Local function definitions ===
+
+/**
+ * @brief Bucket a value goes to
+ * 
+ * Values below LATENCY_SUB have a bucket each. Above, each power of 2 is
+ * split in LATENCY_SUB buckets by the bits after the highest one.
+ * 
+ * @param ns Value
+ * 
+ * @return Bucket, from 0 to LATENCY_BUCKETS - 1
+ */
+static int
+bucketOf (uint64_t ns)
+{
+    int high;
+
+    if ( ns < LATENCY_SUB )
+    {
+        return (int) ns;
+    }
+
+    high = HIGHEST_BIT(ns);
+
+    return (high - LATENCY_SUB_BITS + 1) * LATENCY_SUB +
+            (int) ((ns >> (high - LATENCY_SUB_BITS)) & (LATENCY_SUB - 1));
+}
+
+/**
+ * @brief Time between two times, 0 if they're out of order
+ * 
+ * @param from Earlier time
+ * @param to Later time
+ * 
+ * @return to - from, or 0
+ */
+static uint64_t
+elapsed (uint64_t from, uint64_t to)
+{
+    return (to > from) ? (to - from) : 0;
+}
+
+#ifndef __GNUC__
+
+/**
+ * @brief Position of the highest bit set
+ * 
+ * @param x Value, not 0
+ * 
+ * @return Position, from 0 to 63
+ */
+static int
+highestBit (uint64_t x)
+{
+    int high = 0;
+
+    while ( x >>= 1 )
+    {
+        high++;
+    }
+
+    return high;
+}
+#endif
+
+/**
+ * @brief Highest value a bucket keeps
+ * 
+ * @param bucket Bucket, from 0 to LATENCY_BUCKETS - 1
+ * 
+ * @return Value
+ */
+static uint64_t
+highestOf (int bucket)
+{
+    return (bucket == LATENCY_BUCKETS - 1) ?
+            UINT64_MAX : lowestOf(bucket + 1) - 1;
+}
+
+/**
+ * @brief Lowest value a bucket keeps
+ * 
+ * @param bucket Bucket, from 0 to LATENCY_BUCKETS - 1
+ * 
+ * @return Value
+ */
+static uint64_t
+lowestOf (int bucket)
+{
+    int power = bucket / LATENCY_SUB, sub = bucket % LATENCY_SUB;
+
+    return (power == 0) ?
+            (uint64_t) sub : (uint64_t) (LATENCY_SUB + sub) << (power - 1);
+}
+
+/**
+ * @brief Print the histograms when the process exits
+ * 
+ * @return Nothing
+ */
+static void
+onExit (void)
+{
+    latency_dump(stderr);
+}
+
+/**
+ * @brief Ask for the histograms to be printed
+ * 
+ * Printing isn't safe in a signal handler, so it's left to latency_poll().
+ * 
+ * @param signum Signal received
+ * 
+ * @return Nothing
+ */
+static void
+onSignal (int signum)
+{
+    (void) signum;
+
+    dumpRequested = 1;
+}
@@ -0,0 +1,194 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ * 
+ * @file    latency.h
+ * 
+ * @brief   Latency from the player input to the display.
+ * 
+ * Every action of the player is followed through the game: when it happened,
+ * when it changed the board, when the frame showing it was composed and when
+ * the display returned after showing it. The time between each of them is
+ * kept in a histogram per stage, whose percentiles are printed when the game
+ * exits, or when it gets SIGUSR1.
+ * 
+ * Histograms have log linear buckets, as HDR histograms do: every power of 2
+ * is split in LATENCY_SUB buckets, so values are kept within 1 / LATENCY_SUB
+ * of what they were, from nanoseconds to minutes, in a fixed size.
+ * 
+ * To enable the measurements, add the argument -D LATENCY at compilation
+ * time. Frontends call the LATENCY_ macros, which do nothing without it: the
+ * input time isn't even evaluated.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 15:20
+ * 
+ * @copyright GNU General Public License v3
+ */
+
+#ifndef LATENCY_H
+#    define LATENCY_H 1
+
+// === Libraries and header files ===
+/// For FILE
+#    include <stdio.h>
+
+/// For uint64_t
+#    include <stdint.h>
+
+// === Constants and Macro definitions ===
+
+/**
+ * @def LATENCY_SUB_BITS
+ * @brief Each power of 2 is split in 2^LATENCY_SUB_BITS buckets
+ */
+#    define LATENCY_SUB_BITS    4
+
+/**
+ * @def LATENCY_SUB
+ * @brief Buckets per power of 2
+ */
+#    define LATENCY_SUB         (1 << LATENCY_SUB_BITS)
+
+/**
+ * @def LATENCY_BUCKETS
+ * @brief Buckets of a histogram, enough for any uint64_t
+ */
+#    define LATENCY_BUCKETS     ((64 - LATENCY_SUB_BITS + 1) * LATENCY_SUB)
+
+#    ifdef LATENCY
+/**
+ * @def LATENCY_START()
+ * @brief Print the histograms on exit and on SIGUSR1
+ */
+#        define LATENCY_START()             latency_start()
+
+/**
+ * @def LATENCY_POLL()
+ * @brief Print the histograms if SIGUSR1 was received
+ */
+#        define LATENCY_POLL()              latency_poll()
+
+/**
+ * @def LATENCY_MUTATED(mark, input)
+ * @brief The board was changed by an action that happened at @p input
+ */
+#        define LATENCY_MUTATED(mark, input)  latency_mutated((mark), (input))
+
+/**
+ * @def LATENCY_COMPOSED(mark)
+ * @brief The frame with the actions in @p mark was composed
+ */
+#        define LATENCY_COMPOSED(mark)      latency_composed(mark)
+
+/**
+ * @def LATENCY_SHOWN(mark)
+ * @brief The display returned after showing the frame
+ */
+#        define LATENCY_SHOWN(mark)         latency_shown(mark)
+#    else
+#        define LATENCY_START()             ((void) 0)
+#        define LATENCY_POLL()              ((void) 0)
+#        define LATENCY_MUTATED(mark, input)  ((void) (mark), \
+                                               (void) sizeof (input))
+#        define LATENCY_COMPOSED(mark)      ((void) (mark))
+#        define LATENCY_SHOWN(mark)         ((void) (mark))
+#    endif
+
+// === Enumerations, structures and typedefs ===
+
+/**
+ * @brief Stages measured
+ */
+enum latencyStages
+{
+    /// From the input to the board changed by it
+    LATENCY_INPUT,
+    /// From the board changed to the frame composed
+    LATENCY_FRAME,
+    /// From the frame composed to the display returning
+    LATENCY_DISPLAY,
+    /// From the input to the display returning
+    LATENCY_TOTAL,
+    /// Number of stages
+    LATENCY_STAGES
+};
+
+/**
+ * @brief Times of the oldest action not shown yet
+ * 
+ * It goes with the game until a frame is published, and then with the frame.
+ * Times are in ns of the monotonic clock. Clear it with all of them to 0.
+ */
+typedef struct LATENCY_MARK
+{
+    /// When the action happened. 0 if there's none
+    uint64_t input;
+
+    /// When it changed the board
+    uint64_t mutation;
+
+    /// When the frame showing it was composed
+    uint64_t frame;
+} latency_mark_t;
+
+// === Global variables ===
+
+// === ROM Constant variables ===
+
+// === Global function definitions ===
+
+// The frame with the actions in mark was composed
+void
+latency_composed (latency_mark_t * mark);
+
+// Print the percentiles of every stage
+void
+latency_dump (FILE * stream);
+
+// The board was changed by an action
+void
+latency_mutated (latency_mark_t * mark, uint64_t input);
+
+// Time below which a fraction of the values of a stage are
+uint64_t
+latency_percentile (int stage, double p);
+
+// Print the histograms if SIGUSR1 was received
+void
+latency_poll (void);
+
+// Add a value to the histogram of a stage
+void
+latency_record (int stage, uint64_t ns);
+
+// Clear every histogram
+void
+latency_reset (void);
+
+// The display returned after showing the frame
+void
+latency_shown (latency_mark_t * mark);
+
+// Print the histograms on exit and on SIGUSR1
+int
+latency_start (void);
+
+#endif /* LATENCY_H */
@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ * 
+ * @file    monotonic.h
+ * 
+ * @brief   Time of the monotonic clock, shared by the whole game.
+ * 
+ * Inputs, gravity, latencies and the BOT's deadlines are all measured with
+ * it, so their times can be compared. It's the real time passed, even when
+ * the system clock is changed.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 18:10
+ * 
+ * @copyright GNU General Public License v3
+ */
+
+#ifndef MONOTONIC_H
+#    define MONOTONIC_H 1
+
+// === Libraries and header files ===
+/// For uint64_t
+#    include <stdint.h>
+
+// === Constants and Macro definitions ===
+
+// === Enumerations, structures and typedefs ===
+
+// === Global variables ===
+
+// === ROM Constant variables ===
+
+// === Global function definitions ===
+
+// Current time of the monotonic clock
+uint64_t
+monotonic_now (void);
+
+#endif /* MONOTONIC_H */
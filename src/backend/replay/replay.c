@@ -0,0 +1,1377 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/******************************************************************************
+ * 
+ * @file    replay.c
+ * 
+ * @brief   Compact binary recording of a game, that can be played again.
+ * 
+ * @details A replay file starts with REPLAY_MAGIC, its version and the height
+ * of the board it was recorded in. Then, every event is a varint with the
+ * milliseconds since the last event times 16 plus its type, followed by its
+ * arguments as zigzag varints. Events with a variable number of arguments
+ * have it first.
+ * 
+ * While recording, events are encoded in a ring of REPLAY_CHUNKS chunks,
+ * taken when the replay is created. A full chunk is handed to the writer by
+ * moving the count of queued chunks forward, and the writer moves the count
+ * of written ones, so the game takes no lock and allocates no memory while
+ * it records. A single thread writes every replay being recorded, and waits
+ * for full chunks on a semaphore. If it falls a whole ring behind, events
+ * are dropped and the replay fails, but the game never waits for the file.
+ * 
+ * A keyframe is a REPLAY_KEYFRAME event with every value of a board_state_t
+ * as its arguments, about 300 bytes. A loaded replay is read to memory at
+ * once, as it's only a few KB, and the position of every keyframe is kept so
+ * seek() can go straight to it.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 18:20
+ * 
+ * @copyright GNU General Public License v3
+ *****************************************************************************/
+
+// === Libraries and header files ===
+// For semaphores, as they aren't part of C11
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+// For monotonic_now, the clock of the delays between events
+#include "../monotonic/monotonic.h"
+
+// For stats_t
+#include "../stats/stats_mgmt.h"
+
+// This file
+#include "replay.h"
+
+/// @privatesection
+// === Constants and Macro definitions ===
+
+/**
+ * @def PRIVATE(p)
+ * @brief Returns the private structure of the replay_t (p)
+ */
+#define PRIVATE(p)      ((replay_private_t *) (p))
+
+/**
+ * @def FILLING(r)
+ * @brief Chunk of the ring of the replay (r) where events are being encoded
+ */
+#define FILLING(r)      (&(r) -> ring[atomic_load_explicit(&(r) -> queued, \
+                                      memory_order_relaxed) % REPLAY_CHUNKS])
+
+/// First bytes of every replay file
+#define REPLAY_MAGIC    "TXRP"
+
+/// Version of the format written
+#define REPLAY_VERSION  1
+
+/// Bits of the first varint of an event taken by its type
+#define TYPE_BITS       4
+
+/// Longest varint of a 64 bits number
+#define VARINT_BYTES    10
+
+/// Arguments of an event that has its number first
+#define VARIABLE        -1
+
+/// Values of a board_state_t written in a keyframe
+#define KEYFRAME_VALUES ((BOARD_HEIGHT + HIDDEN_ROWS) * (BOARD_WIDTH + 1) + \
+                         BOARD_WIDTH + COORD_NUM + 2 * TETROMINOS + \
+                         RANDOM_HISTORY + 24)
+
+/**
+ * @def STATE_VALUE(field)
+ * @brief Copy a field of the state to or from the next value, in
+ * stateValues()
+ */
+#define STATE_VALUE(field)  ((load) ? (void) ((field) = values[n]) : \
+                             (void) (values[n] = (int64_t) (field)), n++)
+
+// === Enumerations, structures and typedefs ===
+
+/**
+ * @brief Chunk of encoded events
+ */
+typedef struct REPLAY_BUFFER
+{
+    /// Bytes used
+    size_t used;
+
+    unsigned char data[REPLAY_CHUNK];
+} chunk_t;
+
+/**
+ * @brief Keyframe of a loaded replay
+ */
+typedef struct REPLAY_INDEX
+{
+    /// Where its event starts
+    size_t position;
+
+    /// Pieces deployed before it
+    int pieces;
+} keyframe_t;
+
+/**
+ * @brief Private structure of a replay
+ */
+typedef struct REPLAY_PRIVATE
+{
+    /// Public structure. Must be the first member
+    replay_t public;
+
+    /// File being recorded
+    FILE * file;
+
+    /// Ring of REPLAY_CHUNKS chunks where events are encoded
+    chunk_t * ring;
+
+    /// Chunks filled, only moved by the game. The next one is being filled
+    atomic_size_t queued;
+
+    /// Chunks written to the file, only moved by the writer
+    atomic_size_t written;
+
+    /// Next replay being recorded, in recorders
+    struct REPLAY_PRIVATE * nextRecording;
+
+    /// Set when a chunk couldn't be written or kept
+    atomic_bool failed;
+
+    /// Time of the last event recorded, in whole ms of the monotonic clock
+    uint64_t lastEvent;
+
+    /// Whole loaded replay, and the next byte to read
+    unsigned char * data;
+    size_t size;
+    size_t position;
+
+    /// Keyframes of the loaded replay, in order
+    keyframe_t * keyframes;
+    int nKeyframes;
+
+    /// Milliseconds given to play() and not played yet
+    uint64_t elapsed;
+} replay_private_t;
+
+/**
+ * @brief Replays being recorded, and the thread writing them
+ */
+typedef struct REPLAY_RECORDERS
+{
+    /// Lock of the list. The writer holds it while writing
+    pthread_mutex_t lock;
+
+    /// Replays being recorded, the last one first
+    replay_private_t * first;
+
+    /// Set while the writer runs. It stops when there's no replay left
+    bool running;
+
+    /// Posted once for every chunk queued, and to stop the writer
+    sem_t wake;
+} recorders_t;
+
+// === Global variables ===
+
+// === Function prototypes for private functions with file level scope ===
+
+// Write an encoded event in the chunk being filled
+static int
+append (replay_private_t * rStruct, const unsigned char * buffer,
+        size_t used);
+
+// Pieces deployed in a game
+static int
+deployed (board_t * board);
+
+// Free everything a replay holds
+static void
+destroy (replay_private_t * rStruct);
+
+// Encode an event, with the time since the last one
+static size_t
+encode (replay_private_t * rStruct, unsigned char * buffer, int type, int n,
+        const int64_t args[]);
+
+// Record an event
+static int
+event (replay_t * self, int type, int n, const int64_t args[]);
+
+// Find every keyframe of a loaded replay
+static int
+findKeyframes (replay_private_t * rStruct);
+
+// Write the chunks queued by a replay
+static void
+flush (replay_private_t * rStruct);
+
+// Initialize the semaphore of the writer
+static void
+initRecorders (void);
+
+// Record a keyframe
+static int
+keyframe (replay_t * self, const board_state_t * state);
+
+// Read the next event of a loaded replay
+static int
+next (replay_t * self, replay_event_t * event);
+
+// Play the events of a loaded replay that happen in some time
+static int
+play (replay_t * self, board_t * board, uint64_t ms);
+
+// Queue the chunk being filled to be written
+static int
+queueChunk (replay_private_t * rStruct);
+
+// Read a varint
+static int
+readVarint (replay_private_t * rStruct, uint64_t * value);
+
+// Set a board as it was before a piece was deployed
+static int
+seek (replay_t * self, board_t * board, int piece);
+
+// Copy a board state to or from the values of a keyframe
+static void
+stateValues (board_state_t * state, int64_t values[KEYFRAME_VALUES],
+             bool load);
+
+// Write a varint
+static size_t
+writeVarint (unsigned char * buffer, uint64_t value);
+
+// Write the queued chunks of every replay until there's none left
+static void *
+writer (void * arg);
+
+// === ROM Constant variables with file level scope ===
+
+// Arguments of every event, in replayEvents enum order
+static const int eventArgs[REPLAY_EVENTS] = {
+    1, 1, 1, 1, 1 + BOARD_WIDTH, 0, 1, 1, 0, 0, 3, VARIABLE, 0,
+    KEYFRAME_VALUES
+};
+
+// === Static variables and constant variables with file level scope ===
+
+/// Replays being recorded
+static recorders_t recorders = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .first = NULL,
+    .running = false
+};
+
+/// Initializes the semaphore of recorders once
+static pthread_once_t recordersOnce = PTHREAD_ONCE_INIT;
+
+// === Global function definitions ===
+/// @publicsection
+
+/**
+ * @brief Apply an event of a replay to a board
+ * 
+ * Events must be applied in the order they were read, starting with a new
+ * board or a restored keyframe. A keyframe isn't restored, but compared
+ * with the board.
+ * 
+ * @param board Board where the game is played again
+ * @param event Event read with next()
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE if the event is invalid, or the keyframe isn't
+ * the same as the board
+ */
+int
+replay_apply (board_t * board, const replay_event_t * event)
+{
+    int i;
+    int lines[BOARD_HEIGHT];
+    grid_t cells[BOARD_WIDTH];
+    placement_t where;
+    board_state_t state;
+
+    if ( board == NULL || event == NULL || board -> init == false )
+    {
+        fputs("Invalid board for replay_apply()", stderr);
+        return EXIT_FAILURE;
+    }
+
+    switch ( event -> type )
+    {
+        case REPLAY_SEED:
+            board -> set.seed(board, (uint64_t) event -> args[0]);
+            break;
+
+        case REPLAY_RANDOMIZER:
+            board -> set.randomizer(board, (int) event -> args[0]);
+            break;
+
+        case REPLAY_START_LEVEL:
+            board -> set.startLevel(board, (unsigned char) event -> args[0]);
+            break;
+
+        case REPLAY_START_ROWS:
+            board -> set.startRows(board, (unsigned char) event -> args[0]);
+            break;
+
+        case REPLAY_ROW:
+            for ( i = 0; i < BOARD_WIDTH; i++ )
+            {
+                cells[i] = (grid_t) event -> args[i + 1];
+            }
+
+            board -> set.row(board, (int) event -> args[0], cells);
+            break;
+
+        case REPLAY_UPDATE:
+            board -> update(board);
+            break;
+
+        case REPLAY_SHIFT:
+            board -> piece.shift(board, (int) event -> args[0]);
+            break;
+
+        case REPLAY_ROTATE:
+            board -> piece.rotate(board, (int) event -> args[0]);
+            break;
+
+        case REPLAY_SOFT_DROP:
+            board -> piece.softDrop(board);
+            break;
+
+        case REPLAY_HARD_DROP:
+            board -> piece.hardDrop(board);
+            break;
+
+        case REPLAY_PLACE:
+            where.x = (int) event -> args[0];
+            where.y = (int) event -> args[1];
+            where.orientation = (int) event -> args[2];
+            board -> piece.place(board, &where);
+            break;
+
+        case REPLAY_CLEAR_LINES:
+            for ( i = 0; i < event -> n && i < BOARD_HEIGHT; i++ )
+            {
+                lines[i] = (int) event -> args[i];
+            }
+
+            board -> clear.lines(board, lines, i);
+            break;
+
+        case REPLAY_FILLED_ROWS:
+            board -> ask.filledRows(board, lines);
+            break;
+
+        case REPLAY_KEYFRAME:
+            board_snapshot(board, &state);
+
+            // A new top score depends on the top scores of each computer
+            state.stats.newTop = event -> keyframe.stats.newTop;
+
+            if ( memcmp(&state, &event -> keyframe, sizeof (state)) )
+            {
+                fputs("The game isn't the same as the replay.", stderr);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        default:
+            fputs("Invalid event for replay_apply()", stderr);
+            return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Free a replay, writing the events left if it's being recorded
+ * 
+ * @param self Replay given by replay_record() or replay_load()
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE if some events of a recorded replay couldn't be
+ * written
+ */
+int
+replay_close (replay_t * self)
+{
+    int ans = EXIT_SUCCESS;
+
+    if ( self != NULL )
+    {
+        replay_private_t * rStruct = PRIVATE(self);
+        replay_private_t ** link;
+        chunk_t * chunk;
+
+        if ( self -> recording == true && rStruct -> ring != NULL )
+        {
+            // Once out of the list, the writer doesn't touch it again
+            pthread_mutex_lock(&recorders.lock);
+
+            for ( link = &recorders.first; *link != NULL;
+                  link = &(*link) -> nextRecording )
+            {
+                if ( *link == rStruct )
+                {
+                    *link = rStruct -> nextRecording;
+                    break;
+                }
+            }
+
+            // The writer stops if it was the last one
+            (recorders.first == NULL) ? sem_post(&recorders.wake) : 0;
+
+            pthread_mutex_unlock(&recorders.lock);
+
+            // Chunks queued and not written yet, and the one being filled
+            flush(rStruct);
+
+            chunk = FILLING(rStruct);
+
+            (chunk -> used > 0 &&
+             fwrite(chunk -> data, 1, chunk -> used, rStruct -> file) != \
+             chunk -> used) ? (rStruct -> failed = true) : 0;
+        }
+
+        destroy(rStruct);
+
+        ans = (rStruct -> failed == true) ? EXIT_FAILURE : EXIT_SUCCESS;
+
+        free(rStruct);
+    }
+
+    return ans;
+}
+
+/**
+ * @brief Load a replay to play it again
+ * 
+ * Its events are read with next() and applied to a new board with
+ * replay_apply(), or played with play() and seek().
+ * 
+ * @param path Replay file
+ * 
+ * @return Success: Pointer to the replay
+ * @return Fail: NULL if it can't be read, or it was recorded with another
+ * version or board height
+ */
+replay_t *
+replay_load (const char * path)
+{
+    FILE * pFile;
+    long size;
+    uint64_t version = 0, height = 0;
+    replay_private_t * rStruct = calloc(1, sizeof (replay_private_t));
+
+    if ( rStruct == NULL )
+    {
+        fputs("Could not allocate memory for the REPLAY.", stderr);
+        return NULL;
+    }
+
+    pFile = (path != NULL) ? fopen(path, "rb") : NULL;
+
+    if ( pFile == NULL )
+    {
+        fputs("Could not open the replay.", stderr);
+        free(rStruct);
+        return NULL;
+    }
+
+    // Read it whole
+    fseek(pFile, 0, SEEK_END);
+    size = ftell(pFile);
+    rewind(pFile);
+
+    rStruct -> data = (size > 0) ? malloc(size) : NULL;
+    rStruct -> size = (rStruct -> data != NULL) ? \
+            fread(rStruct -> data, 1, size, pFile) : 0;
+
+    fclose(pFile);
+
+    // Header
+    rStruct -> position = sizeof (REPLAY_MAGIC) - 1;
+
+    if ( rStruct -> size < rStruct -> position ||
+         memcmp(rStruct -> data, REPLAY_MAGIC, rStruct -> position) ||
+         readVarint(rStruct, &version) || version != REPLAY_VERSION ||
+         readVarint(rStruct, &height) || height != BOARD_HEIGHT ||
+         findKeyframes(rStruct) )
+    {
+        fputs("Invalid replay file.", stderr);
+        free(rStruct -> keyframes);
+        free(rStruct -> data);
+        free(rStruct);
+        return NULL;
+    }
+
+    rStruct -> public.recording = false;
+    rStruct -> public.event = &event;
+    rStruct -> public.keyframe = &keyframe;
+    rStruct -> public.next = &next;
+    rStruct -> public.play = &play;
+    rStruct -> public.seek = &seek;
+    rStruct -> public.init = true;
+
+    return &rStruct -> public;
+}
+
+/**
+ * @brief Start recording a replay
+ * 
+ * The replay is given to a board with set.replay(), and the file is written
+ * while the game is played.
+ * 
+ * @param path File where the replay is written. It's replaced if it exists
+ * 
+ * @return Success: Pointer to the replay
+ * @return Fail: NULL
+ */
+replay_t *
+replay_record (const char * path)
+{
+    pthread_t thread;
+    chunk_t * chunk;
+    replay_private_t * rStruct = calloc(1, sizeof (replay_private_t));
+
+    if ( rStruct == NULL )
+    {
+        fputs("Could not allocate memory for the REPLAY.", stderr);
+        return NULL;
+    }
+
+    rStruct -> file = (path != NULL) ? fopen(path, "wb") : NULL;
+    rStruct -> ring = malloc(REPLAY_CHUNKS * sizeof (chunk_t));
+
+    if ( rStruct -> file == NULL || rStruct -> ring == NULL )
+    {
+        fputs("Could not create the replay.", stderr);
+        destroy(rStruct);
+        free(rStruct);
+        return NULL;
+    }
+
+    atomic_init(&rStruct -> queued, 0);
+    atomic_init(&rStruct -> written, 0);
+    atomic_init(&rStruct -> failed, false);
+
+    // Header
+    chunk = FILLING(rStruct);
+
+    memcpy(chunk -> data, REPLAY_MAGIC, sizeof (REPLAY_MAGIC) - 1);
+    chunk -> used = sizeof (REPLAY_MAGIC) - 1;
+    chunk -> used += writeVarint(&chunk -> data[chunk -> used],
+                                 REPLAY_VERSION);
+    chunk -> used += writeVarint(&chunk -> data[chunk -> used], BOARD_HEIGHT);
+
+    rStruct -> lastEvent = monotonic_now() / 1000000;
+
+    // Written by the thread writing every replay, started if it's the first
+    pthread_once(&recordersOnce, &initRecorders);
+    pthread_mutex_lock(&recorders.lock);
+
+    if ( recorders.running == false )
+    {
+        if ( pthread_create(&thread, NULL, &writer, NULL) )
+        {
+            pthread_mutex_unlock(&recorders.lock);
+            fputs("Could not start the replay writer.", stderr);
+            destroy(rStruct);
+            free(rStruct);
+            return NULL;
+        }
+
+        pthread_detach(thread);
+        recorders.running = true;
+    }
+
+    rStruct -> nextRecording = recorders.first;
+    recorders.first = rStruct;
+
+    pthread_mutex_unlock(&recorders.lock);
+
+    rStruct -> public.recording = true;
+    rStruct -> public.event = &event;
+    rStruct -> public.keyframe = &keyframe;
+    rStruct -> public.next = &next;
+    rStruct -> public.play = &play;
+    rStruct -> public.seek = &seek;
+    rStruct -> public.init = true;
+
+    return &rStruct -> public;
+}
+
+/// @privatesection
+// === Local function definitions ===
+
+/**
+ * @brief Write an encoded event in the chunk being filled
+ * 
+ * @param rStruct Private structure of the replay
+ * @param buffer Encoded event
+ * @param used Bytes of the event. Never more than REPLAY_CHUNK
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE if it couldn't be kept
+ */
+static int
+append (replay_private_t * rStruct, const unsigned char * buffer,
+        size_t used)
+{
+    chunk_t * chunk;
+
+    if ( rStruct -> ring == NULL )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if ( FILLING(rStruct) -> used + used > REPLAY_CHUNK &&
+         queueChunk(rStruct) )
+    {
+        return EXIT_FAILURE;
+    }
+
+    chunk = FILLING(rStruct);
+
+    memcpy(&chunk -> data[chunk -> used], buffer, used);
+    chunk -> used += used;
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Pieces deployed in a game, the moving one included
+ * 
+ * @param board Board of the game
+ * 
+ * @return Number of pieces
+ */
+static int
+deployed (board_t * board)
+{
+    int i, pieces = 0;
+    const stats_t * stats = board -> ask.stats(board);
+
+    for ( i = 0; i < TETROMINOS; i++ )
+    {
+        pieces += stats -> piece.number[i];
+    }
+
+    return pieces;
+}
+
+/**
+ * @brief Free everything a replay holds, but the structure
+ * 
+ * It must not be in recorders.
+ * 
+ * @param rStruct Private structure of the replay
+ * 
+ * @return Nothing
+ */
+static void
+destroy (replay_private_t * rStruct)
+{
+    if ( rStruct -> file != NULL )
+    {
+        (fclose(rStruct -> file) != 0) ? (rStruct -> failed = true) : 0;
+        rStruct -> file = NULL;
+    }
+
+    free(rStruct -> ring);
+    free(rStruct -> data);
+    free(rStruct -> keyframes);
+    rStruct -> ring = NULL;
+    rStruct -> data = NULL;
+    rStruct -> keyframes = NULL;
+
+    rStruct -> public.event = NULL;
+    rStruct -> public.keyframe = NULL;
+    rStruct -> public.next = NULL;
+    rStruct -> public.play = NULL;
+    rStruct -> public.seek = NULL;
+    rStruct -> public.init = false;
+}
+
+/**
+ * @brief Encode an event, with the time since the last one
+ * 
+ * @param rStruct Private structure of the replay
+ * @param buffer Where it's encoded. There must be room for n + 2 varints
+ * @param type One of replayEvents enum
+ * @param n Number of arguments
+ * @param args Arguments
+ * 
+ * @return Bytes encoded
+ */
+static size_t
+encode (replay_private_t * rStruct, unsigned char * buffer, int type, int n,
+        const int64_t args[])
+{
+    int i;
+    size_t used = 0;
+    uint64_t delay, now = monotonic_now() / 1000000;
+
+    // Only whole milliseconds are taken, so they aren't lost between events
+    delay = (now > rStruct -> lastEvent) ? now - rStruct -> lastEvent : 0;
+    rStruct -> lastEvent += delay;
+
+    used += writeVarint(&buffer[used], (delay << TYPE_BITS) | type);
+
+    (eventArgs[type] == VARIABLE) ? \
+            used += writeVarint(&buffer[used], n) : 0;
+
+    // Zigzag, so small negative numbers take a single byte too
+    for ( i = 0; i < n; i++ )
+    {
+        used += writeVarint(&buffer[used], ((uint64_t) args[i] << 1) ^ \
+                            (uint64_t) (args[i] >> 63));
+    }
+
+    return used;
+}
+
+/**
+ * @brief Record an event
+ * 
+ * @param self Structure from which this function is called
+ * @param type One of replayEvents enum
+ * @param n Number of arguments
+ * @param args Arguments, as described in replayEvents enum
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+static int
+event (replay_t * self, int type, int n, const int64_t args[])
+{
+    unsigned char buffer[(REPLAY_ARGS + 2) * VARINT_BYTES];
+    replay_private_t * rStruct = PRIVATE(self);
+
+    if ( self -> recording == false || type < 0 || type >= REPLAY_EVENTS ||
+         n < 0 || n > REPLAY_ARGS ||
+         (eventArgs[type] != VARIABLE && n != eventArgs[type]) )
+    {
+        fputs("Invalid event for the replay.", stderr);
+        return EXIT_FAILURE;
+    }
+
+    return append(rStruct, buffer, encode(rStruct, buffer, type, n, args));
+}
+
+/**
+ * @brief Find every keyframe of a loaded replay
+ * 
+ * Every event is read once, so a broken replay is found when it's loaded.
+ * 
+ * @param rStruct Private structure of the replay, right after the header
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE if an event is broken or there's no memory
+ */
+static int
+findKeyframes (replay_private_t * rStruct)
+{
+    int i, size = 0;
+    size_t start = rStruct -> position, position;
+    replay_event_t * event = malloc(sizeof (replay_event_t));
+
+    if ( event == NULL )
+    {
+        return EXIT_FAILURE;
+    }
+
+    while ( (position = rStruct -> position) < rStruct -> size )
+    {
+        if ( next(&rStruct -> public, event) )
+        {
+            free(event);
+            return EXIT_FAILURE;
+        }
+
+        if ( event -> type != REPLAY_KEYFRAME )
+        {
+            continue;
+        }
+
+        // Room for twice as many
+        if ( rStruct -> nKeyframes == size )
+        {
+            keyframe_t * keyframes;
+
+            size = (size > 0) ? 2 * size : 16;
+            keyframes = realloc(rStruct -> keyframes,
+                                size * sizeof (keyframe_t));
+
+            if ( keyframes == NULL )
+            {
+                free(event);
+                return EXIT_FAILURE;
+            }
+
+            rStruct -> keyframes = keyframes;
+        }
+
+        rStruct -> keyframes[rStruct -> nKeyframes].position = position;
+        rStruct -> keyframes[rStruct -> nKeyframes].pieces = 0;
+
+        for ( i = 0; i < TETROMINOS; i++ )
+        {
+            rStruct -> keyframes[rStruct -> nKeyframes].pieces += \
+                    event -> keyframe.stats.number[i];
+        }
+
+        rStruct -> nKeyframes++;
+    }
+
+    free(event);
+
+    rStruct -> position = start;
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Write the chunks queued by a replay
+ * 
+ * Called by the writer with recorders locked, or when the replay is closed
+ * and out of the list.
+ * 
+ * @param rStruct Private structure of the replay
+ * 
+ * @return Nothing
+ */
+static void
+flush (replay_private_t * rStruct)
+{
+    chunk_t * chunk;
+    size_t written = atomic_load_explicit(&rStruct -> written,
+                                          memory_order_relaxed);
+    size_t queued = atomic_load_explicit(&rStruct -> queued,
+                                         memory_order_acquire);
+
+    if ( written == queued )
+    {
+        return;
+    }
+
+    for ( ; written != queued; written++ )
+    {
+        chunk = &rStruct -> ring[written % REPLAY_CHUNKS];
+
+        (fwrite(chunk -> data, 1, chunk -> used, rStruct -> file) != \
+         chunk -> used) ? (rStruct -> failed = true) : 0;
+
+        // The game can fill it again
+        atomic_store_explicit(&rStruct -> written, written + 1,
+                              memory_order_release);
+    }
+
+    fflush(rStruct -> file);
+}
+
+/**
+ * @brief Initialize the semaphore of the writer
+ * 
+ * Called once, through recordersOnce.
+ * 
+ * @return Nothing
+ */
+static void
+initRecorders (void)
+{
+    (sem_init(&recorders.wake, 0, 0) != 0) ? \
+            fputs("Could not create the replay semaphore.", stderr) : 0;
+}
+
+/**
+ * @brief Record a keyframe
+ * 
+ * @param self Structure from which this function is called
+ * @param state State of the game
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+static int
+keyframe (replay_t * self, const board_state_t * state)
+{
+    int64_t values[KEYFRAME_VALUES];
+    unsigned char buffer[(KEYFRAME_VALUES + 1) * VARINT_BYTES];
+    replay_private_t * rStruct = PRIVATE(self);
+
+    if ( self -> recording == false || state == NULL )
+    {
+        fputs("Invalid keyframe for the replay.", stderr);
+        return EXIT_FAILURE;
+    }
+
+    stateValues((board_state_t *) state, values, false);
+
+    return append(rStruct, buffer, encode(rStruct, buffer, REPLAY_KEYFRAME,
+                                          KEYFRAME_VALUES, values));
+}
+
+/**
+ * @brief Read the next event of a loaded replay
+ * 
+ * @param self Structure from which this function is called
+ * @param event Where the event is written
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+static int
+next (replay_t * self, replay_event_t * event)
+{
+    int i;
+    uint64_t value;
+    int64_t values[KEYFRAME_VALUES];
+    replay_private_t * rStruct = PRIVATE(self);
+
+    if ( self -> recording == true || event == NULL )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if ( rStruct -> position >= rStruct -> size )
+    {
+        self -> finished = true;
+        return EXIT_FAILURE;
+    }
+
+    if ( readVarint(rStruct, &value) )
+    {
+        return EXIT_FAILURE;
+    }
+
+    event -> type = (int) (value & ((1 << TYPE_BITS) - 1));
+    event -> delay = value >> TYPE_BITS;
+
+    if ( event -> type >= REPLAY_EVENTS )
+    {
+        fputs("Invalid event in the replay.", stderr);
+        return EXIT_FAILURE;
+    }
+
+    event -> n = eventArgs[event -> type];
+
+    if ( event -> n == VARIABLE )
+    {
+        if ( readVarint(rStruct, &value) || value > REPLAY_ARGS )
+        {
+            fputs("Invalid event in the replay.", stderr);
+            return EXIT_FAILURE;
+        }
+
+        event -> n = (int) value;
+    }
+
+    for ( i = 0; i < event -> n; i++ )
+    {
+        if ( readVarint(rStruct, &value) )
+        {
+            fputs("Invalid event in the replay.", stderr);
+            return EXIT_FAILURE;
+        }
+
+        values[i] = (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+    }
+
+    // Keyframes have no arguments but the state
+    if ( event -> type == REPLAY_KEYFRAME )
+    {
+        stateValues(&event -> keyframe, values, true);
+        event -> n = 0;
+    }
+    else
+    {
+        memcpy(event -> args, values, event -> n * sizeof (int64_t));
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Play the events of a loaded replay that happen in some time
+ * 
+ * @param self Structure from which this function is called
+ * @param board Board where the game is played again
+ * @param ms Milliseconds played, or REPLAY_MAX_SPEED
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+static int
+play (replay_t * self, board_t * board, uint64_t ms)
+{
+    size_t position;
+    replay_event_t event;
+    replay_private_t * rStruct = PRIVATE(self);
+
+    if ( self -> recording == true || board == NULL )
+    {
+        fputs("Invalid board for play()", stderr);
+        return EXIT_FAILURE;
+    }
+
+    rStruct -> elapsed = (ms > REPLAY_MAX_SPEED - rStruct -> elapsed) ? \
+            REPLAY_MAX_SPEED : rStruct -> elapsed + ms;
+
+    while ( self -> finished == false )
+    {
+        position = rStruct -> position;
+
+        if ( next(self, &event) )
+        {
+            // Broken, unless it's the end
+            return (self -> finished == true) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        // Not its time yet. It's read again in the next call
+        if ( event.delay > rStruct -> elapsed )
+        {
+            rStruct -> position = position;
+            break;
+        }
+
+        (rStruct -> elapsed != REPLAY_MAX_SPEED) ? \
+                (rStruct -> elapsed -= event.delay) : 0;
+
+        if ( replay_apply(board, &event) )
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Queue the chunk being filled to be written
+ * 
+ * The next chunk of the ring is taken to keep recording. The writer sees
+ * the queued one once the count is moved, with no lock.
+ * 
+ * @param rStruct Private structure of the replay
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE if the next chunk isn't written yet. The event
+ * being recorded is lost
+ */
+static int
+queueChunk (replay_private_t * rStruct)
+{
+    size_t queued = atomic_load_explicit(&rStruct -> queued,
+                                         memory_order_relaxed);
+
+    if ( queued + 1 - atomic_load_explicit(&rStruct -> written,
+                                           memory_order_acquire) >=
+         REPLAY_CHUNKS )
+    {
+        (rStruct -> failed == false) ? \
+                fputs("The replay writer fell behind.", stderr) : 0;
+        rStruct -> failed = true;
+        return EXIT_FAILURE;
+    }
+
+    rStruct -> ring[(queued + 1) % REPLAY_CHUNKS].used = 0;
+
+    atomic_store_explicit(&rStruct -> queued, queued + 1,
+                          memory_order_release);
+    sem_post(&recorders.wake);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Read a varint
+ * 
+ * @param rStruct Private structure of the replay
+ * @param value Where the number is written
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE if the replay ends before it
+ */
+static int
+readVarint (replay_private_t * rStruct, uint64_t * value)
+{
+    int shift = 0;
+    unsigned char byte;
+
+    *value = 0;
+
+    do
+    {
+        if ( rStruct -> position >= rStruct -> size ||
+             shift >= VARINT_BYTES * 7 )
+        {
+            return EXIT_FAILURE;
+        }
+
+        byte = rStruct -> data[rStruct -> position++];
+        *value |= (uint64_t) (byte & 0x7F) << shift;
+        shift += 7;
+    }
+    while ( byte & 0x80 );
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Set a board as it was before a piece was deployed
+ * 
+ * @param self Structure from which this function is called
+ * @param board Board where the game is played again
+ * @param piece Pieces deployed before
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+static int
+seek (replay_t * self, board_t * board, int piece)
+{
+    int first, last, middle;
+    int cells[BLOCKS][COORD_NUM];
+    size_t position;
+    replay_event_t event;
+    replay_private_t * rStruct = PRIVATE(self);
+
+    if ( self -> recording == true || board == NULL || piece < 0 )
+    {
+        fputs("Invalid board for seek()", stderr);
+        return EXIT_FAILURE;
+    }
+
+    if ( rStruct -> nKeyframes == 0 ||
+         rStruct -> keyframes[0].pieces > piece )
+    {
+        fputs("There's no keyframe before that piece.", stderr);
+        return EXIT_FAILURE;
+    }
+
+    // Last keyframe before the piece
+    first = 0;
+    last = rStruct -> nKeyframes - 1;
+
+    while ( first < last )
+    {
+        middle = (first + last + 1) / 2;
+
+        (rStruct -> keyframes[middle].pieces <= piece) ? \
+                (first = middle) : (last = middle - 1);
+    }
+
+    rStruct -> position = rStruct -> keyframes[first].position;
+    rStruct -> elapsed = 0;
+    self -> finished = false;
+
+    if ( next(self, &event) || board_restore(board, &event.keyframe) )
+    {
+        return EXIT_FAILURE;
+    }
+
+    // Every event until the update deploying the next piece
+    position = rStruct -> position;
+
+    while ( !next(self, &event) )
+    {
+        if ( event.type == REPLAY_UPDATE && deployed(board) == piece &&
+             board -> ask.piece(board, cells) == TETROMINO_NONE )
+        {
+            rStruct -> position = position;
+            return EXIT_SUCCESS;
+        }
+
+        if ( replay_apply(board, &event) )
+        {
+            return EXIT_FAILURE;
+        }
+
+        position = rStruct -> position;
+    }
+
+    // The game ended before
+    return (self -> finished == true && deployed(board) == piece) ? \
+            EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Copy a board state to or from the values of a keyframe
+ * 
+ * @param state Board state
+ * @param values Values of the keyframe
+ * @param load true to copy the values to the state, false to copy the state
+ * to the values
+ * 
+ * @return Nothing
+ */
+static void
+stateValues (board_state_t * state, int64_t values[KEYFRAME_VALUES],
+             bool load)
+{
+    int i, j, n = 0;
+
+    // Padding is cleared, so it can be compared with a snapshot
+    (load == true) ? memset(state, 0, sizeof (board_state_t)) : 0;
+
+    for ( i = 0; i < BOARD_HEIGHT + HIDDEN_ROWS; i++ )
+    {
+        for ( j = 0; j < BOARD_WIDTH; j++ )
+        {
+            STATE_VALUE(state -> cells[i][j]);
+        }
+
+        STATE_VALUE(state -> rows[i]);
+    }
+
+    for ( i = 0; i < BOARD_WIDTH; i++ )
+    {
+        STATE_VALUE(state -> heights[i]);
+    }
+
+    STATE_VALUE(state -> touched);
+    STATE_VALUE(state -> status.moving);
+    STATE_VALUE(state -> status.topOut);
+
+    STATE_VALUE(state -> piece.type);
+    STATE_VALUE(state -> piece.orientation);
+
+    for ( i = 0; i < COORD_NUM; i++ )
+    {
+        STATE_VALUE(state -> piece.move[i]);
+    }
+
+    for ( i = 0; i < TETROMINOS; i++ )
+    {
+        STATE_VALUE(state -> bag.pieces[i]);
+        STATE_VALUE(state -> stats.number[i]);
+    }
+
+    STATE_VALUE(state -> bag.position);
+    STATE_VALUE(state -> bag.lastTetromino);
+    STATE_VALUE(state -> bag.piecesSinceI);
+    STATE_VALUE(state -> bag.szInARow);
+
+    for ( i = 0; i < RANDOM_HISTORY; i++ )
+    {
+        STATE_VALUE(state -> bag.history[i]);
+    }
+
+    STATE_VALUE(state -> bag.randomizer);
+    STATE_VALUE(state -> bag.seed);
+
+    for ( i = 0; i < (int) (sizeof (state -> bag.random) / sizeof (uint64_t));
+          i++ )
+    {
+        STATE_VALUE(state -> bag.random[i]);
+    }
+
+    STATE_VALUE(state -> stats.level);
+    STATE_VALUE(state -> stats.cleared);
+    STATE_VALUE(state -> stats.current);
+    STATE_VALUE(state -> stats.next);
+    STATE_VALUE(state -> stats.actual);
+    STATE_VALUE(state -> stats.lastPiece);
+    STATE_VALUE(state -> stats.lastDifficult);
+    STATE_VALUE(state -> stats.soft);
+    STATE_VALUE(state -> stats.newTop);
+}
+
+/**
+ * @brief Write a varint
+ * 
+ * 7 bits are written in every byte, the lowest first, with the highest bit
+ * set in every byte but the last one.
+ * 
+ * @param buffer Where it's written. There must be room for VARINT_BYTES
+ * @param value Number
+ * 
+ * @return Bytes written
+ */
+static size_t
+writeVarint (unsigned char * buffer, uint64_t value)
+{
+    size_t n = 0;
+
+    while ( value >= 0x80 )
+    {
+        buffer[n++] = (unsigned char) (value | 0x80);
+        value >>= 7;
+    }
+
+    buffer[n++] = (unsigned char) value;
+
+    return n;
+}
+
+/**
+ * @brief Write the queued chunks of every replay until there's none left
+ * 
+ * @param arg Unused
+ * 
+ * @return NULL
+ */
+static void *
+writer (void * arg)
+{
+    replay_private_t * rStruct;
+
+    (void) arg;
+
+    pthread_mutex_lock(&recorders.lock);
+
+    while ( recorders.first != NULL )
+    {
+        pthread_mutex_unlock(&recorders.lock);
+
+        // A chunk was queued, or the last replay was closed
+        sem_wait(&recorders.wake);
+
+        pthread_mutex_lock(&recorders.lock);
+
+        for ( rStruct = recorders.first; rStruct != NULL;
+              rStruct = rStruct -> nextRecording )
+        {
+            flush(rStruct);
+        }
+    }
+
+    // The next replay recorded starts another one
+    recorders.running = false;
+
+    pthread_mutex_unlock(&recorders.lock);
+
+    return NULL;
+}
@@ -0,0 +1,308 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ * 
+ * @file    replay.h
+ * 
+ * @brief   Compact binary recording of a game, that can be played again.
+ * 
+ * A replay is given to a board with set.replay() and every call that changes
+ * the game is written to it as an event: the seed, randomizer, start level
+ * and start rows first, then every update, shift, rotation, drop, placement,
+ * scored and cleared line. Applying the same events to a new board with
+ * replay_apply() gets the same game, so it can be played again headless.
+ * 
+ * Every REPLAY_KEYFRAME_PIECES pieces, the whole state of the game is
+ * recorded too. A loaded replay can seek() to any piece restoring the last
+ * keyframe before it, so only a few pieces are played again, and play() it
+ * at its own pace or as fast as possible. Keyframes found while playing are
+ * compared with the board, so a game that isn't played the same is noticed.
+ * 
+ * Every event takes a byte with the milliseconds since the last one, if
+ * there were less than 8, and its arguments as varints, so a game takes a
+ * few KB. Events are written to a ring of chunks in memory, and whole
+ * chunks are given without a lock to a thread that writes every replay, so
+ * recording never waits for the file.
+ * 
+ * The frontends record every game in REPLAY_LAST, through REPLAY_GAME().
+ * To stop recording them, add the argument -D NOREPLAY at compilation time.
+ * 
+ * @note replay_record() or replay_load() <b>must</b> be called to get a
+ * replay, and replay_close() to free it.
+ * 
+ * @note With TRUERANDOM pieces aren't given by the seed, so the events are
+ * recorded but a game isn't played the same again.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 18:20
+ * 
+ * @copyright GNU General Public License v3
+ */
+
+#ifndef REPLAY_H
+#    define REPLAY_H 1
+
+// === Libraries and header files ===
+/// For bool, true and false
+#    include <stdbool.h>
+
+/// For int64_t and uint64_t
+#    include <stdint.h>
+
+/// For board_t and BOARD_HEIGHT
+#    include "../board/board.h"
+
+// === Constants and Macro definitions ===
+
+/**
+ * @def REPLAY_CHUNK
+ * @brief Bytes of events kept in memory before they're written to the file
+ */
+#    define REPLAY_CHUNK        4096
+
+/**
+ * @def REPLAY_CHUNKS
+ * @brief Chunks in the ring of a replay being recorded. Events are dropped
+ * if the writer falls this far behind
+ */
+#    define REPLAY_CHUNKS       16
+
+/**
+ * @def REPLAY_ARGS
+ * @brief Most arguments of an event: the rows cleared at once, or a row and
+ * its cells
+ */
+#    define REPLAY_ARGS         (BOARD_HEIGHT + 1)
+
+/**
+ * @def REPLAY_KEYFRAME_PIECES
+ * @brief Pieces deployed between keyframes
+ */
+#    define REPLAY_KEYFRAME_PIECES      100
+
+/**
+ * @def REPLAY_MAX_SPEED
+ * @brief Milliseconds given to play() to play every event left at once
+ */
+#    define REPLAY_MAX_SPEED    UINT64_MAX
+
+/**
+ * @def REPLAY_LAST
+ * @brief File where the frontends record the last game played
+ */
+#    define REPLAY_LAST         "gamefiles/last.txr"
+
+#    ifndef NOREPLAY
+/**
+ * @def REPLAY_GAME()
+ * @brief Replay where a frontend records a new game. NULL if it couldn't be
+ * created, or with NOREPLAY
+ */
+#        define REPLAY_GAME()       replay_record(REPLAY_LAST)
+#    else
+#        define REPLAY_GAME()       ((replay_t *) NULL)
+#    endif
+
+// === Enumerations, structures and typedefs ===
+
+/**
+ * @brief Events of a replay, with their arguments
+ * 
+ * @note There can't be more than 16 events, and they can only be added at
+ * the end, so older replays can still be read.
+ */
+enum replayEvents
+{
+    /// set.seed(): seed
+    REPLAY_SEED = 0,
+    /// set.randomizer(): randomizer
+    REPLAY_RANDOMIZER,
+    /// set.startLevel(): level
+    REPLAY_START_LEVEL,
+    /// set.startRows(): rows
+    REPLAY_START_ROWS,
+    /// set.row(): row and the BOARD_WIDTH cells
+    REPLAY_ROW,
+    /// update(), including the gravity ticks
+    REPLAY_UPDATE,
+    /// piece.shift(): direction
+    REPLAY_SHIFT,
+    /// piece.rotate(): direction
+    REPLAY_ROTATE,
+    /// piece.softDrop()
+    REPLAY_SOFT_DROP,
+    /// piece.hardDrop()
+    REPLAY_HARD_DROP,
+    /// piece.place(): column, row and orientation
+    REPLAY_PLACE,
+    /// clear.lines() and clear.line(): the rows cleared
+    REPLAY_CLEAR_LINES,
+    /// ask.filledRows() after a piece is fixed or a row is loaded
+    REPLAY_FILLED_ROWS,
+    /// State of the game before a piece is deployed, in keyframe
+    REPLAY_KEYFRAME,
+    /// Number of events
+    REPLAY_EVENTS
+};
+
+/**
+ * @brief An event read from a replay
+ */
+typedef struct REPLAY_EVENT
+{
+    /// One of replayEvents enum
+    int type;
+
+    /// Milliseconds since the last event
+    uint64_t delay;
+
+    /// Number of arguments
+    int n;
+
+    /// Arguments, as described in replayEvents enum
+    int64_t args[REPLAY_ARGS];
+
+    /// State of the game of a REPLAY_KEYFRAME
+    board_state_t keyframe;
+} replay_event_t;
+
+/**
+ * @brief Replay object.
+ * 
+ * @warning Must be created with replay_record() or replay_load() and freed
+ * with replay_close().
+ * 
+ * @headerfile replay.h
+ */
+typedef struct REPLAY
+{
+    /// Set to true when the replay is initialized.
+    bool init;
+
+    /// Set to true if the replay is being recorded, false if it's read
+    bool recording;
+
+    /// Set to true once every event of a loaded replay was read
+    bool finished;
+
+    /**
+     * @brief Record an event
+     * 
+     * Called by the board, so it isn't needed unless the game is played
+     * some other way.
+     * 
+     * @param self Structure from which this function is called
+     * @param type One of replayEvents enum
+     * @param n Number of arguments
+     * @param args Arguments, as described in replayEvents enum
+     * 
+     * @return Success: EXIT_SUCCESS
+     * @return Fail: EXIT_FAILURE if the replay isn't being recorded, or it
+     * couldn't be kept
+     */
+    int (* event) (struct REPLAY * self, int type, int n,
+                   const int64_t args[]);
+
+    /**
+     * @brief Record a keyframe
+     * 
+     * Called by the board before every REPLAY_KEYFRAME_PIECES pieces are
+     * deployed.
+     * 
+     * @param self Structure from which this function is called
+     * @param state State of the game, taken with board_snapshot()
+     * 
+     * @return Success: EXIT_SUCCESS
+     * @return Fail: EXIT_FAILURE if the replay isn't being recorded, or it
+     * couldn't be kept
+     */
+    int (* keyframe) (struct REPLAY * self, const board_state_t * state);
+
+    /**
+     * @brief Read the next event of a loaded replay
+     * 
+     * @param self Structure from which this function is called
+     * @param event Where the event is written
+     * 
+     * @return Success: EXIT_SUCCESS
+     * @return Fail: EXIT_FAILURE at the end of the replay, or if it's
+     * broken
+     */
+    int (* next) (struct REPLAY * self, replay_event_t * event);
+
+    /**
+     * @brief Play the events of a loaded replay that happen in some time
+     * 
+     * Events are applied to the board with replay_apply(), from where the
+     * last call to play() or seek() stopped. The time left before the next
+     * event is kept for the following call.
+     * 
+     * @param self Structure from which this function is called
+     * @param board Board where the game is played again
+     * @param ms Milliseconds played. REPLAY_MAX_SPEED plays every event left
+     * 
+     * @return Success: EXIT_SUCCESS, and finished is set at the end
+     * @return Fail: EXIT_FAILURE if an event is invalid or a keyframe isn't
+     * the same as the board
+     */
+    int (* play) (struct REPLAY * self, board_t * board, uint64_t ms);
+
+    /**
+     * @brief Set a board as it was before a piece was deployed
+     * 
+     * The last keyframe before the piece is restored and the events after it
+     * are applied, so it takes as long as playing REPLAY_KEYFRAME_PIECES
+     * pieces at most. Playing goes on from there.
+     * 
+     * @param self Structure from which this function is called
+     * @param board Board where the game is played again
+     * @param piece Pieces deployed before, from 0
+     * 
+     * @return Success: EXIT_SUCCESS
+     * @return Fail: EXIT_FAILURE if the game has less pieces, or the replay
+     * has no keyframes. The board is left at the end of the game in the
+     * first case
+     */
+    int (* seek) (struct REPLAY * self, board_t * board, int piece);
+} replay_t;
+
+// === Global variables ===
+
+// === ROM Constant variables ===
+
+// === Global function definitions ===
+
+// Apply an event of a replay to a board
+int
+replay_apply (board_t * board, const replay_event_t * event);
+
+// Free a replay, writing the events left if it's being recorded
+int
+replay_close (replay_t * self);
+
+// Load a replay to play it again
+replay_t *
+replay_load (const char * path);
+
+// Start recording a replay
+replay_t *
+replay_record (const char * path);
+
+#endif /* REPLAY_H */
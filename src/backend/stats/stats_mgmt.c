@@ -61,73 +61,61 @@
 #define TETRIS_P          800
 // === Enumerations, structures and typedefs ===
 
-/**
- * @brief Private structure for stats_t
- */
-typedef struct STATS_PRIVATE
-{
-    /// Public stats_t
-    stats_t * public;
-
-    /// Last piece copy from public
-    int lastPiece;
-
-    /// The last clearing was a difficult one (i.e. back2back)
-    int lastDifficult;
-
-    /// Soft drop performed
-    int soft;
-
-    /// There is a new top score!
-    int newTop;
-
-    // Top score file r/w operations
-    rwScores_t scoreFile;
-
-    // Top score file loaded properly
-    bool tsLoaded;
-} stats_private_t;
-
 // === Global variables ===
 
 // === Function prototypes for private functions with file level scope ===
 
 // Verify if the previous move was a difficult one and add extra points
 static int
-back2Back (int points);
+back2Back (stats_t * self, int points);
 
 // Destroy current stats, erasing all the structure's information
 static void
-destroy (void);
+destroy (stats_t * self);
+
+// A hard drop has been performed, so add 1 to the score per row dropped
+static void
+hardDrop (stats_t * self, int rows);
+
+// Set the stats of a game from a board state
+static void
+load (stats_t * self, const board_state_t * state);
+
+// Read the top scores file, creating it if it doesn't exist
+static int
+loadTopScores (stats_t * self);
 
 // Update the stats with a new piece
 static void
-newPiece (int * cp, int * np);
+newPiece (stats_t * self, int * cp, int * np);
+
+// Copy the stats of the game to a board state
+static void
+save (stats_t * self, board_state_t * state);
 
 // A soft drop has been performed, so add 1 to the score
 static void
-softDrop (void);
+softDrop (stats_t * self);
 
 // Advance to the next level if conditions are met
 static void
-uLevel (void);
+uLevel (stats_t * self);
 
 // Update the number of lines cleared
 static void
-uLines (int rows);
+uLines (stats_t * self, int rows);
 
 // Update scoring when a/some line(s) is/are cleared
 static void
-updateStats (int rows);
+updateStats (stats_t * self, int rows);
 
 // Keep actual and top score equal if the actual is bigger
 static void
-uScore (void);
+uScore (stats_t * self);
 
 // === ROM Constant variables with file level scope ===
 
 // === Static variables and constant variables with file level scope ===
-static stats_private_t gameStats;
 
 // === Global function definitions ===
 /// @publicsection
@@ -135,84 +123,64 @@ static stats_private_t gameStats;
 /**
  * @brief Initialize a STATS structure
  * 
- * @param stats STATS structure to initialize
+ * @param self STATS structure to initialize
  * 
  * @return Success: EXIT_SUCCESS
  * @return Fail: EXIT_FAILURE
  */
 int
-initStats (struct STATS * stats)
+initStats (struct STATS * self)
 {
     // Counter
     int i;
 
 
-    if ( stats == NULL )
+    if ( self == NULL )
     {
         fputs("Invalid STATS structures.", stderr);
         return EXIT_FAILURE;
     }
 
-    gameStats.public = stats;
-
     // Hold as uninitialized until done
-    gameStats.public -> _init = false;
+    self -> _init = false;
 
-    gameStats.public -> level = 0;
-    gameStats.public -> lines.cleared = 0;
-    gameStats.public -> piece.next = TETROMINO_NONE;
-    gameStats.public -> piece.current = TETROMINO_NONE;
-    gameStats.public -> _tsLoaded = false;
-    gameStats.public -> topScores = NULL;
+    self -> level = 0;
+    self -> lines.cleared = 0;
+    self -> piece.next = TETROMINO_NONE;
+    self -> piece.current = TETROMINO_NONE;
+    self -> _tsLoaded = false;
+    self -> topScores = NULL;
 
     for ( i = 0; i < TETROMINOS; i++ )
     {
-        gameStats.public -> piece.number[i] = 0;
+        self -> piece.number[i] = 0;
     }
 
-    // Initialize rw operations and read top score
-    if ( init_rwOps(&gameStats.scoreFile) )
-    {
-        fputs("R/W Ops could not be initialized. Stats will run anyway.",
-              stderr);
+    // Top scores are read by loadTopScores(), only when they're shown
+    self -> score.top = 0;
+    self -> _private.tsLoaded = false;
 
-        gameStats.public -> score.top = 0;
-        gameStats.tsLoaded = false;
-    }
+    self -> score.actual = 0;
 
-    else if ( gameStats.scoreFile.get.readTopScore(&gameStats.scoreFile) )
-    {
-        fputs("Top scores could not be readed. Stats will run anyway.",
-              stderr);
+    self -> softDrop = &softDrop;
+    self -> hardDrop = &hardDrop;
+    self -> update = &updateStats;
+    self -> newPiece = &newPiece;
+    self -> save = &save;
+    self -> load = &load;
+    self -> loadTopScores = &loadTopScores;
+    self -> destroy = &destroy;
 
-        gameStats.public -> score.top = 0;
-        gameStats.tsLoaded = false;
-    }
+    self -> _private.lastPiece = TETROMINO_NONE;
 
-    else
-    {
-        gameStats.public -> topScores = &gameStats.scoreFile;
-        gameStats.public -> score.top = gameStats.scoreFile.get._scores[0];
-        gameStats.tsLoaded = gameStats.public -> _tsLoaded = true;
-    }
-
-    gameStats.public -> score.actual = 0;
-
-    gameStats.public -> softDrop = &softDrop;
-    gameStats.public -> update = &updateStats;
-    gameStats.public -> newPiece = &newPiece;
-    gameStats.public -> destroy = &destroy;
+    self -> _private.soft = 0;
 
-    gameStats.lastPiece = TETROMINO_NONE;
+    self -> _private.newTop = false;
 
-    gameStats.soft = 0;
-
-    gameStats.newTop = false;
-
-    gameStats.lastDifficult = false;
+    self -> _private.lastDifficult = false;
 
     // Set as initialized
-    gameStats.public -> _init = true;
+    self -> _init = true;
 
     return EXIT_SUCCESS;
 }
@@ -223,6 +191,7 @@ initStats (struct STATS * stats)
 /**
  * @brief Verify if the previous move was a difficult one and add extra points
  * 
+ * @param self STATS structure from which this function is called
  * @param points How many points should be used in the calculation if the b2b 
  * is performed
  * 
@@ -233,20 +202,20 @@ initStats (struct STATS * stats)
  * performed and checking a previous one is desired.
  */
 static int
-back2Back (int points)
+back2Back (stats_t * self, int points)
 {
     int ans = EXIT_FAILURE;
 
-    if ( gameStats.lastDifficult == true )
+    if ( self -> _private.lastDifficult == true )
     {
-        gameStats.public -> score.actual += \
-                (points * gameStats.public -> level * 3 / 2);
+        self -> score.actual += \
+                (points * self -> level * 3 / 2);
 
         ans = EXIT_SUCCESS;
     }
 
     // This function is always called when a difficult action is performed
-    gameStats.lastDifficult = true;
+    self -> _private.lastDifficult = true;
 
     return ans;
 }
@@ -254,122 +223,253 @@ back2Back (int points)
 /**
  * @brief Destroy current stats, erasing all the structure's information
  * 
- * @param None
+ * @param self STATS structure from which this function is called
  * 
  * @return Nothing
  */
 static void
-destroy (void)
+destroy (stats_t * self)
 {
     int i;
 
     // Clear private vars
-    gameStats.lastDifficult = false;
-    gameStats.lastPiece = TETROMINO_NONE;
-    gameStats.newTop = false;
-    gameStats.soft = 0;
-    gameStats.tsLoaded = gameStats.public -> _tsLoaded = false;
+    self -> _private.lastDifficult = false;
+    self -> _private.lastPiece = TETROMINO_NONE;
+    self -> _private.newTop = false;
+    self -> _private.soft = 0;
+    self -> _private.tsLoaded = self -> _tsLoaded = false;
 
     // Clear public vars
-    gameStats.public -> level = 0;
-    gameStats.public -> lines.cleared = 0;
-    gameStats.public -> piece.current = TETROMINO_NONE;
-    gameStats.public -> piece.next = TETROMINO_NONE;
-    gameStats.public -> score.actual = 0;
-    gameStats.public -> score.top = 0;
+    self -> level = 0;
+    self -> lines.cleared = 0;
+    self -> piece.current = TETROMINO_NONE;
+    self -> piece.next = TETROMINO_NONE;
+    self -> score.actual = 0;
+    self -> score.top = 0;
 
     for ( i = 0; i < TETROMINOS; i++ )
     {
-        gameStats.public -> piece.number[i] = 0;
+        self -> piece.number[i] = 0;
     }
 
     // Clear public pointers
-    gameStats.public -> softDrop = NULL;
-    gameStats.public -> newPiece = NULL;
-    gameStats.public -> update = NULL;
-    gameStats.public -> destroy = NULL;
-    gameStats.public = NULL;
+    self -> softDrop = NULL;
+    self -> hardDrop = NULL;
+    self -> newPiece = NULL;
+    self -> update = NULL;
+    self -> save = NULL;
+    self -> load = NULL;
+    self -> loadTopScores = NULL;
+    self -> destroy = NULL;
+}
+
+/**
+ * @brief A hard drop has been performed, so add 1 to the score per row dropped
+ * 
+ * Scores the same as soft dropping the piece the same number of rows.
+ * 
+ * @param self STATS structure from which this function is called
+ * @param rows Number of rows the piece was dropped
+ * 
+ * @return Nothing
+ */
+static void
+hardDrop (stats_t * self, int rows)
+{
+    if ( rows > 0 )
+    {
+        self -> score.actual += rows;
+
+        // Update score
+        uScore(self);
+    }
+}
+
+/**
+ * @brief Set the stats of a game from a board state
+ * 
+ * The top score is kept as it is.
+ * 
+ * @param self STATS structure from which this function is called
+ * @param state State taken with save()
+ * 
+ * @return Nothing
+ */
+static void
+load (stats_t * self, const board_state_t * state)
+{
+    int i;
+
+    self -> level = state -> stats.level;
+    self -> lines.cleared = state -> stats.cleared;
+    self -> piece.current = state -> stats.current;
+    self -> piece.next = state -> stats.next;
+    self -> score.actual = state -> stats.actual;
+
+    for ( i = 0; i < TETROMINOS; i++ )
+    {
+        self -> piece.number[i] = state -> stats.number[i];
+    }
+
+    self -> _private.lastPiece = state -> stats.lastPiece;
+    self -> _private.lastDifficult = state -> stats.lastDifficult;
+    self -> _private.soft = state -> stats.soft;
+    self -> _private.newTop = state -> stats.newTop;
+}
+
+/**
+ * @brief Read the top scores file, creating it if it doesn't exist
+ * 
+ * The top score becomes the highest one in the file, unless this game's is
+ * higher already.
+ * 
+ * @param self STATS structure from which this function is called
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+static int
+loadTopScores (stats_t * self)
+{
+    // Initialize rw operations and read top score
+    if ( init_rwOps(&self -> _private.scoreFile) )
+    {
+        fputs("R/W Ops could not be initialized. Stats will run anyway.",
+              stderr);
+
+        return EXIT_FAILURE;
+    }
+
+    if ( self -> _private.scoreFile.get.readTopScore(
+                                                  &self -> _private.scoreFile) )
+    {
+        fputs("Top scores could not be readed. Stats will run anyway.",
+              stderr);
+
+        return EXIT_FAILURE;
+    }
+
+    self -> topScores = &self -> _private.scoreFile;
+    self -> _private.tsLoaded = self -> _tsLoaded = true;
+
+    ((int) self -> _private.scoreFile.get._scores[0] > self -> score.top) ?
+            (self -> score.top = self -> _private.scoreFile.get._scores[0]) : 0;
+
+    return EXIT_SUCCESS;
 }
 
 /**
  * @brief Update the stats with a new piece
  * 
+ * @param self STATS structure from which this function is called
  * @param cp Current Piece (using pieces enum in board.h)
  * @param np Next Piece (using pieces enum in board.h)
  * 
  * @return Nothing
  */
 static void
-newPiece (int * cp, int * np)
+newPiece (stats_t * self, int * cp, int * np)
 {
-    gameStats.lastPiece = gameStats.public -> piece.current;
-    gameStats.public -> piece.current = *cp;
-    gameStats.public -> piece.next = *np;
+    self -> _private.lastPiece = self -> piece.current;
+    self -> piece.current = *cp;
+    self -> piece.next = *np;
 
     // Update how many pieces where dropped
-    (gameStats.public -> piece.number[gameStats.public -> piece.current])++;
+    (self -> piece.number[self -> piece.current])++;
+}
+
+/**
+ * @brief Copy the stats of the game to a board state
+ * 
+ * @param self STATS structure from which this function is called
+ * @param state Board state where the stats are written
+ * 
+ * @return Nothing
+ */
+static void
+save (stats_t * self, board_state_t * state)
+{
+    int i;
+
+    state -> stats.level = self -> level;
+    state -> stats.cleared = self -> lines.cleared;
+    state -> stats.current = self -> piece.current;
+    state -> stats.next = self -> piece.next;
+    state -> stats.actual = self -> score.actual;
+
+    for ( i = 0; i < TETROMINOS; i++ )
+    {
+        state -> stats.number[i] = self -> piece.number[i];
+    }
+
+    state -> stats.lastPiece = self -> _private.lastPiece;
+    state -> stats.lastDifficult = self -> _private.lastDifficult;
+    state -> stats.soft = self -> _private.soft;
+    state -> stats.newTop = self -> _private.newTop;
 }
 
 /**
  * @brief A soft drop has been performed, so add 1 to the score
  * 
- * @param None
+ * @param self STATS structure from which this function is called
  * 
  * @return Nothing
  */
 static void
-softDrop (void)
+softDrop (stats_t * self)
 {
-    (gameStats.public -> score.actual)++;
+    (self -> score.actual)++;
 
     // Update score
-    uScore();
+    uScore(self);
 }
 
 /**
  * @brief Advance to the next level if conditions are met
  * 
- * @param None
+ * @param self STATS structure from which this function is called
  * 
  * @return Nothing
  */
 static void
-uLevel (void)
+uLevel (stats_t * self)
 {
     // Advance to the next level when 10*n rows have been cleared
     // And 10*n equals the current level (i.e. level to advance from level 10
     // to 11, 110 must have been cleared)
-    if ( ((gameStats.public -> level + 1) * 10 <= \
-        gameStats.public -> lines.cleared) &&
-         (((gameStats.public -> lines.cleared) % 10 >= 0) &&
-          ((gameStats.public -> lines.cleared) % 10 <= BLOCKS)) )
+    if ( ((self -> level + 1) * 10 <= \
+        self -> lines.cleared) &&
+         (((self -> lines.cleared) % 10 >= 0) &&
+          ((self -> lines.cleared) % 10 <= BLOCKS)) )
     {
-        (gameStats.public -> level)++;
+        (self -> level)++;
     }
 }
 
 /**
  * @brief Update the number of lines cleared
  * 
+ * @param self STATS structure from which this function is called
  * @param rows Number of lines cleared
  * 
  * @return Nothing
  */
 static void
-uLines (int rows)
+uLines (stats_t * self, int rows)
 {
-    gameStats.public -> lines.cleared += rows;
+    self -> lines.cleared += rows;
 }
 
 /**
  * @brief Update scoring when a/some line(s) is/are cleared
  * 
+ * @param self STATS structure from which this function is called
  * @param rows Number of rows to be cleared
  * 
  * @return Nothing
  */
 static void
-updateStats (int rows)
+updateStats (stats_t * self, int rows)
 {
     // When no rows are cleared, exit
     if ( rows == 0 )
@@ -381,66 +481,66 @@ updateStats (int rows)
     switch ( rows )
     {
         case SINGLE:
-            (gameStats.public -> score.actual) += \
-                    (SINGLE_P * gameStats.public -> level);
-            gameStats.lastDifficult = false;
+            (self -> score.actual) += \
+                    (SINGLE_P * self -> level);
+            self -> _private.lastDifficult = false;
             break;
 
         case DOUBLE:
-            (gameStats.public -> score.actual) += \
-                    (DOUBLE_P * gameStats.public -> level);
-            gameStats.lastDifficult = false;
+            (self -> score.actual) += \
+                    (DOUBLE_P * self -> level);
+            self -> _private.lastDifficult = false;
             break;
 
         case TRIPLE:
-            (gameStats.public -> score.actual) += \
-                    (TRIPLE_P * gameStats.public -> level);
-            gameStats.lastDifficult = false;
+            (self -> score.actual) += \
+                    (TRIPLE_P * self -> level);
+            self -> _private.lastDifficult = false;
             break;
 
         case TETRIS:
 
             // A TETRIS clearing is a difficult task, so back2Back should be 
             // checked
-            if ( back2Back(TETRIS_P) )
+            if ( back2Back(self, TETRIS_P) )
             {
-                (gameStats.public -> score.actual) += \
-                        (TETRIS_P * gameStats.public -> level);
+                (self -> score.actual) += \
+                        (TETRIS_P * self -> level);
             }
 
             break;
 
         default:
-            gameStats.lastDifficult = false;
+            self -> _private.lastDifficult = false;
             break;
     }
 
     // Update number of lines
-    uLines(rows);
+    uLines(self, rows);
 
     // Update level
-    uLevel();
+    uLevel(self);
 
     // Update score
-    uScore();
+    uScore(self);
 
     // Restore soft drops counter
-    gameStats.soft = 0;
+    self -> _private.soft = 0;
 }
 
 /**
  * @brief Keep actual and top score equal if the actual is bigger
  * 
- * @param None
+ * @param self STATS structure from which this function is called
  * 
  * @return Nothing
  */
 static void
-uScore (void)
+uScore (stats_t * self)
 {
-    if ( gameStats.public -> score.actual >= gameStats.public -> score.top )
+    if ( self -> score.actual >= self -> score.top )
     {
-        gameStats.public -> score.top = gameStats.public -> score.actual;
-        gameStats.newTop = true;
+        self -> score.top = self -> score.actual;
+        self -> _private.newTop = true;
     }
 }
@@ -43,6 +43,34 @@
 
 // === Enumerations, structures and typedefs ===
 
+/**
+ * @brief Private variables of a STATS structure.
+ * 
+ * Kept inside every STATS structure so each game has its own.
+ * 
+ * @warning Must be modified only by stats_mgmt.c functions.
+ */
+typedef struct STATS_PRIVATE
+{
+    /// Last piece copy from public
+    int lastPiece;
+
+    /// The last clearing was a difficult one (i.e. back2back)
+    int lastDifficult;
+
+    /// Soft drop performed
+    int soft;
+
+    /// There is a new top score!
+    int newTop;
+
+    /// Top score file r/w operations
+    rwScores_t scoreFile;
+
+    /// Top score file loaded properly
+    bool tsLoaded;
+} stats_private_t;
+
 /**
  * @brief Holds current game statistics.
  * 
@@ -100,7 +128,8 @@ typedef struct STATS
     } score;
 
     /**
-     * @brief Set to true only when Top Scores file has been loaded properly.
+     * @brief Set to true only when Top Scores file has been loaded properly
+     * by loadTopScores().
      * 
      * If topScores is called while this variable is set to false, a NULL 
      * pointer will be readed.
@@ -110,42 +139,92 @@ typedef struct STATS
     /// Access and edit the top scores list
     rwScores_t * topScores;
 
+    /// Private variables. Do not access them
+    stats_private_t _private;
+
     /**
      * @brief Call when a soft drop has been performed
      * 
-     * @param None
+     * @param self Structure from which this function is called
      * 
      * @return Nothing
      */
-    void (* softDrop) (void);
+    void (* softDrop) (struct STATS * self);
+
+    /**
+     * @brief Call when a hard drop has been performed
+     * 
+     * @param self Structure from which this function is called
+     * @param rows Number of rows the piece was dropped
+     * 
+     * @return Nothing
+     */
+    void (* hardDrop) (struct STATS * self, int rows);
 
     /**
      * @brief Update the stats with a new piece
      * 
+     * @param self Structure from which this function is called
      * @param cp Current Piece (using pieces enum in board.h)
      * @param np Next Piece (using pieces enum in board.h)
      * 
      * @return Nothing
      */
-    void (* newPiece) (int * cp, int * np);
+    void (* newPiece) (struct STATS * self, int * cp, int * np);
+
+    /**
+     * @brief Copy the stats of the game to a board state
+     * 
+     * The top score is not copied.
+     * 
+     * @param self Structure from which this function is called
+     * @param state Board state where the stats are written
+     * 
+     * @return Nothing
+     */
+    void (* save) (struct STATS * self, board_state_t * state);
+
+    /**
+     * @brief Set the stats of the game from a board state
+     * 
+     * @param self Structure from which this function is called
+     * @param state State taken with save()
+     * 
+     * @return Nothing
+     */
+    void (* load) (struct STATS * self, const board_state_t * state);
+
+    /**
+     * @brief Read the top scores file, creating it if it doesn't exist
+     * 
+     * Stats don't touch the file until it's called, so games that don't
+     * show top scores do no I/O.
+     * 
+     * @param self Structure from which this function is called
+     * 
+     * @return Success: EXIT_SUCCESS
+     * @return Fail: EXIT_FAILURE
+     */
+    int (* loadTopScores) (struct STATS * self);
 
     /**
      * @brief Update scoring when a/some line(s) is/are cleared
      * 
+     * @param self Structure from which this function is called
      * @param rows Number of rows to be cleared
      * 
      * @return Nothing
      */
-    void (* update) (int rows);
+    void (* update) (struct STATS * self, int rows);
 
     /**
      * @brief Destroy current stats, erasing all the structure's information
      * 
-     * @param None
+     * @param self Structure from which this function is called
      * 
      * @return Nothing
      */
-    void (* destroy) (void);
+    void (* destroy) (struct STATS * self);
 
 } stats_t;
 
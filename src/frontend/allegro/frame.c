@@ -0,0 +1,180 @@
+/******************************************************************************
+ * Copyright (C) 2020 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/******************************************************************************
+ * 
+ * @file    frame.c
+ * 
+ * @brief   Frames handed from the game logic to the display
+ * 
+ * @details Lock free triple buffer. The index of the frame in between is
+ * swapped atomically, with a flag telling the reader if it's newer than the
+ * one it already has.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 10:12
+ * 
+ * @copyright GNU General Public License v3
+ *****************************************************************************/
+
+// === Libraries and header files ===
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>     // For memcpy and memset
+
+// This file
+#include "frame.h"
+
+/// @privatesection
+// === Constants and Macro definitions ===
+
+/**
+ * @def FRAME_FRESH
+ * @brief Set in the middle index when the writer published a frame the reader
+ * hasn't taken
+ */
+#define FRAME_FRESH     (1 << 2)
+
+/**
+ * @def FRAME_INDEX(m)
+ * @brief Frame index stored in the middle index @p m
+ */
+#define FRAME_INDEX(m)  ((m) & (FRAME_FRESH - 1))
+
+// === Enumerations, structures and typedefs ===
+
+// === Global variables ===
+
+// === Function prototypes for private functions with file level scope ===
+
+// === ROM Constant variables with file level scope ===
+
+// === Static variables and constant variables with file level scope ===
+
+// === Global function definitions ===
+/// @publicsection
+
+/**
+ * @brief Frame to write the next snapshot in
+ * 
+ * It belongs to the writer until frame_publish() is called.
+ * 
+ * @param frames Triple buffer
+ * 
+ * @return Writer's frame
+ */
+frame_t *
+frame_back (frames_t * frames)
+{
+    return &(frames -> slot[frames -> back]);
+}
+
+/**
+ * @brief Initialize a triple buffer
+ * 
+ * Every frame is cleared and none of them is fresh.
+ * 
+ * @param frames Triple buffer
+ * 
+ * @return Nothing
+ */
+void
+frame_init (frames_t * frames)
+{
+    memset(frames -> slot, 0, sizeof (frames -> slot));
+
+    frames -> back = 0;
+    frames -> front = 1;
+    atomic_init(&(frames -> middle), 2);
+}
+
+/**
+ * @brief Latest frame published
+ * 
+ * When there's a fresh frame, the reader's one is swapped with it. The frame
+ * returned belongs to the reader until the next call.
+ * 
+ * @param frames Triple buffer
+ * @param fresh Set to true if the frame wasn't returned before. Can be NULL
+ * 
+ * @return Reader's frame
+ */
+const frame_t *
+frame_latest (frames_t * frames, bool * fresh)
+{
+    bool isFresh = false;
+
+    if ( atomic_load_explicit(&(frames -> middle),
+                              memory_order_relaxed) & FRAME_FRESH )
+    {
+        // Acquire pairs with frame_publish release, so the writes to the
+        // frame are seen
+        frames -> front = FRAME_INDEX(atomic_exchange_explicit(
+                                      &(frames -> middle), frames -> front,
+                                      memory_order_acq_rel));
+        isFresh = true;
+    }
+
+    (fresh != NULL) ? (*fresh = isFresh) : 0;
+
+    return &(frames -> slot[frames -> front]);
+}
+
+/**
+ * @brief Publish the frame given by frame_back()
+ * 
+ * The writer gets the frame in between, which is either the oldest one or
+ * one the reader didn't take. It's never the reader's frame.
+ * 
+ * @param frames Triple buffer
+ * 
+ * @return Nothing
+ */
+void
+frame_publish (frames_t * frames)
+{
+    frames -> back = FRAME_INDEX(atomic_exchange_explicit(
+                                 &(frames -> middle),
+                                 frames -> back | FRAME_FRESH,
+                                 memory_order_acq_rel));
+}
+
+/**
+ * @brief Copy the board, pieces and stats of a game to a frame
+ * 
+ * The game status and the pause menu are left to the caller.
+ * 
+ * @param frame Frame to write
+ * @param logic Game logic
+ * 
+ * @return Nothing
+ */
+void
+frame_take (frame_t * frame, board_t * logic)
+{
+    memcpy(frame -> board, logic -> ask.board(logic), sizeof (frame -> board));
+
+    frame -> pieceType = logic -> ask.piece(logic, frame -> piece);
+    frame -> ghostType = logic -> ask.ghost(logic, frame -> ghost);
+
+    frame -> stats = *((const stats_t *) logic -> ask.stats(logic));
+}
+
+/// @privatesection
+// === Local function definitions ===
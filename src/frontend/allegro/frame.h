@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Copyright (C) 2020 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ * 
+ * @file    frame.h
+ * 
+ * @brief   Frames handed from the game logic to the display
+ * 
+ * @details The logic thread writes a frame with everything the game screen
+ * shows and publishes it. The display thread takes the latest published one
+ * and draws it, without reading the game logic.
+ * 
+ * Frames go through a triple buffer: the writer and the reader own a frame
+ * each, and they swap theirs with the one in between, so neither of them ever
+ * waits for the other. Only one thread may write and only one may read.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 10:12
+ * 
+ * @copyright GNU General Public License v3
+ */
+
+#ifndef FRAME_H
+#    define FRAME_H 1
+
+// === Libraries and header files ===
+#    include <stdbool.h>
+#    include <stdatomic.h>
+
+// For board_t, grid_t and the board size
+#    include "../../backend/board/board.h"
+// For stats_t
+#    include "../../backend/stats/stats_mgmt.h"
+// For pause_t
+#    include "screen/gamePause.h"
+// For latency_mark_t
+#    include "../../backend/latency/latency.h"
+
+// === Constants and Macro definitions ===
+
+/**
+ * @def FRAME_SLOTS
+ * @brief Frames in the buffer: the writer's, the reader's and the one in
+ * between
+ */
+#    define FRAME_SLOTS 3
+
+// === Enumerations, structures and typedefs ===
+
+/**
+ * @brief Everything the game screen shows at a given time
+ * 
+ * Once published, a frame is not modified until the reader hands it back.
+ */
+typedef struct
+{
+    /// Visible cells of the board. Read them with GET_CELL()
+    grid_t board[BOARD_HEIGHT * BOARD_WIDTH];
+
+    /// Tetromino of the moving piece, TETROMINO_NONE if there's none
+    int pieceType;
+    /// Cells of the moving piece
+    int piece[BLOCKS][COORD_NUM];
+
+    /// Tetromino of the ghost piece, TETROMINO_NONE if there's none
+    int ghostType;
+    /// Cells where the moving piece would land
+    int ghost[BLOCKS][COORD_NUM];
+
+    /// Game stats
+    stats_t stats;
+
+    /// Game status, using game.c enum
+    int status;
+
+    /// Pause menu
+    pause_t pause;
+
+    /// Oldest key moving the piece shown by this frame
+    latency_mark_t latency;
+} frame_t;
+
+/**
+ * @brief Triple buffer of frames
+ * 
+ * @warning Function frame_init() must be called before using this structure
+ */
+typedef struct
+{
+    /// Frames
+    frame_t slot[FRAME_SLOTS];
+
+    /// Frame owned by the writer
+    int back;
+
+    /// Frame owned by the reader
+    int front;
+
+    /// Frame in between. FRAME_FRESH is set when it hasn't been read yet
+    atomic_int middle;
+} frames_t;
+
+// === Global variables ===
+
+// === ROM Constant variables ===
+
+// === Global function definitions ===
+
+// Frame to write the next snapshot in
+frame_t *
+frame_back (frames_t * frames);
+
+// Initialize a triple buffer
+void
+frame_init (frames_t * frames);
+
+// Latest frame published
+const frame_t *
+frame_latest (frames_t * frames, bool * fresh);
+
+// Publish the frame given by frame_back()
+void
+frame_publish (frames_t * frames);
+
+// Copy the board, pieces and stats of a game to a frame
+void
+frame_take (frame_t * frame, board_t * logic);
+
+#endif /* FRAME_H */
@@ -35,6 +35,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include <string.h>     // For strcmp and strlen
 
 // Allegro
@@ -58,9 +59,24 @@
 #include "../../../backend/stats/stats_mgmt.h"
 #include "../../../backend/board/timer/boardTimer.h"
 
+// Every game is recorded
+#include "../../../backend/replay/replay.h"
+
+// Timestamped keys, with delayed auto shift and auto repeat
+#include "../../../backend/input/input.h"
+
+// For monotonic_now, the clock keys are timestamped with
+#include "../../../backend/monotonic/monotonic.h"
+
+// Latency from the keys to the display, with -D LATENCY
+#include "../../../backend/latency/latency.h"
+
 // For drawing boxes
 #include "../primitives.h"
 
+// Frames handed from the logic thread to the display
+#include "../frame.h"
+
 // End Game screen
 #include "endGame.h"
 
@@ -76,12 +92,6 @@
 /// @privatesection
 // === Constants and Macro definitions ===
 
-/**
- * @def MS2S(t)
- * @brief Convert MS to S
- */
-#define MS2S(t)             ((t) / 1000.0)
-
 /**
  * @def DRAWSTATS(s)
  * @brief Call a function with prototype drawStats_(s)_f(&screenStats)
@@ -90,6 +100,8 @@
 
 // Display settings
 #define FPS                 60.0
+// Game logic ticks per second. Menu keys are checked on every tick
+#define LOGIC_RATE          60.0
 #define GAME_BKGND_COLOR    "#000000"
 #define BKGND_WIDTH         1920
 #define BKGND_HEIGHT        1280
@@ -160,20 +172,20 @@ typedef struct
     // Background
     ALLEGRO_BITMAP * bkgnd;
 
-    // Event queue
+    // Event queue, read by the game logic
     ALLEGRO_EVENT_QUEUE * evq;
 
+    // Display event queue, read by the thread drawing frames
+    ALLEGRO_EVENT_QUEUE * drawq;
+
     // Timers
 
     struct
     {
-        // Piece
-        ALLEGRO_TIMER * piece;
-        // Display refresh and general timer
+        // Game logic tick and general timer
         ALLEGRO_TIMER * main;
-
-        // Piece droping speed
-        float piece_speed;
+        // Display refresh while playing
+        ALLEGRO_TIMER * draw;
     } timer;
 
     // Initial configurations
@@ -199,17 +211,38 @@ typedef struct
     // Selected option in the game
     int status;
 
-    // Quit game
-    bool exit;
+    // Quit game. Read by both threads while playing
+    atomic_bool exit;
+
+    // The display was closed. Written only by the thread drawing frames
+    bool closed;
+
+    // The game is over and the end game screen should be shown
+    bool over;
 
-    // Redraw display
+    // Publish a new frame
     bool redraw;
 
     // Restart game
     bool restart;
 
     // Game Logic
-    board_t logic;
+    board_t * logic;
+
+    // Replay the game is recorded in. Closed after the game logic is freed
+    replay_t * replay;
+
+    // Keys moving the piece. Pushed and taken by the game logic
+    input_t * input;
+
+    // Oldest key moving the piece not published yet
+    latency_mark_t latency;
+
+    // Pause menu
+    pause_t * pMenu;
+
+    // Frames published by the game logic
+    frames_t frames;
 
 } game_t;
 
@@ -218,12 +251,8 @@ typedef struct
  */
 typedef struct
 {
-    const stats_t * stats;
-
     gbox_t boardBox;
     gbox_t gridBox[TETROMINOS];
-
-    grid_t * r0c0;
 } screenBoard_t;
 
 // === Global variables ===
@@ -243,7 +272,14 @@ static void
 drawBlock (int x, int y, gbox_t * block);
 
 static void
-drawGameBoard (screenBoard_t * board);
+drawFrame (game_t * game,
+           screenBoard_t * screenBoard, screenStats_t * screenStats);
+
+static void
+drawGameBoard (screenBoard_t * board, const frame_t * frame);
+
+static void
+drawGhostBlock (int x, int y, gbox_t * block);
 
 static void
 drawInitial (game_t * game);
@@ -251,15 +287,23 @@ drawInitial (game_t * game);
 static void
 drawScreen (game_t * game);
 
+static uint64_t
+eventTime (const ALLEGRO_EVENT * event);
+
 static void
-gameManagement (game_t * game, screenBoard_t * screenBoard,
-                screenStats_t * screenStats, pause_t * pMenu);
+gameManagement (game_t * game);
 
 static void
 init_rowLevel (game_t * game);
 
 static void
-init_scrBoard (screenBoard_t * board, board_t * logic);
+init_scrBoard (screenBoard_t * board);
+
+static int
+keyAction (int keycode);
+
+static void *
+logicThread (ALLEGRO_THREAD * thread, void * arg);
 
 static void
 manageEvents (game_t * game, board_t * boardLogic, pause_t * menu);
@@ -268,15 +312,16 @@ static void
 playFX (char * path, game_t * game);
 
 static void
-restartGame (game_t * game, screenBoard_t * board, screenStats_t * stats);
+publishFrame (game_t * game);
+
+static void
+restartGame (game_t * game);
 
 static void
-restartPiecesTimer (game_t * game);
+takeActions (game_t * game, board_t * logic);
 
 static void
-validKey (int keyName,
-          unsigned char * keyArr, unsigned char * counterArr,
-          game_t * game);
+validKey (int keyName, unsigned char * keyArr, game_t * game);
 
 // === ROM Constant variables with file level scope ===
 static const char * tetrominos_bkgnd[TETROMINOS + 1] = {
@@ -307,6 +352,10 @@ alg_game (allegro_t * alStru)
     screenBoard_t screenBoard;
     screenStats_t screenStats;
     pause_t pMenu;
+    // Thread running the game logic while playing
+    ALLEGRO_THREAD * logic;
+    // Display event while choosing the initial rows and level
+    ALLEGRO_EVENT event;
 
     // Verify if everything is in order
     if ( alStru == NULL )
@@ -327,13 +376,19 @@ alg_game (allegro_t * alStru)
     game.display = alStru -> screen.display;
     game.bkgnd = NULL;
     game.evq = NULL;
-    game.timer.piece_speed = 1000.0;
-    game.timer.piece = NULL;
+    game.drawq = NULL;
     game.timer.main = NULL;
+    game.timer.draw = NULL;
+    game.input = NULL;
+    game.replay = NULL;
+    game.latency = (latency_mark_t) {0};
     game.status = INITIAL;
     game.exit = false;
+    game.closed = false;
+    game.over = false;
     game.redraw = true;
     game.restart = false;
+    game.pMenu = &pMenu;
 
     game.initial.ready = false;
     game.initial.n[LEVEL] = 0;
@@ -341,26 +396,43 @@ alg_game (allegro_t * alStru)
     game.initial.rl = LEVEL;
 
     // Init game logic
-    board_init(&(game.logic));
+    game.logic = board_create();
 
-    if ( game.logic.init == false )
+    if ( game.logic == NULL )
     {
         fputs("Error initializing boardLogic.", stderr);
         return AL_ERROR;
     }
 
+    // The end screen shows and saves the top scores
+    game.logic -> set.topScores(game.logic);
+
+    game.replay = REPLAY_GAME();
+    game.logic -> set.replay(game.logic, game.replay);
+
+    // Init keys moving the piece
+    game.input = input_create(INPUT_DAS, INPUT_ARR);
+
+    if ( game.input == NULL )
+    {
+        fputs("Error initializing input.", stderr);
+        board_free(game.logic);
+        replay_close(game.replay);
+        return AL_ERROR;
+    }
+
     // Initialize rows and levels
     init_rowLevel(&game);
     // Initialize screen board
-    init_scrBoard(&screenBoard, &(game.logic));
+    init_scrBoard(&screenBoard);
     // Initialize screen stats
-    init_scrStats(&screenStats, &(game.logic));
+    init_scrStats(&screenStats, game.logic);
     // Initialize pause menu
     init_pause(&pMenu, alStru);
 
     // == Timers ==
     // Main timer
-    game.timer.main = al_create_timer(1.0 / FPS);
+    game.timer.main = al_create_timer(1.0 / LOGIC_RATE);
 
     if ( !game.timer.main )
     {
@@ -370,10 +442,14 @@ alg_game (allegro_t * alStru)
         return AL_ERROR;
     }
 
-    // == Event Queue ==
+    // == Event Queues ==
+    // Display events go to their own queue, read by this thread. While
+    // playing, the game logic runs in another one, so a slow flip doesn't
+    // delay keys or gravity
     game.evq = al_create_event_queue();
+    game.drawq = al_create_event_queue();
 
-    if ( !game.evq )
+    if ( !game.evq || !game.drawq )
     {
         fputs("Failed to create event queue.", stderr);
         destroy(&game);
@@ -382,38 +458,58 @@ alg_game (allegro_t * alStru)
     }
 
     // Register events
-    // Display
-    al_register_event_source(game.evq,
-                             al_get_display_event_source(game.display));
     // Keyboard
     al_register_event_source(game.evq, al_get_keyboard_event_source());
     // Main timer
     al_register_event_source(game.evq,
                              al_get_timer_event_source(game.timer.main));
+    // Display
+    al_register_event_source(game.drawq,
+                             al_get_display_event_source(game.display));
 
     // Start events timers
     al_start_timer(game.timer.main);
 
-    while ( game.initial.ready == false )
+    while ( game.initial.ready == false && game.exit == false )
     {
         (game.redraw == true) ? \
             (drawInitial(&game)) : \
             (manageEvents(&game, NULL, &pMenu));
+
+        // Display closed while choosing
+        if ( al_get_next_event(game.drawq, &event) &&
+             event.type == ALLEGRO_EVENT_DISPLAY_CLOSE )
+        {
+            game.alStru -> exit = true;
+            game.exit = true;
+        }
+    }
+
+    if ( game.exit == true )
+    {
+        destroy(&game);
+        return AL_OK;
     }
 
-    game.logic.set.startRows(game.initial.n[ROWS]);
-    game.logic.set.startLevel(game.initial.n[LEVEL]);
+    game.logic -> set.startRows(game.logic, game.initial.n[ROWS]);
+    game.logic -> set.startLevel(game.logic, game.initial.n[LEVEL]);
 
     // Start a new game
     game.status = NEW;
 
-    // == Pieces Timer ==
-    // Init
-    initTimer(screenStats.gStats);
-    game.timer.piece_speed = askTimeLimit();
-    game.timer.piece = al_create_timer(MS2S(game.timer.piece_speed));
+    // Game background replaces the initial one
+    al_destroy_bitmap(game.bkgnd);
+    game.bkgnd = al_load_bitmap(GAME_BKGND);
 
-    if ( !game.timer.piece )
+    if ( game.bkgnd == NULL )
+    {
+        fputs("Error loading background.", stderr);
+    }
+
+    // == Display ==
+    game.timer.draw = al_create_timer(1.0 / FPS);
+
+    if ( !game.timer.draw )
     {
         fputs("Failed to create timer.", stderr);
         destroy(&game);
@@ -421,17 +517,48 @@ alg_game (allegro_t * alStru)
         return AL_ERROR;
     }
 
-    // Register event
-    al_register_event_source(game.evq,
-                             al_get_timer_event_source(game.timer.piece));
+    al_register_event_source(game.drawq,
+                             al_get_timer_event_source(game.timer.draw));
+
+    // First frame, taken before the game logic starts
+    frame_init(&game.frames);
+    publishFrame(&game);
+
+    // == Game logic ==
+    logic = al_create_thread(&logicThread, &game);
+
+    if ( logic == NULL )
+    {
+        fputs("Failed to create game logic thread.", stderr);
+        destroy(&game);
+        alg_destroy();
+        return AL_ERROR;
+    }
+
+    // Gravity counts from now, the time choosing is not played
+    startTimer(game.logic -> ask.timer(game.logic));
+    al_start_timer(game.timer.draw);
 
-    // Start pieces timer
-    al_start_timer(game.timer.piece);
+    al_start_thread(logic);
 
     // Draw and display window
     while ( game.exit == false )
     {
-        gameManagement(&game, &screenBoard, &screenStats, &pMenu);
+        drawFrame(&game, &screenBoard, &screenStats);
+        LATENCY_POLL();
+    }
+
+    // Wait for the game logic to see the exit flag
+    al_join_thread(logic, NULL);
+    al_destroy_thread(logic);
+
+    (game.closed == true) ? (game.alStru -> exit = true) : 0;
+
+    // Print End Game screen
+    if ( game.over == true )
+    {
+        alg_endGame(game.alStru,
+                    (stats_t *) game.logic -> ask.stats(game.logic));
     }
 
     // Stop music
@@ -451,43 +578,117 @@ alg_game (allegro_t * alStru)
 // === Local function definitions ===
 
 /**
- * @brief Manages in game drawing and actions
+ * @brief Draw the latest frame published by the game logic
+ * 
+ * Waits for the display timer, so frames are drawn at most FPS times per
+ * second, and only when there's a new one. Display events are handled too.
  * 
  * @param game Current game structure
  * @param screenBoard Screen board
  * @param screenStats Stats to draw in screen 
- * @param pMenu Pause menu structure
  * 
  * @return Nothing
  */
 static void
-gameManagement (game_t * game, screenBoard_t * screenBoard,
-                screenStats_t * screenStats, pause_t * pMenu)
+drawFrame (game_t * game,
+           screenBoard_t * screenBoard, screenStats_t * screenStats)
 {
-    // Check which line is filled
-    int filled, lines[BOARD_HEIGHT];
+    // Current event
+    ALLEGRO_EVENT event;
+    // Frame to draw
+    const frame_t * frame;
+    bool fresh;
+    // Times of the oldest key it shows
+    latency_mark_t mark;
 
-    // Draw game screen
-    drawScreen(game);
+    // Wait for next event
+    al_wait_for_event(game -> drawq, &event);
 
-    // Draw board
-    drawGameBoard(screenBoard);
+    switch ( event.type )
+    {
+            // Display
+        case ALLEGRO_EVENT_DISPLAY_CLOSE:
+            game -> closed = true;
+            game -> exit = true;
+            break;
+
+            // Display timer. Ticks piled up while flipping are skipped
+        case ALLEGRO_EVENT_TIMER:
+            if ( !al_is_event_queue_empty(game -> drawq) )
+            {
+                break;
+            }
+
+            frame = frame_latest(&(game -> frames), &fresh);
 
-    // Draw Stats
-    DRAWSTATS(pieces);
-    DRAWSTATS(level);
-    DRAWSTATS(score);
+            if ( fresh == false )
+            {
+                break;
+            }
 
-    screenStats -> showNextPiece = pMenu -> get.nextPiece;
-    DRAWSTATS(nextPiece);
+            // Draw game screen
+            drawScreen(game);
 
-    DRAWSTATS(lines);
+            // Draw board
+            drawGameBoard(screenBoard, frame);
 
-    // Game is paused
-    if ( game -> status == PAUSED )
+            // Draw Stats
+            screenStats -> gStats = &(frame -> stats);
+
+            DRAWSTATS(pieces);
+            DRAWSTATS(level);
+            DRAWSTATS(score);
+
+            screenStats -> showNextPiece = frame -> pause.get.nextPiece;
+            DRAWSTATS(nextPiece);
+
+            DRAWSTATS(lines);
+
+            // Game is paused
+            if ( frame -> status == PAUSED )
+            {
+                (frame -> pause.draw.beingDrawn == MAINMENU) ?
+                        (frame -> pause.draw.main(&(frame -> pause))) :
+                        (frame -> pause.draw.options(&(frame -> pause)));
+            }
+
+            // Flip
+            mark = frame -> latency;
+            LATENCY_COMPOSED(&mark);
+
+            al_flip_display();
+
+            LATENCY_SHOWN(&mark);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Manages in game actions
+ * 
+ * Handles the next event and, if the game changed, publishes a frame with it
+ * before clearing lines, restarting or ending the game.
+ * 
+ * @param game Current game structure
+ * 
+ * @return Nothing
+ */
+static void
+gameManagement (game_t * game)
+{
+    // Check which line is filled
+    int filled, lines[BOARD_HEIGHT];
+
+    // Keys and timers
+    manageEvents(game, game -> logic, game -> pMenu);
+
+    // Nothing to show
+    if ( game -> redraw == false )
     {
-        (pMenu -> draw.beingDrawn == MAINMENU) ?
-                (pMenu -> draw.main()) : (pMenu -> draw.options());
+        return;
     }
 
     // Play music
@@ -503,49 +704,40 @@ gameManagement (game_t * game, screenBoard_t * screenBoard,
         game -> alStru -> samples.music.stop();
     }
 
-    // Flip
-    al_flip_display();
+    // Show the game as it is now
+    publishFrame(game);
     game -> redraw = false;
 
     // Game should be restarted
     if ( game -> restart == true )
     {
         // Restart
-        restartGame(game, screenBoard, screenStats);
-        pMenu -> selected.n = 0;
+        restartGame(game);
+        game -> pMenu -> selected.n = 0;
     }
 
         // Check if a row has been filled
-    else if ( (filled = game -> logic.ask.filledRows(lines)) > 0 )
+    else if ( (filled = game -> logic -> ask.filledRows(game -> logic,
+                                                         lines)) > 0 )
     {
-        int i;
         // Remove line(s) from board
-        for ( i = 0; i < filled; i++ )
-        {
-            game -> logic.clear.line(lines, i);
-        }
+        game -> logic -> clear.lines(game -> logic, lines, filled);
         game -> redraw = true;
 
         // Play a sound FX when a line has been cleared
         playFX(FX_LINE, game);
-
-        // Restart pieces timer
-        restartPiecesTimer(game);
     }
 
         // Check End Game
-    else if ( game -> logic.ask.endGame() )
+    else if ( game -> logic -> ask.endGame(game -> logic) )
     {
-        // Stop timers
-        al_stop_timer(game -> timer.piece);
-
         // Play sound FX
         playFX(FX_GOVER, game);
 
-        // Inform a game over to internal structure but not to allegro_t
-        // This way data from this game will be destroyed after showing the
-        // end game screen but player will be able to play again
-        game -> alStru -> exit = false;
+        // The end game screen is shown once the display stops drawing frames.
+        // Data from this game will be destroyed after showing it but player
+        // will be able to play again
+        game -> over = true;
         game -> exit = true;
 
         // Stop music
@@ -554,56 +746,98 @@ gameManagement (game_t * game, screenBoard_t * screenBoard,
         {
             (game -> alStru -> samples.music.stop());
         }
+    }
+}
 
-        // Print End Game screen
-        alg_endGame(game -> alStru, (stats_t *) game -> logic.ask.stats());
+/**
+ * @brief Run the game logic until the game exits
+ * 
+ * @param thread Allegro thread running it
+ * @param arg Current game structure
+ * 
+ * @return NULL
+ */
+static void *
+logicThread (ALLEGRO_THREAD * thread, void * arg)
+{
+    game_t * game = (game_t *) arg;
 
-    }
+    (void) thread;
 
-    // Game goes on
-    while ( game -> redraw == false && game -> exit == false )
+    while ( game -> exit == false )
     {
-        manageEvents(game, &(game -> logic), pMenu);
+        gameManagement(game);
     }
+
+    return NULL;
+}
+
+/**
+ * @brief Publish a frame with the game as it is now
+ * 
+ * @param game Current game structure
+ * 
+ * @return Nothing
+ */
+static void
+publishFrame (game_t * game)
+{
+    frame_t * frame = frame_back(&(game -> frames));
+
+    frame_take(frame, game -> logic);
+
+    frame -> status = game -> status;
+    frame -> pause = *(game -> pMenu);
+
+    // Keys taken until now are shown by this frame
+    frame -> latency = game -> latency;
+    game -> latency = (latency_mark_t) {0};
+
+    frame_publish(&(game -> frames));
 }
 
 /**
  * @brief Restart the game and start a new one
  * 
  * @param game Old game structure (now current)
- * @param board Screen board
- * @param stats Screen stats
  */
 static void
-restartGame (game_t * game, screenBoard_t * board, screenStats_t * stats)
+restartGame (game_t * game)
 {
     // Destroy old game logic
-    game -> logic.destroy();
+    board_free(game -> logic);
+    replay_close(game -> replay);
+    game -> replay = NULL;
 
     // Init game logic
-    board_init(&(game -> logic));
+    game -> logic = board_create();
 
-    if ( game -> logic.init == false )
+    if ( game -> logic == NULL )
     {
         fputs("Error initializing boardLogic.", stderr);
         game -> exit = true;
+        return;
     }
 
-    // Use the same start rows and level as chosen before
-    game -> logic.set.startRows(game -> initial.n[ROWS]);
-    game -> logic.set.startLevel(game -> initial.n[LEVEL]);
+    game -> logic -> set.topScores(game -> logic);
 
-    // Init the new screen board and stats
-    init_scrBoard(board, &(game -> logic));
-    init_scrStats(stats, &(game -> logic));
+    game -> replay = REPLAY_GAME();
+    game -> logic -> set.replay(game -> logic, game -> replay);
+
+    // Use the same start rows and level as chosen before
+    game -> logic -> set.startRows(game -> logic, game -> initial.n[ROWS]);
+    game -> logic -> set.startLevel(game -> logic, game -> initial.n[LEVEL]);
 
     // Redraw and reset status
     game -> redraw = true;
     game -> restart = false;
     game -> status = NEW;
 
-    // Restart pieces timer
-    restartPiecesTimer(game);
+    // Keys held in the old game don't move the new one
+    game -> input -> release(game -> input);
+
+    // Gravity of the new game counts from now
+    startTimer(game -> logic -> ask.timer(game -> logic));
 }
 
 /**
@@ -625,13 +859,10 @@ checkKeys (unsigned char key[ALLEGRO_KEY_MAX],
     // Used to check if a key is in "Play" and "Pause" modes
     bool bothModes = false;
 
-    // Counter to make pieces less sensitive
-    static unsigned char counter[ALLEGRO_KEY_MAX];
-
     // Keys used in "Play Mode"
     const unsigned char playKeys[] = {
         ALLEGRO_KEY_UP, ALLEGRO_KEY_DOWN, ALLEGRO_KEY_LEFT, ALLEGRO_KEY_RIGHT,
-        ALLEGRO_KEY_X, ALLEGRO_KEY_Z,
+        ALLEGRO_KEY_X, ALLEGRO_KEY_Z, ALLEGRO_KEY_SPACE,
         ALLEGRO_KEY_ENTER, ALLEGRO_KEY_Q
     };
 
@@ -641,31 +872,11 @@ checkKeys (unsigned char key[ALLEGRO_KEY_MAX],
         ALLEGRO_KEY_ENTER, ALLEGRO_KEY_Q
     };
 
-    // Start the counter the first game running
-    if ( game -> status == NEW )
-    {
-        memset(counter, 0, sizeof (counter));
-    }
-
-    // Update counter of a given key when necessary
-    for ( i = 0; i < ALLEGRO_KEY_MAX; i++ )
-    {
-        if ( counter[i] == 5 )
-        {
-            counter[i] = 0;
-        }
-
-        else if ( counter[i] > 0 )
-        {
-            counter[i]++;
-        }
-    }
-
     // Keys common to both modes
     // Enter (for pause and menu selection)
     if ( key[ALLEGRO_KEY_ENTER] == KEY_READY )
     {
-        validKey(ALLEGRO_KEY_ENTER, key, counter, game);
+        validKey(ALLEGRO_KEY_ENTER, key, game);
 
         switch ( game -> status )
         {
@@ -679,6 +890,8 @@ checkKeys (unsigned char key[ALLEGRO_KEY_MAX],
             case PLAYING:
                 game -> status = PAUSED;
 
+                // Nothing repeats when the game is resumed
+                game -> input -> release(game -> input);
                 break;
 
                 // Game paused
@@ -690,6 +903,9 @@ checkKeys (unsigned char key[ALLEGRO_KEY_MAX],
                     {
                         case RESUME:
                             game -> status = PLAYING;
+
+                            // The time paused is not played
+                            startTimer(logic -> ask.timer(logic));
                             break;
 
                         case RESTART:
@@ -697,8 +913,7 @@ checkKeys (unsigned char key[ALLEGRO_KEY_MAX],
                             break;
 
                         case OPTIONS:
-                            pMenu -> draw.beingDrawn = OPTIONSMENU;
-                            pMenu -> selected.n = 0;
+                            pMenu -> draw.show(OPTIONSMENU);
                             break;
 
                         case EXIT:
@@ -731,8 +946,7 @@ checkKeys (unsigned char key[ALLEGRO_KEY_MAX],
                             break;
 
                         case OPRET:
-                            pMenu -> draw.beingDrawn = MAINMENU;
-                            pMenu -> selected.n = 0;
+                            pMenu -> draw.show(MAINMENU);
                             break;
 
                         default:
@@ -746,7 +960,7 @@ checkKeys (unsigned char key[ALLEGRO_KEY_MAX],
     // Quit game
     if ( key[ALLEGRO_KEY_Q] == KEY_READY )
     {
-        validKey(ALLEGRO_KEY_Q, key, counter, game);
+        validKey(ALLEGRO_KEY_Q, key, game);
 
         // Avoid bug in initial screen
         game -> initial.ready = true;
@@ -762,7 +976,7 @@ checkKeys (unsigned char key[ALLEGRO_KEY_MAX],
         case CONFIG:
             if ( key[ALLEGRO_KEY_UP] == KEY_READY )
             {
-                validKey(ALLEGRO_KEY_UP, key, counter, game);
+                validKey(ALLEGRO_KEY_UP, key, game);
 
                 (game -> initial.rl == 0) ? \
             (game -> initial.rl)++ : (game -> initial.rl)--;
@@ -771,7 +985,7 @@ checkKeys (unsigned char key[ALLEGRO_KEY_MAX],
 
             if ( key[ALLEGRO_KEY_DOWN] == KEY_READY )
             {
-                validKey(ALLEGRO_KEY_DOWN, key, counter, game);
+                validKey(ALLEGRO_KEY_DOWN, key, game);
 
                 (game -> initial.rl == 0) ? \
             (game -> initial.rl)++ : (game -> initial.rl)--;
@@ -780,7 +994,7 @@ checkKeys (unsigned char key[ALLEGRO_KEY_MAX],
 
             if ( key[ALLEGRO_KEY_LEFT] == KEY_READY )
             {
-                validKey(ALLEGRO_KEY_LEFT, key, counter, game);
+                validKey(ALLEGRO_KEY_LEFT, key, game);
 
                 switch ( game -> initial.rl )
                 {
@@ -805,7 +1019,7 @@ checkKeys (unsigned char key[ALLEGRO_KEY_MAX],
 
             if ( key[ALLEGRO_KEY_RIGHT] == KEY_READY )
             {
-                validKey(ALLEGRO_KEY_RIGHT, key, counter, game);
+                validKey(ALLEGRO_KEY_RIGHT, key, game);
 
                 switch ( game -> initial.rl )
                 {
@@ -829,66 +1043,12 @@ checkKeys (unsigned char key[ALLEGRO_KEY_MAX],
             }
             break;
 
-            // Play mode
-        case PLAYING:
-            if ( key[ALLEGRO_KEY_UP] == KEY_READY )
-            {
-                validKey(ALLEGRO_KEY_UP, key, counter, game);
-
-                // Rotate piece right
-                logic -> piece.rotate(RIGHT);
-            }
-
-            if ( (key[ALLEGRO_KEY_DOWN]) && (counter[ALLEGRO_KEY_DOWN] == 0) )
-            {
-                validKey(ALLEGRO_KEY_DOWN, key, counter, game);
-
-                // Move down one position in the game
-                logic -> piece.softDrop();
-
-                (game -> logic.ask.movingPiece()) ?
-                        playFX(FX_DROP, game) : 0;
-            }
-
-            if ( key[ALLEGRO_KEY_LEFT] && (counter[ALLEGRO_KEY_LEFT] == 0) )
-            {
-                validKey(ALLEGRO_KEY_LEFT, key, counter, game);
-
-                // Move up left position in the game
-                logic -> piece.shift(LEFT);
-            }
-
-            if ( key[ALLEGRO_KEY_RIGHT] && (counter[ALLEGRO_KEY_RIGHT] == 0) )
-            {
-                validKey(ALLEGRO_KEY_RIGHT, key, counter, game);
-
-                // Move right one position in the game
-                logic -> piece.shift(RIGHT);
-            }
-
-            if ( key[ALLEGRO_KEY_X] == KEY_READY )
-            {
-                validKey(ALLEGRO_KEY_X, key, counter, game);
-
-                // Rotate piece right
-                logic -> piece.rotate(RIGHT);
-            }
-
-            if ( key[ALLEGRO_KEY_Z] == KEY_READY )
-            {
-                validKey(ALLEGRO_KEY_Z, key, counter, game);
-
-                // Rotate piece left
-                logic -> piece.rotate(LEFT);
-            }
-            break;
-
             // Pause mode
         case PAUSED:
 
             if ( key[ALLEGRO_KEY_UP] == KEY_READY )
             {
-                validKey(ALLEGRO_KEY_UP, key, counter, game);
+                validKey(ALLEGRO_KEY_UP, key, game);
 
                 (pMenu -> selected.n == 0) ? \
                 (pMenu -> selected.n = pMenu -> get.nWords - 1) : \
@@ -898,7 +1058,7 @@ checkKeys (unsigned char key[ALLEGRO_KEY_MAX],
 
             if ( key[ALLEGRO_KEY_DOWN] == KEY_READY )
             {
-                validKey(ALLEGRO_KEY_DOWN, key, counter, game);
+                validKey(ALLEGRO_KEY_DOWN, key, game);
 
                 (pMenu -> selected.n == pMenu -> get.nWords - 1) ? \
                     (pMenu -> selected.n = 0) : (pMenu -> selected.n)++;
@@ -1132,129 +1292,124 @@ drawScreen (game_t * game)
     // Draw background
     al_clear_to_color(al_color_html(GAME_BKGND_COLOR));
 
-    if ( game -> status == NEW )
+    if ( game -> bkgnd != NULL )
     {
-        game -> bkgnd = al_load_bitmap(GAME_BKGND);
-
-        if ( game -> bkgnd == NULL )
-        {
-
-            fputs("Error loading background.", stderr);
-            return;
-        }
+        al_draw_scaled_bitmap(game -> bkgnd,
+                              0, 0, BKGND_WIDTH, BKGND_HEIGHT,
+                              0, 0, SCREEN_WIDTH, SCREEN_HEIGHT,
+                              0);
     }
-
-    al_draw_scaled_bitmap(game -> bkgnd,
-                          0, 0, BKGND_WIDTH, BKGND_HEIGHT,
-                          0, 0, SCREEN_WIDTH, SCREEN_HEIGHT,
-                          0);
 }
 
 /**
- * @brief Draw the current game board in the screen
+ * @brief Draw the game board of a frame in the screen
  * 
  * @param board Structure with the box settings to draw
+ * @param frame Frame with the board and pieces
  * 
  * @return Nothing
  */
 static void
-drawGameBoard (screenBoard_t * board)
+drawGameBoard (screenBoard_t * board, const frame_t * frame)
 {
-    int x, y;
+    int x, y, i;
     grid_t current;
 
     // Draw board box
     primitive_drawBox(&(board -> boardBox));
 
-    // Draw pieces inside the board
+    // Draw fixed pieces inside the board
     for ( y = 0; y < BOARD_HEIGHT; y++ )
     {
         for ( x = 0; x < BOARD_WIDTH; x++ )
         {
             // Get current cell block type
-            current = GET_CELL(y, x, board -> r0c0);
+            current = GET_CELL(y, x, frame -> board);
 
-            // Moving piece
-            if ( current == CELL_MOVING )
+            switch ( current )
             {
-                switch ( board -> stats -> piece.current )
-                {
-                    case TETROMINO_I:
-                        drawBlock(x, y, &(board -> gridBox[TETROMINO_I]));
-                        break;
 
-                    case TETROMINO_J:
-                        drawBlock(x, y, &(board -> gridBox[TETROMINO_J]));
-                        break;
+                case CELL_I:
+                    drawBlock(x, y, &(board -> gridBox[TETROMINO_I]));
+                    break;
 
-                    case TETROMINO_L:
-                        drawBlock(x, y, &(board -> gridBox[TETROMINO_L]));
-                        break;
+                case CELL_J:
+                    drawBlock(x, y, &(board -> gridBox[TETROMINO_J]));
+                    break;
 
-                    case TETROMINO_O:
-                        drawBlock(x, y, &(board -> gridBox[TETROMINO_O]));
-                        break;
+                case CELL_L:
+                    drawBlock(x, y, &(board -> gridBox[TETROMINO_L]));
+                    break;
 
-                    case TETROMINO_S:
-                        drawBlock(x, y, &(board -> gridBox[TETROMINO_S]));
-                        break;
+                case CELL_O:
+                    drawBlock(x, y, &(board -> gridBox[TETROMINO_O]));
+                    break;
 
-                    case TETROMINO_T:
-                        drawBlock(x, y, &(board -> gridBox[TETROMINO_T]));
-                        break;
+                case CELL_S:
+                    drawBlock(x, y, &(board -> gridBox[TETROMINO_S]));
+                    break;
 
-                    case TETROMINO_Z:
-                        drawBlock(x, y, &(board -> gridBox[TETROMINO_Z]));
-                        break;
+                case CELL_T:
+                    drawBlock(x, y, &(board -> gridBox[TETROMINO_T]));
+                    break;
 
-                    default:
-                        break;
-                }
-            }
+                case CELL_Z:
+                    drawBlock(x, y, &(board -> gridBox[TETROMINO_Z]));
+                    break;
 
-                // Fixed pieces
-            else
-            {
-                switch ( current )
-                {
-
-                    case CELL_I:
-                        drawBlock(x, y, &(board -> gridBox[TETROMINO_I]));
-                        break;
-
-                    case CELL_J:
-                        drawBlock(x, y, &(board -> gridBox[TETROMINO_J]));
-                        break;
-
-                    case CELL_L:
-                        drawBlock(x, y, &(board -> gridBox[TETROMINO_L]));
-                        break;
-
-                    case CELL_O:
-                        drawBlock(x, y, &(board -> gridBox[TETROMINO_O]));
-                        break;
-
-                    case CELL_S:
-                        drawBlock(x, y, &(board -> gridBox[TETROMINO_S]));
-                        break;
-
-                    case CELL_T:
-                        drawBlock(x, y, &(board -> gridBox[TETROMINO_T]));
-                        break;
-
-                    case CELL_Z:
-                        drawBlock(x, y, &(board -> gridBox[TETROMINO_Z]));
-                        break;
-
-                    default:
-                        break;
-                }
+                default:
+                    break;
             }
+        }
+    }
+
+    // Draw where the moving piece would land, skipping the hidden rows
+    for ( i = 0; frame -> ghostType != TETROMINO_NONE && i < BLOCKS; i++ )
+    {
+        if ( frame -> ghost[i][COORD_Y] >= 0 )
+        {
+            drawGhostBlock(frame -> ghost[i][COORD_X],
+                           frame -> ghost[i][COORD_Y],
+                           &(board -> gridBox[frame -> ghostType]));
+        }
+    }
 
+    // Draw the moving piece over them
+    for ( i = 0; frame -> pieceType != TETROMINO_NONE && i < BLOCKS; i++ )
+    {
+        if ( frame -> piece[i][COORD_Y] >= 0 )
+        {
+            drawBlock(frame -> piece[i][COORD_X], frame -> piece[i][COORD_Y],
+                      &(board -> gridBox[frame -> pieceType]));
         }
     }
 }
 
+/**
+ * @brief Draw the border of a single piece block in the given coordinates
+ * 
+ * Used to show where the moving piece would land.
+ * 
+ * @param x Top left X coordinate
+ * @param y Top left Y coordinate
+ * @param block Box with the block settings
+ * 
+ * @return Nothing
+ */
+static void
+drawGhostBlock (int x, int y, gbox_t * block)
+{
+    al_draw_rounded_rectangle(block -> corner.x + x * CELL_WIDTH,
+                              block -> corner.y + y * CELL_HEIGHT,
+                              block -> corner.x + x * CELL_WIDTH + \
+                                                            block -> width,
+                              block -> corner.y + y * CELL_HEIGHT + \
+                                                            block -> height,
+                              BOX_ROUND_X, BOX_ROUND_Y,
+                              al_color_html(block -> color.bkgnd),
+                              (block -> thickness));
+}
+
 /**
  * @brief Draw a single piece block in the given coordinates
  * 
@@ -1300,22 +1455,32 @@ static void
 destroy (game_t * game)
 {
 
-    game -> logic.destroy();
+    board_free(game -> logic);
+    game -> logic = NULL;
+    replay_close(game -> replay);
+    game -> replay = NULL;
+    input_free(game -> input);
+    game -> input = NULL;
     al_destroy_timer(game -> timer.main);
+    al_destroy_timer(game -> timer.draw);
     al_destroy_event_queue(game -> evq);
     al_destroy_bitmap(game -> bkgnd);
+
+    if ( game -> drawq != NULL )
+    {
+        al_destroy_event_queue(game -> drawq);
+    }
 }
 
 /**
  * @brief Initialize the screen board (where the game board is printed)
  * 
  * @param board Screen Board structure where the board will be printed
- * @param logic Current game logic
  * 
  * @return Nothing
  */
 static void
-init_scrBoard (screenBoard_t * board, board_t * logic)
+init_scrBoard (screenBoard_t * board)
 {
     // Counter
     int i;
@@ -1349,18 +1514,13 @@ init_scrBoard (screenBoard_t * board, board_t * logic)
         board -> gridBox[i].corner.x = board -> boardBox.corner.x;
         board -> gridBox[i].corner.y = board -> boardBox.corner.y;
     }
-
-    // Get top left coordinate of the board
-    board -> r0c0 = logic -> ask.board();
-
-    // Get game stats
-    board -> stats = (stats_t*) logic -> ask.stats();
 }
 
 /**
  * @brief Manage all in-game events from here
  * 
- * This includes display, keyboard and timers events
+ * This includes keyboard and timers events, and gravity. Display events are
+ * read by the thread drawing frames.
  * 
  * @param game Current game structure
  * @param boardLogic Backend logic
@@ -1371,6 +1531,15 @@ manageEvents (game_t * game, board_t * boardLogic, pause_t * pMenu)
 {
     // Current event
     ALLEGRO_EVENT event;
+    // Action of the key pressed or released
+    int action;
+    // Time until a held key repeats or the piece falls
+    int64_t timeout, gravity;
+    // Gravity steps due
+    int steps;
+    // Timer of the game, counting gravity while it's played
+    tmr_t * timer = (game -> logic != NULL) ?
+            (tmr_t *) game -> logic -> ask.timer(game -> logic) : NULL;
 
     // Keys array
     static unsigned char key[ALLEGRO_KEY_MAX];
@@ -1385,25 +1554,52 @@ manageEvents (game_t * game, board_t * boardLogic, pause_t * pMenu)
         key_init = true;
     }
 
-    // Wait for next event
-    al_wait_for_event(game -> evq, &event);
+    // Wait for next event, or until a held key repeats or the piece falls
+    timeout = game -> input -> timeLeft(game -> input, monotonic_now());
+
+    if ( game -> status == NEW || game -> status == PLAYING )
+    {
+        gravity = askTimeLeft(timer);
+        (timeout < 0 || gravity < timeout) ? (timeout = gravity) : 0;
+    }
+
+    if ( timeout < 0 )
+    {
+        al_wait_for_event(game -> evq, &event);
+    }
+
+    else if ( !al_wait_for_event_timed(game -> evq, &event, timeout / 1e9) )
+    {
+        // No event, a key repeats or the piece falls
+        event.type = 0;
+    }
 
     // Check events
     switch ( event.type )
     {
-            // Display
-        case ALLEGRO_EVENT_DISPLAY_CLOSE:
-            game -> exit = true;
-            game -> alStru -> exit = true;
-            break;
-
-            // Keyboard
+            // Keyboard. Keys moving the piece go to the input, with the time
+            // they were pressed at
         case ALLEGRO_EVENT_KEY_DOWN:
-            key[event.keyboard.keycode] = KEY_SEEN | KEY_RELEASED;
-            break;
-
         case ALLEGRO_EVENT_KEY_UP:
-            key[event.keyboard.keycode] &= KEY_RELEASED;
+            action = keyAction(event.keyboard.keycode);
+
+            if ( action != INPUT_NONE &&
+                 (game -> status == NEW || game -> status == PLAYING) )
+            {
+                game -> input -> push(game -> input, action,
+                                      event.type == ALLEGRO_EVENT_KEY_DOWN,
+                                      eventTime(&event));
+            }
+
+            else if ( event.type == ALLEGRO_EVENT_KEY_DOWN )
+            {
+                key[event.keyboard.keycode] = KEY_SEEN | KEY_RELEASED;
+            }
+
+            else
+            {
+                key[event.keyboard.keycode] &= KEY_RELEASED;
+            }
             break;
 
             // Timers
@@ -1415,33 +1611,159 @@ manageEvents (game_t * game, board_t * boardLogic, pause_t * pMenu)
                 checkKeys(key, game, boardLogic, pMenu);
 
             }
+            break;
 
-                // Piece timer
-            else if ( event.timer.source == game -> timer.piece &&
-                      game -> status != PAUSED )
-            {
-                // Set the game as playing before the first board update
-                if ( game -> status == NEW )
-                {
-                    game -> status = PLAYING;
-                }
+        default:
+            break;
+    }
+
+    // Gravity. One board update for every step due, unless paused
+    if ( (game -> status == NEW || game -> status == PLAYING) &&
+         game -> exit == false )
+    {
+        for ( steps = askSteps(timer); steps > 0; steps-- )
+        {
+            // Set the game as playing before the first board update
+            game -> status = PLAYING;
 
-                // Call for a board update
-                boardLogic -> update();
+            // Call for a board update
+            boardLogic -> update(boardLogic);
 
-                // Play a sound FX
-                (game -> logic.ask.movingPiece()) ?
-                        playFX(FX_DROP, game) : 0;
+            // Play a sound FX
+            (game -> logic -> ask.movingPiece(game -> logic)) ?
+                    playFX(FX_DROP, game) : 0;
 
-                // Redraw screen
-                game -> redraw = true;
-            }
-            break;
+            // Redraw screen
+            game -> redraw = true;
+        }
+    }
+
+    // Move the piece with the keys due until now
+    if ( game -> status == PLAYING && game -> exit == false )
+    {
+        takeActions(game, boardLogic);
+    }
+}
+
+/**
+ * @brief Take the actions of the keys due until now
+ * 
+ * Presses and repeats are taken in the order they happened, so a key tapped
+ * between two ticks moves the piece as much as a key held for as long.
+ * 
+ * @param game Current game structure
+ * @param logic Game logic
+ * 
+ * @return Nothing
+ */
+static void
+takeActions (game_t * game, board_t * logic)
+{
+    int action;
+
+    while ( (action = game -> input -> next(game -> input,
+                                            monotonic_now())) != INPUT_NONE )
+    {
+        game -> redraw = true;
+
+        switch ( action )
+        {
+            case INPUT_LEFT:
+                logic -> piece.shift(logic, LEFT);
+                break;
+
+            case INPUT_RIGHT:
+                logic -> piece.shift(logic, RIGHT);
+                break;
+
+            case INPUT_SOFT_DROP:
+                // Move down one position in the game
+                logic -> piece.softDrop(logic);
+
+                (logic -> ask.movingPiece(logic)) ? playFX(FX_DROP, game) : 0;
+                break;
+
+            case INPUT_ROTATE_LEFT:
+                logic -> piece.rotate(logic, LEFT);
+                break;
+
+            case INPUT_ROTATE_RIGHT:
+                logic -> piece.rotate(logic, RIGHT);
+                break;
+
+            case INPUT_HARD_DROP:
+                // Drop the piece to the bottom and fix it
+                logic -> piece.hardDrop(logic);
+                playFX(FX_DROP, game);
+                break;
+
+            default:
+                break;
+        }
+
+        LATENCY_MUTATED(&(game -> latency),
+                        game -> input -> when(game -> input));
+
+        // Filled lines are cleared before the next piece moves
+        if ( action == INPUT_HARD_DROP )
+        {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Action of a key moving the piece
+ * 
+ * @param keycode Allegro key code
+ * 
+ * @return One of inputActions enum. INPUT_NONE if the key doesn't move it
+ */
+static int
+keyAction (int keycode)
+{
+    switch ( keycode )
+    {
+        case ALLEGRO_KEY_LEFT:
+            return INPUT_LEFT;
+
+        case ALLEGRO_KEY_RIGHT:
+            return INPUT_RIGHT;
+
+        case ALLEGRO_KEY_DOWN:
+            return INPUT_SOFT_DROP;
+
+        case ALLEGRO_KEY_Z:
+            return INPUT_ROTATE_LEFT;
+
+        case ALLEGRO_KEY_UP:
+        case ALLEGRO_KEY_X:
+            return INPUT_ROTATE_RIGHT;
+
+        case ALLEGRO_KEY_SPACE:
+            return INPUT_HARD_DROP;
 
         default:
-            break;
+            return INPUT_NONE;
     }
+}
+
+/**
+ * @brief Time of the monotonic clock an event happened at
+ * 
+ * Allegro stamps events with its own clock, so their age is taken from it.
+ * 
+ * @param event Allegro event
+ * 
+ * @return Nanoseconds, as given by monotonic_now()
+ */
+static uint64_t
+eventTime (const ALLEGRO_EVENT * event)
+{
+    uint64_t now = monotonic_now();
+    double age = al_get_time() - event -> any.timestamp;
 
+    return (age > 0 && age * 1e9 < now) ? (now - (uint64_t) (age * 1e9)) : now;
 }
 
 /**
@@ -1449,18 +1771,13 @@ manageEvents (game_t * game, board_t * boardLogic, pause_t * pMenu)
  * 
  * @param keyName Key to valid
  * @param keyArr Array with all the keys
- * @param counterArr Array with the key counter (to reduce sensitibility)
  * @param game Current game structure
  */
 static void
-validKey (int keyName,
-          unsigned char * keyArr, unsigned char * counterArr,
-          game_t * game)
+validKey (int keyName, unsigned char * keyArr, game_t * game)
 {
     // Clear key
     clearKey(keyName, keyArr);
-    // Increase counter of this key
-    counterArr[keyName]++;
     // Redraw screen
     game -> redraw = true;
 }
@@ -1480,27 +1797,6 @@ clearKey (int keyName, unsigned char * keyArr)
     keyArr[keyName] &= KEY_SEEN;
 }
 
-/**
- * @brief Restart current game pieces' timer
- * 
- * @param game Current game structure
- * 
- * @return Nothing
- */
-static void
-restartPiecesTimer (game_t * game)
-{
-    // Get piece speed
-    game -> timer.piece_speed = askTimeLimit();
-
-    // Restart pieces timer
-    al_stop_timer(game -> timer.piece);
-
-    al_set_timer_speed(game -> timer.piece, MS2S(game -> timer.piece_speed));
-
-    al_start_timer(game -> timer.piece);
-}
-
 /**
  * @brief Initialize the screen where initial rows and level are choosen
  * 
@@ -145,11 +145,11 @@ typedef struct
 // === Function prototypes for private functions with file level scope ===
 // Draw pause main menu in the display
 static void
-drawMain (void);
+drawMain (const pause_t * state);
 
 // Draw options menu in the display
 static void
-drawOptions (void);
+drawOptions (const pause_t * state);
 
 // Calculate the menu box size
 static void
@@ -159,6 +159,10 @@ getBoxSize (gbox_t * menuBox, int * nWords, const char * wordsArray[]);
 static int
 getWords (int * nWords, const char * wordsArray[]);
 
+// Change the menu being drawn, selecting its first option
+static void
+showMenu (int menu);
+
 // === ROM Constant variables with file level scope ===
 
 // Words in the main pause menu
@@ -204,9 +208,7 @@ init_pause (pause_t * pStru, allegro_t * alStru)
 
     pMenu.public -> draw.main = &drawMain;
     pMenu.public -> draw.options = &drawOptions;
-    pMenu.public -> selected.n = 0;
-
-    pMenu.public -> draw.beingDrawn = MAINMENU;
+    pMenu.public -> draw.show = &showMenu;
 
     pMenu.public -> get.nextPiece = true;
 
@@ -241,6 +243,9 @@ init_pause (pause_t * pStru, allegro_t * alStru)
     pMenu.options.box.width += \
           al_get_text_width(pMenu.selected.box.text.regular, onOffWords[OFF]) \
           + TXT_OFFSET;
+
+    // Start in the main menu
+    showMenu(MAINMENU);
 }
 
 /// @privatesection
@@ -249,12 +254,12 @@ init_pause (pause_t * pStru, allegro_t * alStru)
 /**
  * @brief Draw pause main menu in the display
  * 
- * @param None
+ * @param state Pause menu to draw. It can be a copy of the public one
  * 
  * @return Nothing
  */
 static void
-drawMain (void)
+drawMain (const pause_t * state)
 {
     // Counter
     int i;
@@ -265,14 +270,11 @@ drawMain (void)
     // Draw the box
     primitive_drawBox(&(pMenu.menu.box));
 
-    // Change the public nWords variable
-    pMenu.public -> get.nWords = pMenu.menu.nWords;
-
     // Draw the text
     for ( i = 0; i < pMenu.menu.nWords; i++ )
     {
         // Option is selected
-        if ( (pMenu.public -> selected.n) == i )
+        if ( (state -> selected.n) == i )
         {
             al_draw_text(pMenu.selected.box.text.regular,
                          al_color_html(pMenu.selected.box.text.color),
@@ -298,12 +300,12 @@ drawMain (void)
 /**
  * @brief Draw options menu in the display
  * 
- * @param None
+ * @param state Pause menu to draw. It can be a copy of the public one
  * 
  * @return Nothing
  */
 static void
-drawOptions (void)
+drawOptions (const pause_t * state)
 {
     // Counter
     int i;
@@ -314,9 +316,6 @@ drawOptions (void)
     // Draw the box
     primitive_drawBox(&(pMenu.options.box));
 
-    // Change the public nWords variable
-    pMenu.public -> get.nWords = pMenu.options.nWords;
-
     // Draw options
     for ( i = 0; i < pMenu.options.nWords; i++ )
     {
@@ -339,7 +338,7 @@ drawOptions (void)
 
                 // Next piece is shown or not
             case NP:
-                (pMenu.public->get.nextPiece == true) ?
+                (state -> get.nextPiece == true) ?
                         (onOff = ON) : (onOff = OFF);
                 break;
 
@@ -351,7 +350,7 @@ drawOptions (void)
 
         // Draw text
         // Selected option
-        if ( (pMenu.public -> selected.n) == i )
+        if ( (state -> selected.n) == i )
         {
             al_draw_textf(pMenu.selected.box.text.regular,
                           al_color_html(pMenu.selected.box.text.color),
@@ -479,3 +478,21 @@ getWords (int * nWords, const char * wordsArray[])
     // Return the longest word position
     return longestWord;
 }
+
+/**
+ * @brief Change the menu being drawn, selecting its first option
+ * 
+ * @param menu One of beingDrawn enum
+ * 
+ * @return Nothing
+ */
+static void
+showMenu (int menu)
+{
+    pMenu.public -> draw.beingDrawn = menu;
+    pMenu.public -> selected.n = 0;
+
+    (menu == OPTIONSMENU) ? \
+        (pMenu.public -> get.nWords = pMenu.options.nWords) : \
+        (pMenu.public -> get.nWords = pMenu.menu.nWords);
+}
@@ -83,6 +83,9 @@ enum options
     OPRET
 };
 
+/// Pause menu, see struct PAUSE_MENU
+typedef struct PAUSE_MENU pause_t;
+
 /**
  * @brief Pause box
  * 
@@ -92,7 +95,7 @@ enum options
  * 
  * @warning Function init_pause() must be called before using this structure
  */
-typedef struct
+struct PAUSE_MENU
 {
     /// Selected option in the menu
 
@@ -120,14 +123,17 @@ typedef struct
         /// The menu that's being drawn or should be. Use it with its enum
         int beingDrawn;
 
-        /// Draw options menu
-        void (* options)(void);
+        /// Draw options menu as it is in the given state
+        void (* options)(const pause_t * state);
+
+        /// Draw the main pause menu as it is in the given state
+        void (* main)(const pause_t * state);
 
-        /// Draw the main pause menu
-        void (* main)(void);
+        /// Change the menu being drawn, selecting its first option
+        void (* show)(int menu);
     } draw;
 
-} pause_t;
+};
 
 // === Global variables ===
 
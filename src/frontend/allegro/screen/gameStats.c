@@ -149,7 +149,7 @@ void
 init_scrStats (screenStats_t * stats, board_t * logic)
 {
     // Stats structure
-    stats -> gStats = (stats_t*) logic -> ask.stats();
+    stats -> gStats = (stats_t*) logic -> ask.stats(logic);
 
     stats -> showNextPiece = true;
 
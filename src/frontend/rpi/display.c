@@ -458,7 +458,7 @@ printWmove(words_t word, int xo, int y)
 }
 
 void
-printG(int *matrix)
+printG(grid_t *matrix)
 {
     int i, j;
     dcoord_t point;
@@ -503,6 +503,24 @@ printG(int *matrix)
     }
 }
 
+void
+printP(int cells[BLOCKS][COORD_NUM])
+{
+    int i;
+    dcoord_t point;
+
+    ///Blocks still in the hidden rows are not shown.
+    for(i = 0; i < BLOCKS; i++)
+    {
+        if(cells[i][COORD_Y] >= 0)
+        {
+            point.x = cells[i][COORD_X] + 3;
+            point.y = cells[i][COORD_Y];
+            disp_write(point, D_ON);
+        }
+    }
+}
+
 void
 initMenu(void)
 {
@@ -122,7 +122,21 @@ printL(letters_t * letter, int x, int y);
  */
 
 void
-printG(int * matrix);
+printG(grid_t * matrix);
+
+/**
+ * @brief Print the moving piece.
+ * 
+ * It shows on the display the blocks of the moving piece, over the game
+ * matrix printed by printG.
+ * 
+ * @param cells Piece's blocks coordinates, as given by the board.
+ * 
+ * @return Nothing
+ */
+
+void
+printP(int cells[BLOCKS][COORD_NUM]);
 
 /**
  * @brief Print words.
@@ -33,11 +33,16 @@
  *****************************************************************************/
 
 // === Libraries and header files ===
+// clock_nanosleep
+#define _POSIX_C_SOURCE 200112L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <stdbool.h> 
-#include <string.h> // For memcpy
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
 
 ///Frontend defines, enums and functions.
 #include "display.h"
@@ -53,6 +58,10 @@
 #include "../../backend/board/board.h"
 #include "../../backend/stats/stats_mgmt.h"
 #include "../../backend/board/timer/boardTimer.h"
+#include "../../backend/replay/replay.h"
+#include "../../backend/input/input.h"
+#include "../../backend/monotonic/monotonic.h"
+#include "../../backend/latency/latency.h"
 
 // This file
 #include "rpcontrol.h"
@@ -60,9 +69,21 @@
 /// @privatesection
 // === Constants and Macro definitions ===
 
-///@def PAUSE_LIMIT
-///@brief Time that indicates the user wants to go to pause menu.
-#define PAUSE_LIMIT 20
+///@def PAUSE_TIME
+///@brief Time in ms the switch is held to go to pause menu.
+#define PAUSE_TIME 800
+
+///@def INPUT_PERIOD
+///@brief Time in ms between two joystick samples.
+#define INPUT_PERIOD 10
+
+///@def NS_PER_S
+///@brief Nanoseconds in a second.
+#define NS_PER_S 1000000000ULL
+
+///@def START_LEVEL(dif)
+///@brief Level a game starts at, harder difficulties start faster.
+#define START_LEVEL(dif) (((dif) - EASY) * 4)
 
 #define FX_EXIT     "../res/audio/fx/chau.waw"
 #define FX_LINE     "../res/audio/fx/line.wav"
@@ -81,20 +102,34 @@ enum gamestatus
 
 // === Function prototypes for private functions with file level scope ===
 
+/**
+ * @brief Action of a joystick movement.
+ * 
+ * @param The joystick movement, as returned by surf().
+ * 
+ * @return One of inputActions enum, INPUT_NONE if it doesn't move the piece.
+ */
+int
+joyAction (int jmovement);
+
 /**
  * @brief Creates a playing menu.
  * 
  * It shows the user the gameboard on RPI's display. It let the user to go
  * from the game to the menu to change music, difficulty and check score.
  * 
+ * Joystick movements are pushed to an input with the time they were sampled
+ * at, so held movements repeat after a delay, as keys do in Allegro. The loop
+ * sleeps until the next joystick sample, repeat or gravity step, whichever
+ * comes first, and only redraws when the game changed.
+ * 
  * @param A pointer to the gameboard.
  * @param A pointer to the game stats.
- * @param The difficulty of the game.
  * 
  * @return The game status(pause, menu, exit).
  */
 int
-play_tetris (board_t * gameboard, stats_t* gameStats, int dif);
+play_tetris (board_t * gameboard, stats_t* gameStats);
 
 /**
  * @brief Prints the word "TeTrIx" at the top of the display.
@@ -119,6 +154,16 @@ printTetrix (void);
 void
 printScore (words_t scorestring, int scorenumber);
 
+/**
+ * @brief Sleeps until a time of the monotonic clock.
+ * 
+ * @param Time to wake up at, as returned by monotonic_now().
+ * 
+ * @return Nothing
+ */
+void
+sleepUntil (uint64_t deadline);
+
 // === ROM Constant variables with file level scope ===
 
 // === Static variables and constant variables with file level scope ===
@@ -159,7 +204,9 @@ rpi (void)
     words_t * scorestring = {NULL};
 
     ///Creates the gameboard
-    board_t gameboard;
+    board_t * gameboard = NULL;
+    ///Replay where the game is recorded. Closed after the gameboard is freed
+    replay_t * replay = NULL;
 
     ///Creates a pointer to score table
     stats_t * gameStats = NULL;
@@ -253,14 +300,38 @@ rpi (void)
                     ///stats, timer and gameboard.
                     if ( gameplay == GM_MENU )
                     {
-                        board_init(&gameboard);
-                        gameStats = (stats_t *) gameboard.ask.stats();
-                        initTimer(gameStats);
+                        gameboard = board_create();
+
+                        if ( gameboard == NULL )
+                        {
+                            gameplay = GM_EXIT;
+                            break;
+                        }
+
+                        gameboard->set.topScores(gameboard);
+
+                        replay = REPLAY_GAME();
+                        gameboard->set.replay(gameboard, replay);
+
+                        gameStats = (stats_t *) gameboard->ask.stats(gameboard);
+
+                        ///The difficulty chooses the starting level.
+                        gameboard->set.startLevel(gameboard, START_LEVEL(dif));
                     }
                     ///It comes with the instruction of pausing the game 
                     ///or ending it.
                     //stopMusic();
-                    gameplay = play_tetris(&gameboard, gameStats, dif);
+                    gameplay = play_tetris(gameboard, gameStats);
+
+                    ///The gameboard is freed when the game is over.
+                    if ( gameplay == GM_MENU )
+                    {
+                        board_free(gameboard);
+                        gameboard = NULL;
+                        gameStats = NULL;
+                        replay_close(replay);
+                        replay = NULL;
+                    }
                     disp_clear();
                     break;
                     ///If it is sound, it goes to On/Off.
@@ -302,7 +373,8 @@ rpi (void)
                 case SCORE:
                     if ( gameplay == GM_MENU &&
                          initStats(&scoretable) == EXIT_SUCCESS &&
-                         scoretable._tsLoaded == true )
+                         scoretable.loadTopScores(&scoretable) ==
+                         EXIT_SUCCESS )
                     {
                         printScore(*scorestring, scoretable.score.top);
                     }
@@ -310,12 +382,7 @@ rpi (void)
                               gameStats != NULL &&
                               gameStats -> _init == true )
                     {
-                        board_t tmp;
-                        memcpy(&tmp, &gameboard, sizeof (tmp));
-
                         printScore(*scorestring, gameStats->score.actual);
-
-                        memcpy(&gameboard, &tmp, sizeof (tmp));
                     }
                     else
                     {
@@ -392,150 +459,241 @@ rpi (void)
     ///It turns off the display.
     disp_clear();
 
+    ///A game left paused is recorded until here.
+    board_free(gameboard);
+    replay_close(replay);
+
     return NO_ERROR;
 }
 /// @privatesection
 // === Local function definitions ===
 
 int
-play_tetris (board_t * gameboard, stats_t * gameStats, int dif)
+joyAction (int jmovement)
+{
+    int action;
+
+    switch ( jmovement )
+    {
+        case RIGHT:
+            action = INPUT_RIGHT;
+            break;
+
+        case LEFT:
+            action = INPUT_LEFT;
+            break;
+
+        case DOWN:
+            action = INPUT_SOFT_DROP;
+            break;
+
+        case UP:
+            action = INPUT_ROTATE_LEFT;
+            break;
+
+        case PRESSED:
+            action = INPUT_ROTATE_RIGHT;
+            break;
+
+        default:
+            action = INPUT_NONE;
+            break;
+    }
+
+    return action;
+}
+
+int
+play_tetris (board_t * gameboard, stats_t * gameStats)
 {
-    ///It takes joystick positition.
-    int jmovement;
-    ///It indicates if the user wants to go to the pause menu or not.
-    int pauseflag = 0;
-    ///It works as a timer.
-    int timeflag = 0;
-    ///It indicates the difficulty mode that the user wants.
-    int mode;
+    ///It takes joystick positition and the action it makes.
+    int jmovement, action;
+    ///Action the joystick is holding.
+    int held = INPUT_NONE;
     ///Some variables used as counters, number of lines completed and loops.
     int k, n, gameplay = GM_PLAYING;
     ///An array used for checking completed lines.
     int lines[BOARD_HEIGHT];
     ///Game timing.
-    int delay_time = askTimeLimit();
+    tmr_t * timer = (tmr_t *) gameboard->ask.timer(gameboard);
+    ///Time of the next joystick sample, the current time and when to wake up.
+    uint64_t nextInput, now, wakeUp;
+    ///Time the switch was pressed at.
+    uint64_t pressedAt = 0;
+    ///Time until a held movement repeats.
+    int64_t repeat;
+    ///Hash of the game the last time it was drawn, and before an action.
+    uint64_t drawn, hash;
+    ///Times of the oldest action not shown yet, with -D LATENCY.
+    latency_mark_t latency = {0};
 
     ///It creates a gameboard.
-    grid_t * board = gameboard->ask.board();
+    grid_t * board = gameboard->ask.board(gameboard);
+    ///Cells of the moving piece, drawn over the gameboard.
+    int piece[BLOCKS][COORD_NUM];
+
+    ///Joystick movements, with delayed auto shift and auto repeat.
+    input_t * input = input_create(INPUT_DAS, INPUT_ARR);
+
+    if ( input == NULL )
+    {
+        return GM_EXIT;
+    }
 
     //It shows the gameboard.
     printG(board);
     disp_update();
+    drawn = gameboard->ask.hash(gameboard);
 
-    ///Depending on the difficulty the user chose it makes differents delays.
-    switch ( dif )
-    {
-        case EASY:
-            mode = 20;
-            break;
-        case MEDIUM:
-            mode = 10;
-            break;
-        case HARD:
-            mode = 0;
-            break;
-        default:
-            mode = 20;
-            break;
-    }
+    ///Gravity counts from now, the time spent in the menu is not played.
+    startTimer(timer);
+    nextInput = monotonic_now();
 
     //It is a loop until the game ends.
-    while ( !(gameboard->ask.endGame()) && gameplay == GM_PLAYING )
+    while ( !(gameboard->ask.endGame(gameboard)) && gameplay == GM_PLAYING )
     {
-        //It asks for the user instruction(joystick movement)
-        joy_update();
-        jmovement = surf();
+        ///It sleeps until the next joystick sample, the next repeat or the
+        ///next gravity step.
+        now = monotonic_now();
+        wakeUp = now + (uint64_t) askTimeLeft(timer);
+        (nextInput < wakeUp) ? (wakeUp = nextInput) : 0;
 
-        ///If the user pressed the switch too much time, it goes to pause menu.
-        ///ending the playing loop.
-        if ( pauseflag > PAUSE_LIMIT )
-        {
-            gameplay = GM_PAUSE;
-        }
-            ///If the user didn't move the piece, it does an update and resets the
-            ///"time counter".
-        else if ( timeflag > mode )
-        {
-            timeflag = 0;
-            gameboard->update();
-        }
-            ///If the user goes to the right, it makes a right switch.     
-        else if ( jmovement == RIGHT )
-        {
-            gameboard->piece.shift(RIGHT);
-        }
-            ///If the user goes to the left, it makes a left switch.
-        else if ( jmovement == LEFT )
-        {
-            gameboard->piece.shift(LEFT);
-        }
-            ///If the user goes up for the first time, it makes a left rotation
-            ///and adds one to the pause flag(this make the piece stop rotating too
-            ///much)
-        else if ( jmovement == UP && pauseflag == 0 )
-        {
-            gameboard->piece.rotate(LEFT);
-            pauseflag++;
-        }
-            ///If the user pressed the switch bottom for the first time, it makes a
-            ///right rotation and adds one to the pause flag to avoid the piece to 
-            ///rotate too much.
-        else if ( jmovement == PRESSED && pauseflag == 0 )
-        {
-            gameboard->piece.rotate(RIGHT);
-            pauseflag++;
-        }
-            ///If the user goes down, it makes a soft drop.
-        else if ( jmovement == DOWN )
+        repeat = input->timeLeft(input, now);
+        (repeat >= 0 && now + (uint64_t) repeat < wakeUp) ?
+                (wakeUp = now + (uint64_t) repeat) : 0;
+
+        sleepUntil(wakeUp);
+
+        now = monotonic_now();
+
+        if ( now >= nextInput )
         {
-            gameboard->piece.softDrop();
+            ///The next sample is one period later, or one period from now
+            ///if the loop fell behind.
+            nextInput += INPUT_NS(INPUT_PERIOD);
+            if ( nextInput <= now )
+            {
+                nextInput = now + INPUT_NS(INPUT_PERIOD);
+            }
+
+            //It asks for the user instruction(joystick movement)
+            joy_update();
+            jmovement = surf();
+            action = joyAction(jmovement);
+
+            ///When the joystick moves somewhere else, the held action is
+            ///released and the new one pressed. Between the center and a
+            ///direction (NONE) it keeps holding.
+            if ( jmovement != NONE && action != held )
+            {
+                (held != INPUT_NONE) ?
+                        input->push(input, held, false, now) : 0;
+                (action != INPUT_NONE) ?
+                        input->push(input, action, true, now) : 0;
+
+                held = action;
+                pressedAt = now;
+            }
+
+            ///If the user held the switch too much time, it goes to pause
+            ///menu, ending the playing loop.
+            if ( held == INPUT_ROTATE_RIGHT &&
+                 now - pressedAt >= INPUT_NS(PAUSE_TIME) )
+            {
+                gameplay = GM_PAUSE;
+            }
         }
-            ///If the user didn't move, it adds one to the time counter and it
-            ///resets pause flag(so as the user can rotate the piece again).
-        else if ( jmovement == CENTER )
+
+        ///It moves the piece with every action due, in the order they
+        ///happened.
+        while ( gameplay == GM_PLAYING &&
+                (action = input->next(input, now)) != INPUT_NONE )
         {
-            pauseflag = 0;
-            timeflag++;
+            hash = gameboard->ask.hash(gameboard);
+
+            switch ( action )
+            {
+                case INPUT_RIGHT:
+                    gameboard->piece.shift(gameboard, RIGHT);
+                    break;
+
+                case INPUT_LEFT:
+                    gameboard->piece.shift(gameboard, LEFT);
+                    break;
+
+                case INPUT_SOFT_DROP:
+                    gameboard->piece.softDrop(gameboard);
+                    break;
+
+                case INPUT_ROTATE_LEFT:
+                    gameboard->piece.rotate(gameboard, LEFT);
+                    break;
+
+                case INPUT_ROTATE_RIGHT:
+                    gameboard->piece.rotate(gameboard, RIGHT);
+                    break;
+
+                default:
+                    break;
+            }
+
+            ///Only actions changing the game are followed to the display.
+            if ( gameboard->ask.hash(gameboard) != hash )
+            {
+                LATENCY_MUTATED(&latency, input->when(input));
+            }
         }
-            ///If the pressed bottom is still pressed, it adds one to the pauseflag.
-        else if ( jmovement == PRESSED && pauseflag != 0 )
+
+        LATENCY_POLL();
+
+        ///It makes one update for every gravity step that is due.
+        for ( k = askSteps(timer); k > 0 && gameplay == GM_PLAYING; k-- )
         {
-            pauseflag++;
+            gameboard->update(gameboard);
         }
 
         ///It analises if there is any filled row.
-        n = gameboard->ask.filledRows(lines);
+        n = gameboard->ask.filledRows(gameboard, lines);
         if ( n != 0 )
         {
             for ( k = 0; k < n; k++ )
             {
-                ///If there is one, it eliminates the line. 
+                ///If there is one, it turns the line off.
                 lineoff(lines, lines[k]);
-                gameboard->clear.line(lines, k);
-                ///It changes delay time in case too many rows were cleared.
-                delay_time = askTimeLimit();
                 //playFX(FX_LINE);
             }
-        }
 
-        ///It prints the gameboard after this changes.
-        printG(board);
-        disp_update();
+            ///Then, it eliminates all the lines at once.
+            gameboard->clear.lines(gameboard, lines, n);
+        }
 
-        ///It makes a little delay for a better playability.
-        usleep(delay_time * 10);
+        ///It prints the gameboard only if something changed, with the
+        ///moving piece.
+        if ( gameboard->ask.hash(gameboard) != drawn )
+        {
+            printG(board);
+            if ( gameboard->ask.piece(gameboard, piece) != TETROMINO_NONE )
+            {
+                printP(piece);
+            }
+            LATENCY_COMPOSED(&latency);
+            disp_update();
+            LATENCY_SHOWN(&latency);
+            drawn = gameboard->ask.hash(gameboard);
+        }
     }
 
+    input_free(input);
+
     ///If the user lost.
-    if ( gameboard->ask.endGame() )
+    if ( gameboard->ask.endGame(gameboard) )
     {
         ///It creates a scorestring that wil be shown at the top of the display.
         words_t scorestring = {NULL};
-        stats_t *gameStats = (stats_t *) gameboard->ask.stats();
+        stats_t *gameStats = (stats_t *) gameboard->ask.stats(gameboard);
 
         ///It prints the actual score.
         printScore(scorestring, gameStats->score.actual);
-        gameboard->destroy();
         ///It goes to the menu as if it has to start again.
         gameplay = GM_MENU;
     }
@@ -591,3 +749,18 @@ printScore (words_t scorestring, int scorenumber)
     ///It prints the "score string"
     printWmove(scorestring, 0, 9);
 }
+
+void
+sleepUntil (uint64_t deadline)
+{
+    struct timespec t = {
+        .tv_sec = (time_t) (deadline / NS_PER_S),
+        .tv_nsec = (long) (deadline % NS_PER_S)
+    };
+
+    ///If a signal wakes it up early, it goes back to sleep.
+    while ( clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL) == EINTR )
+    {
+        continue;
+    }
+}
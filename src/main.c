@@ -34,6 +34,7 @@
 #include <stdlib.h>
 
 #include "backend/board/board.h"
+#include "backend/latency/latency.h"
 #include "frontend/rpi/display.h"
 #include "frontend/rpi/libs/disdrv.h"
 
@@ -71,6 +72,9 @@
 int
 main (void)
 {
+    // Print the input latency on exit, with -D LATENCY
+    LATENCY_START();
+
     // Game is being run with a Raspberry PI
 #ifdef RPI
     if ( rpi() == ERROR )
@@ -0,0 +1,874 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ * 
+ * @file    sim.c
+ * 
+ * @brief   Headless simulator playing many games at once.
+ * 
+ * @details Only the backend is linked, so games are played as fast as the
+ * board can be updated, with no frontend, event queue or frame rate.
+ * 
+ * One game is played for every seed in a range, spread between the threads
+ * of a pool. The seed chooses the pieces of the game, so the same seeds always
+ * play the same games. Every piece is fixed by a policy:
+ *  - random: in one of the places it can be fixed, chosen at random.
+ *  - bot: where the bot scores it best.
+ *  - input: by the moves in a file, repeated until the game ends.
+ *  - replay: by the replay of the game with the same seed, recorded before
+ *    with -w, as fast as possible. Its keyframes are checked, so a game that
+ *    isn't played the same isn't counted.
+ * 
+ * Pieces are chosen by the randomizer given, a shuffled bag of the 7 pieces
+ * unless another one is asked for.
+ * 
+ * Every game can be recorded to DIR/SEED.txr with -w, and played again with
+ * -p replay -i DIR.
+ * 
+ * When every game ends, games and pieces per second and the distribution of
+ * the lines and scores are printed, and the result of every game can be
+ * written to a file.
+ * 
+ * Usage:
+ *      tetrix-sim [-s FIRST[:LAST]] [-t THREADS]
+ *                 [-p random|bot|input|replay] [-r bag|nes|history]
+ *                 [-i FILE] [-m PIECES] [-o FILE] [-w DIR]
+ * 
+ * Moves in an input file are one character each, and everything else is
+ * ignored:
+ *  - L, R: shift the piece left or right.
+ *  - Z, X: rotate the piece left or right.
+ *  - S, H: soft or hard drop the piece.
+ *  - .: update the board, as the timer does.
+ * 
+ * @author  Gino Minnucci                               <gminnucci@itba.edu.ar>
+ * @author  Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 16:05
+ * 
+ * @copyright GNU General Public License v3
+ */
+
+// === Libraries and header files ===
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>         // For sysconf
+
+#include "../backend/board/board.h"
+#include "../backend/board/random_generator.h"
+#include "../backend/bot/bot.h"
+#include "../backend/bot/pool.h"
+#include "../backend/monotonic/monotonic.h"
+#include "../backend/replay/replay.h"
+#include "../backend/stats/stats_mgmt.h"
+
+/// @privatesection
+// === Constants and Macro definitions ===
+
+/// Seeds played when none are given
+#define FIRST_SEED      0
+#define LAST_SEED       99
+
+/// Pieces after which a game is stopped when no limit is given
+#define MAX_PIECES      10000
+
+/// Moves from an input file that can be used for every piece before the game
+/// is stopped, so files that never fix a piece end
+#define MAX_MOVES       1024
+
+/// Longest input file read
+#define MAX_INPUT       (1 << 20)
+
+/// Longest path of a replay file
+#define MAX_PATH        4096
+
+// === Enumerations, structures and typedefs ===
+
+/**
+ * @brief How pieces are fixed
+ */
+enum policies
+{
+    /// At random, in one of the places where they can be fixed
+    POLICY_RANDOM,
+    /// Where the bot scores them best
+    POLICY_BOT,
+    /// By the moves in an input file
+    POLICY_INPUT,
+    /// By a replay recorded before
+    POLICY_REPLAY
+};
+
+/**
+ * @brief Options of the simulation
+ */
+typedef struct SIM_OPTIONS
+{
+    unsigned long long first;
+    unsigned long long last;
+    int threads;
+    int policy;
+    int randomizer;
+    int maxPieces;
+    const char * input;
+    const char * output;
+    const char * replays;
+} options_t;
+
+/**
+ * @brief Result of a game
+ */
+typedef struct SIM_GAME
+{
+    /// Seed of the game
+    unsigned long long seed;
+
+    /// The game could be played
+    bool played;
+
+    /// The game ended because the board was topped out
+    bool topOut;
+
+    int pieces;
+    int lines;
+    int score;
+    int level;
+} game_t;
+
+/**
+ * @brief Everything shared by the games of a simulation
+ */
+typedef struct SIM
+{
+    const options_t * options;
+
+    /// Bot fixing the pieces, for POLICY_BOT
+    bot_t bot;
+
+    /// Moves of the input file, for POLICY_INPUT
+    char * moves;
+    size_t nMoves;
+
+    /// Result of every game
+    game_t * games;
+} sim_t;
+
+/**
+ * @brief Argument of the task playing a game
+ */
+typedef struct SIM_TASK
+{
+    sim_t * sim;
+    game_t * game;
+} task_t;
+
+// === Global variables ===
+
+// === Function prototypes for private functions with file level scope ===
+
+// Sort scores from the lowest
+static int
+compare (const void * a, const void * b);
+
+// Fix the moving piece with a move from the input file
+static void
+move (board_t * board, char c);
+
+// Parse the command line
+static int
+parse (int argc, char ** argv, options_t * options);
+
+// Play a game
+static void
+play (void * arg);
+
+// Read the moves of the input file
+static int
+readInput (sim_t * sim, const char * path);
+
+// Play a game again from its replay
+static int
+replayGame (board_t * board, const char * dir, game_t * game);
+
+// Print the results of the simulation
+static void
+report (const sim_t * sim, double seconds);
+
+// Print how to run the simulator
+static void
+usage (const char * name);
+
+// Write the result of every game
+static int
+writeGames (const sim_t * sim, const char * path);
+
+// === ROM Constant variables with file level scope ===
+
+// === Static variables and constant variables with file level scope ===
+
+// === Global function definitions ===
+/// @publicsection
+
+/**
+ * @brief Main
+ */
+int
+main (int argc, char ** argv)
+{
+    options_t options;
+    sim_t sim = {0};
+    pool_t * pool = NULL;
+    task_t * tasks;
+    atomic_int pending = 0;
+    unsigned long long i, n;
+    uint64_t start;
+
+    if ( parse(argc, argv, &options) )
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    sim.options = &options;
+
+    if ( options.policy == POLICY_INPUT && readInput(&sim, options.input) )
+    {
+        return EXIT_FAILURE;
+    }
+
+    bot_init(&sim.bot);
+
+    n = options.last - options.first + 1;
+    sim.games = calloc(n, sizeof (game_t));
+    tasks = calloc(n, sizeof (task_t));
+
+    if ( sim.games == NULL || tasks == NULL )
+    {
+        fputs("Could not allocate memory for the games.", stderr);
+        free(sim.games);
+        free(tasks);
+        free(sim.moves);
+        return EXIT_FAILURE;
+    }
+
+    // The calling thread plays too
+    if ( options.threads > 1 )
+    {
+        pool = pool_create(options.threads - 1);
+
+        (pool == NULL) ? fputs("Could not start the threads. Playing from "
+                               "a single one.", stderr) : 0;
+    }
+
+    start = monotonic_now();
+
+    for ( i = 0; i < n; i++ )
+    {
+        sim.games[i].seed = options.first + i;
+        tasks[i].sim = &sim;
+        tasks[i].game = &sim.games[i];
+
+        if ( pool != NULL )
+        {
+            pool -> submit(pool, &play, &tasks[i], &pending);
+        }
+        else
+        {
+            play(&tasks[i]);
+        }
+    }
+
+    (pool != NULL) ? pool -> wait(pool, &pending) : (void) 0;
+
+    report(&sim, (monotonic_now() - start) / 1e9);
+
+    (options.output != NULL) ? writeGames(&sim, options.output) : 0;
+
+    pool_free(pool);
+    free(tasks);
+    free(sim.games);
+    free(sim.moves);
+
+    return EXIT_SUCCESS;
+}
+
+/// @privatesection
+// === Local function definitions ===
+
+/**
+ * @brief Sort scores from the lowest
+ * 
+ * @param a Score
+ * @param b Score
+ * 
+ * @return Less than, equal to or greater than 0 if @p a is lower, equal or
+ * greater than @p b
+ */
+static int
+compare (const void * a, const void * b)
+{
+    const int x = *(const int *) a;
+    const int y = *(const int *) b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Fix the moving piece with a move from the input file
+ * 
+ * @param board Board with the moving piece
+ * @param c Move, as described in the input file
+ * 
+ * @return Nothing
+ */
+static void
+move (board_t * board, char c)
+{
+    switch ( c )
+    {
+        case 'L':
+            board -> piece.shift(board, LEFT);
+            break;
+
+        case 'R':
+            board -> piece.shift(board, RIGHT);
+            break;
+
+        case 'Z':
+            board -> piece.rotate(board, LEFT);
+            break;
+
+        case 'X':
+            board -> piece.rotate(board, RIGHT);
+            break;
+
+        case 'S':
+            board -> piece.softDrop(board);
+            break;
+
+        case 'H':
+            board -> piece.hardDrop(board);
+            break;
+
+        case '.':
+            board -> update(board);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Parse the command line
+ * 
+ * @param argc Number of arguments
+ * @param argv Arguments
+ * @param options Where the options are written
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+static int
+parse (int argc, char ** argv, options_t * options)
+{
+    int i;
+    char * end;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+    options -> first = FIRST_SEED;
+    options -> last = LAST_SEED;
+    options -> threads = (cores > 0) ? (int) cores : 1;
+    options -> policy = POLICY_BOT;
+    options -> randomizer = RANDOMIZER_BAG;
+    options -> maxPieces = MAX_PIECES;
+    options -> input = NULL;
+    options -> output = NULL;
+    options -> replays = NULL;
+
+    for ( i = 1; i < argc; i++ )
+    {
+        // Every option has a value
+        if ( argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' ||
+             i + 1 == argc )
+        {
+            return EXIT_FAILURE;
+        }
+
+        switch ( argv[i++][1] )
+        {
+            case 's':
+                options -> first = strtoull(argv[i], &end, 10);
+                options -> last = (*end == ':') ? \
+                        strtoull(end + 1, &end, 10) : options -> first;
+
+                if ( *end != '\0' || options -> last < options -> first )
+                {
+                    return EXIT_FAILURE;
+                }
+                break;
+
+            case 't':
+                options -> threads = (int) strtol(argv[i], &end, 10);
+
+                if ( *end != '\0' || options -> threads < 1 )
+                {
+                    return EXIT_FAILURE;
+                }
+                break;
+
+            case 'p':
+                if ( strcmp(argv[i], "random") == 0 )
+                {
+                    options -> policy = POLICY_RANDOM;
+                }
+                else if ( strcmp(argv[i], "bot") == 0 )
+                {
+                    options -> policy = POLICY_BOT;
+                }
+                else if ( strcmp(argv[i], "input") == 0 )
+                {
+                    options -> policy = POLICY_INPUT;
+                }
+                else if ( strcmp(argv[i], "replay") == 0 )
+                {
+                    options -> policy = POLICY_REPLAY;
+                }
+                else
+                {
+                    return EXIT_FAILURE;
+                }
+                break;
+
+            case 'r':
+                if ( strcmp(argv[i], "bag") == 0 )
+                {
+                    options -> randomizer = RANDOMIZER_BAG;
+                }
+                else if ( strcmp(argv[i], "nes") == 0 )
+                {
+                    options -> randomizer = RANDOMIZER_NES;
+                }
+                else if ( strcmp(argv[i], "history") == 0 )
+                {
+                    options -> randomizer = RANDOMIZER_HISTORY;
+                }
+                else
+                {
+                    return EXIT_FAILURE;
+                }
+                break;
+
+            case 'i':
+                options -> input = argv[i];
+                break;
+
+            case 'm':
+                options -> maxPieces = (int) strtol(argv[i], &end, 10);
+
+                if ( *end != '\0' || options -> maxPieces < 1 )
+                {
+                    return EXIT_FAILURE;
+                }
+                break;
+
+            case 'o':
+                options -> output = argv[i];
+                break;
+
+            case 'w':
+                options -> replays = argv[i];
+                break;
+
+            default:
+                return EXIT_FAILURE;
+        }
+    }
+
+    if ( (options -> policy == POLICY_INPUT ||
+          options -> policy == POLICY_REPLAY) && options -> input == NULL )
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Play a game
+ * 
+ * Pieces are fixed by the policy of the simulation until the game ends or
+ * the most pieces allowed are fixed.
+ * 
+ * @param arg Task of the game
+ * 
+ * @return Nothing
+ */
+static void
+play (void * arg)
+{
+    task_t * task = arg;
+    sim_t * sim = task -> sim;
+    game_t * game = task -> game;
+    const options_t * options = sim -> options;
+    const stats_t * stats;
+    board_t * board;
+    placement_t list[MAX_PLACEMENTS];
+    int lines[BOARD_HEIGHT];
+    int n, cells[BLOCKS][COORD_NUM];
+    size_t moves = 0;
+    rnd_state_t choices;
+    replay_t * replay = NULL;
+    char path[MAX_PATH];
+
+    board = board_create();
+
+    if ( board == NULL )
+    {
+        return;
+    }
+
+    if ( options -> replays != NULL )
+    {
+        snprintf(path, sizeof (path), "%s/%llu.txr", options -> replays,
+                 game -> seed);
+
+        replay = replay_record(path);
+        (replay != NULL) ? board -> set.replay(board, replay) : (void) 0;
+    }
+
+    // Games with the same seed get the same pieces and random choices
+    board -> set.seed(board, game -> seed);
+    board -> set.randomizer(board, options -> randomizer);
+    init_random_state(&choices, ~game -> seed, RANDOMIZER_BAG);
+
+    if ( options -> policy == POLICY_REPLAY &&
+         replayGame(board, options -> input, game) )
+    {
+        board_free(board);
+        replay_close(replay);
+        return;
+    }
+
+    while ( options -> policy != POLICY_REPLAY &&
+            !board -> ask.endGame(board) &&
+            game -> pieces < options -> maxPieces )
+    {
+        // Next piece
+        (!board -> ask.movingPiece(board)) ? board -> update(board) : (void) 0;
+
+        if ( board -> ask.endGame(board) )
+        {
+            break;
+        }
+
+        switch ( options -> policy )
+        {
+            case POLICY_RANDOM:
+                n = board -> ask.placements(board, TETROMINO_NONE, list);
+
+                if ( n == 0 ||
+                     board -> piece.place(board,
+                                          &list[random_number(&choices, n)]) )
+                {
+                    n = -1;
+                }
+                break;
+
+            case POLICY_BOT:
+                n = sim -> bot.play(&sim -> bot, board) ? -1 : 0;
+                break;
+
+            case POLICY_INPUT:
+            default:
+                n = (moves / MAX_MOVES > (size_t) game -> pieces) ? -1 : 0;
+                move(board, sim -> moves[moves++ % sim -> nMoves]);
+                break;
+        }
+
+        // Nowhere to fix the piece, or the moves never fix it
+        if ( n < 0 )
+        {
+            break;
+        }
+
+        // The piece was fixed
+        if ( !board -> ask.movingPiece(board) )
+        {
+            game -> pieces++;
+
+            n = board -> ask.filledRows(board, lines);
+            board -> clear.lines(board, lines, n);
+        }
+    }
+
+    stats = board -> ask.stats(board);
+
+    // Every piece deployed was fixed, but the moving one or the one that
+    // topped out the board
+    for ( game -> pieces = n = 0; n < TETROMINOS; n++ )
+    {
+        game -> pieces += stats -> piece.number[n];
+    }
+
+    (board -> ask.piece(board, cells) != TETROMINO_NONE ||
+     board -> ask.endGame(board)) ? game -> pieces-- : 0;
+
+    game -> played = true;
+    game -> topOut = board -> ask.endGame(board);
+    game -> lines = stats -> lines.cleared;
+    game -> score = stats -> score.actual;
+    game -> level = stats -> level;
+
+    board_free(board);
+
+    (replay_close(replay)) ? fputs("Could not record a game.", stderr) : 0;
+}
+
+/**
+ * @brief Read the moves of the input file
+ * 
+ * Only the characters of a move are kept.
+ * 
+ * @param sim Simulation where the moves are kept
+ * @param path Input file
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+static int
+readInput (sim_t * sim, const char * path)
+{
+    FILE * pFile;
+    int c;
+
+    pFile = fopen(path, "r");
+
+    if ( pFile == NULL )
+    {
+        fputs("Could not open the input file.", stderr);
+        return EXIT_FAILURE;
+    }
+
+    sim -> moves = malloc(MAX_INPUT);
+    sim -> nMoves = 0;
+
+    if ( sim -> moves == NULL )
+    {
+        fputs("Could not allocate memory for the input file.", stderr);
+        fclose(pFile);
+        return EXIT_FAILURE;
+    }
+
+    while ( (c = fgetc(pFile)) != EOF && sim -> nMoves < MAX_INPUT )
+    {
+        (c != '\0' && strchr("LRZXSH.", c) != NULL) ? \
+                sim -> moves[sim -> nMoves++] = (char) c : 0;
+    }
+
+    fclose(pFile);
+
+    if ( sim -> nMoves == 0 )
+    {
+        fputs("The input file has no moves.", stderr);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Play a game again from its replay
+ * 
+ * The replay with the seed of the game is played at once in the board,
+ * which is recorded in it from the start. Its keyframes are compared with
+ * the board, so the game must be the same.
+ * 
+ * @param board New board
+ * @param dir Directory of the replays
+ * @param game Game being played
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE if there's no replay of the game, or it isn't
+ * played the same
+ */
+static int
+replayGame (board_t * board, const char * dir, game_t * game)
+{
+    int ans;
+    char path[MAX_PATH];
+    replay_t * replay;
+
+    snprintf(path, sizeof (path), "%s/%llu.txr", dir, game -> seed);
+
+    replay = replay_load(path);
+
+    if ( replay == NULL )
+    {
+        return EXIT_FAILURE;
+    }
+
+    ans = replay -> play(replay, board, REPLAY_MAX_SPEED);
+
+    (ans == EXIT_FAILURE) ? \
+            fprintf(stderr, "The game %llu isn't played the same.\n",
+                    game -> seed) : 0;
+
+    replay_close(replay);
+
+    return ans;
+}
+
+/**
+ * @brief Print the results of the simulation
+ * 
+ * @param sim Simulation with every game ended
+ * @param seconds Time the games took
+ * 
+ * @return Nothing
+ */
+static void
+report (const sim_t * sim, double seconds)
+{
+    const size_t n = sim -> options -> last - sim -> options -> first + 1;
+    size_t i, played = 0, topOut = 0;
+    double pieces = 0, lines = 0, score = 0, deviation = 0;
+    int * scores = malloc(n * sizeof (int));
+
+    if ( scores == NULL )
+    {
+        fputs("Could not allocate memory for the report.", stderr);
+        return;
+    }
+
+    for ( i = 0; i < n; i++ )
+    {
+        const game_t * game = &sim -> games[i];
+
+        if ( game -> played )
+        {
+            scores[played++] = game -> score;
+            topOut += game -> topOut;
+            pieces += game -> pieces;
+            lines += game -> lines;
+            score += game -> score;
+        }
+    }
+
+    printf("Games:        %zu played, %zu topped out, %zu failed\n",
+           played, topOut, n - played);
+    printf("Time:         %.3f s with %d threads\n",
+           seconds, sim -> options -> threads);
+    printf("Speed:        %.1f games/s, %.1f pieces/s\n",
+           played / seconds, pieces / seconds);
+
+    if ( played > 0 )
+    {
+        score /= played;
+
+        for ( i = 0; i < played; i++ )
+        {
+            deviation += (scores[i] - score) * (scores[i] - score);
+        }
+
+        qsort(scores, played, sizeof (int), &compare);
+
+        printf("Pieces:       %.1f mean\n", pieces / played);
+        printf("Lines:        %.1f mean\n", lines / played);
+        printf("Score:        %.1f mean, %.1f deviation\n",
+               score, sqrt(deviation / played));
+        printf("Percentiles:  0%% %d, 10%% %d, 50%% %d, 90%% %d, 100%% %d\n",
+               scores[0], scores[played / 10], scores[played / 2],
+               scores[played * 9 / 10], scores[played - 1]);
+    }
+
+    free(scores);
+}
+
+/**
+ * @brief Print how to run the simulator
+ * 
+ * @param name Name of the program
+ * 
+ * @return Nothing
+ */
+static void
+usage (const char * name)
+{
+    fprintf(stderr,
+            "Usage: %s [-s FIRST[:LAST]] [-t THREADS]\n"
+            "          [-p random|bot|input|replay] [-r bag|nes|history]\n"
+            "          [-i FILE] [-m PIECES] [-o FILE] [-w DIR]\n"
+            "  -s  Seeds of the games played (default %d:%d)\n"
+            "  -t  Threads playing them (default: every core)\n"
+            "  -p  How pieces are fixed: random, bot, input or replay "
+            "(default: bot)\n"
+            "  -r  How pieces are chosen (default: bag)\n"
+            "  -i  Moves for the input policy: L, R, Z, X, S, H and ., or\n"
+            "      the directory of the replays for the replay policy\n"
+            "  -m  Most pieces in a game (default %d)\n"
+            "  -o  File where the result of every game is written\n"
+            "  -w  Directory where every game is recorded\n",
+            name, FIRST_SEED, LAST_SEED, MAX_PIECES);
+}
+
+/**
+ * @brief Write the result of every game
+ * 
+ * One line for every game, with comma separated values.
+ * 
+ * @param sim Simulation with every game ended
+ * @param path Output file
+ * 
+ * @return Success: EXIT_SUCCESS
+ * @return Fail: EXIT_FAILURE
+ */
+static int
+writeGames (const sim_t * sim, const char * path)
+{
+    const size_t n = sim -> options -> last - sim -> options -> first + 1;
+    size_t i;
+    FILE * pFile;
+
+    pFile = fopen(path, "w");
+
+    if ( pFile == NULL )
+    {
+        fputs("Could not open the output file.", stderr);
+        return EXIT_FAILURE;
+    }
+
+    fputs("seed,played,top_out,pieces,lines,score,level\n", pFile);
+
+    for ( i = 0; i < n; i++ )
+    {
+        const game_t * game = &sim -> games[i];
+
+        fprintf(pFile, "%llu,%d,%d,%d,%d,%d,%d\n", game -> seed,
+                game -> played, game -> topOut, game -> pieces,
+                game -> lines, game -> score, game -> level);
+    }
+
+    fclose(pFile);
+
+    return EXIT_SUCCESS;
+}
@@ -33,13 +33,24 @@
 
 /// @publicsection
 // === Libraries and header files ===
+// For nanosleep, as it isn't part of C11
+#define _POSIX_C_SOURCE 199309L
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include <CUnit/Basic.h>
 
 // Functions to test
 #include "../../src/backend/board/board.h"
 
+// For STATS
+#include "../../src/backend/stats/stats_mgmt.h"
+
+// For tmr_t
+#include "../../src/backend/board/timer/boardTimer.h"
+
 // === Constants and Macro definitions ===
 /**
  * @def CELL(r,c)
@@ -73,6 +84,27 @@ void test4 (void);
 // Test end game
 void test5 (void);
 
+// Test clearing several filled lines at once
+void test6 (void);
+
+// Hard drop a piece where the ghost piece is
+void test7 (void);
+
+// Snapshot and restore a game
+void test8 (void);
+
+// List every place where a piece can be fixed
+void test9 (void);
+
+// Hash of the game
+void test10 (void);
+
+// Seed of the game
+void test11 (void);
+
+// Gravity timer counts the time asleep
+void test12 (void);
+
 // Verify if the last row has a fixed piece
 static int
 pieceInLastRow (grid_t * board);
@@ -84,7 +116,7 @@ printBoard (grid_t * board);
 
 // === Static variables and constant variables with file level scope ===
 // Board structure to use in the tests
-static board_t boardStruct;
+static board_t * boardStruct = NULL;
 
 // === Global function definitions ===
 
@@ -116,7 +148,19 @@ main ()
                               test3)) ||
          (NULL == CU_add_test(pSuite, "test4: Test clearing filled lines",
                               test4)) ||
-         (NULL == CU_add_test(pSuite, "test5: Test end game", test5)) )
+         (NULL == CU_add_test(pSuite, "test5: Test end game", test5)) ||
+         (NULL == CU_add_test(pSuite, "test6: Test clearing several filled "\
+                                        "lines at once", test6)) ||
+         (NULL == CU_add_test(pSuite, "test7: Hard drop a piece where the "\
+                                        "ghost piece is", test7)) ||
+         (NULL == CU_add_test(pSuite, "test8: Snapshot and restore a game",
+                              test8)) ||
+         (NULL == CU_add_test(pSuite, "test9: List every place where a piece "\
+                                        "can be fixed", test9)) ||
+         (NULL == CU_add_test(pSuite, "test10: Hash of the game", test10)) ||
+         (NULL == CU_add_test(pSuite, "test11: Seed of the game", test11)) ||
+         (NULL == CU_add_test(pSuite, "test12: Gravity timer counts the "\
+                                        "time asleep", test12)) )
     {
         CU_cleanup_registry();
         return CU_get_error();
@@ -140,7 +184,7 @@ main ()
 int
 init_suite (void)
 {
-    board_init(&boardStruct);
+    boardStruct = board_create();
     return 0;
 }
 
@@ -154,9 +198,10 @@ int
 clean_suite (void)
 {
     // If the board wasn't destroyed, do it
-    if ( boardStruct.destroy != NULL )
+    if ( boardStruct != NULL )
     {
-        boardStruct.destroy();
+        board_free(boardStruct);
+        boardStruct = NULL;
     }
     return 0;
 }
@@ -175,7 +220,7 @@ test1 ()
 
     grid_t * gboard = NULL;
 
-    gboard = boardStruct.ask.board();
+    gboard = boardStruct -> ask.board(boardStruct);
 
     printBoard(gboard);
 
@@ -199,34 +244,35 @@ void
 test2 (void)
 {
     // Drop it a few times
-    boardStruct.update();
-    boardStruct.update();
-    boardStruct.update();
+    boardStruct -> update(boardStruct);
+    boardStruct -> update(boardStruct);
+    boardStruct -> update(boardStruct);
 
     printBoard(NULL);
 
     // Shift it to the left
-    boardStruct.piece.shift(LEFT);
-    boardStruct.piece.shift(LEFT);
-    boardStruct.piece.shift(LEFT);
+    boardStruct -> piece.shift(boardStruct, LEFT);
+    boardStruct -> piece.shift(boardStruct, LEFT);
+    boardStruct -> piece.shift(boardStruct, LEFT);
 
     printBoard(NULL);
 
     // Shift it to the right
-    boardStruct.piece.shift(RIGHT);
-    boardStruct.piece.shift(RIGHT);
+    boardStruct -> piece.shift(boardStruct, RIGHT);
+    boardStruct -> piece.shift(boardStruct, RIGHT);
 
     // Drop it once again
-    boardStruct.update();
+    boardStruct -> update(boardStruct);
 
     printBoard(NULL);
 
     // Rotate it
-    boardStruct.piece.rotate(RIGHT);
+    boardStruct -> piece.rotate(boardStruct, RIGHT);
     printBoard(NULL);
 
     // Destroy the board
-    boardStruct.destroy();
+    board_free(boardStruct);
+    boardStruct = NULL;
 }
 
 /**
@@ -244,28 +290,29 @@ test3 (void)
     // Number of pieces to stack up, number of blocks fixed and blocks moving
     int nPieces = 3, fixed = 0, moving = 0;
 
-    // Board
+    // Board and moving piece
     grid_t * gboard = NULL;
+    int piece[BLOCKS][COORD_NUM];
 
-    board_init(&boardStruct);
+    boardStruct = board_create();
 
     // Drop the first piece to make it fully visible
     for ( i = 0; i < 4; i++ )
     {
-        boardStruct.update();
+        boardStruct -> update(boardStruct);
     }
 
     // Stack up nPieces
     for ( i = 0; i < nPieces * BOARD_HEIGHT; i++ )
     {
-        boardStruct.update();
+        boardStruct -> update(boardStruct);
     }
 
     // Print the results
     printBoard(NULL);
 
     // Read the board
-    gboard = boardStruct.ask.board();
+    gboard = boardStruct -> ask.board(boardStruct);
 
     for ( i = 0; i < BOARD_HEIGHT; i++ )
     {
@@ -274,16 +321,26 @@ test3 (void)
             // The block has a fixed piece
             (CELL(gboard, i, j) >= CELL_I) ? (fixed++) : 0;
 
-            // The block has a moving piece
-            (CELL(gboard, i, j) == CELL_MOVING) ? (moving++) : 0;
+            // The moving piece must not be written in the board
+            CU_ASSERT(CELL(gboard, i, j) != CELL_MOVING);
         }
     }
 
+    // The moving piece is fully visible
+    CU_ASSERT(boardStruct -> ask.piece(boardStruct, piece) != TETROMINO_NONE);
+    for ( i = 0; i < BLOCKS; i++ )
+    {
+        (piece[i][COORD_Y] >= 0 && piece[i][COORD_Y] < BOARD_HEIGHT &&
+         CELL(gboard, piece[i][COORD_Y], piece[i][COORD_X]) == CELL_CLEAR) ? \
+                (moving++) : 0;
+    }
+
     CU_ASSERT(fixed == BLOCKS * nPieces);
     CU_ASSERT(moving == BLOCKS);
 
     // Destroy the board
-    boardStruct.destroy();
+    board_free(boardStruct);
+    boardStruct = NULL;
 }
 
 /**
@@ -303,25 +360,26 @@ test4 (void)
     int nfl, flines[BOARD_HEIGHT];
     grid_t * tboard;
 
+    // Rows to be loaded in the board
+    grid_t layout[BOARD_HEIGHT][BOARD_WIDTH] = {
+        {CELL_CLEAR}
+    };
+
     // Create the board and make a piece appear at the top (it should be always
     // there)
-    board_init(&boardStruct);
-    boardStruct.update();
-    boardStruct.update();
+    boardStruct = board_create();
+    boardStruct -> update(boardStruct);
+    boardStruct -> update(boardStruct);
 
-    // Get board
-    tboard = boardStruct.ask.board();
-    if ( tboard == NULL )
-    {
-        CU_FAIL("Could not get board in tboard.\n");
-    }
+    // The rows are written in layout first
+    tboard = &layout[0][0];
 
     /*
      * Last six lines of the board
      * 
      *  0  0  0  0  0  0  0  0  0  0 
-     *  0  0  0 -1 -1  0  3  0  0  0 
-     *  2  2 -1 -1  3  3  3  0  0  0 
+     *  0  0  0  0  0  0  3  0  0  0 
+     *  2  2  0  0  3  3  3  0  0  0 
      *  2  1  1  1  1  6  1  1  1  1 
      *  2  0  0  0  6  6  6  0  4  4 
      *  1  1  1  1  1  1  1  1  4  4 
@@ -367,30 +425,37 @@ test4 (void)
     CELL(tboard, BOARD_HEIGHT - 4, 0) = CELL_J;
     CELL(tboard, BOARD_HEIGHT - 4, 1) = CELL_J;
 
-    // Finally, add a piece moving which "fills" the third to last line
-    CELL(tboard, BOARD_HEIGHT - 4, 2) = CELL_MOVING;
-    CELL(tboard, BOARD_HEIGHT - 4, 3) = CELL_MOVING;
-    CELL(tboard, BOARD_HEIGHT - 5, 3) = CELL_MOVING;
-    CELL(tboard, BOARD_HEIGHT - 5, 4) = CELL_MOVING;
+    // Finally, load the last six lines in the board
+    for ( i = BOARD_HEIGHT - 6; i < BOARD_HEIGHT; i++ )
+    {
+        boardStruct -> set.row(boardStruct, i, layout[i]);
+    }
+
+    // Get board
+    tboard = boardStruct -> ask.board(boardStruct);
+    if ( tboard == NULL )
+    {
+        CU_FAIL("Could not get board in tboard.\n");
+    }
 
     // Print the current board
     printBoard(tboard);
 
     // Get lines that should be cleared
-    nfl = boardStruct.ask.filledRows(flines);
+    nfl = boardStruct -> ask.filledRows(boardStruct, flines);
     CU_ASSERT(nfl == 2);
     CU_ASSERT(flines[1] == BOARD_HEIGHT - 1);
     CU_ASSERT(flines[0] == BOARD_HEIGHT - 3);
 
     // Clear both of them
-    boardStruct.clear.line(flines, 1);
-    boardStruct.clear.line(flines, 0);
+    boardStruct -> clear.line(boardStruct, flines, 1);
+    boardStruct -> clear.line(boardStruct, flines, 0);
 
     // Check the bottom six rows
     /*
      *  0  0  0  0  0  0  0  0  0  0 
-     *  0  0  0 -1 -1  0  0  0  0  0 
-     *  0  0 -1 -1  0  0  0  0  0  0 
+     *  0  0  0  0  0  0  0  0  0  0 
+     *  0  0  0  0  0  0  0  0  0  0 
      *  0  0  0  0  0  0  3  0  0  3 
      *  2  2  0  0  3  3  3  3  3  3 
      *  2  0  0  0  6  6  6  0  4  4 
@@ -430,8 +495,8 @@ test4 (void)
 
     CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 4, 0) == 0);
     CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 4, 1) == 0);
-    CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 4, 2) == -1);
-    CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 4, 3) == -1);
+    CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 4, 2) == 0);
+    CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 4, 3) == 0);
     CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 4, 4) == 0);
     CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 4, 5) == 0);
     CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 4, 6) == 0);
@@ -442,8 +507,8 @@ test4 (void)
     CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 5, 0) == 0);
     CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 5, 1) == 0);
     CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 5, 2) == 0);
-    CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 5, 3) == -1);
-    CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 5, 4) == -1);
+    CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 5, 3) == 0);
+    CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 5, 4) == 0);
     CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 5, 5) == 0);
     CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 5, 6) == 0);
     CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 5, 7) == 0);
@@ -465,7 +530,8 @@ test4 (void)
     printBoard(tboard);
 
     // And destroy it
-    boardStruct.destroy();
+    board_free(boardStruct);
+    boardStruct = NULL;
 }
 
 /**
@@ -481,36 +547,607 @@ void
 test5 (void)
 {
     // Initialize the board
-    board_init(&boardStruct);
+    boardStruct = board_create();
 
     // Stack up pieces until the last visible row has a fixed one
     while ( !pieceInLastRow(NULL) )
     {
-        boardStruct.update();
+        boardStruct -> update(boardStruct);
 
         // Game must not end while "still playing"
         (pieceInLastRow(NULL)) ? \
-            1 : (CU_ASSERT(boardStruct.ask.endGame() == 0));
+            1 : (CU_ASSERT(boardStruct -> ask.endGame(boardStruct) == 0));
 
     }
 
     // Update the board twice so any new piece also gets stacked up
-    boardStruct.update();
-    boardStruct.update();
+    boardStruct -> update(boardStruct);
+    boardStruct -> update(boardStruct);
 
     // And perform an endGame check
-    CU_ASSERT(boardStruct.ask.endGame() == 1);
+    CU_ASSERT(boardStruct -> ask.endGame(boardStruct) == 1);
 
     // Finally, print the board
     printBoard(NULL);
 }
+/**
+ * @brief Test clearing several filled lines at once
+ * 
+ * Load two filled rows interleaved with two partial ones and clear both of
+ * them with a single call to clear.lines
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test6 (void)
+{
+    int i, j;
+    int nfl, flines[BOARD_HEIGHT];
+    const int * heights;
+    grid_t * tboard;
+
+    // Rows to be loaded in the board
+    grid_t layout[BOARD_HEIGHT][BOARD_WIDTH] = {
+        {CELL_CLEAR}
+    };
+
+    // Previous test leaves its board behind
+    if ( boardStruct != NULL )
+    {
+        board_free(boardStruct);
+    }
+
+    // Create the board and make a piece appear at the top
+    boardStruct = board_create();
+    boardStruct -> update(boardStruct);
+    boardStruct -> update(boardStruct);
+
+    /*
+     * Last four lines of the board
+     * 
+     *  0  0  0  0  0  0  0  0  0  5 
+     *  1  1  1  1  1  1  1  1  1  1 
+     *  2  0  0  0  0  0  0  0  0  0 
+     *  1  1  1  1  1  1  1  1  1  1 
+     */
+    for ( i = 0; i < BOARD_WIDTH; i++ )
+    {
+        layout[BOARD_HEIGHT - 1][i] = CELL_I;
+        layout[BOARD_HEIGHT - 3][i] = CELL_I;
+    }
+    layout[BOARD_HEIGHT - 2][0] = CELL_J;
+    layout[BOARD_HEIGHT - 4][BOARD_WIDTH - 1] = CELL_L;
+
+    for ( i = BOARD_HEIGHT - 4; i < BOARD_HEIGHT; i++ )
+    {
+        boardStruct -> set.row(boardStruct, i, layout[i]);
+    }
+
+    tboard = boardStruct -> ask.board(boardStruct);
+    if ( tboard == NULL )
+    {
+        CU_FAIL("Could not get board in tboard.\n");
+        return;
+    }
+
+    // Column heights of the loaded rows
+    heights = boardStruct -> ask.heights(boardStruct);
+    CU_ASSERT(heights[0] == 3);
+    CU_ASSERT(heights[BOARD_WIDTH - 1] == 4);
+    for ( j = 1; j < BOARD_WIDTH - 1; j++ )
+    {
+        CU_ASSERT(heights[j] == 3);
+    }
+
+    // Both filled rows must be found
+    nfl = boardStruct -> ask.filledRows(boardStruct, flines);
+    CU_ASSERT(nfl == 2);
+    CU_ASSERT(flines[0] == BOARD_HEIGHT - 3);
+    CU_ASSERT(flines[1] == BOARD_HEIGHT - 1);
+
+    // Clear them in one pass
+    boardStruct -> clear.lines(boardStruct, flines, nfl);
+
+    // The given lines must not be modified
+    CU_ASSERT(flines[0] == BOARD_HEIGHT - 3);
+    CU_ASSERT(flines[1] == BOARD_HEIGHT - 1);
+
+    // The two partial rows must have fallen to the bottom, in order
+    for ( j = 0; j < BOARD_WIDTH; j++ )
+    {
+        CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 1, j) == \
+                  ((j == 0) ? CELL_J : CELL_CLEAR));
+        CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 2, j) == \
+                  ((j == BOARD_WIDTH - 1) ? CELL_L : CELL_CLEAR));
+        CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 3, j) == CELL_CLEAR);
+        CU_ASSERT(CELL(tboard, BOARD_HEIGHT - 4, j) == CELL_CLEAR);
+    }
+
+    // Heights must have dropped with the blocks
+    CU_ASSERT(heights[0] == 1);
+    CU_ASSERT(heights[BOARD_WIDTH - 1] == 2);
+    for ( j = 1; j < BOARD_WIDTH - 1; j++ )
+    {
+        CU_ASSERT(heights[j] == 0);
+    }
+
+    // And no filled rows should be left
+    CU_ASSERT(boardStruct -> ask.filledRows(boardStruct, flines) == 0);
+
+    // Print the board
+    printBoard(tboard);
+
+    // And destroy it
+    board_free(boardStruct);
+    boardStruct = NULL;
+}
+
+/**
+ * @brief Hard drop a piece where the ghost piece is
+ * 
+ * Ask where the piece would land, hard drop it and check that it was fixed
+ * there, scoring one point per row dropped.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test7 (void)
+{
+    int i, type, bottom = 0;
+    int piece[BLOCKS][COORD_NUM], ghost[BLOCKS][COORD_NUM];
+    const stats_t * stats;
+    grid_t * tboard;
+
+    boardStruct = board_create();
+    boardStruct -> update(boardStruct);
+
+    tboard = boardStruct -> ask.board(boardStruct);
+    stats = (const stats_t *) boardStruct -> ask.stats(boardStruct);
+
+    // The ghost is the piece at the bottom of the board
+    type = boardStruct -> ask.piece(boardStruct, piece);
+    CU_ASSERT_FATAL(type != TETROMINO_NONE);
+    CU_ASSERT(boardStruct -> ask.ghost(boardStruct, ghost) == type);
+
+    for ( i = 0; i < BLOCKS; i++ )
+    {
+        CU_ASSERT(ghost[i][COORD_X] == piece[i][COORD_X]);
+        CU_ASSERT(ghost[i][COORD_Y] - piece[i][COORD_Y] == \
+                  ghost[0][COORD_Y] - piece[0][COORD_Y]);
+        CU_ASSERT(ghost[i][COORD_Y] < BOARD_HEIGHT);
+    }
+
+    // Hard drop it
+    boardStruct -> piece.hardDrop(boardStruct);
+
+    // No piece is moving and it was fixed where the ghost was
+    CU_ASSERT(boardStruct -> ask.piece(boardStruct, piece) == TETROMINO_NONE);
+
+    for ( i = 0; i < BLOCKS; i++ )
+    {
+        CU_ASSERT(CELL(tboard, ghost[i][COORD_Y], ghost[i][COORD_X]) == \
+                  type + 1);
+    }
+
+    // On an empty board, it lands on the last row
+    for ( i = 0; i < BLOCKS; i++ )
+    {
+        (ghost[i][COORD_Y] == BOARD_HEIGHT - 1) ? bottom++ : 0;
+    }
+    CU_ASSERT(bottom > 0);
+    CU_ASSERT(stats -> score.actual == ghost[0][COORD_Y] - piece[0][COORD_Y]);
+
+    printBoard(tboard);
+
+    board_free(boardStruct);
+    boardStruct = NULL;
+}
+
+/**
+ * @brief Snapshot and restore a game
+ * 
+ * A game restored to a snapshot looks as it did when it was taken and, from
+ * then on, plays exactly like the game it was taken from, even in another
+ * board.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test8 (void)
+{
+    int i, type;
+    int piece[BLOCKS][COORD_NUM], cells[BLOCKS][COORD_NUM];
+    grid_t grid[BOARD_HEIGHT * BOARD_WIDTH];
+    board_state_t state, again;
+    board_t * other;
+    const stats_t * stats, * otherStats;
+    int score;
+
+    boardStruct = board_create();
+    other = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL && other != NULL);
+
+    stats = (const stats_t *) boardStruct -> ask.stats(boardStruct);
+    otherStats = (const stats_t *) other -> ask.stats(other);
+
+    // Fix some pieces and leave one moving
+    for ( i = 0; i < 3; i++ )
+    {
+        boardStruct -> update(boardStruct);
+        boardStruct -> piece.shift(boardStruct, (i % 2) ? LEFT : RIGHT);
+        boardStruct -> piece.hardDrop(boardStruct);
+    }
+    boardStruct -> update(boardStruct);
+    boardStruct -> piece.rotate(boardStruct, RIGHT);
+    boardStruct -> piece.softDrop(boardStruct);
+
+    CU_ASSERT_FATAL(board_snapshot(boardStruct, &state) == EXIT_SUCCESS);
+
+    memcpy(grid, boardStruct -> ask.board(boardStruct), sizeof (grid));
+    type = boardStruct -> ask.piece(boardStruct, piece);
+    score = stats -> score.actual;
+
+    // Keep playing
+    for ( i = 0; i < 4; i++ )
+    {
+        boardStruct -> piece.hardDrop(boardStruct);
+        boardStruct -> update(boardStruct);
+    }
+    CU_ASSERT(memcmp(grid, boardStruct -> ask.board(boardStruct),
+                     sizeof (grid)) != 0);
+
+    // Go back
+    CU_ASSERT_FATAL(board_restore(boardStruct, &state) == EXIT_SUCCESS);
+
+    CU_ASSERT(memcmp(grid, boardStruct -> ask.board(boardStruct),
+                     sizeof (grid)) == 0);
+    CU_ASSERT(boardStruct -> ask.piece(boardStruct, cells) == type);
+    CU_ASSERT(memcmp(piece, cells, sizeof (piece)) == 0);
+    CU_ASSERT(stats -> score.actual == score);
+
+    // A snapshot of the restored game is the same
+    CU_ASSERT(board_snapshot(boardStruct, &again) == EXIT_SUCCESS);
+    CU_ASSERT(memcmp(&state, &again, sizeof (state)) == 0);
+
+    // Both games play the same from the snapshot. New bags come from the
+    // global random generator, so only the moving and next pieces are played
+    CU_ASSERT_FATAL(board_restore(other, &state) == EXIT_SUCCESS);
+
+    for ( i = 0; i < 2; i++ )
+    {
+        boardStruct -> piece.shift(boardStruct, (i % 3) ? RIGHT : LEFT);
+        other -> piece.shift(other, (i % 3) ? RIGHT : LEFT);
+        boardStruct -> piece.hardDrop(boardStruct);
+        other -> piece.hardDrop(other);
+        boardStruct -> update(boardStruct);
+        other -> update(other);
+    }
+
+    CU_ASSERT(memcmp(boardStruct -> ask.board(boardStruct),
+                     other -> ask.board(other), sizeof (grid)) == 0);
+    CU_ASSERT(boardStruct -> ask.piece(boardStruct, piece) == \
+              other -> ask.piece(other, cells));
+    CU_ASSERT(stats -> score.actual == otherStats -> score.actual);
+    CU_ASSERT(stats -> piece.current == otherStats -> piece.current);
+
+    printBoard(boardStruct -> ask.board(boardStruct));
+
+    board_free(other);
+    board_free(boardStruct);
+    boardStruct = NULL;
+}
+
+/**
+ * @brief List every place where a piece can be fixed
+ * 
+ * On an empty board, every piece can be fixed in every column of the last row
+ * with each of its distinct shapes. Under an overhang, a piece can only be
+ * fixed shifting it after it was dropped.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test9 (void)
+{
+    int i, j, k, n, low, tucked;
+    // Distinct placements of every piece in an empty board
+    const int expected[TETROMINOS] = {
+        // I
+        (BOARD_WIDTH - 3) + BOARD_WIDTH,
+        // J, L
+        2 * (BOARD_WIDTH - 2) + 2 * (BOARD_WIDTH - 1),
+        2 * (BOARD_WIDTH - 2) + 2 * (BOARD_WIDTH - 1),
+        // O
+        BOARD_WIDTH - 1,
+        // S
+        (BOARD_WIDTH - 2) + (BOARD_WIDTH - 1),
+        // T
+        2 * (BOARD_WIDTH - 2) + 2 * (BOARD_WIDTH - 1),
+        // Z
+        (BOARD_WIDTH - 2) + (BOARD_WIDTH - 1)
+    };
+    const grid_t overhang[BOARD_WIDTH] = {
+        CELL_Z, CELL_Z, CELL_Z, CELL_Z, CELL_Z, CELL_Z
+    };
+    placement_t list[MAX_PLACEMENTS];
+    grid_t * tboard;
+
+    boardStruct = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL);
+    tboard = boardStruct -> ask.board(boardStruct);
+
+    for ( i = TETROMINO_I; i < TETROMINOS; i++ )
+    {
+        n = boardStruct -> ask.placements(boardStruct, i, list);
+        CU_ASSERT(n == expected[i]);
+
+        for ( j = 0; j < n; j++ )
+        {
+            // Every piece lands on the last row
+            for ( k = b1, low = 0; k < BLOCKS; k++ )
+            {
+                (list[j].cells[k][COORD_Y] == BOARD_HEIGHT - 1) ? low++ : 0;
+            }
+            CU_ASSERT(low > 0);
+
+            // And no two placements have the same blocks
+            for ( k = 0; k < j; k++ )
+            {
+                CU_ASSERT(memcmp(list[j].cells, list[k].cells,
+                                 sizeof (list[j].cells)) != 0);
+            }
+        }
+    }
+
+    // The moving piece can be fixed in the same places as a new one
+    boardStruct -> update(boardStruct);
+    i = boardStruct -> ask.piece(boardStruct, list[0].cells);
+    CU_ASSERT(boardStruct -> ask.placements(boardStruct, TETROMINO_NONE,
+                                            list) == expected[i]);
+
+    // Cover the first columns of the last row. An horizontal I fits under them
+    boardStruct -> set.row(boardStruct, BOARD_HEIGHT - 2, overhang);
+    n = boardStruct -> ask.placements(boardStruct, TETROMINO_I, list);
+
+    for ( j = 0, tucked = 0; j < n; j++ )
+    {
+        for ( k = b1, low = 0; k < BLOCKS; k++ )
+        {
+            // Every block is fixed in a clear cell
+            CU_ASSERT(CELL(tboard, list[j].cells[k][COORD_Y],
+                           list[j].cells[k][COORD_X]) == CELL_CLEAR);
+
+            (list[j].cells[k][COORD_Y] == BOARD_HEIGHT - 1 &&
+             list[j].cells[k][COORD_X] < 4) ? low++ : 0;
+        }
+
+        (low == BLOCKS) ? tucked++ : 0;
+    }
+    CU_ASSERT(tucked == 1);
+
+    board_free(boardStruct);
+    boardStruct = NULL;
+}
+
+/**
+ * @brief Hash of the game
+ * 
+ * The hash kept up to date while playing is the same one a restored game
+ * computes from scratch, and goes back to its value when the game does.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test10 (void)
+{
+    int i, n, type, lines[BOARD_HEIGHT];
+    int before[BLOCKS][COORD_NUM], after[BLOCKS][COORD_NUM];
+    uint64_t hash;
+    board_state_t state;
+    board_t * other;
+
+    boardStruct = board_create();
+    other = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL && other != NULL);
+
+    boardStruct -> set.startRows(boardStruct, 4);
+
+    for ( i = 0; i < 40 && !boardStruct -> ask.endGame(boardStruct); i++ )
+    {
+        boardStruct -> update(boardStruct);
+
+        // Moving the piece changes the hash, and moving it back restores it
+        hash = boardStruct -> ask.hash(boardStruct);
+        type = boardStruct -> ask.piece(boardStruct, before);
+        boardStruct -> piece.shift(boardStruct, RIGHT);
+
+        if ( type != TETROMINO_NONE &&
+             boardStruct -> ask.piece(boardStruct, after) == type &&
+             memcmp(before, after, sizeof (before)) != 0 )
+        {
+            CU_ASSERT(boardStruct -> ask.hash(boardStruct) != hash);
+            boardStruct -> piece.shift(boardStruct, LEFT);
+            CU_ASSERT(boardStruct -> ask.hash(boardStruct) == hash);
+        }
+
+        boardStruct -> piece.shift(boardStruct, (i % 2) ? LEFT : RIGHT);
+        boardStruct -> piece.hardDrop(boardStruct);
+
+        n = boardStruct -> ask.filledRows(boardStruct, lines);
+        boardStruct -> clear.lines(boardStruct, lines, n);
+
+        // Same as computing it again
+        CU_ASSERT_FATAL(board_snapshot(boardStruct, &state) == EXIT_SUCCESS);
+        CU_ASSERT_FATAL(board_restore(other, &state) == EXIT_SUCCESS);
+        CU_ASSERT(boardStruct -> ask.hash(boardStruct) == \
+                  other -> ask.hash(other));
+    }
+
+    // Another game is different
+    board_free(other);
+    other = board_create();
+    CU_ASSERT_FATAL(other != NULL);
+    CU_ASSERT(boardStruct -> ask.hash(boardStruct) != other -> ask.hash(other));
+
+    board_free(other);
+    board_free(boardStruct);
+    boardStruct = NULL;
+}
+
+/**
+ * @brief Seed of the game
+ * 
+ * Two games with the same seed get the same rows and pieces, even when
+ * snapshots are restored in the middle, and new games get different seeds.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test11 (void)
+{
+    board_t * other;
+
+    boardStruct = board_create();
+    other = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL && other != NULL);
+
+    // Every game is created with its own seed
+    CU_ASSERT(boardStruct -> ask.seed(boardStruct) != other -> ask.seed(other));
+
+    boardStruct -> set.seed(boardStruct, 2019);
+    other -> set.seed(other, 2019);
+    CU_ASSERT(boardStruct -> ask.seed(boardStruct) == 2019);
+    CU_ASSERT(other -> ask.seed(other) == 2019);
+
+    // The randomizer keeps the seed
+    CU_ASSERT(boardStruct -> ask.randomizer(boardStruct) == RANDOMIZER_BAG);
+    boardStruct -> set.randomizer(boardStruct, RANDOMIZER_NES);
+    other -> set.randomizer(other, RANDOMIZER_NES);
+    CU_ASSERT(boardStruct -> ask.randomizer(boardStruct) == RANDOMIZER_NES);
+    CU_ASSERT(boardStruct -> ask.seed(boardStruct) == 2019);
+
+    // Seeds are ignored with TRUERANDOM
+#ifndef TRUERANDOM
+    int i;
+    int cells[BLOCKS][COORD_NUM];
+    board_state_t state;
+
+    boardStruct -> set.startRows(boardStruct, 3);
+    other -> set.startRows(other, 3);
+    CU_ASSERT(memcmp(boardStruct -> ask.board(boardStruct),
+                     other -> ask.board(other),
+                     BOARD_HEIGHT * BOARD_WIDTH * sizeof (grid_t)) == 0);
+    CU_ASSERT(boardStruct -> ask.hash(boardStruct) == \
+              other -> ask.hash(other));
+
+    for ( i = 0; i < 3 * TETROMINOS && !boardStruct -> ask.endGame(boardStruct);
+          i++ )
+    {
+        boardStruct -> update(boardStruct);
+        other -> update(other);
+
+        CU_ASSERT(boardStruct -> ask.piece(boardStruct, cells) == \
+                  other -> ask.piece(other, cells));
+
+        boardStruct -> piece.hardDrop(boardStruct);
+        other -> piece.hardDrop(other);
+
+        // The generator goes on from a restored game
+        if ( i == TETROMINOS )
+        {
+            CU_ASSERT_FATAL(board_snapshot(other, &state) == EXIT_SUCCESS);
+            board_free(other);
+            other = board_create();
+            CU_ASSERT_FATAL(other != NULL);
+            CU_ASSERT_FATAL(board_restore(other, &state) == EXIT_SUCCESS);
+            CU_ASSERT(other -> ask.seed(other) == 2019);
+            CU_ASSERT(other -> ask.randomizer(other) == RANDOMIZER_NES);
+        }
+    }
+
+    CU_ASSERT(boardStruct -> ask.hash(boardStruct) == \
+              other -> ask.hash(other));
+#endif
+
+    board_free(other);
+    board_free(boardStruct);
+    boardStruct = NULL;
+}
+
+/**
+ * @brief Gravity timer counts the time asleep
+ * 
+ * Steps are given for the time passed while sleeping, and what's left of a
+ * step is kept for the next one.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test12 (void)
+{
+    int steps;
+    int64_t limit, left;
+    tmr_t * timer;
+    struct timespec nap;
+
+    boardStruct = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL);
+
+    // Shortest time between steps a game can start with
+    boardStruct -> set.startLevel(boardStruct, 9);
+    timer = boardStruct -> ask.timer(boardStruct);
+    limit = (int64_t) askTimeLimit(timer) * 1000000;
+    CU_ASSERT_FATAL(limit > 0);
+
+    startTimer(timer);
+    CU_ASSERT(askSteps(timer) == 0);
+    CU_ASSERT(askTimer(timer) == false);
+
+    left = askTimeLeft(timer);
+    CU_ASSERT(left > 0 && left <= limit);
+
+    // Two steps and a half
+    nap.tv_sec = (5 * limit / 2) / 1000000000;
+    nap.tv_nsec = (5 * limit / 2) % 1000000000;
+
+    nanosleep(&nap, NULL);
+    steps = askSteps(timer);
+    CU_ASSERT(steps >= 2 && steps <= 3);
+
+    left = askTimeLeft(timer);
+    CU_ASSERT(left >= 0 && left <= limit);
+
+    // A step at a time
+    nanosleep(&nap, NULL);
+    CU_ASSERT(askTimer(timer) == true);
+    CU_ASSERT(askTimer(timer) == true);
+    CU_ASSERT(askTimeLeft(timer) < limit);
+
+    board_free(boardStruct);
+    boardStruct = NULL;
+}
+
 // === Local function definitions ===
 
 /**
  * @brief Verify if the last row has a fixed piece
  * 
  * @param board Board from which to read the last row. If NULL, the board is
- * asked using boardStruct.ask.board();
+ * asked using boardStruct -> ask.board(boardStruct);
  * 
  * @return True: Non zero
  * @return False: Zero
@@ -523,7 +1160,7 @@ pieceInLastRow (grid_t * board)
     // Get board if necessary
     if ( board == NULL )
     {
-        board = boardStruct.ask.board();
+        board = boardStruct -> ask.board(boardStruct);
     }
 
     // Read row 0 and set ans to 0 if at least one grid has a fixed block
@@ -539,7 +1176,7 @@ pieceInLastRow (grid_t * board)
  * @brief Print the board
  * 
  * @param board Board to print. If NULL, the board is asked using 
- * boardStruct.ask.board();
+ * boardStruct -> ask.board(boardStruct);
  * 
  * @return Nothing
  */
@@ -551,7 +1188,7 @@ printBoard (grid_t * board)
     // Get board if necessary
     if ( board == NULL )
     {
-        board = boardStruct.ask.board();
+        board = boardStruct -> ask.board(boardStruct);
     }
 
     // Print board
@@ -0,0 +1,504 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ * 
+ * @file    test_bot.c
+ * 
+ * @brief   Test the headless player
+ * 
+ * @details CUnit Test Suite
+ * 
+ * @authors Gino Minnucci                               <gminnucci@itba.edu.ar>
+ *          Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 11:30
+ * 
+ * @copyright GNU General Public License v3
+ */
+
+/// @publicsection
+// === Libraries and header files ===
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <CUnit/Basic.h>
+
+// For board_t
+#include "../../src/backend/board/board.h"
+
+// Functions to test
+#include "../../src/backend/bot/bot.h"
+
+// === Constants and Macro definitions ===
+
+/**
+ * @def PIECES
+ * @brief Pieces played by the bot in a game
+ */
+#define PIECES  500
+
+/**
+ * @def LOOKAHEAD
+ * @brief Pieces played with lookahead()
+ */
+#define LOOKAHEAD   30
+
+/**
+ * @def NO_LIMIT
+ * @brief Time budget long enough for any search, in milliseconds
+ */
+#define NO_LIMIT    1e9
+
+/**
+ * @def SLOTS
+ * @brief Positions held by the transposition table
+ */
+#define SLOTS       4096
+
+// === Enumerations, structures and typedefs ===
+
+// === Global variables ===
+
+// === Function prototypes with global level scope ===
+
+// Initializes this test suite
+int init_suite (void);
+
+// Cleans suite before exiting
+int clean_suite (void);
+
+// Features of a known board
+void test1 (void);
+
+// Batch scores are the weighted features of every placement
+void test2 (void);
+
+// Play a game
+void test3 (void);
+
+// Lookahead finds the same moves with many threads
+void test4 (void);
+
+// Transposition table
+void test5 (void);
+
+// === Function prototypes for private functions with file level scope ===
+
+// Placement of the given piece with every block in the last row or column
+static int
+findPlacement (int type, int vertical, int x, placement_t * where);
+
+// === ROM Constant variables with file level scope ===
+
+// === Static variables and constant variables with file level scope ===
+// Board structure to use in the tests
+static board_t * boardStruct = NULL;
+
+// Bot to use in the tests
+static bot_t bot;
+
+// === Global function definitions ===
+
+// Code automatically generated by NetBeans
+
+int
+main ()
+{
+    CU_pSuite pSuite = NULL;
+
+    /* Initialize the CUnit test registry */
+    if ( CUE_SUCCESS != CU_initialize_registry() )
+        return CU_get_error();
+
+    /* Add a suite to the registry */
+    pSuite = CU_add_suite("test_bot", init_suite, clean_suite);
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Add the tests to the suite */
+    if ( (NULL == CU_add_test(pSuite, "test1: Features of a known board",
+                              test1)) ||
+         (NULL == CU_add_test(pSuite, "test2: Batch scores are the weighted "\
+                                        "features of every placement",
+                              test2)) ||
+         (NULL == CU_add_test(pSuite, "test3: Play a game", test3)) ||
+         (NULL == CU_add_test(pSuite, "test4: Lookahead finds the same "\
+                                        "moves with many threads", test4)) ||
+         (NULL == CU_add_test(pSuite, "test5: Transposition table", test5)) )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Run all tests using the CUnit Basic interface */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+    CU_cleanup_registry();
+    return CU_get_error();
+}
+
+// === Suite definitions ===
+
+/**
+ * @brief Initializes this test suite
+ * 
+ * @return Success: 0
+ * @return Fail: Non 0
+ */
+int
+init_suite (void)
+{
+    return bot_init(&bot);
+}
+
+/*
+ * @brief Cleans suite before exiting
+ * 
+ * @return Success: 0
+ * @return Fail: Non 0
+ */
+int
+clean_suite (void)
+{
+    // If the board wasn't destroyed, do it
+    if ( boardStruct != NULL )
+    {
+        board_free(boardStruct);
+        boardStruct = NULL;
+    }
+    return 0;
+}
+
+// Tests definitions ===
+
+/**
+ * @brief Features of a known board
+ * 
+ * An horizontal I in the corner of an empty board, and a vertical I clearing
+ * the only line of the board.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test1 (void)
+{
+    int i;
+    placement_t where;
+    bot_features_t features;
+    grid_t row[BOARD_WIDTH];
+
+    boardStruct = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL);
+
+    CU_ASSERT_FATAL(findPlacement(TETROMINO_I, 0, 0, &where) == 0);
+    bot.features(&bot, boardStruct -> ask.rows(boardStruct), &where,
+                 &features);
+
+    CU_ASSERT(features.height == 4);
+    CU_ASSERT(features.lines == 0);
+    CU_ASSERT(features.holes == 0);
+    CU_ASSERT(features.bumpiness == 1);
+    CU_ASSERT(features.wells == 0);
+    CU_ASSERT(features.top == 1);
+
+    // Every column but the last one filled in the last row
+    for ( i = 0; i < BOARD_WIDTH; i++ )
+    {
+        row[i] = (i < BOARD_WIDTH - 1) ? CELL_O : CELL_CLEAR;
+    }
+    boardStruct -> set.row(boardStruct, BOARD_HEIGHT - 1, row);
+
+    CU_ASSERT_FATAL(findPlacement(TETROMINO_I, 1, BOARD_WIDTH - 1,
+                                  &where) == 0);
+    bot.features(&bot, boardStruct -> ask.rows(boardStruct), &where,
+                 &features);
+
+    // The line is cleared, leaving three blocks of the I
+    CU_ASSERT(features.lines == 1);
+    CU_ASSERT(features.height == 3);
+    CU_ASSERT(features.holes == 0);
+    CU_ASSERT(features.bumpiness == 3);
+    CU_ASSERT(features.top == 3);
+
+    // The column next to it would be a well without the I
+    CU_ASSERT_FATAL(findPlacement(TETROMINO_I, 1, 0, &where) == 0);
+    bot.features(&bot, boardStruct -> ask.rows(boardStruct), &where,
+                 &features);
+
+    CU_ASSERT(features.lines == 0);
+    CU_ASSERT(features.wells == 1);
+    CU_ASSERT(features.holes == 0);
+
+    board_free(boardStruct);
+    boardStruct = NULL;
+}
+
+/**
+ * @brief Batch scores are the weighted features of every placement
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test2 (void)
+{
+    int i, n;
+    placement_t list[MAX_PLACEMENTS];
+    double scores[MAX_PLACEMENTS], expected;
+    bot_features_t features;
+
+    boardStruct = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL);
+    boardStruct -> set.startRows(boardStruct, 5);
+
+    n = boardStruct -> ask.placements(boardStruct, TETROMINO_T, list);
+    CU_ASSERT_FATAL(n > 0);
+
+    bot.score(&bot, boardStruct -> ask.rows(boardStruct), list, n, scores);
+
+    for ( i = 0; i < n; i++ )
+    {
+        bot.features(&bot, boardStruct -> ask.rows(boardStruct), &list[i],
+                     &features);
+
+        expected = bot.weights.height * features.height +
+                bot.weights.lines * features.lines +
+                bot.weights.holes * features.holes +
+                bot.weights.bumpiness * features.bumpiness +
+                bot.weights.wells * features.wells;
+
+        CU_ASSERT_DOUBLE_EQUAL(scores[i], expected, 1e-9);
+    }
+
+    board_free(boardStruct);
+    boardStruct = NULL;
+}
+
+/**
+ * @brief Play a game
+ * 
+ * The bot fixes every piece and clears lines without losing.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test3 (void)
+{
+    int i, n;
+    int lines[BOARD_HEIGHT], cleared = 0;
+
+    boardStruct = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL);
+
+    for ( i = 0; i < PIECES && !boardStruct -> ask.endGame(boardStruct); i++ )
+    {
+        boardStruct -> update(boardStruct);
+        CU_ASSERT(bot.play(&bot, boardStruct) == EXIT_SUCCESS);
+
+        // The piece was fixed
+        CU_ASSERT(boardStruct -> ask.movingPiece(boardStruct) == false);
+
+        n = boardStruct -> ask.filledRows(boardStruct, lines);
+        boardStruct -> clear.lines(boardStruct, lines, n);
+        cleared += n;
+    }
+
+    CU_ASSERT(i == PIECES);
+    CU_ASSERT(cleared > 0);
+
+    board_free(boardStruct);
+    boardStruct = NULL;
+}
+
+/**
+ * @brief Lookahead finds the same moves with many threads
+ * 
+ * With no time limit, the moving and next piece are placed the same from a
+ * single thread and from many. With no time, the moving piece is still
+ * placed.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test4 (void)
+{
+    int i, n, lines[BOARD_HEIGHT];
+    bot_t parallel;
+    placement_t single[BOT_KNOWN], many[BOT_KNOWN];
+
+    boardStruct = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL);
+    CU_ASSERT_FATAL(bot_init(&parallel) == EXIT_SUCCESS);
+    CU_ASSERT(parallel.threads(&parallel, 4) == EXIT_SUCCESS);
+
+    for ( i = 0; i < LOOKAHEAD && !boardStruct -> ask.endGame(boardStruct);
+          i++ )
+    {
+        boardStruct -> update(boardStruct);
+
+        CU_ASSERT(bot.lookahead(&bot, boardStruct, NO_LIMIT, single) == 2);
+        CU_ASSERT(parallel.lookahead(&parallel, boardStruct, NO_LIMIT,
+                                     many) == 2);
+        CU_ASSERT(memcmp(single, many, sizeof (single)) == 0);
+
+        CU_ASSERT(boardStruct -> piece.place(boardStruct, &single[0]) == \
+                  EXIT_SUCCESS);
+
+        n = boardStruct -> ask.filledRows(boardStruct, lines);
+        boardStruct -> clear.lines(boardStruct, lines, n);
+    }
+
+    CU_ASSERT(i == LOOKAHEAD);
+
+    // No time to look at the next piece
+    boardStruct -> update(boardStruct);
+    CU_ASSERT(parallel.lookahead(&parallel, boardStruct, 0, many) >= 1);
+
+    parallel.destroy(&parallel);
+    CU_ASSERT(parallel.init == false);
+
+    board_free(boardStruct);
+    boardStruct = NULL;
+}
+
+/**
+ * @brief Transposition table
+ * 
+ * Positions are found once stored, and a deeper one isn't replaced. Searching
+ * with a table finds the same moves.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test5 (void)
+{
+    int i, n, lines[BOARD_HEIGHT];
+    ttable_t * table;
+    tt_entry_t entry = {-12.5, 3, 77}, found;
+    bot_t cached;
+    placement_t plain[BOT_KNOWN], withTable[BOT_KNOWN];
+
+    table = ttable_create(SLOTS + 1);
+    CU_ASSERT_FATAL(table != NULL);
+    CU_ASSERT(table -> size == SLOTS);
+
+    CU_ASSERT(table -> probe(table, 0xABCDEF, &found) == false);
+    table -> store(table, 0xABCDEF, &entry);
+    CU_ASSERT(table -> probe(table, 0xABCDEF, &found) == true);
+    CU_ASSERT_DOUBLE_EQUAL(found.value, entry.value, 0);
+    CU_ASSERT(found.depth == entry.depth && found.move == entry.move);
+
+    // Same slot, another hash
+    CU_ASSERT(table -> probe(table, 0xABCDEF + SLOTS, &found) == false);
+
+    // Searched deeper, so it's kept
+    entry.depth = 1;
+    entry.value = 0;
+    table -> store(table, 0xABCDEF, &entry);
+    CU_ASSERT(table -> probe(table, 0xABCDEF, &found) == true);
+    CU_ASSERT(found.depth == 3);
+
+    table -> clear(table);
+    CU_ASSERT(table -> probe(table, 0xABCDEF, &found) == false);
+
+    // Search past the next piece, so the table is used
+    boardStruct = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL);
+    CU_ASSERT_FATAL(bot_init(&cached) == EXIT_SUCCESS);
+    cached.table = table;
+    cached.depth = bot.depth = 3;
+    cached.beam = bot.beam = 2;
+
+    for ( i = 0; i < LOOKAHEAD / 3 &&
+          !boardStruct -> ask.endGame(boardStruct); i++ )
+    {
+        boardStruct -> update(boardStruct);
+
+        CU_ASSERT(bot.lookahead(&bot, boardStruct, NO_LIMIT, plain) == 2);
+        CU_ASSERT(cached.lookahead(&cached, boardStruct, NO_LIMIT,
+                                   withTable) == 2);
+        CU_ASSERT(memcmp(plain, withTable, sizeof (plain)) == 0);
+
+        boardStruct -> piece.place(boardStruct, &plain[0]);
+        n = boardStruct -> ask.filledRows(boardStruct, lines);
+        boardStruct -> clear.lines(boardStruct, lines, n);
+    }
+
+    bot_init(&bot);
+    cached.destroy(&cached);
+    ttable_free(table);
+
+    board_free(boardStruct);
+    boardStruct = NULL;
+}
+
+// === Local function definitions ===
+
+/**
+ * @brief Placement of the given piece with every block in the last row or
+ * column
+ * 
+ * @param type Piece
+ * @param vertical Look for a vertical placement, in the column @p x
+ * @param x Column of the left-most block
+ * @param where Where the placement is written
+ * 
+ * @return Success: 0
+ * @return Fail: Non 0
+ */
+static int
+findPlacement (int type, int vertical, int x, placement_t * where)
+{
+    int i, j, n, ok;
+    placement_t list[MAX_PLACEMENTS];
+
+    n = boardStruct -> ask.placements(boardStruct, type, list);
+
+    for ( i = 0; i < n; i++ )
+    {
+        for ( j = b1, ok = 1; j < BLOCKS; j++ )
+        {
+            (vertical && list[i].cells[j][COORD_X] != x) ? ok = 0 : 0;
+            (!vertical && list[i].cells[j][COORD_Y] != BOARD_HEIGHT - 1) ? \
+                    ok = 0 : 0;
+            (!vertical && list[i].cells[j][COORD_X] < x) ? ok = 0 : 0;
+            (!vertical && list[i].cells[j][COORD_X] > x + BLOCKS - 1) ? \
+                    ok = 0 : 0;
+        }
+
+        if ( ok )
+        {
+            *where = list[i];
+            return 0;
+        }
+    }
+
+    return -1;
+}
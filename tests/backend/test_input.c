@@ -0,0 +1,430 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ * 
+ * @file    test_input.c
+ * 
+ * @brief   Test the player input
+ * 
+ * @details CUnit Test Suite
+ * 
+ * @authors Gino Minnucci                               <gminnucci@itba.edu.ar>
+ *          Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 13:05
+ * 
+ * @copyright GNU General Public License v3
+ */
+
+/// @publicsection
+// === Libraries and header files ===
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <CUnit/Basic.h>
+
+// Functions to test
+#include "../../src/backend/input/input.h"
+
+// === Constants and Macro definitions ===
+
+/**
+ * @def DAS
+ * @brief Delayed auto shift of the tests, in ms
+ */
+#define DAS         100
+
+/**
+ * @def ARR
+ * @brief Auto repeat rate of the tests, in ms
+ */
+#define ARR         20
+
+/**
+ * @def T0
+ * @brief Time of the first event of a test, in ns
+ */
+#define T0          1000000000ULL
+
+/**
+ * @def PRESSES
+ * @brief Rotations pushed by another thread
+ */
+#define PRESSES     100000
+
+// === Enumerations, structures and typedefs ===
+
+// === Global variables ===
+
+// === Function prototypes with global level scope ===
+
+// Initializes this test suite
+int init_suite (void);
+
+// Cleans suite before exiting
+int clean_suite (void);
+
+// Actions are taken once, when they're pressed
+void test1 (void);
+
+// Shifts repeat after DAS and then every ARR
+void test2 (void);
+
+// Releases and the other direction stop repeats when they happen
+void test3 (void);
+
+// Events pushed from another thread are all taken in order
+void test4 (void);
+
+// === Function prototypes for private functions with file level scope ===
+
+// Push rotations with increasing times
+static void *
+producer (void * arg);
+
+// === ROM Constant variables with file level scope ===
+
+// === Static variables and constant variables with file level scope ===
+// Input structure to use in the tests
+static input_t * inputStruct = NULL;
+
+// === Global function definitions ===
+
+// Code automatically generated by NetBeans
+
+int
+main ()
+{
+    CU_pSuite pSuite = NULL;
+
+    /* Initialize the CUnit test registry */
+    if ( CUE_SUCCESS != CU_initialize_registry() )
+        return CU_get_error();
+
+    /* Add a suite to the registry */
+    pSuite = CU_add_suite("test_input", init_suite, clean_suite);
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Add the tests to the suite */
+    if ( (NULL == CU_add_test(pSuite, "test1: Actions are taken once, when "\
+                                        "they're pressed", test1)) ||
+         (NULL == CU_add_test(pSuite, "test2: Shifts repeat after DAS and "\
+                                        "then every ARR", test2)) ||
+         (NULL == CU_add_test(pSuite, "test3: Releases and the other "\
+                                        "direction stop repeats when they "\
+                                        "happen", test3)) ||
+         (NULL == CU_add_test(pSuite, "test4: Events pushed from another "\
+                                        "thread are all taken in order",
+                              test4)) )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Run all tests using the CUnit Basic interface */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+    CU_cleanup_registry();
+    return CU_get_error();
+}
+
+// === Suite definitions ===
+
+/**
+ * @brief Initializes this test suite
+ * 
+ * @return Success: 0
+ * @return Fail: Non 0
+ */
+int
+init_suite (void)
+{
+    return 0;
+}
+
+/*
+ * @brief Cleans suite before exiting
+ * 
+ * @return Success: 0
+ * @return Fail: Non 0
+ */
+int
+clean_suite (void)
+{
+    // If the input wasn't destroyed, do it
+    input_free(inputStruct);
+    inputStruct = NULL;
+
+    return 0;
+}
+
+// Tests definitions ===
+
+/**
+ * @brief Actions are taken once, when they're pressed
+ * 
+ * Rotations and hard drops don't repeat, events aren't taken before they
+ * happen, and a full queue drops them.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test1 (void)
+{
+    int i;
+
+    inputStruct = input_create(DAS, ARR);
+    CU_ASSERT_FATAL(inputStruct != NULL);
+    CU_ASSERT(inputStruct -> init == true);
+
+    // Nothing held
+    CU_ASSERT(inputStruct -> next(inputStruct, T0) == INPUT_NONE);
+    CU_ASSERT(inputStruct -> timeLeft(inputStruct, T0) == -1);
+
+    // Invalid actions
+    CU_ASSERT(inputStruct -> push(inputStruct, INPUT_NONE, true, T0) == \
+              EXIT_FAILURE);
+    CU_ASSERT(inputStruct -> push(inputStruct, INPUT_ACTIONS, true, T0) == \
+              EXIT_FAILURE);
+
+    CU_ASSERT(inputStruct -> push(inputStruct, INPUT_ROTATE_RIGHT, true,
+                                  T0) == EXIT_SUCCESS);
+    CU_ASSERT(inputStruct -> push(inputStruct, INPUT_HARD_DROP, true,
+                                  T0 + INPUT_NS(1)) == EXIT_SUCCESS);
+
+    // Not yet
+    CU_ASSERT(inputStruct -> timeLeft(inputStruct, T0 - INPUT_NS(2)) == \
+              INPUT_NS(2));
+    CU_ASSERT(inputStruct -> next(inputStruct, T0 - 1) == INPUT_NONE);
+
+    // Once each, even if they're held
+    CU_ASSERT(inputStruct -> next(inputStruct, T0 + INPUT_NS(DAS * 10)) == \
+              INPUT_ROTATE_RIGHT);
+    CU_ASSERT(inputStruct -> next(inputStruct, T0 + INPUT_NS(DAS * 10)) == \
+              INPUT_HARD_DROP);
+    CU_ASSERT(inputStruct -> next(inputStruct, T0 + INPUT_NS(DAS * 10)) == \
+              INPUT_NONE);
+    CU_ASSERT(inputStruct -> timeLeft(inputStruct, T0) == -1);
+
+    // A full queue drops events
+    for ( i = 0; i < INPUT_QUEUE; i++ )
+    {
+        CU_ASSERT(inputStruct -> push(inputStruct, INPUT_ROTATE_LEFT, i % 2,
+                                      T0 + i) == EXIT_SUCCESS);
+    }
+
+    CU_ASSERT(inputStruct -> push(inputStruct, INPUT_ROTATE_LEFT, true,
+                                  T0 + i) == EXIT_FAILURE);
+
+    // Release drops them too
+    inputStruct -> release(inputStruct);
+    CU_ASSERT(inputStruct -> timeLeft(inputStruct, T0) == -1);
+    CU_ASSERT(inputStruct -> next(inputStruct, T0 + i) == INPUT_NONE);
+
+    input_free(inputStruct);
+    inputStruct = NULL;
+}
+
+/**
+ * @brief Shifts repeat after DAS and then every ARR
+ * 
+ * Repeats are timed from the press, no matter when next() is called.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test2 (void)
+{
+    int i;
+
+    inputStruct = input_create(DAS, ARR);
+    CU_ASSERT_FATAL(inputStruct != NULL);
+
+    inputStruct -> push(inputStruct, INPUT_LEFT, true, T0);
+
+    CU_ASSERT(inputStruct -> next(inputStruct, T0) == INPUT_LEFT);
+    CU_ASSERT(inputStruct -> when(inputStruct) == T0);
+    CU_ASSERT(inputStruct -> timeLeft(inputStruct, T0) == INPUT_NS(DAS));
+    CU_ASSERT(inputStruct -> next(inputStruct, T0 + INPUT_NS(DAS) - 1) == \
+              INPUT_NONE);
+
+    // DAS, and then 3 repeats some time later
+    CU_ASSERT(inputStruct -> next(inputStruct, T0 + INPUT_NS(DAS)) == \
+              INPUT_LEFT);
+    CU_ASSERT(inputStruct -> when(inputStruct) == T0 + INPUT_NS(DAS));
+
+    // Repeats taken late happened when they were due
+    for ( i = 0; i < 3; i++ )
+    {
+        CU_ASSERT(inputStruct -> next(inputStruct,
+                                      T0 + INPUT_NS(DAS + 3 * ARR + 1)) == \
+                  INPUT_LEFT);
+        CU_ASSERT(inputStruct -> when(inputStruct) == \
+                  T0 + INPUT_NS(DAS + (i + 1) * ARR));
+    }
+
+    CU_ASSERT(inputStruct -> next(inputStruct,
+                                  T0 + INPUT_NS(DAS + 3 * ARR + 1)) == \
+              INPUT_NONE);
+    CU_ASSERT(inputStruct -> timeLeft(inputStruct,
+                                      T0 + INPUT_NS(DAS + 3 * ARR + 1)) == \
+              INPUT_NS(ARR - 1));
+
+    // Soft drops repeat every ARR from the start
+    inputStruct -> push(inputStruct, INPUT_LEFT, false, T0 + INPUT_NS(1000));
+    inputStruct -> push(inputStruct, INPUT_SOFT_DROP, true,
+                        T0 + INPUT_NS(1000));
+
+    // The shifts due before the release are taken first. The one due at
+    // the same time isn't
+    for ( i = 0; inputStruct -> next(inputStruct, T0 + INPUT_NS(1000)) == \
+          INPUT_LEFT; i++ );
+
+    CU_ASSERT(i == (1000 - DAS - 3 * ARR) / ARR - 1);
+    CU_ASSERT(inputStruct -> timeLeft(inputStruct, T0 + INPUT_NS(1000)) == \
+              INPUT_NS(ARR));
+    CU_ASSERT(inputStruct -> next(inputStruct, T0 + INPUT_NS(1000 + ARR)) == \
+              INPUT_SOFT_DROP);
+
+    input_free(inputStruct);
+    inputStruct = NULL;
+}
+
+/**
+ * @brief Releases and the other direction stop repeats when they happen
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test3 (void)
+{
+    inputStruct = input_create(DAS, ARR);
+    CU_ASSERT_FATAL(inputStruct != NULL);
+
+    // Released between the second and third repeats, taken long after
+    inputStruct -> push(inputStruct, INPUT_RIGHT, true, T0);
+    inputStruct -> push(inputStruct, INPUT_RIGHT, false,
+                        T0 + INPUT_NS(DAS + ARR + 1));
+
+    CU_ASSERT(inputStruct -> next(inputStruct, T0 + INPUT_NS(5000)) == \
+              INPUT_RIGHT);
+    CU_ASSERT(inputStruct -> next(inputStruct, T0 + INPUT_NS(5000)) == \
+              INPUT_RIGHT);
+    CU_ASSERT(inputStruct -> next(inputStruct, T0 + INPUT_NS(5000)) == \
+              INPUT_RIGHT);
+    CU_ASSERT(inputStruct -> next(inputStruct, T0 + INPUT_NS(5000)) == \
+              INPUT_NONE);
+    CU_ASSERT(inputStruct -> timeLeft(inputStruct, T0 + INPUT_NS(5000)) == -1);
+
+    // Right pressed while left is held: only right repeats
+    inputStruct -> push(inputStruct, INPUT_LEFT, true, T0 + INPUT_NS(6000));
+    inputStruct -> push(inputStruct, INPUT_RIGHT, true,
+                        T0 + INPUT_NS(6000 + DAS / 2));
+
+    CU_ASSERT(inputStruct -> next(inputStruct, T0 + INPUT_NS(6000 + DAS)) == \
+              INPUT_LEFT);
+    CU_ASSERT(inputStruct -> next(inputStruct, T0 + INPUT_NS(6000 + DAS)) == \
+              INPUT_RIGHT);
+    CU_ASSERT(inputStruct -> next(inputStruct, T0 + INPUT_NS(6000 + DAS)) == \
+              INPUT_NONE);
+    CU_ASSERT(inputStruct -> next(inputStruct,
+                                  T0 + INPUT_NS(6000 + DAS / 2 + DAS)) == \
+              INPUT_RIGHT);
+
+    input_free(inputStruct);
+    inputStruct = NULL;
+}
+
+/**
+ * @brief Events pushed from another thread are all taken in order
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test4 (void)
+{
+    int taken = 0, action;
+    pthread_t thread;
+
+    inputStruct = input_create(DAS, ARR);
+    CU_ASSERT_FATAL(inputStruct != NULL);
+
+    CU_ASSERT_FATAL(pthread_create(&thread, NULL, &producer,
+                                   inputStruct) == 0);
+
+    // Every press is a rotation, and releases aren't taken
+    while ( taken < PRESSES )
+    {
+        action = inputStruct -> next(inputStruct, UINT64_MAX);
+
+        if ( action != INPUT_NONE )
+        {
+            CU_ASSERT(action == ((taken % 2) ? INPUT_ROTATE_LEFT :
+                                 INPUT_ROTATE_RIGHT));
+            taken++;
+        }
+    }
+
+    pthread_join(thread, NULL);
+
+    CU_ASSERT(inputStruct -> next(inputStruct, UINT64_MAX) == INPUT_NONE);
+
+    input_free(inputStruct);
+    inputStruct = NULL;
+}
+
+/**
+ * @brief Push rotations with increasing times
+ * 
+ * Each one is pressed and released, retrying while the queue is full.
+ * 
+ * @param arg Input where they're pushed
+ * 
+ * @return NULL
+ */
+static void *
+producer (void * arg)
+{
+    input_t * input = (input_t *) arg;
+    int i, action;
+
+    for ( i = 0; i < PRESSES; i++ )
+    {
+        action = (i % 2) ? INPUT_ROTATE_LEFT : INPUT_ROTATE_RIGHT;
+
+        while ( input -> push(input, action, true, T0 + 2 * i) != \
+                EXIT_SUCCESS );
+
+        while ( input -> push(input, action, false, T0 + 2 * i + 1) != \
+                EXIT_SUCCESS );
+    }
+
+    return NULL;
+}
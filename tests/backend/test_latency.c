@@ -0,0 +1,384 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ * 
+ * @file    test_latency.c
+ * 
+ * @brief   Test the latency histograms
+ * 
+ * @details CUnit Test Suite
+ * 
+ * @authors Gino Minnucci                               <gminnucci@itba.edu.ar>
+ *          Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 15:50
+ * 
+ * @copyright GNU General Public License v3
+ */
+
+/// @publicsection
+// === Libraries and header files ===
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <CUnit/Basic.h>
+
+// Functions to test
+#include "../../src/backend/latency/latency.h"
+
+// Clock the input times are taken with
+#include "../../src/backend/monotonic/monotonic.h"
+
+// === Constants and Macro definitions ===
+
+/**
+ * @def US
+ * @brief Nanoseconds in a microsecond
+ */
+#define US          1000ULL
+
+/**
+ * @def RECORDS
+ * @brief Values recorded by each thread
+ */
+#define RECORDS     100000
+
+/**
+ * @def THREADS
+ * @brief Threads recording at once
+ */
+#define THREADS     4
+
+// === Enumerations, structures and typedefs ===
+
+// === Global variables ===
+
+// === Function prototypes with global level scope ===
+
+// Initializes this test suite
+int init_suite (void);
+
+// Cleans suite before exiting
+int clean_suite (void);
+
+// Values are kept within 1 / LATENCY_SUB of what they were
+void test1 (void);
+
+// Percentiles of values spread evenly
+void test2 (void);
+
+// An action is followed from the input to the display
+void test3 (void);
+
+// Values recorded from several threads are all counted
+void test4 (void);
+
+// === Function prototypes for private functions with file level scope ===
+
+// Record values from 1 to RECORDS
+static void *
+recorder (void * arg);
+
+// === ROM Constant variables with file level scope ===
+
+// === Static variables and constant variables with file level scope ===
+
+// === Global function definitions ===
+
+// Code automatically generated by NetBeans
+
+int
+main ()
+{
+    CU_pSuite pSuite = NULL;
+
+    /* Initialize the CUnit test registry */
+    if ( CUE_SUCCESS != CU_initialize_registry() )
+        return CU_get_error();
+
+    /* Add a suite to the registry */
+    pSuite = CU_add_suite("test_latency", init_suite, clean_suite);
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Add the tests to the suite */
+    if ( (NULL == CU_add_test(pSuite, "test1: Values are kept within "\
+                                        "1 / LATENCY_SUB of what they were",
+                              test1)) ||
+         (NULL == CU_add_test(pSuite, "test2: Percentiles of values spread "\
+                                        "evenly", test2)) ||
+         (NULL == CU_add_test(pSuite, "test3: An action is followed from "\
+                                        "the input to the display", test3)) ||
+         (NULL == CU_add_test(pSuite, "test4: Values recorded from several "\
+                                        "threads are all counted", test4)) )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Run all tests using the CUnit Basic interface */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+    CU_cleanup_registry();
+    return CU_get_error();
+}
+
+// === Suite definitions ===
+
+/**
+ * @brief Initializes this test suite
+ * 
+ * @return Success: 0
+ * @return Fail: Non 0
+ */
+int
+init_suite (void)
+{
+    latency_reset();
+
+    return 0;
+}
+
+/*
+ * @brief Cleans suite before exiting
+ * 
+ * @return Success: 0
+ * @return Fail: Non 0
+ */
+int
+clean_suite (void)
+{
+    latency_reset();
+
+    return 0;
+}
+
+// Tests definitions ===
+
+/**
+ * @brief Values are kept within 1 / LATENCY_SUB of what they were
+ * 
+ * Each value is recorded with a much larger one, so the median is the bucket
+ * holding it and not the highest value recorded.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test1 (void)
+{
+    uint64_t value, kept;
+
+    // Values below LATENCY_SUB are exact
+    for ( value = 1; value < 4 * LATENCY_SUB; value++ )
+    {
+        latency_reset();
+        latency_record(LATENCY_INPUT, value);
+        latency_record(LATENCY_INPUT, UINT64_MAX);
+
+        kept = latency_percentile(LATENCY_INPUT, 0.5);
+        CU_ASSERT(kept >= value && kept - value < (value / LATENCY_SUB) + 1);
+    }
+
+    for ( value = 4 * LATENCY_SUB; value < UINT64_MAX / 3; value *= 3 )
+    {
+        latency_reset();
+        latency_record(LATENCY_INPUT, value);
+        latency_record(LATENCY_INPUT, UINT64_MAX);
+
+        kept = latency_percentile(LATENCY_INPUT, 0.5);
+        CU_ASSERT(kept >= value && kept - value <= value / LATENCY_SUB);
+    }
+
+    // The highest value is kept as it was
+    CU_ASSERT(latency_percentile(LATENCY_INPUT, 1) == UINT64_MAX);
+
+    // Invalid and empty stages
+    latency_reset();
+    latency_record(LATENCY_STAGES, 10);
+    latency_record(-1, 10);
+
+    CU_ASSERT(latency_percentile(LATENCY_STAGES, 0.5) == 0);
+    CU_ASSERT(latency_percentile(LATENCY_INPUT, 0.5) == 0);
+}
+
+/**
+ * @brief Percentiles of values spread evenly
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test2 (void)
+{
+    uint64_t i;
+    FILE * stream;
+    char line[128];
+    int lines = 0;
+
+    latency_reset();
+
+    // 1 to 1000 us
+    for ( i = 1; i <= 1000; i++ )
+    {
+        latency_record(LATENCY_DISPLAY, i * US);
+    }
+
+    CU_ASSERT(latency_percentile(LATENCY_DISPLAY, 0.5) >= 500 * US);
+    CU_ASSERT(latency_percentile(LATENCY_DISPLAY, 0.5) <= \
+              500 * US + 500 * US / LATENCY_SUB);
+
+    CU_ASSERT(latency_percentile(LATENCY_DISPLAY, 0.99) >= 990 * US);
+    CU_ASSERT(latency_percentile(LATENCY_DISPLAY, 0.99) <= 1000 * US);
+
+    CU_ASSERT(latency_percentile(LATENCY_DISPLAY, 0) >= 1 * US);
+    CU_ASSERT(latency_percentile(LATENCY_DISPLAY, 0) <= \
+              1 * US + US / LATENCY_SUB);
+
+    CU_ASSERT(latency_percentile(LATENCY_DISPLAY, 1) == 1000 * US);
+
+    // Other stages are empty
+    CU_ASSERT(latency_percentile(LATENCY_TOTAL, 0.99) == 0);
+
+    // A header and a line per stage
+    stream = tmpfile();
+    CU_ASSERT_FATAL(stream != NULL);
+
+    latency_dump(stream);
+    rewind(stream);
+
+    while ( fgets(line, sizeof (line), stream) != NULL )
+    {
+        if ( lines == 1 + LATENCY_DISPLAY )
+        {
+            CU_ASSERT(strncmp(line, "display", 7) == 0);
+        }
+
+        lines++;
+    }
+
+    CU_ASSERT(lines == 1 + LATENCY_STAGES);
+
+    fclose(stream);
+}
+
+/**
+ * @brief An action is followed from the input to the display
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test3 (void)
+{
+    latency_mark_t mark = {0};
+    uint64_t input = monotonic_now() - 1000 * US, other;
+
+    latency_reset();
+
+    // Nothing to follow
+    latency_mutated(&mark, 0);
+    latency_composed(&mark);
+    latency_shown(&mark);
+
+    CU_ASSERT(mark.input == 0);
+    CU_ASSERT(latency_percentile(LATENCY_INPUT, 1) == 0);
+    CU_ASSERT(latency_percentile(LATENCY_FRAME, 1) == 0);
+
+    // The oldest action is the one followed, every one is recorded
+    latency_mutated(&mark, input);
+    other = monotonic_now();
+    latency_mutated(&mark, other);
+
+    CU_ASSERT(mark.input == input);
+    CU_ASSERT(mark.mutation >= input + 1000 * US && mark.mutation <= other);
+    CU_ASSERT(latency_percentile(LATENCY_INPUT, 1) >= 1000 * US);
+    CU_ASSERT(latency_percentile(LATENCY_INPUT, 0) < 1000 * US);
+
+    latency_composed(&mark);
+    CU_ASSERT(mark.frame >= mark.mutation);
+
+    latency_shown(&mark);
+
+    CU_ASSERT(mark.input == 0 && mark.mutation == 0 && mark.frame == 0);
+    CU_ASSERT(latency_percentile(LATENCY_TOTAL, 1) >= 1000 * US);
+    CU_ASSERT(latency_percentile(LATENCY_TOTAL, 1) < 1000 * 1000 * US);
+}
+
+/**
+ * @brief Values recorded from several threads are all counted
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test4 (void)
+{
+    pthread_t thread[THREADS];
+    int i;
+
+    latency_reset();
+
+    for ( i = 0; i < THREADS; i++ )
+    {
+        CU_ASSERT_FATAL(pthread_create(&thread[i], NULL, &recorder, NULL) == \
+                        0);
+    }
+
+    for ( i = 0; i < THREADS; i++ )
+    {
+        pthread_join(thread[i], NULL);
+    }
+
+    // Each value was recorded THREADS times
+    CU_ASSERT(latency_percentile(LATENCY_FRAME, 1) == RECORDS);
+    CU_ASSERT(latency_percentile(LATENCY_FRAME, 1.0 / RECORDS) == 1);
+    CU_ASSERT(latency_percentile(LATENCY_FRAME, 0.5) >= RECORDS / 2);
+    CU_ASSERT(latency_percentile(LATENCY_FRAME, 0.5) <= \
+              RECORDS / 2 + RECORDS / 2 / LATENCY_SUB);
+}
+
+/**
+ * @brief Record values from 1 to RECORDS
+ * 
+ * @param arg Unused
+ * 
+ * @return NULL
+ */
+static void *
+recorder (void * arg)
+{
+    uint64_t i;
+
+    (void) arg;
+
+    for ( i = 1; i <= RECORDS; i++ )
+    {
+        latency_record(LATENCY_FRAME, i);
+    }
+
+    return NULL;
+}
@@ -181,7 +181,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
 /*
  * clearMoving, setFixed, setMoving functions are copy-pasted from board.c file
  * as this test is only meant to test pieces, not board functions but this are
- * required by testPiece.update()
+ * required by testPiece.update(&testPiece)
  */
 // Clear all cells with moving pieces on the board
 static void
@@ -200,9 +200,11 @@ setMoving (void);
 // === Static variables and constant variables with file level scope ===
 
 // Board structure
-static board_t bStru;
+static board_t * bStru = NULL;
 // Board
 static int gboard[H_BOARD][W_BOARD];
+// Occupancy mask of every row in gboard
+static row_t rows[H_BOARD];
 
 // Piece structure where the piece to test is loaded
 static piece_t testPiece;
@@ -269,7 +271,7 @@ main ()
 int
 init_suite (void)
 {
-    board_init(&bStru);
+    bStru = board_create();
 
     // Create a bag with all pieces, in order
     bag[0] = TETROMINO_I;
@@ -295,6 +297,9 @@ init_suite (void)
 int
 clean_suite (void)
 {
+    board_free(bStru);
+    bStru = NULL;
+
     return 0;
 }
 
@@ -530,14 +535,14 @@ conf_onePiece (void)
 {
     clearBoard();
 
-    if ( piece_init(&testPiece, &bStru,
-                    &gboard[0][0], H_BOARD, W_BOARD,
+    if ( piece_init(&testPiece, bStru,
+                    rows, H_BOARD, W_BOARD,
                     bag[position]) )
     {
         return -1;
     }
 
-    testPiece.update();
+    testPiece.update(&testPiece);
     clearMoving();
     setMoving();
 
@@ -562,6 +567,8 @@ clearBoard (void)
         {
             gboard[i][j] = CELL_CLEAR;
         }
+
+        rows[i] = 0;
     }
 }
 
@@ -738,7 +745,7 @@ check_Gravity (int b1[COORD_NUM], int b2[COORD_NUM],
 
     for ( i = 3; i < H_BOARD; i++ )
     {
-        cellType = testPiece.update();
+        cellType = testPiece.update(&testPiece);
 
         // Last drop (must be fixed after that)
         if ( i == H_BOARD - 1 && testPiece.type != TETROMINO_I )
@@ -753,7 +760,7 @@ check_Gravity (int b1[COORD_NUM], int b2[COORD_NUM],
         {
             check_onePieceMoving(b1, b2, b3, b4);
 
-            cellType = testPiece.update();
+            cellType = testPiece.update(&testPiece);
 
             setFixed(cellType);
             check_onePieceFixed(b1, b2, b3, b4);
@@ -826,7 +833,7 @@ check_Shift (int b1[COORD_NUM], int b2[COORD_NUM],
     // Displace the piece fully to the right
     for ( i = 0; i < limit_r; i++ )
     {
-        testPiece.shift(RIGHT);
+        testPiece.shift(&testPiece, RIGHT);
 
         (b1[COORD_X]) += 1;
         (b2[COORD_X]) += 1;
@@ -839,12 +846,12 @@ check_Shift (int b1[COORD_NUM], int b2[COORD_NUM],
     // It must keep itself in the same position
     for ( i = 0; i < 10; i++ )
     {
-        testPiece.shift(RIGHT);
+        testPiece.shift(&testPiece, RIGHT);
         check_onePieceMoving(b1, b2, b3, b4);
     }
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     // And check if it's where it's supposed to
     (b1[COORD_Y]) += 1;
@@ -857,7 +864,7 @@ check_Shift (int b1[COORD_NUM], int b2[COORD_NUM],
     // Displace the piece fully to the left
     for ( i = limit_l; i > 0; i-- )
     {
-        testPiece.shift(LEFT);
+        testPiece.shift(&testPiece, LEFT);
 
         (b1[COORD_X]) -= 1;
         (b2[COORD_X]) -= 1;
@@ -870,12 +877,12 @@ check_Shift (int b1[COORD_NUM], int b2[COORD_NUM],
     // It must keep itself in the same position
     for ( i = 0; i < 10; i++ )
     {
-        testPiece.shift(LEFT);
+        testPiece.shift(&testPiece, LEFT);
         check_onePieceMoving(b1, b2, b3, b4);
     }
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     // And check if it's where it's supposed to
     (b1[COORD_Y]) += 1;
@@ -1256,7 +1263,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
                  int b3[COORD_NUM], int b4[COORD_NUM])
 {
     // Position 1 to 2
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 0;
@@ -1271,7 +1278,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1281,7 +1288,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 2 to 3
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) += 0;
@@ -1296,7 +1303,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1306,7 +1313,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 3 to 4
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) += 2;
     (b2[COORD_X]) += 1;
@@ -1321,7 +1328,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1331,7 +1338,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 4 to 1
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) -= 2;
     (b2[COORD_X]) -= 1;
@@ -1346,7 +1353,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1356,7 +1363,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 1 to 4
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) += 2;
     (b2[COORD_X]) += 1;
@@ -1371,7 +1378,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1381,7 +1388,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 4 to 3
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) -= 2;
     (b2[COORD_X]) -= 1;
@@ -1396,7 +1403,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1406,7 +1413,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 3 to 2
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 0;
@@ -1421,7 +1428,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1431,7 +1438,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 2 to 1
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) += 0;
@@ -1446,7 +1453,7 @@ check_rotationI (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1474,7 +1481,7 @@ check_rotationJ (int b1[COORD_NUM], int b2[COORD_NUM],
                  int b3[COORD_NUM], int b4[COORD_NUM])
 {
     // Position 1 to 2
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 0;
@@ -1489,7 +1496,7 @@ check_rotationJ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1499,7 +1506,7 @@ check_rotationJ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 2 to 3
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 2;
@@ -1514,7 +1521,7 @@ check_rotationJ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1524,7 +1531,7 @@ check_rotationJ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 3 to 4
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) += 0;
@@ -1539,7 +1546,7 @@ check_rotationJ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1549,7 +1556,7 @@ check_rotationJ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 4 to 1
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) -= 2;
@@ -1564,7 +1571,7 @@ check_rotationJ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1574,7 +1581,7 @@ check_rotationJ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 1 to 4
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 2;
@@ -1589,7 +1596,7 @@ check_rotationJ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1599,7 +1606,7 @@ check_rotationJ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 4 to 3
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 0;
@@ -1614,7 +1621,7 @@ check_rotationJ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1624,7 +1631,7 @@ check_rotationJ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 3 to 2
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) -= 2;
@@ -1639,7 +1646,7 @@ check_rotationJ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 2 to 1
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) += 0;
@@ -1654,7 +1661,7 @@ check_rotationJ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1681,7 +1688,7 @@ check_rotationL (int b1[COORD_NUM], int b2[COORD_NUM],
                  int b3[COORD_NUM], int b4[COORD_NUM])
 {
     // Position 1 to 2
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) -= 2;
@@ -1696,7 +1703,7 @@ check_rotationL (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1706,7 +1713,7 @@ check_rotationL (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 2 to 3
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) += 0;
@@ -1721,7 +1728,7 @@ check_rotationL (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1731,7 +1738,7 @@ check_rotationL (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 3 to 4
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 2;
@@ -1746,7 +1753,7 @@ check_rotationL (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1756,7 +1763,7 @@ check_rotationL (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 4 to 1
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 0;
@@ -1771,7 +1778,7 @@ check_rotationL (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1781,7 +1788,7 @@ check_rotationL (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 1 to 4
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) += 0;
@@ -1797,7 +1804,7 @@ check_rotationL (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1807,7 +1814,7 @@ check_rotationL (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 4 to 3
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) -= 2;
@@ -1822,7 +1829,7 @@ check_rotationL (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1832,7 +1839,7 @@ check_rotationL (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 3 to 2
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 0;
@@ -1847,7 +1854,7 @@ check_rotationL (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1857,7 +1864,7 @@ check_rotationL (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 2 to 1
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 2;
@@ -1889,12 +1896,12 @@ check_rotationO (int b1[COORD_NUM], int b2[COORD_NUM],
                  int b3[COORD_NUM], int b4[COORD_NUM])
 {
     // Position 1 to 2
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1904,12 +1911,12 @@ check_rotationO (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 2 to 3
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1919,12 +1926,12 @@ check_rotationO (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 3 to 4
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1934,12 +1941,12 @@ check_rotationO (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 4 to 1
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1949,12 +1956,12 @@ check_rotationO (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 1 to 4
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1964,12 +1971,12 @@ check_rotationO (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 4 to 3
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1979,12 +1986,12 @@ check_rotationO (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 3 to 2
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -1994,12 +2001,12 @@ check_rotationO (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 2 to 1
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2026,7 +2033,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
                  int b3[COORD_NUM], int b4[COORD_NUM])
 {
     // Position 1 to 2
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 0;
@@ -2041,7 +2048,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2051,7 +2058,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 2 to 3
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) += 0;
@@ -2066,7 +2073,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2076,7 +2083,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 3 to 4
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 0;
@@ -2091,7 +2098,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2101,7 +2108,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 4 to 1
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) += 0;
@@ -2116,7 +2123,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2126,7 +2133,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 1 to 4
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 0;
@@ -2141,7 +2148,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2151,7 +2158,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 4 to 3
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) += 0;
@@ -2166,7 +2173,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2176,7 +2183,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 3 to 2
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 0;
@@ -2191,7 +2198,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2201,7 +2208,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 2 to 1
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) += 0;
@@ -2216,7 +2223,7 @@ check_rotationS (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2243,7 +2250,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
                  int b3[COORD_NUM], int b4[COORD_NUM])
 {
     // Position 1 to 2
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 1;
@@ -2258,7 +2265,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2268,7 +2275,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 2 to 3
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) -= 1;
@@ -2283,7 +2290,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2293,7 +2300,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 3 to 4
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) += 1;
@@ -2308,7 +2315,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2318,7 +2325,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 4 to 1
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) -= 1;
@@ -2333,7 +2340,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2343,7 +2350,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 1 to 4
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) += 1;
@@ -2358,7 +2365,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2368,7 +2375,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 4 to 3
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) -= 1;
@@ -2383,7 +2390,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2393,7 +2400,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 3 to 2
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) += 1;
     (b2[COORD_X]) += 1;
@@ -2408,7 +2415,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2418,7 +2425,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 2 to 1
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) -= 1;
     (b2[COORD_X]) -= 1;
@@ -2433,7 +2440,7 @@ check_rotationT (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2460,7 +2467,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
                  int b3[COORD_NUM], int b4[COORD_NUM])
 {
     // Position 1 to 2
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) += 2;
     (b2[COORD_X]) += 1;
@@ -2475,7 +2482,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2485,7 +2492,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 2 to 3
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) -= 2;
     (b2[COORD_X]) -= 1;
@@ -2500,7 +2507,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2510,7 +2517,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 3 to 4
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) += 2;
     (b2[COORD_X]) += 1;
@@ -2525,7 +2532,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2535,7 +2542,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 4 to 1
-    testPiece.rotate(RIGHT);
+    testPiece.rotate(&testPiece, RIGHT);
 
     (b1[COORD_X]) -= 2;
     (b2[COORD_X]) -= 1;
@@ -2550,7 +2557,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2560,7 +2567,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 1 to 4
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) += 2;
     (b2[COORD_X]) += 1;
@@ -2575,7 +2582,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2585,7 +2592,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 4 to 3
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) -= 2;
     (b2[COORD_X]) -= 1;
@@ -2600,7 +2607,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2610,7 +2617,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 3 to 2
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) += 2;
     (b2[COORD_X]) += 1;
@@ -2625,7 +2632,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2635,7 +2642,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Position 2 to 1
-    testPiece.rotate(LEFT);
+    testPiece.rotate(&testPiece, LEFT);
 
     (b1[COORD_X]) -= 2;
     (b2[COORD_X]) -= 1;
@@ -2650,7 +2657,7 @@ check_rotationZ (int b1[COORD_NUM], int b2[COORD_NUM],
     check_onePieceMoving(b1, b2, b3, b4);
 
     // Drop it once
-    testPiece.update();
+    testPiece.update(&testPiece);
 
     (b1[COORD_Y])++;
     (b2[COORD_Y])++;
@@ -2719,8 +2726,17 @@ setMoving (void)
 static void
 setFixed (int cellType)
 {
+    int i;
+
     if ( cellType >= CELL_I )
     {
+        // Occupancy masks
+        for ( i = b1; i < BLOCKS; i++ )
+        {
+            rows[ testPiece.get.coordinates[i][COORD_Y] ] |= \
+                                ROW_BIT(testPiece.get.coordinates[i][COORD_X]);
+        }
+
         gboard[ testPiece.get.coordinates[b1][COORD_Y] ][ \
                         testPiece.get.coordinates[b1][COORD_X] ] = cellType;
 
@@ -35,6 +35,7 @@
 // === Libraries and header files ===
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 #include <CUnit/Basic.h>
 
 // For TETROMINO_X, NUM_PIECES, board_cell, coords and board_t
@@ -54,6 +55,7 @@
 // === Global variables ===
 int num_i;
 int rnd_bag[TETROMINOS];
+rnd_state_t rnd_state;
 
 // === Function prototypes for private functions with file level scope ===
 int init_suite (void);
@@ -61,6 +63,9 @@ int clean_suite (void);
 
 void test1 (void);
 void test2 (void);
+void test3 (void);
+void test4 (void);
+void test5 (void);
 
 /*static void
 printArr (int arr[TETROMINOS]);*/
@@ -191,7 +196,10 @@ main ()
          (NULL == CU_add_test(pSuite, "test2 (97) ", test2)) ||
          (NULL == CU_add_test(pSuite, "test2 (98) ", test2)) ||
          (NULL == CU_add_test(pSuite, "test2 (99) ", test2)) ||
-         (NULL == CU_add_test(pSuite, "test2 (100) ", test2)) )
+         (NULL == CU_add_test(pSuite, "test2 (100) ", test2)) ||
+         (NULL == CU_add_test(pSuite, "test3", test3)) ||
+         (NULL == CU_add_test(pSuite, "test4", test4)) ||
+         (NULL == CU_add_test(pSuite, "test5", test5)) )
     {
         CU_cleanup_registry();
         return CU_get_error();
@@ -209,12 +217,7 @@ main ()
 int
 init_suite (void)
 {
-#ifndef TRUERANDOM
-    if ( init_random_generator() )
-    {
-        return 1;
-    }
-#endif
+    init_random_state(&rnd_state, (uint64_t) time(NULL), RANDOMIZER_BAG);
 
     return 0;
 }
@@ -237,7 +240,7 @@ test1 ()
     count_oth = 0;
     count_i = count_j = count_l = count_o = count_s = count_t = count_z = 0;
 
-    random_generator(rnd_bag, TETROMINOS);
+    random_generator(&rnd_state, rnd_bag, TETROMINOS);
 
     for ( i = 0; i < TETROMINOS; i++ )
     {
@@ -301,7 +304,7 @@ test2 ()
         old_bag[i] = rnd_bag[i];
     }
 
-    random_generator(rnd_bag, TETROMINOS);
+    random_generator(&rnd_state, rnd_bag, TETROMINOS);
 
     for ( i = 0; i < TETROMINOS; i++ )
     {
@@ -359,6 +362,133 @@ test2 ()
 
 }
 
+void
+test3 ()
+{
+    int i, j, differ = 0;
+    int bag_a[TETROMINOS] = {0}, bag_b[TETROMINOS] = {0};
+    rnd_state_t state_a, state_b;
+
+    // The same seed gives the same bags
+    init_random_state(&state_a, 42, RANDOMIZER_BAG);
+    init_random_state(&state_b, 42, RANDOMIZER_BAG);
+    CU_ASSERT(state_a.seed == 42);
+
+    for ( i = 0; i < 100; i++ )
+    {
+        random_generator(&state_a, bag_a, TETROMINOS);
+        random_generator(&state_b, bag_b, TETROMINOS);
+
+        for ( j = 0; j < TETROMINOS; j++ )
+        {
+#ifndef TRUERANDOM
+            CU_ASSERT(bag_a[j] == bag_b[j]);
+#endif
+            CU_ASSERT(bag_a[j] >= TETROMINO_I && bag_a[j] <= TETROMINO_Z);
+        }
+    }
+
+    // Another seed doesn't
+    init_random_state(&state_b, 43, RANDOMIZER_BAG);
+
+    for ( i = 0; i < 100; i++ )
+    {
+        random_generator(&state_a, bag_a, TETROMINOS);
+        random_generator(&state_b, bag_b, TETROMINOS);
+
+        for ( j = 0; j < TETROMINOS; j++ )
+        {
+            (bag_a[j] != bag_b[j]) ? differ++ : 0;
+        }
+    }
+
+    CU_ASSERT(differ > 0);
+
+    // Numbers are in range
+    for ( i = 0; i < 1000; i++ )
+    {
+        CU_ASSERT(random_number(&state_a, TETROMINOS) < TETROMINOS);
+    }
+}
+
+void
+test4 ()
+{
+    int i, n;
+    int seen[TETROMINOS] = {0};
+
+    // Far more numbers than fit in a pool of random bytes, so it's filled
+    // again many times
+    for ( i = 0; i < 10000; i++ )
+    {
+        n = random_number(&rnd_state, TETROMINOS);
+
+        CU_ASSERT(n >= 0 && n < TETROMINOS);
+        (n >= 0 && n < TETROMINOS) ? seen[n]++ : 0;
+    }
+
+    // Every number is given, and none too often
+    for ( i = 0; i < TETROMINOS; i++ )
+    {
+        CU_ASSERT(seen[i] > 10000 / TETROMINOS / 2);
+        CU_ASSERT(seen[i] < 10000 / TETROMINOS * 2);
+    }
+}
+
+void
+test5 ()
+{
+    int randomizer, i, j;
+    int count_sz, count_i, count[TETROMINOS];
+    int bag[TETROMINOS];
+    rnd_state_t state;
+
+    for ( randomizer = 0; randomizer < RANDOMIZERS; randomizer++ )
+    {
+        init_random_state(&state, 2019, randomizer);
+        CU_ASSERT(state.randomizer == randomizer);
+
+        count_sz = count_i = 0;
+
+        for ( i = 0; i < 1000; i++ )
+        {
+            random_generator(&state, bag, TETROMINOS);
+
+            for ( j = 0; j < TETROMINOS; j++ )
+            {
+                count[j] = 0;
+            }
+
+            // Every randomizer keeps the rules
+            for ( j = 0; j < TETROMINOS; j++ )
+            {
+                CU_ASSERT_FATAL(bag[j] >= TETROMINO_I && bag[j] <= TETROMINO_Z);
+                count[bag[j]]++;
+
+                (bag[j] == TETROMINO_S || bag[j] == TETROMINO_Z) ? \
+                        count_sz++ : (count_sz = 0);
+                (bag[j] == TETROMINO_I) ? (count_i = 0) : count_i++;
+
+                CU_ASSERT(count_sz <= MAX_SZ);
+                CU_ASSERT(count_i <= MAX_I);
+            }
+
+            // A bag has every piece once
+            if ( randomizer == RANDOMIZER_BAG )
+            {
+                for ( j = 0; j < TETROMINOS; j++ )
+                {
+                    CU_ASSERT(count[j] == 1);
+                }
+            }
+        }
+    }
+
+    // An invalid randomizer gets a bag
+    init_random_state(&state, 2019, RANDOMIZERS);
+    CU_ASSERT(state.randomizer == RANDOMIZER_BAG);
+}
+
 // === Local function definitions ===
 
 /*static void
@@ -0,0 +1,561 @@
+/******************************************************************************
+ * Copyright (C) 2019 Martín E. Zahnd
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+
+/**
+ * 
+ * @file    test_replay.c
+ * 
+ * @brief   Test the recording of games
+ * 
+ * @details CUnit Test Suite
+ * 
+ * @authors Gino Minnucci                               <gminnucci@itba.edu.ar>
+ *          Martín E. Zahnd                                <mzahnd@itba.edu.ar>
+ * 
+ * @date    17/10/2026, 19:10
+ * 
+ * @copyright GNU General Public License v3
+ */
+
+/// @publicsection
+// === Libraries and header files ===
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <CUnit/Basic.h>
+
+// For board_t
+#include "../../src/backend/board/board.h"
+
+// For rnd_state_t
+#include "../../src/backend/board/random_generator.h"
+
+// For stats_t
+#include "../../src/backend/stats/stats_mgmt.h"
+
+// For bot_t
+#include "../../src/backend/bot/bot.h"
+
+// Functions to test
+#include "../../src/backend/replay/replay.h"
+
+// === Constants and Macro definitions ===
+
+/**
+ * @def REPLAY_FILE
+ * @brief Replay written by the tests
+ */
+#define REPLAY_FILE "test_replay.txr"
+
+/**
+ * @def MOVES
+ * @brief Moves played in a recorded game
+ */
+#define MOVES       3000
+
+/**
+ * @def SEED
+ * @brief Seed of the recorded game
+ */
+#define SEED        1234
+
+/**
+ * @def PIECES
+ * @brief Pieces played by the bot in a recorded game
+ */
+#define PIECES      (3 * REPLAY_KEYFRAME_PIECES + 50)
+
+// === Enumerations, structures and typedefs ===
+
+// === Global variables ===
+
+// === Function prototypes with global level scope ===
+
+// Initializes this test suite
+int init_suite (void);
+
+// Cleans suite before exiting
+int clean_suite (void);
+
+// Events are read as they were written
+void test1 (void);
+
+// A recorded game is played the same again
+void test2 (void);
+
+// Only new boards are recorded
+void test3 (void);
+
+// Seek to any piece
+void test4 (void);
+
+// === Function prototypes for private functions with file level scope ===
+
+// === ROM Constant variables with file level scope ===
+
+// === Static variables and constant variables with file level scope ===
+// Board structure to use in the tests
+static board_t * boardStruct = NULL;
+
+// === Global function definitions ===
+
+// Code automatically generated by NetBeans
+
+int
+main ()
+{
+    CU_pSuite pSuite = NULL;
+
+    /* Initialize the CUnit test registry */
+    if ( CUE_SUCCESS != CU_initialize_registry() )
+        return CU_get_error();
+
+    /* Add a suite to the registry */
+    pSuite = CU_add_suite("test_replay", init_suite, clean_suite);
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Add the tests to the suite */
+    if ( (NULL == CU_add_test(pSuite, "test1: Events are read as they were "\
+                                        "written", test1)) ||
+         (NULL == CU_add_test(pSuite, "test2: A recorded game is played the "\
+                                        "same again", test2)) ||
+         (NULL == CU_add_test(pSuite, "test3: Only new boards are recorded",
+                              test3)) ||
+         (NULL == CU_add_test(pSuite, "test4: Seek to any piece", test4)) )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Run all tests using the CUnit Basic interface */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+    CU_cleanup_registry();
+    return CU_get_error();
+}
+
+// === Suite definitions ===
+
+/**
+ * @brief Initializes this test suite
+ * 
+ * @return Success: 0
+ * @return Fail: Non 0
+ */
+int
+init_suite (void)
+{
+    return 0;
+}
+
+/*
+ * @brief Cleans suite before exiting
+ * 
+ * @return Success: 0
+ * @return Fail: Non 0
+ */
+int
+clean_suite (void)
+{
+    // If the board wasn't destroyed, do it
+    if ( boardStruct != NULL )
+    {
+        board_free(boardStruct);
+        boardStruct = NULL;
+    }
+
+    remove(REPLAY_FILE);
+    return 0;
+}
+
+// Tests definitions ===
+
+/**
+ * @brief Events are read as they were written
+ * 
+ * Negative and large arguments are kept, and events with a wrong number of
+ * arguments aren't.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test1 (void)
+{
+    int i;
+    FILE * file;
+    replay_t * replay;
+    replay_event_t event;
+    const int64_t seed[1] = {INT64_MIN}, shift[1] = {-1},
+            place[3] = {-2, 300000, 3}, lines[3] = {19, 18, 0};
+
+    replay = replay_record(REPLAY_FILE);
+    CU_ASSERT_FATAL(replay != NULL);
+    CU_ASSERT(replay -> recording == true);
+
+    CU_ASSERT(replay -> event(replay, REPLAY_SEED, 1, seed) == EXIT_SUCCESS);
+    CU_ASSERT(replay -> event(replay, REPLAY_UPDATE, 0, NULL) == \
+              EXIT_SUCCESS);
+    CU_ASSERT(replay -> event(replay, REPLAY_SHIFT, 1, shift) == \
+              EXIT_SUCCESS);
+    CU_ASSERT(replay -> event(replay, REPLAY_PLACE, 3, place) == \
+              EXIT_SUCCESS);
+    CU_ASSERT(replay -> event(replay, REPLAY_CLEAR_LINES, 3, lines) == \
+              EXIT_SUCCESS);
+
+    // Wrong arguments or event
+    CU_ASSERT(replay -> event(replay, REPLAY_PLACE, 1, place) == \
+              EXIT_FAILURE);
+    CU_ASSERT(replay -> event(replay, REPLAY_EVENTS, 0, NULL) == \
+              EXIT_FAILURE);
+
+    // Nothing is read from a replay being recorded
+    CU_ASSERT(replay -> next(replay, &event) == EXIT_FAILURE);
+
+    CU_ASSERT(replay_close(replay) == EXIT_SUCCESS);
+
+    replay = replay_load(REPLAY_FILE);
+    CU_ASSERT_FATAL(replay != NULL);
+    CU_ASSERT(replay -> recording == false);
+
+    CU_ASSERT_FATAL(replay -> next(replay, &event) == EXIT_SUCCESS);
+    CU_ASSERT(event.type == REPLAY_SEED && event.n == 1);
+    CU_ASSERT(event.args[0] == INT64_MIN);
+
+    CU_ASSERT_FATAL(replay -> next(replay, &event) == EXIT_SUCCESS);
+    CU_ASSERT(event.type == REPLAY_UPDATE && event.n == 0);
+
+    CU_ASSERT_FATAL(replay -> next(replay, &event) == EXIT_SUCCESS);
+    CU_ASSERT(event.type == REPLAY_SHIFT && event.n == 1);
+    CU_ASSERT(event.args[0] == -1);
+
+    CU_ASSERT_FATAL(replay -> next(replay, &event) == EXIT_SUCCESS);
+    CU_ASSERT(event.type == REPLAY_PLACE && event.n == 3);
+    for ( i = 0; i < 3; i++ )
+    {
+        CU_ASSERT(event.args[i] == place[i]);
+    }
+
+    CU_ASSERT_FATAL(replay -> next(replay, &event) == EXIT_SUCCESS);
+    CU_ASSERT(event.type == REPLAY_CLEAR_LINES && event.n == 3);
+    for ( i = 0; i < 3; i++ )
+    {
+        CU_ASSERT(event.args[i] == lines[i]);
+    }
+
+    // End of the replay
+    CU_ASSERT(replay -> next(replay, &event) == EXIT_FAILURE);
+
+    // Nothing is recorded to a loaded replay
+    CU_ASSERT(replay -> event(replay, REPLAY_UPDATE, 0, NULL) == \
+              EXIT_FAILURE);
+
+    CU_ASSERT(replay_close(replay) == EXIT_SUCCESS);
+
+    // Not a replay
+    file = fopen(REPLAY_FILE, "w");
+    CU_ASSERT_FATAL(file != NULL);
+    fputs("TXT", file);
+    fclose(file);
+
+    CU_ASSERT(replay_load(REPLAY_FILE) == NULL);
+}
+
+/**
+ * @brief A recorded game is played the same again
+ * 
+ * A game with start rows, random moves and pieces placed by the bot, clearing
+ * its lines, gets the same rows, score and pieces when its replay is applied
+ * to a new board.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test2 (void)
+{
+    int i, n, lines[BOARD_HEIGHT], failed = 0, filled = 0, pieces = 0;
+    uint64_t hash;
+    row_t rows[BOARD_HEIGHT];
+    stats_t stats;
+    const stats_t * again;
+    rnd_state_t moves;
+    bot_t bot;
+    replay_t * replay;
+    replay_event_t event;
+
+    boardStruct = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL);
+
+    replay = replay_record(REPLAY_FILE);
+    CU_ASSERT_FATAL(replay != NULL);
+
+    boardStruct -> set.seed(boardStruct, SEED);
+    boardStruct -> set.randomizer(boardStruct, RANDOMIZER_NES);
+    boardStruct -> set.replay(boardStruct, replay);
+    boardStruct -> set.startRows(boardStruct, 4);
+
+    init_random_state(&moves, SEED, RANDOMIZER_BAG);
+    CU_ASSERT_FATAL(bot_init(&bot) == EXIT_SUCCESS);
+
+    for ( i = 0; i < MOVES && !boardStruct -> ask.endGame(boardStruct); i++ )
+    {
+        switch ( random_number(&moves, 8) )
+        {
+            case 0:
+                boardStruct -> piece.shift(boardStruct, LEFT);
+                break;
+            case 1:
+                boardStruct -> piece.shift(boardStruct, RIGHT);
+                break;
+            case 2:
+                boardStruct -> piece.rotate(boardStruct,
+                                            random_number(&moves, 2) ?
+                                            LEFT : RIGHT);
+                break;
+            case 3:
+                boardStruct -> piece.softDrop(boardStruct);
+                break;
+            case 4:
+                boardStruct -> piece.hardDrop(boardStruct);
+                break;
+            case 5:
+            case 6:
+                // Fails with no moving piece, so nothing is placed
+                bot.play(&bot, boardStruct);
+                break;
+            default:
+                boardStruct -> update(boardStruct);
+                break;
+        }
+
+        n = boardStruct -> ask.filledRows(boardStruct, lines);
+        boardStruct -> clear.lines(boardStruct, lines, n);
+    }
+
+    CU_ASSERT(replay_close(replay) == EXIT_SUCCESS);
+    bot.destroy(&bot);
+
+    hash = boardStruct -> ask.hash(boardStruct);
+    memcpy(rows, boardStruct -> ask.rows(boardStruct), sizeof (rows));
+    memcpy(&stats, boardStruct -> ask.stats(boardStruct), sizeof (stats));
+
+    board_free(boardStruct);
+
+    // Play it again
+    boardStruct = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL);
+
+    replay = replay_load(REPLAY_FILE);
+    CU_ASSERT_FATAL(replay != NULL);
+
+    while ( replay -> next(replay, &event) == EXIT_SUCCESS )
+    {
+        failed += replay_apply(boardStruct, &event);
+        filled += (event.type == REPLAY_FILLED_ROWS);
+    }
+
+    CU_ASSERT(replay_close(replay) == EXIT_SUCCESS);
+
+    // Rows are only checked after the start rows and each fixed piece
+    for ( i = 0; i < TETROMINOS; i++ )
+    {
+        pieces += stats.piece.number[i];
+    }
+
+    CU_ASSERT(filled > 0 && filled <= pieces + 1);
+
+    CU_ASSERT(boardStruct -> ask.seed(boardStruct) == SEED);
+    CU_ASSERT(boardStruct -> ask.randomizer(boardStruct) == RANDOMIZER_NES);
+    // Pieces aren't given by the seed with TRUERANDOM
+#ifndef TRUERANDOM
+    CU_ASSERT(failed == 0);
+    CU_ASSERT(boardStruct -> ask.hash(boardStruct) == hash);
+    CU_ASSERT(memcmp(boardStruct -> ask.rows(boardStruct), rows,
+                     sizeof (rows)) == 0);
+
+    again = boardStruct -> ask.stats(boardStruct);
+    CU_ASSERT(again -> level == stats.level);
+    CU_ASSERT(again -> lines.cleared == stats.lines.cleared);
+    CU_ASSERT(again -> score.actual == stats.score.actual);
+    CU_ASSERT(memcmp(again -> piece.number, stats.piece.number,
+                     sizeof (stats.piece.number)) == 0);
+#else
+    (void) hash;
+    (void) again;
+    (void) failed;
+#endif
+
+    board_free(boardStruct);
+    boardStruct = NULL;
+}
+
+/**
+ * @brief Only new boards are recorded
+ * 
+ * A board already played and a loaded replay are ignored by set.replay().
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test3 (void)
+{
+    replay_t * replay;
+    replay_event_t event;
+
+    boardStruct = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL);
+
+    // Already played
+    boardStruct -> update(boardStruct);
+
+    replay = replay_record(REPLAY_FILE);
+    CU_ASSERT_FATAL(replay != NULL);
+
+    boardStruct -> set.replay(boardStruct, replay);
+    boardStruct -> update(boardStruct);
+    boardStruct -> piece.hardDrop(boardStruct);
+
+    CU_ASSERT(replay_close(replay) == EXIT_SUCCESS);
+    board_free(boardStruct);
+
+    // Nothing was recorded
+    replay = replay_load(REPLAY_FILE);
+    CU_ASSERT_FATAL(replay != NULL);
+    CU_ASSERT(replay -> next(replay, &event) == EXIT_FAILURE);
+
+    // A loaded replay can't be recorded
+    boardStruct = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL);
+
+    boardStruct -> set.replay(boardStruct, replay);
+    boardStruct -> update(boardStruct);
+
+    CU_ASSERT(replay -> next(replay, &event) == EXIT_FAILURE);
+    CU_ASSERT(replay_close(replay) == EXIT_SUCCESS);
+
+    board_free(boardStruct);
+    boardStruct = NULL;
+}
+
+/**
+ * @brief Seek to any piece
+ * 
+ * The state of a game before some pieces are deployed is kept while it's
+ * recorded. Seeking to them, forwards and backwards, gets the same states,
+ * and the game can be played on from there. A board that isn't the same
+ * stops at the next keyframe.
+ * 
+ * @param None
+ * 
+ * @return Nothing
+ */
+void
+test4 (void)
+{
+    // Pieces aren't given by the seed with TRUERANDOM
+#ifndef TRUERANDOM
+    int i, n, lines[BOARD_HEIGHT];
+    const int pieces[] = {
+        0, REPLAY_KEYFRAME_PIECES + 37, REPLAY_KEYFRAME_PIECES, 3,
+        3 * REPLAY_KEYFRAME_PIECES + 10, 2 * REPLAY_KEYFRAME_PIECES - 1
+    };
+    const int seeks = sizeof (pieces) / sizeof (pieces[0]);
+    board_state_t states[sizeof (pieces) / sizeof (pieces[0])], state;
+    grid_t row[BOARD_WIDTH] = {CELL_O};
+    bot_t bot;
+    replay_t * replay;
+
+    boardStruct = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL);
+    CU_ASSERT_FATAL(bot_init(&bot) == EXIT_SUCCESS);
+
+    replay = replay_record(REPLAY_FILE);
+    CU_ASSERT_FATAL(replay != NULL);
+
+    boardStruct -> set.seed(boardStruct, SEED);
+    boardStruct -> set.replay(boardStruct, replay);
+
+    for ( i = 0; i < PIECES && !boardStruct -> ask.endGame(boardStruct); i++ )
+    {
+        // Right before the piece is deployed
+        for ( n = 0; n < seeks; n++ )
+        {
+            (pieces[n] == i) ? board_snapshot(boardStruct, &states[n]) : 0;
+        }
+
+        boardStruct -> update(boardStruct);
+        CU_ASSERT(bot.play(&bot, boardStruct) == EXIT_SUCCESS);
+
+        n = boardStruct -> ask.filledRows(boardStruct, lines);
+        boardStruct -> clear.lines(boardStruct, lines, n);
+    }
+
+    CU_ASSERT_FATAL(i == PIECES);
+    CU_ASSERT(replay_close(replay) == EXIT_SUCCESS);
+    bot.destroy(&bot);
+
+    board_free(boardStruct);
+
+    // Seek on a new board
+    boardStruct = board_create();
+    CU_ASSERT_FATAL(boardStruct != NULL);
+
+    replay = replay_load(REPLAY_FILE);
+    CU_ASSERT_FATAL(replay != NULL);
+
+    for ( n = 0; n < seeks; n++ )
+    {
+        CU_ASSERT_FATAL(replay -> seek(replay, boardStruct, pieces[n]) == \
+                        EXIT_SUCCESS);
+        board_snapshot(boardStruct, &state);
+        CU_ASSERT(memcmp(&state, &states[n], sizeof (state)) == 0);
+    }
+
+    // There aren't so many pieces
+    CU_ASSERT(replay -> seek(replay, boardStruct, 2 * PIECES) == \
+              EXIT_FAILURE);
+    CU_ASSERT(replay -> finished == true);
+
+    // Played on to the end, checking every keyframe
+    CU_ASSERT(replay -> seek(replay, boardStruct, 10) == EXIT_SUCCESS);
+    CU_ASSERT(replay -> finished == false);
+    CU_ASSERT(replay -> play(replay, boardStruct, REPLAY_MAX_SPEED) == \
+              EXIT_SUCCESS);
+    CU_ASSERT(replay -> finished == true);
+
+    // Not the same game
+    CU_ASSERT(replay -> seek(replay, boardStruct, 10) == EXIT_SUCCESS);
+    boardStruct -> set.row(boardStruct, BOARD_HEIGHT - 1, row);
+    CU_ASSERT(replay -> play(replay, boardStruct, REPLAY_MAX_SPEED) == \
+              EXIT_FAILURE);
+    CU_ASSERT(replay -> finished == false);
+
+    CU_ASSERT(replay_close(replay) == EXIT_SUCCESS);
+
+    board_free(boardStruct);
+    boardStruct = NULL;
+#endif
+}